@@ -0,0 +1,182 @@
+#include "BatteryHistory.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static constexpr uint32_t HISTORY_MAGIC = 0x48424c45;  // "ELBH"
+static constexpr uint16_t HISTORY_VERSION = 1;
+
+struct BatteryHistory::Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+    uint32_t capacity;
+    uint32_t head;   // slot the next sample is written to
+    uint32_t count;
+    uint32_t reserved;
+    int64_t lastTime;  // of the newest sample, for the write rate limit
+    uint8_t lastState;
+    uint8_t padding[31];
+};
+
+static_assert(sizeof(BatterySample) == 16, "BatterySample is stored on disk");
+
+static bool makeDirectories(const std::string& path) {
+    for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+        if (mkdir(path.substr(0, slash).c_str(), 0700) != 0 && errno != EEXIST) return false;
+    }
+    return true;
+}
+
+BatteryHistory::BatteryHistory()
+    : fd(-1), writable(false), mappedSize(0), header(nullptr), records(nullptr) {
+}
+
+BatteryHistory::~BatteryHistory() {
+    close();
+}
+
+std::string BatteryHistory::defaultPath() {
+    const char* state = getenv("XDG_STATE_HOME");
+    std::string base;
+    if (state && state[0] == '/') {
+        base = state;
+    } else {
+        const char* home = getenv("HOME");
+        if (!home) return "";
+        base = std::string(home) + "/.local/state";
+    }
+    return base + "/elysia-settings/battery-history";
+}
+
+bool BatteryHistory::open(const std::string& path) {
+    static_assert(sizeof(Header) == 64, "history header is stored on disk");
+
+    close();
+    if (path.empty() || !makeDirectories(path)) return false;
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) return false;
+
+    // Another instance is already recording; show its history without writing
+    writable = flock(fd, LOCK_EX | LOCK_NB) == 0;
+
+    mappedSize = sizeof(Header) + CAPACITY * sizeof(BatterySample);
+    struct stat st;
+    if (fstat(fd, &st) != 0 ||
+        (static_cast<size_t>(st.st_size) != mappedSize && (!writable || ftruncate(fd, mappedSize) != 0))) {
+        close();
+        return false;
+    }
+
+    void* mapping = mmap(nullptr, mappedSize, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        close();
+        return false;
+    }
+    header = static_cast<Header*>(mapping);
+    records = reinterpret_cast<BatterySample*>(static_cast<uint8_t*>(mapping) + sizeof(Header));
+
+    bool valid = header->magic == HISTORY_MAGIC && header->version == HISTORY_VERSION &&
+                 header->recordSize == sizeof(BatterySample) && header->capacity == CAPACITY &&
+                 header->head < CAPACITY && header->count <= CAPACITY;
+    if (!valid) {
+        if (!writable) {
+            close();
+            return false;
+        }
+        // New file, or one from an incompatible build: start over
+        memset(header, 0, sizeof(Header));
+        header->magic = HISTORY_MAGIC;
+        header->version = HISTORY_VERSION;
+        header->recordSize = sizeof(BatterySample);
+        header->capacity = CAPACITY;
+    }
+    return true;
+}
+
+void BatteryHistory::close() {
+    if (header) munmap(header, mappedSize);
+    if (fd >= 0) ::close(fd);  // also drops the lock
+    fd = -1;
+    writable = false;
+    mappedSize = 0;
+    header = nullptr;
+    records = nullptr;
+}
+
+bool BatteryHistory::record(const BatterySample& sample) {
+    if (!header || !writable) return false;
+
+    if (header->count > 0) {
+        int64_t elapsed = sample.time - header->lastTime;
+        // A clock set backwards is taken as a fresh start rather than
+        // blocking recording until it catches up
+        if (elapsed >= 0) {
+            int interval = sample.state != header->lastState ? STATE_INTERVAL : RECORD_INTERVAL;
+            if (elapsed < interval) return false;
+        }
+    }
+
+    // The record first, then the header, so a crash in between loses only
+    // the new sample
+    records[header->head] = sample;
+    header->head = (header->head + 1) % CAPACITY;
+    if (header->count < CAPACITY) header->count++;
+    header->lastTime = sample.time;
+    header->lastState = sample.state;
+    return true;
+}
+
+size_t BatteryHistory::size() const {
+    return header ? header->count : 0;
+}
+
+const BatterySample& BatteryHistory::at(size_t index) const {
+    size_t oldest = (header->head + CAPACITY - header->count) % CAPACITY;
+    return records[(oldest + index) % CAPACITY];
+}
+
+size_t BatteryHistory::lowerBound(int64_t time) const {
+    size_t low = 0;
+    size_t high = size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (at(middle).time < time) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+void BatteryHistory::decimate(int64_t from, int64_t to, size_t bucketCount,
+                              std::vector<HistoryBucket>& buckets) const {
+    const float inf = std::numeric_limits<float>::infinity();
+    buckets.assign(bucketCount, HistoryBucket{inf, -inf, inf, -inf, 0});
+    if (!header || bucketCount == 0 || to <= from) return;
+
+    const double span = static_cast<double>(to - from);
+    for (size_t i = lowerBound(from); i < size(); ++i) {
+        const BatterySample& sample = at(i);
+        if (sample.time >= to) break;
+        if (sample.time < from) continue;  // out of order after a clock change
+
+        size_t index = static_cast<size_t>((sample.time - from) / span * bucketCount);
+        HistoryBucket& bucket = buckets[std::min(index, bucketCount - 1)];
+        if (sample.charge != BatterySample::NO_CHARGE) {
+            float charge = sample.charge / 100.0f;
+            bucket.minCharge = std::min(bucket.minCharge, charge);
+            bucket.maxCharge = std::max(bucket.maxCharge, charge);
+        }
+        float rate = sample.rate / 100.0f;
+        bucket.minRate = std::min(bucket.minRate, rate);
+        bucket.maxRate = std::max(bucket.maxRate, rate);
+        bucket.count++;
+    }
+}
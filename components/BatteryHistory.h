@@ -0,0 +1,84 @@
+#ifndef BATTERYHISTORY_H
+#define BATTERYHISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One stored reading: 16 bytes, so a week at one sample a minute is ~160 KB
+struct BatterySample {
+    int64_t time;      // seconds since the epoch; the history outlives reboots
+    uint16_t charge;   // percent * 100, NO_CHARGE if unknown
+    int16_t rate;      // watts * 100, negative while discharging
+    uint16_t voltage;  // millivolts, 0 if unknown
+    uint8_t state;     // BatteryState
+    uint8_t reserved;
+
+    static constexpr uint16_t NO_CHARGE = 0xffff;
+};
+
+// Extremes of the samples falling into one slice of a chart; min > max
+// when the slice has no charge reading
+struct HistoryBucket {
+    float minCharge;
+    float maxCharge;
+    float minRate;
+    float maxRate;
+    uint32_t count;
+};
+
+// Battery history kept in a fixed-size ring file that is mapped into memory.
+// A header at the front holds the write position; samples are plain
+// BatterySample records, so appending touches one record and the header and
+// the kernel writes the dirty page back on its own schedule. record()
+// enforces the write rate: at most one sample per RECORD_INTERVAL seconds,
+// or per STATE_INTERVAL when the charging state flips.
+//
+// Only one process records at a time: the file is locked on open, and a
+// second instance maps it read-only.
+class BatteryHistory {
+public:
+    static constexpr uint32_t CAPACITY = 10240;  // a little over 7 days at one a minute
+    static constexpr int RECORD_INTERVAL = 60;
+    static constexpr int STATE_INTERVAL = 10;
+
+    BatteryHistory();
+    ~BatteryHistory();
+
+    BatteryHistory(const BatteryHistory&) = delete;
+    BatteryHistory& operator=(const BatteryHistory&) = delete;
+
+    // $XDG_STATE_HOME/elysia-settings/battery-history, or ~/.local/state/...
+    static std::string defaultPath();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+    bool isWritable() const { return writable; }
+
+    // Returns true if the sample was stored
+    bool record(const BatterySample& sample);
+
+    size_t size() const;
+    // Oldest first
+    const BatterySample& at(size_t index) const;
+
+    // Splits [from, to) into bucketCount equal slices and collects the
+    // extremes of each; the cost depends on the samples in range, not on
+    // how many buckets are drawn later
+    void decimate(int64_t from, int64_t to, size_t bucketCount, std::vector<HistoryBucket>& buckets) const;
+
+private:
+    struct Header;
+
+    int fd;
+    bool writable;
+    size_t mappedSize;
+    Header* header;
+    BatterySample* records;
+
+    size_t lowerBound(int64_t time) const;
+};
+
+#endif // BATTERYHISTORY_H
@@ -2,21 +2,41 @@
 #include "../MainWindow.h"
 #include "../translations/translations.h"
 #include <iostream>
-#include <sstream>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 #include <algorithm>
-#include <regex>
+#include <cmath>
+#include <fcntl.h>
+#include <glib-unix.h>
+
+static double monotonicSeconds() {
+    return g_get_monotonic_time() / static_cast<double>(G_USEC_PER_SEC);
+}
 
 BatteryManager::BatteryManager(MainWindow* mainWindow, GtkWindow* parentWindow, GtkWidget* overlay)
     : mainWindow(mainWindow), parentWindow(parentWindow), overlay(overlay),
       batteryContainer(nullptr), backButton(nullptr), titleLabel(nullptr),
       batteryIcon(nullptr), percentageLabel(nullptr), statusLabel(nullptr),
       progressBar(nullptr), infoContainer(nullptr), healthContainer(nullptr),
-      powerContainer(nullptr), updateTimer(0) {
-    
-    batteryDevice = findBatteryDevice();
+      powerContainer(nullptr), percentageClass(nullptr),
+      peripheralContainer(nullptr), historyArea(nullptr), historyRangeDropDown(nullptr),
+      recordTimer(0), governorFd(-1), supplyWatchId(0), updateTimer(0) {
+    
+    // Hotplug and change notifications for every battery, for the app's lifetime
+    supplies.start(monotonicSeconds());
+    if (supplies.eventFd() >= 0) {
+        supplyWatchId = g_unix_fd_add(supplies.eventFd(), G_IO_IN, onSupplyEvent, this);
+    }
+    std::string governorPath = PowerSupply::sysfsRoot() + "/devices/system/cpu/cpu0/cpufreq/scaling_governor";
+    governorFd = open(governorPath.c_str(), O_RDONLY | O_CLOEXEC);
+    history.open(BatteryHistory::defaultPath());
     setupUI();
+    
+    // Keep recording while the page is closed; a seconds timer lets GLib
+    // wake up for it together with other timers
+    recordTimer = g_timeout_add_seconds(BatteryHistory::RECORD_INTERVAL, onRecordTimer, this);
 }
 
 BatteryManager::~BatteryManager() {
@@ -25,6 +45,18 @@ BatteryManager::~BatteryManager() {
         g_source_remove(updateTimer);
         updateTimer = 0;
     }
+    if (recordTimer > 0) {
+        g_source_remove(recordTimer);
+        recordTimer = 0;
+    }
+    if (governorFd >= 0) {
+        close(governorFd);
+        governorFd = -1;
+    }
+    if (supplyWatchId > 0) {
+        g_source_remove(supplyWatchId);
+        supplyWatchId = 0;
+    }
     
     // Clear widget vectors for cleanup
     batteryWidgets.clear();
@@ -126,6 +158,12 @@ void BatteryManager::initBatteryUI() {
         "}"
         ".charging {"
         "  color: #25d979;"
+        "}"
+        ".battery-history {"
+        "  background: rgba(255, 255, 255, 0.06);"
+        "  border-radius: 16px;"
+        "  border: 1px solid rgba(255, 166, 218, 0.15);"
+        "  padding: 8px 12px;"
         "}";
     
     gtk_css_provider_load_from_string(cssProvider, css);
@@ -147,6 +185,7 @@ void BatteryManager::initBatteryUI() {
     
     createBatteryDisplay();
     createInfoSections();
+    createHistoryChart();
     
     // Initial update
     updateBatteryDisplay();
@@ -245,9 +284,9 @@ void BatteryManager::createBatteryDisplay() {
     // Status label
     statusLabel = gtk_label_new(TR(TranslationKeys::CHECKING_BATTERY_STATUS));
     gtk_widget_add_css_class(statusLabel, "battery-status");
-    gtk_widget_set_size_request(statusLabel, 400, 30);
+    gtk_widget_set_size_request(statusLabel, 500, 30);
     gtk_label_set_xalign(GTK_LABEL(statusLabel), 0.5);
-    gtk_fixed_put(GTK_FIXED(displayContainer), statusLabel, 50, 200); // Below percentage
+    gtk_fixed_put(GTK_FIXED(displayContainer), statusLabel, 0, 200); // Below percentage, wide enough for the estimate range
     batteryWidgets.push_back(statusLabel);
 }
 
@@ -267,6 +306,7 @@ void BatteryManager::createInfoSections() {
     gtk_label_set_xalign(GTK_LABEL(healthTitle), 0.5);
     gtk_fixed_put(GTK_FIXED(healthContainer), healthTitle, 20, 10);
     batteryWidgets.push_back(healthTitle);
+    createInfoSlots(healthContainer, healthSlots);
     
     // Power Information Section - positioned like AppearanceManager
     powerContainer = gtk_fixed_new();
@@ -281,6 +321,51 @@ void BatteryManager::createInfoSections() {
     gtk_label_set_xalign(GTK_LABEL(powerTitle), 0.5);
     gtk_fixed_put(GTK_FIXED(powerContainer), powerTitle, 20, 10);
     batteryWidgets.push_back(powerTitle);
+    createInfoSlots(powerContainer, powerSlots);
+    
+    createPeripheralSection();
+}
+
+void BatteryManager::createPeripheralSection() {
+    // Mice, keyboards, headsets and UPSes; hidden while there are none
+    peripheralContainer = gtk_fixed_new();
+    gtk_widget_set_size_request(peripheralContainer, 300, 200);
+    gtk_widget_add_css_class(peripheralContainer, "info-section");
+    gtk_widget_set_visible(peripheralContainer, FALSE);
+    gtk_fixed_put(GTK_FIXED(batteryContainer), peripheralContainer, 1100, 410);
+    batteryWidgets.push_back(peripheralContainer);
+    
+    GtkWidget* peripheralTitle = gtk_label_new(TR(TranslationKeys::PERIPHERAL_BATTERIES));
+    gtk_widget_add_css_class(peripheralTitle, "section-title");
+    gtk_widget_set_size_request(peripheralTitle, 260, 25);
+    gtk_label_set_xalign(GTK_LABEL(peripheralTitle), 0.5);
+    gtk_fixed_put(GTK_FIXED(peripheralContainer), peripheralTitle, 20, 10);
+    batteryWidgets.push_back(peripheralTitle);
+    createInfoSlots(peripheralContainer, peripheralSlots);
+}
+
+void BatteryManager::createHistoryChart() {
+    if (!batteryContainer) return;
+    
+    // Redrawn only when a sample is stored or the range changes
+    historyArea = gtk_drawing_area_new();
+    gtk_widget_set_size_request(historyArea, 560, 140);
+    gtk_widget_add_css_class(historyArea, "battery-history");
+    gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(historyArea), drawHistoryChart, this, nullptr);
+    gtk_fixed_put(GTK_FIXED(batteryContainer), historyArea, 400, 630);
+    batteryWidgets.push_back(historyArea);
+    
+    const char* ranges[] = {
+        TR(TranslationKeys::HISTORY_DAY),
+        TR(TranslationKeys::HISTORY_WEEK),
+        nullptr
+    };
+    historyRangeDropDown = gtk_drop_down_new_from_strings(ranges);
+    gtk_widget_set_size_request(historyRangeDropDown, 80, 36);
+    gtk_widget_set_tooltip_text(historyRangeDropDown, TR(TranslationKeys::BATTERY_HISTORY));
+    g_signal_connect(historyRangeDropDown, "notify::selected", G_CALLBACK(onHistoryRangeChanged), this);
+    gtk_fixed_put(GTK_FIXED(batteryContainer), historyRangeDropDown, 970, 630);
+    batteryWidgets.push_back(historyRangeDropDown);
 }
 
 void BatteryManager::show() {
@@ -292,11 +377,15 @@ void BatteryManager::show() {
             mainWindow->switchToBackground("background4.png");
         }
         
-        // Start update timer (update every 2 seconds)
-        updateTimer = g_timeout_add(2000, onUpdateTimer, this);
+        // Start update timer (update every 2 seconds); showing the page
+        // again while it is open must not stack a second timer
+        if (updateTimer == 0) {
+            updateTimer = g_timeout_add(2000, onUpdateTimer, this);
+        }
         
         // Immediate update
         updateBatteryDisplay();
+        refreshHistoryChart();
     }
 }
 
@@ -312,116 +401,80 @@ void BatteryManager::hide() {
     }
 }
 
-std::string BatteryManager::findBatteryDevice() {
-    std::string output = executeCommand("upower -e");
-    std::istringstream stream(output);
-    std::string line;
-    
-    while (std::getline(stream, line)) {
-        if (line.find("battery_") != std::string::npos || line.find("BAT") != std::string::npos) {
-            return line;
-        }
+const char* BatteryManager::describeState(BatteryState state) {
+    switch (state) {
+        case BatteryState::Charging: return TR(TranslationKeys::CHARGING);
+        case BatteryState::Discharging: return TR(TranslationKeys::DISCHARGING);
+        case BatteryState::NotCharging: return TR(TranslationKeys::NOT_CHARGING);
+        case BatteryState::Full: return TR(TranslationKeys::FULL);
+        default: return TR(TranslationKeys::BATTERY_STATE_UNKNOWN);
     }
-    
-    return "";
 }
 
-BatteryInfo BatteryManager::parseBatteryInfo(const std::string& device) {
-    BatteryInfo info = {};
-    
-    if (device.empty()) {
-        return info;
-    }
-    
-    std::string command = "upower -i " + device;
-    std::string output = executeCommand(command);
-    std::istringstream stream(output);
-    std::string line;
-    
-    while (std::getline(stream, line)) {
-        if (line.find(":") == std::string::npos) continue;
-        
-        size_t colonPos = line.find(":");
-        std::string key = line.substr(0, colonPos);
-        std::string value = line.substr(colonPos + 1);
-        
-        // Trim whitespace
-        key.erase(0, key.find_first_not_of(" \t"));
-        key.erase(key.find_last_not_of(" \t") + 1);
-        value.erase(0, value.find_first_not_of(" \t"));
-        value.erase(value.find_last_not_of(" \t") + 1);
-        
-        if (key == "state") {
-            info.state = value;
-            info.isCharging = (value == "charging");
-        } else if (key == "warning-level") {
-            info.warningLevel = value;
-        } else if (key == "energy-full") {
-            info.energyFull = value;
-        } else if (key == "energy-full-design") {
-            info.energyFullDesign = value;
-        } else if (key == "energy-rate") {
-            info.energyRate = value;
-        } else if (key == "voltage") {
-            info.voltage = value;
-        } else if (key == "charge-cycles") {
-            info.chargeCycles = value;
-        } else if (key == "percentage") {
-            info.percentage = value;
-            // Extract numeric value
-            std::regex percentRegex(R"((\d+)%)");
-            std::smatch match;
-            if (std::regex_search(value, match, percentRegex)) {
-                info.percentageValue = std::stoi(match[1]);
-            }
-        } else if (key == "capacity") {
-            info.capacity = value;
-        } else if (key == "technology") {
-            info.technology = value;
-        } else if (key == "time to empty") {
-            info.timeToEmpty = formatBatteryTime(value);
-        } else if (key == "time to full") {
-            info.timeToFull = formatBatteryTime(value);
-        }
+const char* BatteryManager::describeLevel(BatteryLevel level) {
+    switch (level) {
+        case BatteryLevel::Normal: return TR(TranslationKeys::BATTERY_LEVEL_NORMAL);
+        case BatteryLevel::Low: return TR(TranslationKeys::BATTERY_LEVEL_LOW);
+        case BatteryLevel::Critical: return TR(TranslationKeys::BATTERY_LEVEL_CRITICAL);
+        case BatteryLevel::Full: return TR(TranslationKeys::FULL);
+        default: return "";
     }
-    
-    return info;
 }
 
 void BatteryManager::updateBatteryDisplay() {
-    if (batteryDevice.empty()) {
+    // Only the supplies whose own interval has run out are read again
+    supplies.refresh(monotonicSeconds());
+    updatePeripheralSection();
+    
+    if (supplies.systemCount() == 0) {
         gtk_label_set_text(GTK_LABEL(percentageLabel), "N/A");
         gtk_label_set_text(GTK_LABEL(statusLabel), TR(TranslationKeys::NO_BATTERY_DETECTED));
         return;
     }
-    
-    currentInfo = parseBatteryInfo(batteryDevice);
+    currentInfo = supplies.aggregate();
+    recordSample(currentInfo);
     
     // Update percentage
-    gtk_label_set_text(GTK_LABEL(percentageLabel), currentInfo.percentage.c_str());
-    
-    // Update status
-    std::string statusText = currentInfo.state;
-    if (currentInfo.isCharging && !currentInfo.timeToFull.empty()) {
-        statusText += " - " + currentInfo.timeToFull + " until full";
-    } else if (!currentInfo.isCharging && !currentInfo.timeToEmpty.empty()) {
-        statusText += " - " + currentInfo.timeToEmpty + " remaining";
+    std::string percentageText = "---%";
+    if (currentInfo.percentage >= 0.0) {
+        percentageText = std::to_string(static_cast<int>(std::lround(currentInfo.percentage))) + "%";
+    }
+    gtk_label_set_text(GTK_LABEL(percentageLabel), percentageText.c_str());
+    
+    // Update status: the smoothed estimate once the model has warmed up,
+    // the driver's instantaneous figure until then
+    DischargeEstimator::Estimate estimate = estimator.estimate(currentInfo.state, readPowerProfile(),
+                                                               currentInfo.energyNow, currentInfo.energyFull);
+    double remaining = currentInfo.isCharging ? currentInfo.timeToFull : currentInfo.timeToEmpty;
+    if (estimate.valid()) remaining = estimate.seconds;
+    
+    std::string statusText = describeState(currentInfo.state);
+    if (remaining > 0.0) {
+        statusText += " - " + formatBatteryTime(remaining) + " ";
+        statusText += currentInfo.isCharging ? TR(TranslationKeys::BATTERY_UNTIL_FULL) : TR(TranslationKeys::BATTERY_REMAINING);
+        if (estimate.valid() && estimate.high > 0.0) {
+            statusText += " (" + formatBatteryTime(estimate.low) + " \u2013 " + formatBatteryTime(estimate.high) + ")";
+        }
     }
     gtk_label_set_text(GTK_LABEL(statusLabel), statusText.c_str());
     
     // Note: We're using a custom static battery.png icon, so no dynamic icon update needed
     
-    // Update color based on battery level
-    gtk_widget_remove_css_class(percentageLabel, "warning");
-    gtk_widget_remove_css_class(percentageLabel, "critical");
-    gtk_widget_remove_css_class(percentageLabel, "charging");
-    
+    // Update color based on battery level, touching the classes only when
+    // the level changes so the label is not restyled on every refresh
+    const char* levelClass = nullptr;
     if (currentInfo.isCharging) {
-        gtk_widget_add_css_class(percentageLabel, "charging");
-    } else if (currentInfo.percentageValue <= 15) {
-        gtk_widget_add_css_class(percentageLabel, "critical");
-    } else if (currentInfo.percentageValue <= 30) {
-        gtk_widget_add_css_class(percentageLabel, "warning");
+        levelClass = "charging";
+    } else if (currentInfo.percentage >= 0.0 && currentInfo.percentage <= 15.0) {
+        levelClass = "critical";
+    } else if (currentInfo.percentage >= 0.0 && currentInfo.percentage <= 30.0) {
+        levelClass = "warning";
+    }
+    
+    if (levelClass != percentageClass) {
+        if (percentageClass) gtk_widget_remove_css_class(percentageLabel, percentageClass);
+        if (levelClass) gtk_widget_add_css_class(percentageLabel, levelClass);
+        percentageClass = levelClass;
     }
     
     // Update info sections
@@ -429,95 +482,175 @@ void BatteryManager::updateBatteryDisplay() {
 }
 
 void BatteryManager::updateInfoSections() {
-    // For GTK4, we'll track and manage info widgets manually
-    // Clear any existing dynamic info widgets by recreating the containers
-    
-    // Add health info
-    int yPos = 45;
     std::vector<std::pair<std::string, std::string>> healthInfo = {
-        {TR(TranslationKeys::CAPACITY), currentInfo.capacity},
+        {TR(TranslationKeys::CAPACITY), formatValue(currentInfo.capacity, "%.1f%%")},
         {TR(TranslationKeys::TECHNOLOGY), currentInfo.technology},
-        {TR(TranslationKeys::CHARGE_CYCLES), currentInfo.chargeCycles},
-        {TR(TranslationKeys::WARNING_LEVEL), currentInfo.warningLevel}
+        {TR(TranslationKeys::CHARGE_CYCLES), currentInfo.chargeCycles >= 0 ? std::to_string(currentInfo.chargeCycles) : ""},
+        {TR(TranslationKeys::WARNING_LEVEL), describeLevel(currentInfo.level)}
     };
+    updateInfoSlots(healthSlots, healthInfo);
     
-    for (const auto& [label, value] : healthInfo) {
-        if (!value.empty() && value != "N/A") {
-            GtkWidget* infoLabel = gtk_label_new((label + ":").c_str());
-            gtk_widget_add_css_class(infoLabel, "info-label");
-            gtk_widget_set_size_request(infoLabel, 120, 20);
-            gtk_label_set_xalign(GTK_LABEL(infoLabel), 0.0);
-            gtk_fixed_put(GTK_FIXED(healthContainer), infoLabel, 20, yPos);
-            
-            GtkWidget* valueLabel = gtk_label_new(value.c_str());
-            gtk_widget_add_css_class(valueLabel, "info-value");
-            gtk_widget_set_size_request(valueLabel, 140, 20);
-            gtk_label_set_xalign(GTK_LABEL(valueLabel), 1.0);
-            gtk_fixed_put(GTK_FIXED(healthContainer), valueLabel, 140, yPos);
-            
-            batteryWidgets.push_back(infoLabel);
-            batteryWidgets.push_back(valueLabel);
-            yPos += 30;
-        }
-    }
-    
-    // Power section info will be added dynamically
-    
-    // Add power info
-    yPos = 45;
     std::vector<std::pair<std::string, std::string>> powerInfo = {
-        {TR(TranslationKeys::ENERGY_FULL), currentInfo.energyFull},
-        {TR(TranslationKeys::ENERGY_DESIGN), currentInfo.energyFullDesign},
-        {TR(TranslationKeys::ENERGY_RATE), currentInfo.energyRate},
-        {TR(TranslationKeys::VOLTAGE), currentInfo.voltage}
+        {TR(TranslationKeys::ENERGY_FULL), formatValue(currentInfo.energyFull, "%.1f Wh")},
+        {TR(TranslationKeys::ENERGY_DESIGN), formatValue(currentInfo.energyFullDesign, "%.1f Wh")},
+        {TR(TranslationKeys::ENERGY_RATE), formatValue(currentInfo.energyRate, "%.1f W")},
+        {TR(TranslationKeys::VOLTAGE), formatValue(currentInfo.voltage, "%.1f V")}
     };
+    updateInfoSlots(powerSlots, powerInfo);
+}
+
+void BatteryManager::updatePeripheralSection() {
+    if (!peripheralContainer) return;
+    
+    std::vector<std::pair<std::string, std::string>> peripheralInfo;
+    for (size_t i = 0; i < supplies.size(); i++) {
+        const PowerSupplyStatus& supply = supplies.at(i);
+        if (!supply.peripheral) continue;
+        
+        // Some devices only report a coarse level
+        std::string value = supply.info.percentage >= 0.0
+            ? formatValue(supply.info.percentage, "%.0f%%")
+            : describeLevel(supply.info.level);
+        if (value.empty()) value = "?";
+        if (supply.info.isCharging) value = std::string(TR(TranslationKeys::CHARGING)) + " " + value;
+        peripheralInfo.push_back({supply.model, value});
+    }
+    
+    gtk_widget_set_visible(peripheralContainer, !peripheralInfo.empty());
+    updateInfoSlots(peripheralSlots, peripheralInfo);
+}
+
+void BatteryManager::createInfoSlots(GtkWidget* container, std::vector<InfoSlot>& slots) {
+    // One key/value pair per row a section can show; they are only ever
+    // relabelled or hidden afterwards
+    int yPos = 45;
+    for (int i = 0; i < INFO_ROWS; i++) {
+        InfoSlot slot;
+        
+        slot.keyLabel = gtk_label_new("");
+        gtk_widget_add_css_class(slot.keyLabel, "info-label");
+        gtk_widget_set_size_request(slot.keyLabel, 120, 20);
+        gtk_label_set_xalign(GTK_LABEL(slot.keyLabel), 0.0);
+        // Device names can be long; keep them clear of the value
+        gtk_label_set_ellipsize(GTK_LABEL(slot.keyLabel), PANGO_ELLIPSIZE_END);
+        gtk_label_set_max_width_chars(GTK_LABEL(slot.keyLabel), 14);
+        gtk_widget_set_visible(slot.keyLabel, FALSE);
+        gtk_fixed_put(GTK_FIXED(container), slot.keyLabel, 20, yPos);
+        
+        slot.valueLabel = gtk_label_new("");
+        gtk_widget_add_css_class(slot.valueLabel, "info-value");
+        gtk_widget_set_size_request(slot.valueLabel, 140, 20);
+        gtk_label_set_xalign(GTK_LABEL(slot.valueLabel), 1.0);
+        gtk_widget_set_visible(slot.valueLabel, FALSE);
+        gtk_fixed_put(GTK_FIXED(container), slot.valueLabel, 140, yPos);
+        
+        batteryWidgets.push_back(slot.keyLabel);
+        batteryWidgets.push_back(slot.valueLabel);
+        slots.push_back(slot);
+        yPos += 30;
+    }
+}
+
+void BatteryManager::updateInfoSlots(std::vector<InfoSlot>& slots,
+                                     const std::vector<std::pair<std::string, std::string>>& rows) {
+    // Rows without a value are skipped, so the ones shown stay packed at the top
+    size_t slotIndex = 0;
+    for (const auto& [label, value] : rows) {
+        if (value.empty() || slotIndex >= slots.size()) continue;
+        
+        InfoSlot& slot = slots[slotIndex++];
+        if (slot.key != label) {
+            slot.key = label;
+            gtk_label_set_text(GTK_LABEL(slot.keyLabel), (label + ":").c_str());
+        }
+        if (slot.value != value) {
+            slot.value = value;
+            gtk_label_set_text(GTK_LABEL(slot.valueLabel), value.c_str());
+        }
+        if (!slot.shown) {
+            slot.shown = true;
+            gtk_widget_set_visible(slot.keyLabel, TRUE);
+            gtk_widget_set_visible(slot.valueLabel, TRUE);
+        }
+    }
     
-    for (const auto& [label, value] : powerInfo) {
-        if (!value.empty() && value != "N/A") {
-            GtkWidget* infoLabel = gtk_label_new((label + ":").c_str());
-            gtk_widget_add_css_class(infoLabel, "info-label");
-            gtk_widget_set_size_request(infoLabel, 120, 20);
-            gtk_label_set_xalign(GTK_LABEL(infoLabel), 0.0);
-            gtk_fixed_put(GTK_FIXED(powerContainer), infoLabel, 20, yPos);
-            
-            GtkWidget* valueLabel = gtk_label_new(value.c_str());
-            gtk_widget_add_css_class(valueLabel, "info-value");
-            gtk_widget_set_size_request(valueLabel, 140, 20);
-            gtk_label_set_xalign(GTK_LABEL(valueLabel), 1.0);
-            gtk_fixed_put(GTK_FIXED(powerContainer), valueLabel, 140, yPos);
-            
-            batteryWidgets.push_back(infoLabel);
-            batteryWidgets.push_back(valueLabel);
-            yPos += 30;
+    for (; slotIndex < slots.size(); slotIndex++) {
+        InfoSlot& slot = slots[slotIndex];
+        if (slot.shown) {
+            slot.shown = false;
+            gtk_widget_set_visible(slot.keyLabel, FALSE);
+            gtk_widget_set_visible(slot.valueLabel, FALSE);
         }
     }
 }
 
-std::string BatteryManager::formatBatteryTime(const std::string& timeStr) {
-    if (timeStr.empty() || timeStr == "N/A") return "";
+void BatteryManager::recordSample(const BatteryInfo& info) {
+    // Every reading trains the estimator; the history keeps only some
+    estimator.addSample(g_get_monotonic_time() / static_cast<double>(G_USEC_PER_SEC), info.state,
+                        readPowerProfile(), info.energyNow, info.energyRate);
+    
+    BatterySample sample = {};
+    sample.time = g_get_real_time() / G_USEC_PER_SEC;
+    sample.charge = info.percentage >= 0.0
+        ? static_cast<uint16_t>(std::lround(info.percentage * 100.0))
+        : BatterySample::NO_CHARGE;
+    
+    double rate = std::max(info.energyRate, 0.0);
+    if (info.state == BatteryState::Discharging) rate = -rate;
+    sample.rate = static_cast<int16_t>(std::clamp(std::lround(rate * 100.0), -32767L, 32767L));
+    sample.voltage = info.voltage > 0.0
+        ? static_cast<uint16_t>(std::min(std::lround(info.voltage * 1000.0), 65535L))
+        : 0;
+    sample.state = static_cast<uint8_t>(info.state);
+    
+    // record() applies the write rate limit; most calls store nothing
+    if (history.record(sample) && batteryContainer && gtk_widget_get_visible(batteryContainer)) {
+        refreshHistoryChart();
+    }
+}
+
+void BatteryManager::refreshHistoryChart() {
+    if (!historyArea) return;
     
-    // Parse time format like "2.5 hours" or "45 minutes"
-    std::regex timeRegex(R"((\d+(?:\.\d+)?)\s*(hours?|minutes?))");
-    std::smatch match;
+    int64_t span = 24 * 3600;
+    if (historyRangeDropDown && gtk_drop_down_get_selected(GTK_DROP_DOWN(historyRangeDropDown)) == 1) {
+        span = 7 * 24 * 3600;
+    }
+    int64_t now = g_get_real_time() / G_USEC_PER_SEC;
+    history.decimate(now - span, now + 1, HISTORY_BUCKETS, historyBuckets);
+    gtk_widget_queue_draw(historyArea);
+}
+
+PowerProfile BatteryManager::readPowerProfile() {
+    // Same mapping as PowerManager::detectCurrentMode: auto-cpufreq's
+    // performance mode forces the performance governor and balanced forces
+    // powersave; anything else is left to the system
+    char governor[32];
+    ssize_t length = governorFd >= 0 ? pread(governorFd, governor, sizeof(governor) - 1, 0) : -1;
+    if (length <= 0) return PowerProfile::Default;
+    
+    governor[length] = '\0';
+    if (strncmp(governor, "performance", 11) == 0) return PowerProfile::Performance;
+    if (strncmp(governor, "powersave", 9) == 0) return PowerProfile::Balanced;
+    return PowerProfile::Default;
+}
+
+std::string BatteryManager::formatBatteryTime(double seconds) {
+    if (seconds <= 0.0) return "";
     
-    if (std::regex_search(timeStr, match, timeRegex)) {
-        double value = std::stod(match[1]);
-        std::string unit = match[2];
-        
-        if (unit.find("hour") != std::string::npos) {
-            if (value < 1.0) {
-                int minutes = static_cast<int>(value * 60);
-                return std::to_string(minutes) + " min";
-            } else {
-                return std::to_string(static_cast<int>(value)) + "h " + 
-                       std::to_string(static_cast<int>((value - static_cast<int>(value)) * 60)) + "m";
-            }
-        } else {
-            return std::to_string(static_cast<int>(value)) + " min";
-        }
+    int minutes = static_cast<int>(seconds / 60.0);
+    if (minutes < 60) {
+        return std::to_string(minutes) + " min";
     }
+    return std::to_string(minutes / 60) + "h " + std::to_string(minutes % 60) + "m";
+}
+
+std::string BatteryManager::formatValue(double value, const char* format) {
+    if (value < 0.0) return "";
     
-    return timeStr;
+    char text[32];
+    snprintf(text, sizeof(text), format, value);
+    return text;
 }
 
 std::string BatteryManager::getBatteryIconName(int percentage, bool isCharging) {
@@ -533,19 +666,6 @@ std::string BatteryManager::getBatteryIconName(int percentage, bool isCharging)
     else return "battery-empty";
 }
 
-std::string BatteryManager::executeCommand(const std::string& command) {
-    std::string result;
-    FILE* pipe = popen(command.c_str(), "r");
-    if (pipe) {
-        char buffer[128];
-        while (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-            result += buffer;
-        }
-        pclose(pipe);
-    }
-    return result;
-}
-
 std::string BatteryManager::getAssetPath(const std::string& filename) {
     const char* home = getenv("HOME");
     if (!home) return filename;
@@ -573,3 +693,139 @@ gboolean BatteryManager::onUpdateTimer(gpointer user_data) {
     }
     return G_SOURCE_CONTINUE;
 }
+
+gboolean BatteryManager::onRecordTimer(gpointer user_data) {
+    BatteryManager* manager = static_cast<BatteryManager*>(user_data);
+    // While the page is open its own refresh records the samples
+    if (manager && manager->updateTimer == 0) {
+        manager->supplies.refresh(monotonicSeconds());
+        if (manager->supplies.systemCount() > 0) {
+            manager->recordSample(manager->supplies.aggregate());
+        }
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+gboolean BatteryManager::onSupplyEvent(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd; (void)condition;
+    
+    BatteryManager* manager = static_cast<BatteryManager*>(user_data);
+    if (!manager) return G_SOURCE_REMOVE;
+    
+    if (manager->supplies.processEvents(monotonicSeconds())) {
+        if (manager->updateTimer > 0) {
+            manager->updateBatteryDisplay();
+        } else if (manager->supplies.systemCount() > 0) {
+            // Plugging in or out is worth a history sample even while the page is closed
+            manager->recordSample(manager->supplies.aggregate());
+        }
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void BatteryManager::onHistoryRangeChanged(GObject*, GParamSpec*, gpointer user_data) {
+    BatteryManager* manager = static_cast<BatteryManager*>(user_data);
+    if (manager) {
+        manager->refreshHistoryChart();
+    }
+}
+
+void BatteryManager::drawHistoryChart(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data) {
+    BatteryManager* manager = static_cast<BatteryManager*>(user_data);
+    if (!manager || width <= 0 || height <= 0) return;
+    
+    const std::vector<HistoryBucket>& buckets = manager->historyBuckets;
+    const double textHeight = 22.0;
+    const double graphTop = textHeight;
+    const double graphHeight = height - graphTop - 2.0;
+    if (graphHeight <= 0) return;
+    
+    // Peak power in either direction sets the scale of the rate line
+    bool hasData = false;
+    double peakRate = 0.0;
+    for (const HistoryBucket& bucket : buckets) {
+        if (bucket.count == 0) continue;
+        hasData = true;
+        peakRate = std::max({peakRate, std::fabs(static_cast<double>(bucket.minRate)),
+                             std::fabs(static_cast<double>(bucket.maxRate))});
+    }
+    
+    std::string title = TR(TranslationKeys::BATTERY_HISTORY);
+    std::string peak = hasData && peakRate > 0.0
+        ? std::string(TR(TranslationKeys::ENERGY_RATE)) + " " + manager->formatValue(peakRate, "%.1f W")
+        : "";
+    
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.95);
+    PangoLayout* layout = gtk_widget_create_pango_layout(GTK_WIDGET(area), title.c_str());
+    cairo_move_to(cr, 0, 0);
+    pango_cairo_show_layout(cr, layout);
+    
+    if (!peak.empty()) {
+        int peakWidth = 0;
+        pango_layout_set_text(layout, peak.c_str(), -1);
+        pango_layout_get_pixel_size(layout, &peakWidth, nullptr);
+        cairo_move_to(cr, width - peakWidth, 0);
+        pango_cairo_show_layout(cr, layout);
+    }
+    
+    if (!hasData) {
+        int emptyWidth = 0;
+        pango_layout_set_text(layout, TR(TranslationKeys::BATTERY_NO_HISTORY), -1);
+        pango_layout_get_pixel_size(layout, &emptyWidth, nullptr);
+        cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.6);
+        cairo_move_to(cr, (width - emptyWidth) / 2.0, graphTop + graphHeight / 2.0 - 8.0);
+        pango_cairo_show_layout(cr, layout);
+    }
+    g_object_unref(layout);
+    
+    // 0, 50 and 100 % guides
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.2);
+    cairo_set_line_width(cr, 1.0);
+    for (int i = 0; i <= 2; ++i) {
+        double y = std::floor(graphTop + graphHeight * i / 2.0) + 0.5;
+        cairo_move_to(cr, 0, y);
+        cairo_line_to(cr, width, y);
+    }
+    cairo_stroke(cr);
+    
+    if (!hasData) return;
+    
+    const double slice = static_cast<double>(width) / buckets.size();
+    auto yForCharge = [&](double charge) {
+        return graphTop + graphHeight * (1.0 - charge / 100.0);
+    };
+    
+    // Charge as one min/max bar per bucket, so a week of samples costs the
+    // same to draw as an hour
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const HistoryBucket& bucket = buckets[i];
+        if (bucket.minCharge > bucket.maxCharge) continue;
+        double top = yForCharge(bucket.maxCharge);
+        double bottom = std::max(yForCharge(bucket.minCharge), top + 2.0);
+        cairo_rectangle(cr, i * slice, top, std::max(slice - 1.0, 1.0), bottom - top);
+    }
+    cairo_set_source_rgba(cr, 0.99, 0.52, 0.80, 0.85);
+    cairo_fill(cr);
+    
+    // Rate as a line through each bucket's largest magnitude, broken where
+    // nothing was recorded
+    if (peakRate <= 0.0) return;
+    bool drawing = false;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        const HistoryBucket& bucket = buckets[i];
+        if (bucket.count == 0) {
+            drawing = false;
+            continue;
+        }
+        double magnitude = std::max(std::fabs(bucket.minRate), std::fabs(bucket.maxRate));
+        double x = (i + 0.5) * slice;
+        double y = graphTop + graphHeight * (1.0 - magnitude / peakRate);
+        if (drawing) cairo_line_to(cr, x, y);
+        else cairo_move_to(cr, x, y);
+        drawing = true;
+    }
+    cairo_set_source_rgba(cr, 0.29, 0.87, 0.50, 1.0);
+    cairo_set_line_width(cr, 1.5);
+    cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
+    cairo_stroke(cr);
+}
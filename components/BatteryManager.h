@@ -5,28 +5,19 @@
 #include <string>
 #include <vector>
 #include <map>
+#include "PowerSupplyRegistry.h"
+#include "BatteryHistory.h"
+#include "DischargeEstimator.h"
 
 class MainWindow;
 
-struct BatteryInfo {
-    std::string state;
-    std::string warningLevel;
-    std::string energyFull;
-    std::string energyFullDesign;
-    std::string energyRate;
-    std::string voltage;
-    std::string chargeCycles;
-    std::string percentage;
-    std::string capacity;
-    std::string technology;
-    std::string timeToEmpty;
-    std::string timeToFull;
-    bool isCharging;
-    int percentageValue;
-};
-
 class BatteryManager {
 public:
+    // Key/value rows in each info section
+    static constexpr int INFO_ROWS = 4;
+    // Slices the history chart is decimated into, whatever its range
+    static constexpr int HISTORY_BUCKETS = 120;
+    
     BatteryManager(MainWindow* mainWindow, GtkWindow* parentWindow, GtkWidget* overlay);
     ~BatteryManager();
     
@@ -36,6 +27,10 @@ public:
     // Static callback functions
     static void onBackButtonClicked(GtkButton* button, gpointer user_data);
     static gboolean onUpdateTimer(gpointer user_data);
+    static gboolean onRecordTimer(gpointer user_data);
+    static gboolean onSupplyEvent(gint fd, GIOCondition condition, gpointer user_data);
+    static void onHistoryRangeChanged(GObject* dropDown, GParamSpec* pspec, gpointer user_data);
+    static void drawHistoryChart(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data);
 
 private:
     MainWindow* mainWindow;
@@ -51,9 +46,32 @@ private:
     GtkWidget* infoContainer;
     GtkWidget* healthContainer;
     GtkWidget* powerContainer;
+    const char* percentageClass;  // level CSS class on percentageLabel, if any
+    
+    // A row of an info section; key and value cache what the labels show
+    struct InfoSlot {
+        GtkWidget* keyLabel = nullptr;
+        GtkWidget* valueLabel = nullptr;
+        std::string key;
+        std::string value;
+        bool shown = false;
+    };
+    std::vector<InfoSlot> healthSlots;
+    std::vector<InfoSlot> powerSlots;
+    GtkWidget* peripheralContainer;
+    std::vector<InfoSlot> peripheralSlots;
+    
+    GtkWidget* historyArea;
+    GtkWidget* historyRangeDropDown;
+    BatteryHistory history;
+    std::vector<HistoryBucket> historyBuckets;  // decimated for the selected range
+    guint recordTimer;  // runs while the app does, not only while the page is open
+    DischargeEstimator estimator;
+    int governorFd;     // cpu0 scaling_governor, which the Power page's modes set
     
     std::vector<GtkWidget*> batteryWidgets; // For cleanup
-    std::string batteryDevice;
+    PowerSupplyRegistry supplies;
+    guint supplyWatchId;
     BatteryInfo currentInfo;
     guint updateTimer;
     
@@ -64,12 +82,21 @@ private:
     void createInfoSections();
     void updateBatteryDisplay();
     void updateInfoSections();
+    void createPeripheralSection();
+    void updatePeripheralSection();
+    void createInfoSlots(GtkWidget* container, std::vector<InfoSlot>& slots);
+    void updateInfoSlots(std::vector<InfoSlot>& slots,
+                         const std::vector<std::pair<std::string, std::string>>& rows);
+    void createHistoryChart();
+    void recordSample(const BatteryInfo& info);
+    PowerProfile readPowerProfile();
+    void refreshHistoryChart();
     
     // Battery information functions
-    std::string findBatteryDevice();
-    BatteryInfo parseBatteryInfo(const std::string& device);
-    std::string executeCommand(const std::string& command);
-    std::string formatBatteryTime(const std::string& timeStr);
+    const char* describeState(BatteryState state);
+    const char* describeLevel(BatteryLevel level);
+    std::string formatBatteryTime(double seconds);
+    std::string formatValue(double value, const char* format);
     std::string getBatteryIconName(int percentage, bool isCharging);
     
     // Utility functions
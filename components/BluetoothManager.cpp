@@ -2,12 +2,8 @@
 #include "../MainWindow.h"
 #include "../translations/translations.h"
 #include <cstdlib>
-#include <sstream>
 #include <algorithm>
-#include <cstdio>
 #include <memory>
-#include <stdexcept>
-#include <array>
 
 // Forward declaration of callback data
 struct BluetoothBackButtonCallbackData {
@@ -17,32 +13,55 @@ struct BluetoothBackButtonCallbackData {
 // Device action data structure for button callbacks
 struct DeviceActionData {
     BluetoothManager* manager;
-    std::string mac;
+    std::string path;
     std::string name;
 };
 
+// Scan lengths offered next to the scan button
+static const guint SCAN_DURATIONS[] = {10, 30, 60};
+
+// RSSI change (dB) needed before a row moves; readings jitter by a few dB
+static const int RSSI_HYSTERESIS = 10;
+
+// Device operations. Pairing may wait on the user confirming a code.
+static const size_t MAX_CONCURRENT_OPERATIONS = 2;
+static const int PAIR_TIMEOUT_MS = 60000;
+static const int CONNECT_TIMEOUT_MS = 20000;
+static const int DISCONNECT_TIMEOUT_MS = 10000;
+static const int REMOVE_TIMEOUT_MS = 10000;
+
 BluetoothManager::BluetoothManager(MainWindow* mainWindow, GtkWidget* parentWindow, GtkWidget* overlay) 
     : mainWindow(mainWindow), parentWindow(parentWindow), overlay(overlay), 
       bluetoothContainer(nullptr), backButton(nullptr), statusLabel(nullptr),
       connectionStatusLabel(nullptr), toggleButton(nullptr), scanButton(nullptr), 
-      deviceListBox(nullptr), scrolledWindow(nullptr), bluetoothEnabled(false), 
-      isScanning(false), refreshTimeoutId(0), scanTimeoutId(0) {
+      scanDurationDropDown(nullptr), deviceListBox(nullptr), placeholderLabel(nullptr),
+      scrolledWindow(nullptr), bluetoothEnabled(false), isScanning(false), refreshIdleId(0),
+      listDirty(false), scanTimeoutId(0), telemetryTickId(0) {
     setupUI();
+    
+    bluez = std::make_unique<BluezClient>([this](BluezClient::Event event, const std::string& path) {
+        onBluezEvent(event, path);
+    });
 }
 
 BluetoothManager::~BluetoothManager() {
     // Clean up timeouts
-    if (refreshTimeoutId > 0) {
-        g_source_remove(refreshTimeoutId);
-        refreshTimeoutId = 0;
+    if (refreshIdleId > 0) {
+        g_source_remove(refreshIdleId);
+        refreshIdleId = 0;
     }
     if (scanTimeoutId > 0) {
         g_source_remove(scanTimeoutId);
         scanTimeoutId = 0;
     }
+    stopTelemetryUpdates();
+    
+    // Pending BlueZ calls are cancelled and their replies dropped
+    bluez.reset();
     
     // Clear widget tracking - GTK handles the actual widget cleanup
-    deviceWidgets.clear();
+    deviceRows.clear();
+    rowKeys.clear();
     
     // All GTK widgets are managed by GTK and will be cleaned up automatically
 }
@@ -56,11 +75,6 @@ void BluetoothManager::show() {
         }
         updateBluetoothStatus();
         populateDeviceList();
-        
-        // Start refresh timer
-        if (refreshTimeoutId == 0) {
-            refreshTimeoutId = g_timeout_add(5000, refreshDevicesTimeout, this);
-        }
     }
 }
 
@@ -68,11 +82,17 @@ void BluetoothManager::hide() {
     if (bluetoothContainer) {
         gtk_widget_set_visible(bluetoothContainer, FALSE);
         
-        // Stop refresh timer
-        if (refreshTimeoutId > 0) {
-            g_source_remove(refreshTimeoutId);
-            refreshTimeoutId = 0;
+        // Nobody is watching the results any more
+        if (isScanning) {
+            stopScan();
+        }
+        
+        // Events keep the device table current; the list is rebuilt on show
+        if (refreshIdleId > 0) {
+            g_source_remove(refreshIdleId);
+            refreshIdleId = 0;
         }
+        stopTelemetryUpdates();
     }
 }
 
@@ -161,8 +181,27 @@ void BluetoothManager::initBluetoothUI() {
             g_signal_connect(scanButton, "clicked", G_CALLBACK(onScanDevicesClicked), this);
         }
         
+        // Scan duration
+        const char* durations[G_N_ELEMENTS(SCAN_DURATIONS) + 1];
+        std::vector<std::string> durationLabels;
+        for (guint seconds : SCAN_DURATIONS) {
+            durationLabels.push_back(std::to_string(seconds) + " s");
+        }
+        for (size_t i = 0; i < durationLabels.size(); ++i) {
+            durations[i] = durationLabels[i].c_str();
+        }
+        durations[durationLabels.size()] = nullptr;
+        
+        scanDurationDropDown = gtk_drop_down_new_from_strings(durations);
+        if (scanDurationDropDown) {
+            gtk_widget_set_size_request(scanDurationDropDown, 90, 40);
+            gtk_widget_set_tooltip_text(scanDurationDropDown, TR(TranslationKeys::SCAN_DURATION));
+            gtk_widget_set_valign(scanDurationDropDown, GTK_ALIGN_CENTER);
+        }
+        
         gtk_box_append(GTK_BOX(bluetoothHeader), toggleButton);
         gtk_box_append(GTK_BOX(bluetoothHeader), scanButton);
+        gtk_box_append(GTK_BOX(bluetoothHeader), scanDurationDropDown);
         
         gtk_fixed_put(GTK_FIXED(bluetoothContainer), bluetoothHeader, 500, 180);
     }
@@ -203,6 +242,13 @@ void BluetoothManager::initBluetoothUI() {
         if (deviceListBox) {
             gtk_widget_add_css_class(deviceListBox, "bluetooth-list");
             gtk_list_box_set_selection_mode(GTK_LIST_BOX(deviceListBox), GTK_SELECTION_NONE);
+            gtk_list_box_set_sort_func(GTK_LIST_BOX(deviceListBox), compareDeviceRows, this, nullptr);
+            
+            // Shown whenever the list has no rows
+            placeholderLabel = gtk_label_new(TR(TranslationKeys::NO_DEVICES_FOUND_BT));
+            gtk_widget_add_css_class(placeholderLabel, "device-name");
+            gtk_widget_set_margin_top(placeholderLabel, 16);
+            gtk_list_box_set_placeholder(GTK_LIST_BOX(deviceListBox), placeholderLabel);
             gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scrolledWindow), deviceListBox);
         }
         
@@ -308,6 +354,12 @@ void BluetoothManager::initBluetoothUI() {
             ".device-status.disconnected { "
             "  color: #f87171; "
             "} "
+            ".device-telemetry { "
+            "  color: rgba(255, 255, 255, 0.6); "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 11px; "
+            "  font-weight: 400; "
+            "} "
             ".device-connect-btn, .device-disconnect-btn, .device-forget-btn { "
             "  background: rgba(255, 255, 255, 0.15); "
             "  color: white; "
@@ -415,148 +467,269 @@ void BluetoothManager::setupBackButton() {
 
 // Bluetooth utility functions
 bool BluetoothManager::getBluetoothPowerState() {
-    std::string output = executeBluetoothCommand({"show"});
-    return output.find("Powered: yes") != std::string::npos;
+    const BluezAdapter* adapter = bluez ? bluez->adapter() : nullptr;
+    return adapter && adapter->powered;
 }
 
-std::vector<BluetoothDevice> BluetoothManager::getBluetoothDevices() {
-    std::vector<BluetoothDevice> devices;
+std::vector<const BluezDevice*> BluetoothManager::getBluetoothDevices() {
+    std::vector<const BluezDevice*> devices;
     
     if (!getBluetoothPowerState()) {
         return devices; // Return empty list if Bluetooth is off
     }
     
-    std::string output = executeBluetoothCommand({"devices"});
-    std::istringstream stream(output);
-    std::string line;
-    
-    while (std::getline(stream, line)) {
-        if (line.find("Device ") == 0) {
-            // Parse: "Device XX:XX:XX:XX:XX:XX Device Name"
-            size_t firstSpace = line.find(' ');
-            size_t secondSpace = line.find(' ', firstSpace + 1);
-            
-            if (firstSpace != std::string::npos && secondSpace != std::string::npos) {
-                BluetoothDevice device;
-                device.mac = line.substr(firstSpace + 1, secondSpace - firstSpace - 1);
-                device.name = line.substr(secondSpace + 1);
-                
-                // Check if device is connected and paired
-                device.isConnected = isDeviceConnected(device.mac);
-                device.isPaired = isDevicePaired(device.mac);
-                
-                devices.push_back(device);
-            }
-        }
+    for (const auto& entry : bluez->devices()) {
+        devices.push_back(&entry.second);
     }
     
     return devices;
 }
 
-bool BluetoothManager::isDeviceConnected(const std::string& mac) {
-    std::string output = executeBluetoothCommand({"info", mac});
-    return output.find("Connected: yes") != std::string::npos;
-}
-
-bool BluetoothManager::isDevicePaired(const std::string& mac) {
-    std::string output = executeBluetoothCommand({"info", mac});
-    return output.find("Paired: yes") != std::string::npos;
-}
-
-std::string BluetoothManager::executeBluetoothCommand(const std::vector<std::string>& args) {
-    std::string command = "bluetoothctl";
-    for (const auto& arg : args) {
-        command += " " + arg;
+void BluetoothManager::onBluezEvent(BluezClient::Event event, const std::string& path) {
+    if (event == BluezClient::Event::ServiceChanged && !bluez->isAvailable() && isScanning) {
+        // bluetoothd went away mid-scan; there is nothing left to stop
+        stopScan();
     }
     
-    std::array<char, 128> buffer;
-    std::string result;
-    std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(command.c_str(), "r"), pclose);
-    
-    if (!pipe) {
-        std::cerr << "Failed to run command: " << command << std::endl;
-        return "";
+    if (!bluetoothContainer || !gtk_widget_get_visible(bluetoothContainer)) return;
+    
+    // Device events touch only their own row, so discoveries stream in one by one
+    const BluezDevice* device = bluez->device(path);
+    switch (event) {
+        case BluezClient::Event::DeviceAdded:
+        case BluezClient::Event::DeviceChanged:
+            if (device && bluetoothEnabled) syncDeviceRow(*device);
+            scheduleRefresh(false);
+            break;
+        case BluezClient::Event::DeviceRemoved:
+            removeDeviceRow(path);
+            scheduleRefresh(false);
+            break;
+        case BluezClient::Event::TelemetryChanged:
+            // RSSI alone can change several times a second per device during a scan
+            telemetryDirty.insert(path);
+            if (telemetryTickId == 0 && deviceListBox) {
+                telemetryTickId = gtk_widget_add_tick_callback(deviceListBox, onTelemetryTick, this, nullptr);
+            }
+            break;
+        case BluezClient::Event::AdapterChanged:
+        case BluezClient::Event::ServiceChanged:
+            scheduleRefresh(true);
+            break;
     }
-    
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
+}
+
+void BluetoothManager::scheduleRefresh(bool rebuildList) {
+    // Signals arrive in bursts (a connect changes several properties); redraw once
+    listDirty = listDirty || rebuildList;
+    if (refreshIdleId == 0) {
+        refreshIdleId = g_idle_add(refreshDevicesIdle, this);
     }
-    
-    return result;
 }
 
 void BluetoothManager::toggleBluetoothPower() {
-    bool currentState = getBluetoothPowerState();
-    std::string newState = currentState ? "off" : "on";
+    bool newState = !getBluetoothPowerState();
     
-    std::cout << "Toggling Bluetooth power to: " << newState << std::endl;
-    executeBluetoothCommand({"power", newState});
-    
-    // Update UI after a short delay
-    g_timeout_add(1000, refreshDevicesTimeout, this);
+    std::cout << "Toggling Bluetooth power to: " << (newState ? "on" : "off") << std::endl;
+    bluez->setPowered(newState, [this](bool ok, const std::string& error) {
+        if (!ok) {
+            std::cerr << "Failed to toggle Bluetooth power: " << error << std::endl;
+            showMessage(TR(TranslationKeys::ERROR), error);
+        }
+    });
 }
 
 void BluetoothManager::scanForDevices() {
     if (isScanning) return;
     
     isScanning = true;
-    gtk_button_set_label(GTK_BUTTON(scanButton), TR(TranslationKeys::SCANNING));
-    gtk_widget_set_sensitive(scanButton, FALSE);
+    gtk_button_set_label(GTK_BUTTON(scanButton), TR(TranslationKeys::STOP_SCAN));
+    gtk_widget_set_sensitive(scanDurationDropDown, FALSE);
     
     updateBluetoothStatus();
     
-    std::cout << "Starting Bluetooth scan..." << std::endl;
+    guint duration = scanDurationSeconds();
+    std::cout << "Starting Bluetooth scan for " << duration << " s" << std::endl;
     
-    // Start scan in background
-    g_timeout_add(100, [](gpointer user_data) -> gboolean {
-        BluetoothManager* manager = static_cast<BluetoothManager*>(user_data);
-        
-        if (manager && manager->bluetoothContainer) {
-            // Execute scan commands
-            manager->executeBluetoothCommand({"--timeout", "3", "scan", "on"});
-            manager->executeBluetoothCommand({"--timeout", "2", "scan", "off"});
-            
-            // Schedule scan completion
-            manager->scanTimeoutId = g_timeout_add(3000, scanCompleteTimeout, manager);
+    // Armed first: a failure reported straight from startDiscovery() calls
+    // stopScan(), which must find the timeout to remove it
+    scanTimeoutId = g_timeout_add_seconds(duration, scanCompleteTimeout, this);
+    
+    // Devices stream in through InterfacesAdded while discovery runs
+    bluez->startDiscovery([this](bool ok, const std::string& error) {
+        if (!ok && isScanning) {
+            std::cerr << "Failed to start discovery: " << error << std::endl;
+            stopScan();
         }
-        
-        return G_SOURCE_REMOVE;
-    }, this);
+    });
 }
 
-void BluetoothManager::connectToDevice(const std::string& mac, const std::string& name) {
-    std::cout << "Connecting to device: " << name << " (" << mac << ")" << std::endl;
+void BluetoothManager::stopScan() {
+    if (!isScanning) return;
     
-    // Pair and connect
-    executeBluetoothCommand({"pair", mac});
-    executeBluetoothCommand({"connect", mac});
+    isScanning = false;
+    if (scanTimeoutId > 0) {
+        g_source_remove(scanTimeoutId);
+        scanTimeoutId = 0;
+    }
     
-    showMessage(TR(TranslationKeys::SUCCESS_BLU), std::string(TR(TranslationKeys::CONNECTED_TO)) + name);
+    // Discovery stays on in bluetoothd until the last client stops it
+    bluez->stopDiscovery();
+    std::cout << "Bluetooth scan stopped" << std::endl;
     
-    // Refresh device list
-    g_timeout_add(1000, refreshDevicesTimeout, this);
+    if (scanButton) {
+        gtk_button_set_label(GTK_BUTTON(scanButton), TR(TranslationKeys::SCAN_DEVICES));
+    }
+    if (scanDurationDropDown) {
+        gtk_widget_set_sensitive(scanDurationDropDown, TRUE);
+    }
+    updateBluetoothStatus();
+}
+
+guint BluetoothManager::scanDurationSeconds() const {
+    guint selected = scanDurationDropDown ? gtk_drop_down_get_selected(GTK_DROP_DOWN(scanDurationDropDown)) : 0;
+    return selected < G_N_ELEMENTS(SCAN_DURATIONS) ? SCAN_DURATIONS[selected] : SCAN_DURATIONS[0];
 }
 
-void BluetoothManager::disconnectDevice(const std::string& mac, const std::string& name) {
-    std::cout << "Disconnecting device: " << name << " (" << mac << ")" << std::endl;
+void BluetoothManager::connectToDevice(const std::string& path, const std::string& name) {
+    enqueueOperation(BluetoothOperationKind::Connect, path, name);
+}
+
+void BluetoothManager::disconnectDevice(const std::string& path, const std::string& name) {
+    enqueueOperation(BluetoothOperationKind::Disconnect, path, name);
+}
+
+void BluetoothManager::forgetDevice(const std::string& path, const std::string& name) {
+    enqueueOperation(BluetoothOperationKind::Forget, path, name);
+}
+
+void BluetoothManager::enqueueOperation(BluetoothOperationKind kind, const std::string& path, const std::string& name) {
+    // One operation per device; its row shows a cancel button meanwhile
+    if (runningOperations.count(path)) return;
+    for (const BluetoothOperation& queued : queuedOperations) {
+        if (queued.path == path) return;
+    }
     
-    executeBluetoothCommand({"disconnect", mac});
+    operationErrors.erase(path);
+    queuedOperations.push_back(BluetoothOperation{kind, path, name, 0, false});
+    refreshDeviceRow(path);
+    pumpOperations();
+}
+
+void BluetoothManager::pumpOperations() {
+    while (runningOperations.size() < MAX_CONCURRENT_OPERATIONS && !queuedOperations.empty()) {
+        BluetoothOperation operation = queuedOperations.front();
+        queuedOperations.pop_front();
+        startOperation(operation);
+    }
+}
+
+void BluetoothManager::startOperation(const BluetoothOperation& operation) {
+    const std::string path = operation.path;
+    runningOperations[path] = operation;
+    refreshDeviceRow(path);
+    
+    auto finish = [this, path](bool ok, const std::string& error) {
+        finishOperation(path, ok, error);
+    };
+    
+    guint callId = 0;
+    switch (operation.kind) {
+        case BluetoothOperationKind::Connect: {
+            std::cout << "Connecting to device: " << operation.name << " (" << path << ")" << std::endl;
+            
+            // Unpaired devices have to pair before they accept a connection
+            const BluezDevice* device = bluez->device(path);
+            if (device && !device->paired) {
+                runningOperations[path].pairing = true;
+                callId = bluez->pairDevice(path, PAIR_TIMEOUT_MS, [this, path, finish](bool ok, const std::string& error) {
+                    auto it = runningOperations.find(path);
+                    if (!ok || it == runningOperations.end()) {
+                        finish(ok, error);
+                        return;
+                    }
+                    it->second.pairing = false;
+                    it->second.callId = 0;
+                    refreshDeviceRow(path);
+                    
+                    guint connectId = bluez->connectDevice(path, CONNECT_TIMEOUT_MS, finish);
+                    it = runningOperations.find(path);
+                    if (it != runningOperations.end()) it->second.callId = connectId;
+                });
+            } else {
+                callId = bluez->connectDevice(path, CONNECT_TIMEOUT_MS, finish);
+            }
+            break;
+        }
+        case BluetoothOperationKind::Disconnect:
+            std::cout << "Disconnecting device: " << operation.name << " (" << path << ")" << std::endl;
+            callId = bluez->disconnectDevice(path, DISCONNECT_TIMEOUT_MS, finish);
+            break;
+        case BluetoothOperationKind::Forget:
+            std::cout << "Forgetting device: " << operation.name << " (" << path << ")" << std::endl;
+            callId = bluez->removeDevice(path, REMOVE_TIMEOUT_MS, finish);
+            break;
+    }
+    
+    // A call that failed at once has already finished the operation
+    auto it = runningOperations.find(path);
+    if (it != runningOperations.end()) it->second.callId = callId;
+}
+
+void BluetoothManager::finishOperation(const std::string& path, bool ok, const std::string& error) {
+    auto it = runningOperations.find(path);
+    if (it == runningOperations.end()) return;
+    
+    BluetoothOperation operation = it->second;
+    runningOperations.erase(it);
     
-    showMessage(TR(TranslationKeys::DISCONNECTED_BLU), std::string(TR(TranslationKeys::DISCONNECTED_BLU)) + " from " + name);
+    // Success shows in the row through the device's own properties; failures stay on it
+    if (ok) {
+        std::cout << "Bluetooth operation on " << operation.name << " succeeded" << std::endl;
+    } else {
+        std::cerr << "Bluetooth operation on " << operation.name << " failed: " << error << std::endl;
+        operationErrors[path] = error;
+    }
     
-    // Refresh device list
-    g_timeout_add(1000, refreshDevicesTimeout, this);
+    refreshDeviceRow(path);
+    pumpOperations();
 }
 
-void BluetoothManager::forgetDevice(const std::string& mac, const std::string& name) {
-    std::cout << "Forgetting device: " << name << " (" << mac << ")" << std::endl;
+void BluetoothManager::cancelOperation(const std::string& path) {
+    for (auto queued = queuedOperations.begin(); queued != queuedOperations.end(); ++queued) {
+        if (queued->path == path) {
+            queuedOperations.erase(queued);
+            refreshDeviceRow(path);
+            return;
+        }
+    }
+    
+    auto it = runningOperations.find(path);
+    if (it == runningOperations.end()) return;
     
-    executeBluetoothCommand({"remove", mac});
+    BluetoothOperation operation = it->second;
+    runningOperations.erase(it);
+    bluez->cancel(operation.callId);
     
-    showMessage(TR(TranslationKeys::REMOVED), "Forgot device " + name);
+    // Dropping the call doesn't stop bluetoothd; tell it to give up as well
+    if (operation.kind == BluetoothOperationKind::Connect) {
+        if (operation.pairing) {
+            bluez->cancelPairing(path);
+        } else {
+            bluez->disconnectDevice(path, DISCONNECT_TIMEOUT_MS);
+        }
+    }
+    std::cout << "Cancelled Bluetooth operation on " << operation.name << std::endl;
     
-    // Refresh device list
-    g_timeout_add(1000, refreshDevicesTimeout, this);
+    refreshDeviceRow(path);
+    pumpOperations();
+}
+
+void BluetoothManager::refreshDeviceRow(const std::string& path) {
+    const BluezDevice* device = bluez->device(path);
+    if (device && rowKeys.count(path)) {
+        syncDeviceRow(*device);
+    }
 }
 
 void BluetoothManager::showMessage(const std::string& title, const std::string& message) {
@@ -593,7 +766,10 @@ void BluetoothManager::updateBluetoothStatus() {
     
     bluetoothEnabled = getBluetoothPowerState();
     
-    if (isScanning) {
+    if (!bluez->isAvailable()) {
+        statusText = TR(TranslationKeys::BLUETOOTH_UNAVAILABLE);
+        cssClass = "disabled";
+    } else if (isScanning) {
         statusText = TR(TranslationKeys::SCANNING_FOR_DEVICES);
         cssClass = "scanning";
     } else if (bluetoothEnabled) {
@@ -602,11 +778,11 @@ void BluetoothManager::updateBluetoothStatus() {
         int connectedCount = 0;
         std::string connectedDeviceName;
         
-        for (const auto& device : devices) {
-            if (device.isConnected) {
+        for (const BluezDevice* device : devices) {
+            if (device->connected) {
                 connectedCount++;
                 if (connectedCount == 1) {
-                    connectedDeviceName = device.name;
+                    connectedDeviceName = device->name;
                 }
             }
         }
@@ -635,52 +811,231 @@ void BluetoothManager::updateBluetoothStatus() {
                            bluetoothEnabled ? TR(TranslationKeys::TURN_OFF) : TR(TranslationKeys::TURN_ON));
     }
     
+    // The scan button doubles as the stop button while discovery runs
     if (scanButton) {
-        gtk_widget_set_sensitive(scanButton, bluetoothEnabled && !isScanning);
+        gtk_widget_set_sensitive(scanButton, bluetoothEnabled);
     }
 }
 
 void BluetoothManager::populateDeviceList() {
     if (!deviceListBox) return;
     
-    // Clear existing list
-    GtkWidget* child = gtk_widget_get_first_child(deviceListBox);
-    while (child) {
-        GtkWidget* next = gtk_widget_get_next_sibling(child);
-        gtk_list_box_remove(GTK_LIST_BOX(deviceListBox), child);
-        child = next;
+    if (placeholderLabel) {
+        gtk_label_set_text(GTK_LABEL(placeholderLabel), bluetoothEnabled ? TR(TranslationKeys::NO_DEVICES_FOUND_BT)
+                                                                         : TR(TranslationKeys::BLUETOOTH_DISABLED));
     }
     
-    // Clear device widgets vector
-    deviceWidgets.clear();
+    // Diff the device table against the rows: drop the vanished, then add or
+    // update the rest; rows whose state didn't change are left alone
+    std::vector<const BluezDevice*> devices;
+    if (bluetoothEnabled) {
+        devices = getBluetoothDevices();
+    }
+    std::unordered_map<std::string, const BluezDevice*> current;
+    for (const BluezDevice* device : devices) {
+        current[device->mac.empty() ? device->path : device->mac] = device;
+    }
     
-    if (!bluetoothEnabled) {
-        GtkWidget* row = gtk_list_box_row_new();
-        GtkWidget* label = gtk_label_new(TR(TranslationKeys::BLUETOOTH_DISABLED));
-        gtk_widget_add_css_class(label, "device-name");
-        gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), label);
-        gtk_list_box_append(GTK_LIST_BOX(deviceListBox), row);
+    for (auto it = deviceRows.begin(); it != deviceRows.end();) {
+        if (current.count(it->first)) {
+            ++it;
+            continue;
+        }
+        gtk_list_box_remove(GTK_LIST_BOX(deviceListBox), it->second.row);
+        rowKeys.erase(it->second.path);
+        it = deviceRows.erase(it);
+    }
+    
+    for (const BluezDevice* device : devices) {
+        syncDeviceRow(*device);
+    }
+}
+
+void BluetoothManager::syncDeviceRow(const BluezDevice& device) {
+    const std::string key = device.mac.empty() ? device.path : device.mac;
+    auto it = deviceRows.find(key);
+    
+    if (it == deviceRows.end()) {
+        BluetoothDeviceRow& entry = deviceRows[key];
+        entry.row = gtk_list_box_row_new();
+        entry.path = device.path;
+        entry.shown = describeDevice(device);
+        entry.telemetryText = describeTelemetry(device.path);
+        entry.paired = device.paired;
+        entry.hasRssi = false;
+        entry.sortRssi = 0;
+        updateRowRssi(entry);
+        rowKeys[device.path] = key;
+        
+        gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(entry.row), buildDeviceRowContent(device, entry));
+        g_object_set_data_full(G_OBJECT(entry.row), "device-key", g_strdup(key.c_str()), g_free);
+        
+        // The sort function places it; no need to touch the rest
+        gtk_list_box_append(GTK_LIST_BOX(deviceListBox), entry.row);
         return;
     }
     
-    auto devices = getBluetoothDevices();
+    BluetoothDeviceRow& entry = it->second;
+    if (entry.path != device.path) {
+        rowKeys.erase(entry.path);
+        entry.path = device.path;
+        rowKeys[device.path] = key;
+    }
     
-    if (devices.empty()) {
-        GtkWidget* row = gtk_list_box_row_new();
-        GtkWidget* label = gtk_label_new(TR(TranslationKeys::NO_DEVICES_FOUND_BT));
-        gtk_widget_add_css_class(label, "device-name");
-        gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), label);
-        gtk_list_box_append(GTK_LIST_BOX(deviceListBox), row);
-        return;
+    BluetoothRowState state = describeDevice(device);
+    bool resort = state.connected != entry.shown.connected || state.name != entry.shown.name ||
+                  device.paired != entry.paired;
+    
+    resort = updateRowRssi(entry) || resort;
+    entry.paired = device.paired;
+    
+    if (state.connected != entry.shown.connected || state.busy != entry.shown.busy ||
+        state.running != entry.shown.running) {
+        // Different set of buttons; rebuild the row's content
+        entry.shown = state;
+        entry.telemetryText = describeTelemetry(entry.path);
+        gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(entry.row), buildDeviceRowContent(device, entry));
+    } else {
+        if (state.name != entry.shown.name) {
+            gtk_label_set_text(GTK_LABEL(entry.nameLabel), state.name.c_str());
+        }
+        if (state.status != entry.shown.status) {
+            gtk_label_set_text(GTK_LABEL(entry.statusLabel), state.status.c_str());
+        }
+        if (state.statusOk != entry.shown.statusOk) {
+            if (state.statusOk) {
+                gtk_widget_remove_css_class(entry.statusLabel, "disconnected");
+            } else {
+                gtk_widget_add_css_class(entry.statusLabel, "disconnected");
+            }
+        }
+        entry.shown = state;
+        updateRowTelemetry(entry);
+    }
+    
+    if (resort) {
+        gtk_list_box_row_changed(GTK_LIST_BOX_ROW(entry.row));
+    }
+}
+
+bool BluetoothManager::updateRowRssi(BluetoothDeviceRow& entry) {
+    const BluezTelemetry* telemetry = bluez->telemetry(entry.path);
+    bool hasRssi = telemetry && telemetry->hasRssi;
+    int rssi = hasRssi ? telemetry->rssi : 0;
+    
+    // RSSI only reorders, and only once it has really moved
+    if (hasRssi != entry.hasRssi || (hasRssi && std::abs(rssi - entry.sortRssi) >= RSSI_HYSTERESIS)) {
+        entry.hasRssi = hasRssi;
+        entry.sortRssi = rssi;
+        return true;
     }
+    return false;
+}
+
+std::string BluetoothManager::describeTelemetry(const std::string& path) const {
+    const BluezTelemetry* telemetry = bluez->telemetry(path);
+    if (!telemetry) return "";
+    
+    std::vector<std::string> parts;
+    if (telemetry->battery >= 0) {
+        parts.push_back(std::string(TR(TranslationKeys::BATTERY_BLU)) + " " + std::to_string(telemetry->battery) + "%");
+    }
+    if (telemetry->hasRssi) {
+        parts.push_back(std::to_string(telemetry->rssi) + " dBm");
+    }
+    if (telemetry->profile) {
+        std::string audio = telemetry->profile;
+        if (telemetry->hasCodec) audio += std::string(" ") + BluezClient::codecName(*telemetry);
+        if (telemetry->streaming) audio += std::string(", ") + TR(TranslationKeys::STREAMING_BLU);
+        parts.push_back(audio);
+    }
+    
+    std::string text;
+    for (const std::string& part : parts) {
+        if (!text.empty()) text += "  ·  ";
+        text += part;
+    }
+    return text;
+}
+
+void BluetoothManager::updateRowTelemetry(BluetoothDeviceRow& entry) {
+    std::string text = describeTelemetry(entry.path);
+    if (text == entry.telemetryText) return;
+    
+    entry.telemetryText = text;
+    gtk_label_set_text(GTK_LABEL(entry.telemetryLabel), text.c_str());
+    gtk_widget_set_visible(entry.telemetryLabel, !text.empty());
+}
+
+void BluetoothManager::stopTelemetryUpdates() {
+    if (telemetryTickId > 0) {
+        gtk_widget_remove_tick_callback(deviceListBox, telemetryTickId);
+        telemetryTickId = 0;
+    }
+    telemetryDirty.clear();
+}
+
+void BluetoothManager::removeDeviceRow(const std::string& path) {
+    operationErrors.erase(path);
+    
+    auto key = rowKeys.find(path);
+    if (key == rowKeys.end()) return;
+    
+    auto it = deviceRows.find(key->second);
+    if (it != deviceRows.end()) {
+        gtk_list_box_remove(GTK_LIST_BOX(deviceListBox), it->second.row);
+        deviceRows.erase(it);
+    }
+    rowKeys.erase(key);
+}
+
+BluetoothRowState BluetoothManager::describeDevice(const BluezDevice& device) const {
+    BluetoothRowState state;
+    state.name = device.name;
+    state.connected = device.connected;
+    state.statusOk = device.connected;
+    
+    // Operation in progress or waiting for a slot
+    auto running = runningOperations.find(device.path);
+    state.running = running != runningOperations.end();
+    state.busy = state.running ||
+                 std::any_of(queuedOperations.begin(), queuedOperations.end(),
+                             [&](const BluetoothOperation& queued) { return queued.path == device.path; });
+    auto failure = operationErrors.find(device.path);
     
-    for (const auto& device : devices) {
-        buildDeviceRow(device);
+    // Device MAC and status
+    state.status = device.mac;
+    if (state.running) {
+        state.status += " - ";
+        switch (running->second.kind) {
+            case BluetoothOperationKind::Connect:
+                state.status += running->second.pairing ? TR(TranslationKeys::PAIRING) : TR(TranslationKeys::CONNECTING);
+                break;
+            case BluetoothOperationKind::Disconnect:
+                state.status += TR(TranslationKeys::DISCONNECTING);
+                break;
+            case BluetoothOperationKind::Forget:
+                state.status += TR(TranslationKeys::REMOVING);
+                break;
+        }
+    } else if (state.busy) {
+        state.status += std::string(" - ") + TR(TranslationKeys::QUEUED);
+    } else if (failure != operationErrors.end()) {
+        state.status += std::string(" - ") + TR(TranslationKeys::ACTIVATION_FAILED) + " " + failure->second;
+        state.statusOk = false;
+    } else if (device.connected) {
+        state.status += TR(TranslationKeys::CONNECTED_STATUS);
+    } else if (device.paired) {
+        state.status += TR(TranslationKeys::PAIRED_STATUS);
+    } else {
+        state.status += TR(TranslationKeys::NOT_PAIRED_STATUS);
     }
+    
+    return state;
 }
 
-void BluetoothManager::buildDeviceRow(const BluetoothDevice& device) {
-    GtkWidget* row = gtk_list_box_row_new();
+GtkWidget* BluetoothManager::buildDeviceRowContent(const BluezDevice& device, BluetoothDeviceRow& entry) {
+    const BluetoothRowState& state = entry.shown;
     GtkWidget* mainBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
     
     gtk_widget_add_css_class(mainBox, "device-row");
@@ -691,44 +1046,64 @@ void BluetoothManager::buildDeviceRow(const BluetoothDevice& device) {
     gtk_widget_set_hexpand(infoBox, TRUE);
     
     // Device name
-    GtkWidget* nameLabel = gtk_label_new(device.name.c_str());
-    gtk_widget_add_css_class(nameLabel, "device-name");
-    gtk_label_set_xalign(GTK_LABEL(nameLabel), 0.0);
-    gtk_box_append(GTK_BOX(infoBox), nameLabel);
+    entry.nameLabel = gtk_label_new(state.name.c_str());
+    gtk_widget_add_css_class(entry.nameLabel, "device-name");
+    gtk_label_set_xalign(GTK_LABEL(entry.nameLabel), 0.0);
+    gtk_box_append(GTK_BOX(infoBox), entry.nameLabel);
     
     // Device MAC and status
-    std::string statusText = device.mac;
-    if (device.isConnected) {
-        statusText += TR(TranslationKeys::CONNECTED_STATUS);
-    } else if (device.isPaired) {
-        statusText += TR(TranslationKeys::PAIRED_STATUS);
-    } else {
-        statusText += TR(TranslationKeys::NOT_PAIRED_STATUS);
+    entry.statusLabel = gtk_label_new(state.status.c_str());
+    gtk_widget_add_css_class(entry.statusLabel, "device-status");
+    if (!state.statusOk) {
+        gtk_widget_add_css_class(entry.statusLabel, "disconnected");
     }
+    gtk_label_set_xalign(GTK_LABEL(entry.statusLabel), 0.0);
+    gtk_label_set_ellipsize(GTK_LABEL(entry.statusLabel), PANGO_ELLIPSIZE_END);
+    gtk_box_append(GTK_BOX(infoBox), entry.statusLabel);
     
-    GtkWidget* statusLabel = gtk_label_new(statusText.c_str());
-    if (device.isConnected) {
-        gtk_widget_add_css_class(statusLabel, "device-status");
-    } else {
-        gtk_widget_add_css_class(statusLabel, "device-status");
-        gtk_widget_add_css_class(statusLabel, "disconnected");
-    }
-    gtk_label_set_xalign(GTK_LABEL(statusLabel), 0.0);
-    gtk_box_append(GTK_BOX(infoBox), statusLabel);
+    // Battery, signal and audio codec
+    entry.telemetryLabel = gtk_label_new(entry.telemetryText.c_str());
+    gtk_widget_add_css_class(entry.telemetryLabel, "device-telemetry");
+    gtk_label_set_xalign(GTK_LABEL(entry.telemetryLabel), 0.0);
+    gtk_widget_set_visible(entry.telemetryLabel, !entry.telemetryText.empty());
+    gtk_box_append(GTK_BOX(infoBox), entry.telemetryLabel);
     
     gtk_box_append(GTK_BOX(mainBox), infoBox);
     
     // Button box
     GtkWidget* buttonBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
     
+    // A busy device only offers to cancel
+    if (state.busy) {
+        if (state.running) {
+            GtkWidget* spinner = gtk_spinner_new();
+            gtk_spinner_start(GTK_SPINNER(spinner));
+            gtk_widget_set_valign(spinner, GTK_ALIGN_CENTER);
+            gtk_box_append(GTK_BOX(buttonBox), spinner);
+        }
+        
+        GtkWidget* cancelBtn = gtk_button_new_with_label(TR(TranslationKeys::CANCEL));
+        gtk_widget_add_css_class(cancelBtn, "device-disconnect-btn");
+        gtk_widget_set_size_request(cancelBtn, 80, 30);
+        
+        DeviceActionData* actionData = new DeviceActionData{this, device.path, device.name};
+        g_object_set_data_full(G_OBJECT(cancelBtn), "action_data", actionData,
+                              [](gpointer data) { delete static_cast<DeviceActionData*>(data); });
+        
+        g_signal_connect(cancelBtn, "clicked", G_CALLBACK(onCancelOperationClicked), actionData);
+        gtk_box_append(GTK_BOX(buttonBox), cancelBtn);
+        gtk_box_append(GTK_BOX(mainBox), buttonBox);
+        return mainBox;
+    }
+    
     // Connect/Disconnect button
-    if (device.isConnected) {
+    if (state.connected) {
         GtkWidget* disconnectBtn = gtk_button_new_with_label(TR(TranslationKeys::DISCONNECT_BLU));
         gtk_widget_add_css_class(disconnectBtn, "device-disconnect-btn");
         gtk_widget_set_size_request(disconnectBtn, 80, 30);
         
         // Store device info for callback
-        DeviceActionData* actionData = new DeviceActionData{this, device.mac, device.name};
+        DeviceActionData* actionData = new DeviceActionData{this, device.path, device.name};
         g_object_set_data_full(G_OBJECT(disconnectBtn), "action_data", actionData, 
                               [](gpointer data) { delete static_cast<DeviceActionData*>(data); });
         
@@ -740,7 +1115,7 @@ void BluetoothManager::buildDeviceRow(const BluetoothDevice& device) {
         gtk_widget_set_size_request(connectBtn, 80, 30);
         
         // Store device info for callback
-        DeviceActionData* actionData = new DeviceActionData{this, device.mac, device.name};
+        DeviceActionData* actionData = new DeviceActionData{this, device.path, device.name};
         g_object_set_data_full(G_OBJECT(connectBtn), "action_data", actionData,
                               [](gpointer data) { delete static_cast<DeviceActionData*>(data); });
         
@@ -754,7 +1129,7 @@ void BluetoothManager::buildDeviceRow(const BluetoothDevice& device) {
     gtk_widget_set_size_request(forgetBtn, 80, 30);
     
     // Store device info for callback
-    DeviceActionData* actionData = new DeviceActionData{this, device.mac, device.name};
+    DeviceActionData* actionData = new DeviceActionData{this, device.path, device.name};
     g_object_set_data_full(G_OBJECT(forgetBtn), "action_data", actionData,
                           [](gpointer data) { delete static_cast<DeviceActionData*>(data); });
     
@@ -763,10 +1138,7 @@ void BluetoothManager::buildDeviceRow(const BluetoothDevice& device) {
     
     gtk_box_append(GTK_BOX(mainBox), buttonBox);
     
-    gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), mainBox);
-    gtk_list_box_append(GTK_LIST_BOX(deviceListBox), row);
-    
-    deviceWidgets.push_back(row);
+    return mainBox;
 }
 
 // Event handlers
@@ -796,7 +1168,11 @@ void BluetoothManager::onToggleBluetoothClicked(GtkButton* button, gpointer user
 void BluetoothManager::onScanDevicesClicked(GtkButton* button, gpointer user_data) {
     (void)button;
     BluetoothManager* manager = static_cast<BluetoothManager*>(user_data);
-    if (manager && manager->bluetoothEnabled) {
+    if (!manager) return;
+    
+    if (manager->isScanning) {
+        manager->stopScan();
+    } else if (manager->bluetoothEnabled) {
         manager->scanForDevices();
     }
 }
@@ -805,7 +1181,7 @@ void BluetoothManager::onConnectButtonClicked(GtkButton* button, gpointer user_d
     (void)button;
     DeviceActionData* data = static_cast<DeviceActionData*>(user_data);
     if (data && data->manager) {
-        data->manager->connectToDevice(data->mac, data->name);
+        data->manager->connectToDevice(data->path, data->name);
     }
 }
 
@@ -813,7 +1189,7 @@ void BluetoothManager::onDisconnectButtonClicked(GtkButton* button, gpointer use
     (void)button;
     DeviceActionData* data = static_cast<DeviceActionData*>(user_data);
     if (data && data->manager) {
-        data->manager->disconnectDevice(data->mac, data->name);
+        data->manager->disconnectDevice(data->path, data->name);
     }
 }
 
@@ -821,32 +1197,79 @@ void BluetoothManager::onForgetButtonClicked(GtkButton* button, gpointer user_da
     (void)button;
     DeviceActionData* data = static_cast<DeviceActionData*>(user_data);
     if (data && data->manager) {
-        data->manager->forgetDevice(data->mac, data->name);
+        data->manager->forgetDevice(data->path, data->name);
     }
 }
 
-gboolean BluetoothManager::refreshDevicesTimeout(gpointer user_data) {
+void BluetoothManager::onCancelOperationClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    DeviceActionData* data = static_cast<DeviceActionData*>(user_data);
+    if (data && data->manager) {
+        data->manager->cancelOperation(data->path);
+    }
+}
+
+gboolean BluetoothManager::refreshDevicesIdle(gpointer user_data) {
     BluetoothManager* manager = static_cast<BluetoothManager*>(user_data);
     if (manager && manager->bluetoothContainer) {
+        manager->refreshIdleId = 0;
         manager->updateBluetoothStatus();
-        manager->populateDeviceList();
+        if (manager->listDirty) {
+            manager->listDirty = false;
+            manager->populateDeviceList();
+        }
+    }
+    return G_SOURCE_REMOVE;
+}
+
+int BluetoothManager::compareDeviceRows(GtkListBoxRow* a, GtkListBoxRow* b, gpointer user_data) {
+    BluetoothManager* manager = static_cast<BluetoothManager*>(user_data);
+    const char* keyA = static_cast<const char*>(g_object_get_data(G_OBJECT(a), "device-key"));
+    const char* keyB = static_cast<const char*>(g_object_get_data(G_OBJECT(b), "device-key"));
+    auto itA = keyA ? manager->deviceRows.find(keyA) : manager->deviceRows.end();
+    auto itB = keyB ? manager->deviceRows.find(keyB) : manager->deviceRows.end();
+    if (itA == manager->deviceRows.end() || itB == manager->deviceRows.end()) return 0;
+    const BluetoothDeviceRow& rowA = itA->second;
+    const BluetoothDeviceRow& rowB = itB->second;
+    
+    // Connected, then paired, then nearest first; devices out of range sink
+    if (rowA.shown.connected != rowB.shown.connected) return rowA.shown.connected ? -1 : 1;
+    if (rowA.paired != rowB.paired) return rowA.paired ? -1 : 1;
+    if (rowA.hasRssi != rowB.hasRssi) return rowA.hasRssi ? -1 : 1;
+    if (rowA.hasRssi && rowA.sortRssi != rowB.sortRssi) return rowA.sortRssi > rowB.sortRssi ? -1 : 1;
+    int byName = g_utf8_collate(rowA.shown.name.c_str(), rowB.shown.name.c_str());
+    return byName != 0 ? byName : g_strcmp0(keyA, keyB);
+}
+
+gboolean BluetoothManager::onTelemetryTick(GtkWidget* widget, GdkFrameClock* clock, gpointer user_data) {
+    (void)widget; (void)clock;
+    
+    BluetoothManager* manager = static_cast<BluetoothManager*>(user_data);
+    manager->telemetryTickId = 0;
+    
+    // Everything that arrived since the last frame, drawn once
+    for (const std::string& path : manager->telemetryDirty) {
+        auto key = manager->rowKeys.find(path);
+        if (key == manager->rowKeys.end()) continue;
+        auto it = manager->deviceRows.find(key->second);
+        if (it == manager->deviceRows.end()) continue;
+        
+        manager->updateRowTelemetry(it->second);
+        if (manager->updateRowRssi(it->second)) {
+            gtk_list_box_row_changed(GTK_LIST_BOX_ROW(it->second.row));
+        }
     }
-    return G_SOURCE_CONTINUE; // Keep the timeout running
+    manager->telemetryDirty.clear();
+    
+    return G_SOURCE_REMOVE;
 }
 
 gboolean BluetoothManager::scanCompleteTimeout(gpointer user_data) {
     BluetoothManager* manager = static_cast<BluetoothManager*>(user_data);
     if (manager && manager->bluetoothContainer) {
-        manager->isScanning = false;
+        // The source is finishing; don't let stopScan remove it again
         manager->scanTimeoutId = 0;
-        
-        if (manager->scanButton) {
-            gtk_button_set_label(GTK_BUTTON(manager->scanButton), "Scan Devices");
-            gtk_widget_set_sensitive(manager->scanButton, manager->bluetoothEnabled);
-        }
-        
-        manager->updateBluetoothStatus();
-        manager->populateDeviceList();
+        manager->stopScan();
     }
     
     return G_SOURCE_REMOVE;
@@ -1,18 +1,53 @@
 #pragma once
 
 #include <gtk/gtk.h>
+#include <deque>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <iostream>
+#include "BluezClient.h"
 
 // Forward declaration
 class MainWindow;
 
-struct BluetoothDevice {
-    std::string mac;
+enum class BluetoothOperationKind { Connect, Disconnect, Forget };
+
+// A queued or running pair/connect/disconnect/forget
+struct BluetoothOperation {
+    BluetoothOperationKind kind;
+    std::string path;
+    std::string name;
+    guint callId;   // BluezClient call in flight, 0 while queued
+    bool pairing;   // a Connect still in its Pair step
+};
+
+// Everything a device row shows. Rows keep the state they were last drawn
+// with and a refresh only touches the widgets whose part of it changed.
+struct BluetoothRowState {
     std::string name;
-    bool isConnected;
-    bool isPaired;
+    std::string status;
+    bool statusOk = false;
+    bool connected = false;  // Connect or Disconnect button
+    bool busy = false;       // queued or running: only a Cancel button
+    bool running = false;    // spinner
+};
+
+// A device row in the list, keyed by MAC so it survives its BlueZ object
+// path changing (bluetoothd restart, adapter replug)
+struct BluetoothDeviceRow {
+    GtkWidget* row;
+    GtkWidget* nameLabel;
+    GtkWidget* statusLabel;
+    GtkWidget* telemetryLabel;
+    std::string telemetryText;
+    std::string path;
+    BluetoothRowState shown;
+    bool paired;
+    bool hasRssi;
+    int sortRssi;  // only follows the live RSSI once it drifts RSSI_HYSTERESIS away
 };
 
 class BluetoothManager {
@@ -29,21 +64,37 @@ private:
     void initBluetoothUI();
     void setupBackButton();
     void populateDeviceList();
-    void buildDeviceRow(const BluetoothDevice& device);
+    void syncDeviceRow(const BluezDevice& device);
+    BluetoothRowState describeDevice(const BluezDevice& device) const;
+    GtkWidget* buildDeviceRowContent(const BluezDevice& device, BluetoothDeviceRow& entry);
+    void removeDeviceRow(const std::string& path);
+    std::string describeTelemetry(const std::string& path) const;
+    void updateRowTelemetry(BluetoothDeviceRow& entry);
+    bool updateRowRssi(BluetoothDeviceRow& entry);
+    void stopTelemetryUpdates();
     void updateBluetoothStatus();
     
-    // Bluetooth utility functions
+    // Bluetooth utility functions, all backed by the BlueZ D-Bus mirror
     bool getBluetoothPowerState();
-    std::vector<BluetoothDevice> getBluetoothDevices();
-    bool isDeviceConnected(const std::string& mac);
-    bool isDevicePaired(const std::string& mac);
+    std::vector<const BluezDevice*> getBluetoothDevices();
     void toggleBluetoothPower();
     void scanForDevices();
-    void connectToDevice(const std::string& mac, const std::string& name);
-    void disconnectDevice(const std::string& mac, const std::string& name);
-    void forgetDevice(const std::string& mac, const std::string& name);
-    std::string executeBluetoothCommand(const std::vector<std::string>& args);
+    void stopScan();
+    guint scanDurationSeconds() const;
+    void connectToDevice(const std::string& path, const std::string& name);
+    void disconnectDevice(const std::string& path, const std::string& name);
+    void forgetDevice(const std::string& path, const std::string& name);
+    
+    // Device operations run at most MAX_CONCURRENT_OPERATIONS at a time, one per device
+    void enqueueOperation(BluetoothOperationKind kind, const std::string& path, const std::string& name);
+    void pumpOperations();
+    void startOperation(const BluetoothOperation& operation);
+    void finishOperation(const std::string& path, bool ok, const std::string& error);
+    void cancelOperation(const std::string& path);
+    void refreshDeviceRow(const std::string& path);
     void showMessage(const std::string& title, const std::string& message);
+    void onBluezEvent(BluezClient::Event event, const std::string& path);
+    void scheduleRefresh(bool rebuildList);
     
     // Event handlers
     static void onBackButtonClicked(GtkGestureClick* gesture, int n_press, double x, double y, gpointer user_data);
@@ -52,7 +103,10 @@ private:
     static void onConnectButtonClicked(GtkButton* button, gpointer user_data);
     static void onDisconnectButtonClicked(GtkButton* button, gpointer user_data);
     static void onForgetButtonClicked(GtkButton* button, gpointer user_data);
-    static gboolean refreshDevicesTimeout(gpointer user_data);
+    static void onCancelOperationClicked(GtkButton* button, gpointer user_data);
+    static gboolean refreshDevicesIdle(gpointer user_data);
+    static int compareDeviceRows(GtkListBoxRow* a, GtkListBoxRow* b, gpointer user_data);
+    static gboolean onTelemetryTick(GtkWidget* widget, GdkFrameClock* clock, gpointer user_data);
     static gboolean scanCompleteTimeout(gpointer user_data);
     static void onMessageDialogResponse(GtkDialog* dialog, gint response_id, gpointer user_data);
     
@@ -69,13 +123,32 @@ private:
     GtkWidget* connectionStatusLabel;
     GtkWidget* toggleButton;
     GtkWidget* scanButton;
+    GtkWidget* scanDurationDropDown;
     GtkWidget* deviceListBox;
+    GtkWidget* placeholderLabel;
     GtkWidget* scrolledWindow;
     
+    // BlueZ object tree, kept current from D-Bus signals
+    std::unique_ptr<BluezClient> bluez;
+    
     // State variables
     bool bluetoothEnabled;
     bool isScanning;
-    guint refreshTimeoutId;
+    guint refreshIdleId;
+    bool listDirty;
     guint scanTimeoutId;
-    std::vector<GtkWidget*> deviceWidgets;
+    
+    // Rows by MAC, and the MAC behind each BlueZ object path; devices stream
+    // in and out while discovery runs
+    std::unordered_map<std::string, BluetoothDeviceRow> deviceRows;
+    std::unordered_map<std::string, std::string> rowKeys;
+    
+    // Device paths with new telemetry, drawn together on the next frame
+    std::unordered_set<std::string> telemetryDirty;
+    guint telemetryTickId;
+    
+    // Device operations: waiting in order, running by path, and the last failure per path
+    std::deque<BluetoothOperation> queuedOperations;
+    std::unordered_map<std::string, BluetoothOperation> runningOperations;
+    std::unordered_map<std::string, std::string> operationErrors;
 };
@@ -0,0 +1,539 @@
+#include "BluezClient.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+static const char* BLUEZ_SERVICE = "org.bluez";
+static const char* ADAPTER_INTERFACE = "org.bluez.Adapter1";
+static const char* DEVICE_INTERFACE = "org.bluez.Device1";
+static const char* BATTERY_INTERFACE = "org.bluez.Battery1";
+static const char* TRANSPORT_INTERFACE = "org.bluez.MediaTransport1";
+static const char* OBJECT_MANAGER_INTERFACE = "org.freedesktop.DBus.ObjectManager";
+static const char* PROPERTIES_INTERFACE = "org.freedesktop.DBus.Properties";
+
+// Carries a method call's reply callback through the async D-Bus call.
+// Owned by the call itself and freed when it completes.
+struct BluezClient::PendingCall {
+    BluezClient* client;
+    guint id;
+    GCancellable* cancellable;
+    Reply reply;
+};
+
+BluezClient::BluezClient(Listener listener)
+    : listener(std::move(listener)), busType(G_BUS_TYPE_SYSTEM), watchId(0), connection(nullptr),
+      cancellable(nullptr), interfacesAddedId(0), interfacesRemovedId(0), propertiesChangedId(0),
+      loaded(false), nextCallId(1) {
+    const char* bus = std::getenv("ELYSIA_BLUEZ_BUS");
+    if (bus && strcmp(bus, "session") == 0) {
+        busType = G_BUS_TYPE_SESSION;
+    }
+
+    watchId = g_bus_watch_name(busType, BLUEZ_SERVICE, G_BUS_NAME_WATCHER_FLAGS_NONE,
+                               onNameAppeared, onNameVanished, this, nullptr);
+}
+
+BluezClient::~BluezClient() {
+    if (watchId > 0) {
+        g_bus_unwatch_name(watchId);
+        watchId = 0;
+    }
+    detach();
+}
+
+const BluezAdapter* BluezClient::adapter() const {
+    const BluezAdapter* first = nullptr;
+    for (const auto& entry : adapterTable) {
+        if (!first || entry.first < first->path) first = &entry.second;
+    }
+    return first;
+}
+
+const BluezDevice* BluezClient::device(const std::string& path) const {
+    auto it = deviceTable.find(path);
+    return it != deviceTable.end() ? &it->second : nullptr;
+}
+
+const BluezTelemetry* BluezClient::telemetry(const std::string& path) const {
+    auto it = telemetryTable.find(path);
+    return it != telemetryTable.end() ? &it->second : nullptr;
+}
+
+const char* BluezClient::codecName(const BluezTelemetry& telemetry) {
+    if (!telemetry.hasCodec) return "";
+
+    // LE Audio transports use the Bluetooth SIG codec ids, where LC3 is 0x06
+    if (telemetry.profile && strcmp(telemetry.profile, "LE Audio") == 0) {
+        return telemetry.codec == 0x06 ? "LC3" : "Vendor";
+    }
+    switch (telemetry.codec) {
+        case 0x00: return "SBC";
+        case 0x01: return "MP3";
+        case 0x02: return "AAC";
+        case 0x04: return "ATRAC";
+        case 0xFF: return "Vendor";  // aptX, LDAC and friends; told apart only by the configuration blob
+        default: return "Unknown";
+    }
+}
+
+// Profile of a media transport from its UUID
+static const char* transportProfile(const std::string& uuid) {
+    std::string prefix = uuid.substr(0, 8);
+    if (prefix == "0000110a" || prefix == "0000110b") return "A2DP";
+    if (prefix == "0000111e" || prefix == "0000111f") return "HFP";
+    if (prefix == "00001108" || prefix == "00001112") return "HSP";
+    return "LE Audio";
+}
+
+guint BluezClient::setPowered(bool powered, Reply reply) {
+    const BluezAdapter* current = adapter();
+    return call(current ? current->path : "", PROPERTIES_INTERFACE, "Set",
+                g_variant_new("(ssv)", ADAPTER_INTERFACE, "Powered", g_variant_new_boolean(powered)),
+                CALL_TIMEOUT_MS, std::move(reply));
+}
+
+guint BluezClient::startDiscovery(Reply reply) {
+    const BluezAdapter* current = adapter();
+    return call(current ? current->path : "", ADAPTER_INTERFACE, "StartDiscovery", nullptr, CALL_TIMEOUT_MS,
+                std::move(reply));
+}
+
+guint BluezClient::stopDiscovery(Reply reply) {
+    const BluezAdapter* current = adapter();
+    return call(current ? current->path : "", ADAPTER_INTERFACE, "StopDiscovery", nullptr, CALL_TIMEOUT_MS,
+                std::move(reply));
+}
+
+guint BluezClient::pairDevice(const std::string& path, int timeoutMs, Reply reply) {
+    return call(path, DEVICE_INTERFACE, "Pair", nullptr, timeoutMs, std::move(reply));
+}
+
+guint BluezClient::cancelPairing(const std::string& path, Reply reply) {
+    return call(path, DEVICE_INTERFACE, "CancelPairing", nullptr, CALL_TIMEOUT_MS, std::move(reply));
+}
+
+guint BluezClient::connectDevice(const std::string& path, int timeoutMs, Reply reply) {
+    return call(path, DEVICE_INTERFACE, "Connect", nullptr, timeoutMs, std::move(reply));
+}
+
+guint BluezClient::disconnectDevice(const std::string& path, int timeoutMs, Reply reply) {
+    return call(path, DEVICE_INTERFACE, "Disconnect", nullptr, timeoutMs, std::move(reply));
+}
+
+guint BluezClient::removeDevice(const std::string& path, int timeoutMs, Reply reply) {
+    // RemoveDevice lives on the adapter that owns the device
+    const BluezDevice* target = device(path);
+    return call(target ? target->adapterPath : "", ADAPTER_INTERFACE, "RemoveDevice",
+                g_variant_new("(o)", path.c_str()), timeoutMs, std::move(reply));
+}
+
+void BluezClient::cancel(guint callId) {
+    auto it = pendingCalls.find(callId);
+    if (it == pendingCalls.end()) return;
+
+    // onCallFinished sees the cancellation and frees the call
+    g_cancellable_cancel(it->second->cancellable);
+    pendingCalls.erase(it);
+}
+
+guint BluezClient::call(const std::string& path, const char* interface, const char* method,
+                        GVariant* parameters, int timeoutMs, Reply reply) {
+    if (!connection || path.empty() || !g_variant_is_object_path(path.c_str())) {
+        if (parameters) g_variant_unref(g_variant_ref_sink(parameters));
+        if (reply) reply(false, connection ? "No such Bluetooth object" : "Bluetooth service is not running");
+        return 0;
+    }
+
+    PendingCall* pending = new PendingCall{this, nextCallId++, g_cancellable_new(), std::move(reply)};
+    if (nextCallId == 0) nextCallId = 1;
+    pendingCalls[pending->id] = pending;
+
+    g_dbus_connection_call(connection, BLUEZ_SERVICE, path.c_str(), interface, method, parameters,
+                           nullptr, G_DBUS_CALL_FLAGS_NONE, timeoutMs, pending->cancellable,
+                           onCallFinished, pending);
+    return pending->id;
+}
+
+void BluezClient::attach(GDBusConnection* bus) {
+    connection = G_DBUS_CONNECTION(g_object_ref(bus));
+    cancellable = g_cancellable_new();
+
+    // Subscribe before asking for the tree so no change falls in between
+    interfacesAddedId = g_dbus_connection_signal_subscribe(
+        connection, BLUEZ_SERVICE, OBJECT_MANAGER_INTERFACE, "InterfacesAdded", nullptr, nullptr,
+        G_DBUS_SIGNAL_FLAGS_NONE, onInterfacesAdded, this, nullptr);
+    interfacesRemovedId = g_dbus_connection_signal_subscribe(
+        connection, BLUEZ_SERVICE, OBJECT_MANAGER_INTERFACE, "InterfacesRemoved", nullptr, nullptr,
+        G_DBUS_SIGNAL_FLAGS_NONE, onInterfacesRemoved, this, nullptr);
+    propertiesChangedId = g_dbus_connection_signal_subscribe(
+        connection, BLUEZ_SERVICE, PROPERTIES_INTERFACE, "PropertiesChanged", nullptr, nullptr,
+        G_DBUS_SIGNAL_FLAGS_NONE, onPropertiesChanged, this, nullptr);
+
+    g_dbus_connection_call(connection, BLUEZ_SERVICE, "/", OBJECT_MANAGER_INTERFACE, "GetManagedObjects",
+                           nullptr, G_VARIANT_TYPE("(a{oa{sa{sv}}})"), G_DBUS_CALL_FLAGS_NONE, -1,
+                           cancellable, onManagedObjects, this);
+}
+
+void BluezClient::detach(const char* reason) {
+    if (cancellable) {
+        g_cancellable_cancel(cancellable);
+        g_clear_object(&cancellable);
+    }
+    // Calls in flight die with the connection; their replies are owed a failure
+    std::vector<Reply> unanswered;
+    for (auto& entry : pendingCalls) {
+        if (reason && entry.second->reply) unanswered.push_back(std::move(entry.second->reply));
+        g_cancellable_cancel(entry.second->cancellable);
+    }
+    pendingCalls.clear();
+    if (connection) {
+        g_dbus_connection_signal_unsubscribe(connection, interfacesAddedId);
+        g_dbus_connection_signal_unsubscribe(connection, interfacesRemovedId);
+        g_dbus_connection_signal_unsubscribe(connection, propertiesChangedId);
+        g_clear_object(&connection);
+    }
+    interfacesAddedId = 0;
+    interfacesRemovedId = 0;
+    propertiesChangedId = 0;
+
+    adapterTable.clear();
+    deviceTable.clear();
+    telemetryTable.clear();
+    transportTable.clear();
+    loaded = false;
+
+    // Last, so a reply that starts a new call finds the client detached
+    for (Reply& reply : unanswered) reply(false, reason);
+}
+
+void BluezClient::addInterfaces(const char* path, GVariant* interfaces, bool notify) {
+    GVariantIter iter;
+    const char* interface;
+    GVariant* properties;
+
+    g_variant_iter_init(&iter, interfaces);
+    while (g_variant_iter_next(&iter, "{&s@a{sv}}", &interface, &properties)) {
+        if (strcmp(interface, ADAPTER_INTERFACE) == 0) {
+            BluezAdapter& entry = adapterTable[path];
+            entry.path = path;
+            applyAdapterProperties(entry, properties);
+            if (notify) listener(Event::AdapterChanged, path);
+        } else if (strcmp(interface, DEVICE_INTERFACE) == 0) {
+            bool isNew = deviceTable.find(path) == deviceTable.end();
+            BluezDevice& entry = deviceTable[path];
+            entry.path = path;
+            applyDeviceProperties(entry, telemetryTable[path], properties, nullptr);
+            if (notify) listener(isNew ? Event::DeviceAdded : Event::DeviceChanged, path);
+        } else if (strcmp(interface, BATTERY_INTERFACE) == 0) {
+            // Battery1 sits on the device object itself
+            applyBatteryProperties(telemetryTable[path], properties);
+            if (notify) listener(Event::TelemetryChanged, path);
+        } else if (strcmp(interface, TRANSPORT_INTERFACE) == 0) {
+            Transport& transport = transportTable[path];
+            applyTransportProperties(transport, properties);
+            updateTransportTelemetry(transport.devicePath, notify);
+        }
+        g_variant_unref(properties);
+    }
+}
+
+void BluezClient::removeInterfaces(const char* path, const char* const* interfaces) {
+    for (const char* const* interface = interfaces; interface && *interface; ++interface) {
+        if (strcmp(*interface, ADAPTER_INTERFACE) == 0) {
+            if (adapterTable.erase(path) > 0) listener(Event::AdapterChanged, path);
+        } else if (strcmp(*interface, DEVICE_INTERFACE) == 0) {
+            telemetryTable.erase(path);
+            if (deviceTable.erase(path) > 0) listener(Event::DeviceRemoved, path);
+        } else if (strcmp(*interface, BATTERY_INTERFACE) == 0) {
+            auto it = telemetryTable.find(path);
+            if (it != telemetryTable.end()) {
+                it->second.battery = -1;
+                listener(Event::TelemetryChanged, path);
+            }
+        } else if (strcmp(*interface, TRANSPORT_INTERFACE) == 0) {
+            auto it = transportTable.find(path);
+            if (it != transportTable.end()) {
+                std::string devicePath = it->second.devicePath;
+                transportTable.erase(it);
+                updateTransportTelemetry(devicePath, true);
+            }
+        }
+    }
+}
+
+void BluezClient::applyAdapterProperties(BluezAdapter& adapter, GVariant* properties) {
+    GVariantIter iter;
+    const char* key;
+    GVariant* value;
+
+    g_variant_iter_init(&iter, properties);
+    while (g_variant_iter_next(&iter, "{&sv}", &key, &value)) {
+        if (strcmp(key, "Address") == 0 && g_variant_is_of_type(value, G_VARIANT_TYPE_STRING)) {
+            adapter.address = g_variant_get_string(value, nullptr);
+        } else if (strcmp(key, "Powered") == 0 && g_variant_is_of_type(value, G_VARIANT_TYPE_BOOLEAN)) {
+            adapter.powered = g_variant_get_boolean(value);
+        } else if (strcmp(key, "Discovering") == 0 && g_variant_is_of_type(value, G_VARIANT_TYPE_BOOLEAN)) {
+            adapter.discovering = g_variant_get_boolean(value);
+        }
+        g_variant_unref(value);
+    }
+}
+
+bool BluezClient::applyDeviceProperties(BluezDevice& device, BluezTelemetry& telemetry, GVariant* properties,
+                                        const char* const* invalidated) {
+    GVariantIter iter;
+    const char* key;
+    GVariant* value;
+    bool stateChanged = false;
+
+    g_variant_iter_init(&iter, properties);
+    while (g_variant_iter_next(&iter, "{&sv}", &key, &value)) {
+        bool isString = g_variant_is_of_type(value, G_VARIANT_TYPE_STRING);
+        bool isBoolean = g_variant_is_of_type(value, G_VARIANT_TYPE_BOOLEAN);
+
+        if (strcmp(key, "Address") == 0 && isString) {
+            device.mac = g_variant_get_string(value, nullptr);
+        } else if (strcmp(key, "Alias") == 0 && isString) {
+            device.name = g_variant_get_string(value, nullptr);
+        } else if (strcmp(key, "Name") == 0 && isString && device.name.empty()) {
+            device.name = g_variant_get_string(value, nullptr);
+        } else if (strcmp(key, "Icon") == 0 && isString) {
+            device.icon = g_variant_get_string(value, nullptr);
+        } else if (strcmp(key, "Adapter") == 0 && g_variant_is_of_type(value, G_VARIANT_TYPE_OBJECT_PATH)) {
+            device.adapterPath = g_variant_get_string(value, nullptr);
+        } else if (strcmp(key, "Paired") == 0 && isBoolean) {
+            device.paired = g_variant_get_boolean(value);
+        } else if (strcmp(key, "Trusted") == 0 && isBoolean) {
+            device.trusted = g_variant_get_boolean(value);
+        } else if (strcmp(key, "Connected") == 0 && isBoolean) {
+            device.connected = g_variant_get_boolean(value);
+        }
+
+        // RSSI and TxPower tick along with every advertisement during discovery
+        if (strcmp(key, "RSSI") == 0 && g_variant_is_of_type(value, G_VARIANT_TYPE_INT16)) {
+            telemetry.rssi = g_variant_get_int16(value);
+            telemetry.hasRssi = true;
+        } else if (strcmp(key, "TxPower") != 0) {
+            stateChanged = true;
+        }
+        g_variant_unref(value);
+    }
+
+    for (const char* const* name = invalidated; name && *name; ++name) {
+        if (strcmp(*name, "RSSI") == 0) telemetry.hasRssi = false;
+    }
+
+    // Devices that never advertised a name are shown by address
+    if (device.name.empty()) device.name = device.mac;
+    return stateChanged;
+}
+
+void BluezClient::applyBatteryProperties(BluezTelemetry& telemetry, GVariant* properties) {
+    guint8 percentage;
+    if (g_variant_lookup(properties, "Percentage", "y", &percentage)) {
+        telemetry.battery = static_cast<int8_t>(std::min<guint8>(percentage, 100));
+    }
+}
+
+void BluezClient::applyTransportProperties(Transport& transport, GVariant* properties) {
+    const char* text;
+    guint8 codec;
+
+    if (g_variant_lookup(properties, "Device", "&o", &text)) transport.devicePath = text;
+    if (g_variant_lookup(properties, "UUID", "&s", &text)) {
+        gchar* lower = g_ascii_strdown(text, -1);
+        transport.uuid = lower;
+        g_free(lower);
+    }
+    if (g_variant_lookup(properties, "State", "&s", &text)) transport.active = strcmp(text, "active") == 0;
+    if (g_variant_lookup(properties, "Codec", "y", &codec)) {
+        transport.codec = codec;
+        transport.hasCodec = true;
+    }
+}
+
+void BluezClient::updateTransportTelemetry(const std::string& devicePath, bool notify) {
+    if (devicePath.empty()) return;
+
+    // A headset may expose several transports (A2DP and LE Audio); the one streaming wins
+    const Transport* best = nullptr;
+    for (const auto& entry : transportTable) {
+        const Transport& transport = entry.second;
+        if (transport.devicePath != devicePath) continue;
+        if (!best || (transport.active && !best->active)) best = &transport;
+    }
+
+    BluezTelemetry& telemetry = telemetryTable[devicePath];
+    telemetry.hasCodec = best && best->hasCodec;
+    telemetry.codec = best ? best->codec : 0;
+    telemetry.streaming = best && best->active;
+    telemetry.profile = best ? transportProfile(best->uuid) : nullptr;
+
+    if (notify) listener(Event::TelemetryChanged, devicePath);
+}
+
+// Static callbacks
+void BluezClient::onNameAppeared(GDBusConnection* bus, const gchar* name, const gchar* owner, gpointer user_data) {
+    (void)name;
+
+    BluezClient* client = static_cast<BluezClient*>(user_data);
+    std::cout << "Bluetooth service appeared as " << owner << std::endl;
+
+    // A new owner means bluetoothd restarted; start from a clean tree
+    client->detach("Bluetooth service restarted");
+    client->attach(bus);
+}
+
+void BluezClient::onNameVanished(GDBusConnection* bus, const gchar* name, gpointer user_data) {
+    (void)bus; (void)name;
+
+    BluezClient* client = static_cast<BluezClient*>(user_data);
+    bool wasAttached = client->connection != nullptr;
+    client->detach("Bluetooth service stopped");
+
+    // Also called once at startup when bluetoothd is not running
+    if (wasAttached) {
+        std::cout << "Bluetooth service vanished" << std::endl;
+    }
+    client->listener(Event::ServiceChanged, "");
+}
+
+void BluezClient::onManagedObjects(GObject* source, GAsyncResult* result, gpointer user_data) {
+    GError* error = nullptr;
+    GVariant* reply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+
+    BluezClient* client = static_cast<BluezClient*>(user_data);
+    if (error) {
+        std::cerr << "Failed to list Bluetooth objects: " << error->message << std::endl;
+        g_error_free(error);
+        return;
+    }
+
+    GVariantIter* objects;
+    const char* path;
+    GVariant* interfaces;
+
+    g_variant_get(reply, "(a{oa{sa{sv}}})", &objects);
+    while (g_variant_iter_next(objects, "{&o@a{sa{sv}}}", &path, &interfaces)) {
+        client->addInterfaces(path, interfaces, false);
+        g_variant_unref(interfaces);
+    }
+    g_variant_iter_free(objects);
+    g_variant_unref(reply);
+
+    client->loaded = true;
+    client->listener(Event::ServiceChanged, "");
+}
+
+void BluezClient::onInterfacesAdded(GDBusConnection* bus, const gchar* sender, const gchar* path,
+                                    const gchar* interface, const gchar* signal, GVariant* parameters,
+                                    gpointer user_data) {
+    (void)bus; (void)sender; (void)path; (void)interface; (void)signal;
+
+    BluezClient* client = static_cast<BluezClient*>(user_data);
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oa{sa{sv}})"))) return;
+
+    const char* objectPath;
+    GVariant* interfaces;
+    g_variant_get(parameters, "(&o@a{sa{sv}})", &objectPath, &interfaces);
+    client->addInterfaces(objectPath, interfaces, client->loaded);
+    g_variant_unref(interfaces);
+}
+
+void BluezClient::onInterfacesRemoved(GDBusConnection* bus, const gchar* sender, const gchar* path,
+                                      const gchar* interface, const gchar* signal, GVariant* parameters,
+                                      gpointer user_data) {
+    (void)bus; (void)sender; (void)path; (void)interface; (void)signal;
+
+    BluezClient* client = static_cast<BluezClient*>(user_data);
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oas)"))) return;
+
+    const char* objectPath;
+    const char** interfaces;
+    g_variant_get(parameters, "(&o^a&s)", &objectPath, &interfaces);
+    client->removeInterfaces(objectPath, interfaces);
+    g_free(interfaces);
+}
+
+void BluezClient::onPropertiesChanged(GDBusConnection* bus, const gchar* sender, const gchar* path,
+                                      const gchar* interface, const gchar* signal, GVariant* parameters,
+                                      gpointer user_data) {
+    (void)bus; (void)sender; (void)interface; (void)signal;
+
+    BluezClient* client = static_cast<BluezClient*>(user_data);
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sa{sv}as)"))) return;
+
+    const char* changedInterface;
+    GVariant* changed;
+    const char** invalidated;
+    g_variant_get(parameters, "(&s@a{sv}^a&s)", &changedInterface, &changed, &invalidated);
+
+    if (strcmp(changedInterface, ADAPTER_INTERFACE) == 0) {
+        auto it = client->adapterTable.find(path);
+        if (it != client->adapterTable.end()) {
+            client->applyAdapterProperties(it->second, changed);
+            if (client->loaded) client->listener(Event::AdapterChanged, path);
+        }
+    } else if (strcmp(changedInterface, DEVICE_INTERFACE) == 0) {
+        auto it = client->deviceTable.find(path);
+        if (it != client->deviceTable.end()) {
+            bool stateChanged = client->applyDeviceProperties(it->second, client->telemetryTable[path], changed,
+                                                              invalidated);
+            if (client->loaded) {
+                client->listener(stateChanged ? Event::DeviceChanged : Event::TelemetryChanged, path);
+            }
+        }
+    } else if (strcmp(changedInterface, BATTERY_INTERFACE) == 0) {
+        client->applyBatteryProperties(client->telemetryTable[path], changed);
+        if (client->loaded) client->listener(Event::TelemetryChanged, path);
+    } else if (strcmp(changedInterface, TRANSPORT_INTERFACE) == 0) {
+        auto it = client->transportTable.find(path);
+        if (it != client->transportTable.end()) {
+            client->applyTransportProperties(it->second, changed);
+            client->updateTransportTelemetry(it->second.devicePath, client->loaded);
+        }
+    }
+
+    g_variant_unref(changed);
+    g_free(invalidated);
+}
+
+void BluezClient::onCallFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
+    PendingCall* pending = static_cast<PendingCall*>(user_data);
+
+    GError* error = nullptr;
+    GVariant* reply = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+    if (g_cancellable_is_cancelled(pending->cancellable)) {
+        // Cancelled by the caller, a restart of bluetoothd or the client's
+        // destruction; in every case nobody is waiting and the client may be
+        // gone, even if the reply itself made it in before the cancellation
+        if (error) g_error_free(error);
+        if (reply) g_variant_unref(reply);
+        g_object_unref(pending->cancellable);
+        delete pending;
+        return;
+    }
+    pending->client->pendingCalls.erase(pending->id);
+
+    if (pending->reply) {
+        if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
+            pending->reply(false, "Timed out");
+        } else if (error) {
+            g_dbus_error_strip_remote_error(error);
+            pending->reply(false, error->message);
+        } else {
+            pending->reply(true, "");
+        }
+    }
+
+    if (error) g_error_free(error);
+    if (reply) g_variant_unref(reply);
+    g_object_unref(pending->cancellable);
+    delete pending;
+}
@@ -0,0 +1,159 @@
+#ifndef BLUEZCLIENT_H
+#define BLUEZCLIENT_H
+
+#include <gio/gio.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct BluezAdapter {
+    std::string path;
+    std::string address;
+    bool powered = false;
+    bool discovering = false;
+};
+
+struct BluezDevice {
+    std::string path;
+    std::string adapterPath;
+    std::string mac;
+    std::string name;     // Alias, which BlueZ falls back to Name or the address
+    std::string icon;     // freedesktop icon name hint, e.g. "audio-headset"
+    bool paired = false;
+    bool trusted = false;
+    bool connected = false;
+};
+
+// Live readings for one device, kept apart from BluezDevice because they
+// change far more often than anything a row's layout depends on
+struct BluezTelemetry {
+    int16_t rssi = 0;
+    int8_t battery = -1;          // percent from org.bluez.Battery1, -1 if not reported
+    uint8_t codec = 0;            // codec id of the device's media transport
+    bool hasRssi = false;         // RSSI is only present while discovery sees the device
+    bool hasCodec = false;
+    bool streaming = false;       // transport State is "active"
+    const char* profile = nullptr; // "A2DP", "HFP", ... (static string) while a transport exists
+};
+
+// Mirror of the BlueZ object tree over D-Bus. One GetManagedObjects call
+// fills the adapter and device tables when org.bluez appears, after which
+// they are kept current from ObjectManager InterfacesAdded/InterfacesRemoved
+// and PropertiesChanged signals; nothing is polled and no process is
+// spawned. Every change is reported through the listener with the object
+// path it concerns; battery, RSSI and audio transport changes come as
+// TelemetryChanged so the UI can batch them. Methods are called asynchronously with their own
+// timeout and report through a Reply callback. Each call returns an id that
+// cancel() accepts; cancelled calls, and calls still running when the
+// client is destroyed, are dropped without a reply. Cancelling only stops
+// waiting: bluetoothd keeps working unless told otherwise (CancelPairing,
+// Disconnect).
+//
+// ELYSIA_BLUEZ_BUS=session makes the client talk to the session bus instead
+// of the system bus, so it can be pointed at a mock BlueZ service.
+class BluezClient {
+public:
+    static constexpr int CALL_TIMEOUT_MS = 25000;
+
+    enum class Event {
+        ServiceChanged,  // org.bluez appeared or vanished; tables were reloaded
+        AdapterChanged,
+        DeviceAdded,
+        DeviceChanged,
+        DeviceRemoved,
+        TelemetryChanged  // only BluezTelemetry of the device at path changed
+    };
+
+    using Listener = std::function<void(Event event, const std::string& path)>;
+    using Reply = std::function<void(bool ok, const std::string& error)>;
+
+    explicit BluezClient(Listener listener);
+    ~BluezClient();
+
+    BluezClient(const BluezClient&) = delete;
+    BluezClient& operator=(const BluezClient&) = delete;
+
+    bool isAvailable() const { return connection != nullptr && loaded; }
+
+    // The first adapter in path order, or null without one
+    const BluezAdapter* adapter() const;
+    const BluezDevice* device(const std::string& path) const;
+    const std::unordered_map<std::string, BluezDevice>& devices() const { return deviceTable; }
+    const BluezTelemetry* telemetry(const std::string& path) const;
+
+    // "SBC", "AAC", "LC3", ... for the codec id of a transport
+    static const char* codecName(const BluezTelemetry& telemetry);
+
+    // Each returns the call id, or 0 if the call failed at once (the reply
+    // has then already run)
+    guint setPowered(bool powered, Reply reply = nullptr);
+    guint startDiscovery(Reply reply = nullptr);
+    guint stopDiscovery(Reply reply = nullptr);
+    guint pairDevice(const std::string& path, int timeoutMs = CALL_TIMEOUT_MS, Reply reply = nullptr);
+    guint cancelPairing(const std::string& path, Reply reply = nullptr);
+    guint connectDevice(const std::string& path, int timeoutMs = CALL_TIMEOUT_MS, Reply reply = nullptr);
+    guint disconnectDevice(const std::string& path, int timeoutMs = CALL_TIMEOUT_MS, Reply reply = nullptr);
+    guint removeDevice(const std::string& path, int timeoutMs = CALL_TIMEOUT_MS, Reply reply = nullptr);
+
+    void cancel(guint callId);
+
+private:
+    struct PendingCall;
+
+    struct Transport {
+        std::string devicePath;
+        std::string uuid;
+        uint8_t codec = 0;
+        bool hasCodec = false;
+        bool active = false;
+    };
+
+    Listener listener;
+    GBusType busType;
+    guint watchId;
+    GDBusConnection* connection;
+    GCancellable* cancellable;
+    guint interfacesAddedId;
+    guint interfacesRemovedId;
+    guint propertiesChangedId;
+    bool loaded;
+    guint nextCallId;
+    std::unordered_map<guint, PendingCall*> pendingCalls;
+
+    std::unordered_map<std::string, BluezAdapter> adapterTable;
+    std::unordered_map<std::string, BluezDevice> deviceTable;
+    std::unordered_map<std::string, BluezTelemetry> telemetryTable;  // by device path
+    std::unordered_map<std::string, Transport> transportTable;       // by transport path
+
+    void attach(GDBusConnection* bus);
+    // Fails every call in flight with reason; nullptr drops them silently
+    void detach(const char* reason = nullptr);
+    void addInterfaces(const char* path, GVariant* interfaces, bool notify);
+    void removeInterfaces(const char* path, const char* const* interfaces);
+    void applyAdapterProperties(BluezAdapter& adapter, GVariant* properties);
+    bool applyDeviceProperties(BluezDevice& device, BluezTelemetry& telemetry, GVariant* properties,
+                               const char* const* invalidated);
+    void applyBatteryProperties(BluezTelemetry& telemetry, GVariant* properties);
+    void applyTransportProperties(Transport& transport, GVariant* properties);
+    void updateTransportTelemetry(const std::string& devicePath, bool notify);
+    guint call(const std::string& path, const char* interface, const char* method,
+               GVariant* parameters, int timeoutMs, Reply reply);
+
+    static void onNameAppeared(GDBusConnection* bus, const gchar* name, const gchar* owner, gpointer user_data);
+    static void onNameVanished(GDBusConnection* bus, const gchar* name, gpointer user_data);
+    static void onManagedObjects(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onInterfacesAdded(GDBusConnection* bus, const gchar* sender, const gchar* path,
+                                  const gchar* interface, const gchar* signal, GVariant* parameters,
+                                  gpointer user_data);
+    static void onInterfacesRemoved(GDBusConnection* bus, const gchar* sender, const gchar* path,
+                                    const gchar* interface, const gchar* signal, GVariant* parameters,
+                                    gpointer user_data);
+    static void onPropertiesChanged(GDBusConnection* bus, const gchar* sender, const gchar* path,
+                                    const gchar* interface, const gchar* signal, GVariant* parameters,
+                                    gpointer user_data);
+    static void onCallFinished(GObject* source, GAsyncResult* result, gpointer user_data);
+};
+
+#endif // BLUEZCLIENT_H
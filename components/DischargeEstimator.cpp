@@ -0,0 +1,96 @@
+#include "DischargeEstimator.h"
+#include <algorithm>
+#include <cmath>
+
+DischargeEstimator::DischargeEstimator() {
+    reset();
+}
+
+void DischargeEstimator::reset() {
+    for (auto& row : models) {
+        for (Model& model : row) {
+            model = Model{0.0, 0.0, 0.0, 0};
+        }
+    }
+    anchorTime = -1.0;
+    anchorEnergy = -1.0;
+    anchorState = BatteryState::Unknown;
+}
+
+int DischargeEstimator::stateIndex(BatteryState state) {
+    switch (state) {
+        case BatteryState::Discharging: return 0;
+        case BatteryState::Charging: return 1;
+        default: return -1;
+    }
+}
+
+void DischargeEstimator::addSample(double time, BatteryState state, PowerProfile profile,
+                                   double energyNow, double rate) {
+    int index = stateIndex(state);
+
+    if (rate <= 0.0) {
+        // No usable power_now/current_now: use the energy change since the
+        // anchor once enough time has passed for the counter to move
+        if (state != anchorState || anchorTime < 0.0 || energyNow < 0.0 || time < anchorTime) {
+            anchorTime = time;
+            anchorEnergy = energyNow;
+            anchorState = state;
+            return;
+        }
+        double elapsed = time - anchorTime;
+        if (elapsed < MIN_DERIVED_STEP) return;
+        if (elapsed > MAX_STEP * 10.0) {
+            // A suspend in between would read as a tiny rate
+            anchorTime = time;
+            anchorEnergy = energyNow;
+            return;
+        }
+        rate = std::fabs(energyNow - anchorEnergy) / elapsed * 3600.0;
+        anchorTime = time;
+        anchorEnergy = energyNow;
+        if (rate <= 0.0) return;
+    }
+
+    if (index < 0) return;
+    update(models[index][static_cast<int>(profile)], time, rate);
+    update(models[index][PROFILES - 1], time, rate);
+}
+
+void DischargeEstimator::update(Model& model, double time, double rate) {
+    if (model.samples == 0) {
+        model.mean = rate;
+        model.variance = 0.0;
+    } else {
+        double step = std::clamp(time - model.lastTime, 0.0, MAX_STEP);
+        double alpha = 1.0 - std::exp(-step / TIME_CONSTANT);
+        double delta = rate - model.mean;
+        // Incremental exponentially weighted mean and variance (West, 1979)
+        model.mean += alpha * delta;
+        model.variance = (1.0 - alpha) * (model.variance + alpha * delta * delta);
+    }
+    model.lastTime = time;
+    if (model.samples < MIN_SAMPLES) model.samples++;
+}
+
+DischargeEstimator::Estimate DischargeEstimator::estimate(BatteryState state, PowerProfile profile,
+                                                          double energyNow, double energyFull) const {
+    Estimate result;
+    int index = stateIndex(state);
+    if (index < 0 || energyNow < 0.0) return result;
+
+    double energy = state == BatteryState::Discharging ? energyNow : energyFull - energyNow;
+    if (energy <= 0.0) return result;
+
+    const Model* model = &models[index][static_cast<int>(profile)];
+    if (model->samples < MIN_SAMPLES) model = &models[index][PROFILES - 1];
+    if (model->samples < MIN_SAMPLES || model->mean <= 0.0) return result;
+
+    double deviation = std::sqrt(model->variance);
+    result.seconds = energy / model->mean * 3600.0;
+    result.low = energy / (model->mean + deviation) * 3600.0;
+    // A spread as wide as the mean leaves no upper bound worth showing
+    double slowest = model->mean - deviation;
+    result.high = slowest > model->mean * 0.1 ? energy / slowest * 3600.0 : -1.0;
+    return result;
+}
@@ -0,0 +1,75 @@
+#ifndef DISCHARGEESTIMATOR_H
+#define DISCHARGEESTIMATOR_H
+
+#include <cstdint>
+#include "PowerSupply.h"
+
+// The modes of the Power page, as told apart by the CPU governor
+enum class PowerProfile : uint8_t {
+    Default,
+    Balanced,
+    Performance
+};
+
+// Smoothed time-to-empty and time-to-full. A separate exponentially
+// weighted mean and variance of the energy rate is kept for each battery
+// state and power profile, plus one per state across all profiles that
+// stands in until a profile has seen enough samples. Switching profile or
+// plugging in therefore picks up a model that already knows that workload
+// instead of starting from one noisy reading.
+//
+// The weight of a sample grows with the time it covers (capped at
+// MAX_STEP, so a model left idle for hours is blended, not replaced), which
+// keeps the smoothing the same whether samples arrive every two seconds or
+// every minute. Each sample costs O(1) and nothing is allocated.
+class DischargeEstimator {
+public:
+    static constexpr double TIME_CONSTANT = 600.0;  // seconds for a weight of 1 - 1/e
+    static constexpr double MAX_STEP = 60.0;
+    static constexpr double MIN_DERIVED_STEP = 30.0;
+    static constexpr int MIN_SAMPLES = 5;
+
+    // Seconds; low and high come from one standard deviation of the rate
+    struct Estimate {
+        double seconds = -1.0;
+        double low = -1.0;
+        double high = -1.0;
+
+        bool valid() const { return seconds > 0.0; }
+    };
+
+    DischargeEstimator();
+
+    // time is monotonic seconds. rate is the reported energy rate in W, or
+    // negative if the driver has none, in which case it is derived from the
+    // change in energyNow.
+    void addSample(double time, BatteryState state, PowerProfile profile, double energyNow, double rate);
+
+    // Time to empty while discharging, time to full while charging
+    Estimate estimate(BatteryState state, PowerProfile profile, double energyNow, double energyFull) const;
+
+    void reset();
+
+private:
+    static constexpr int STATES = 2;    // Discharging, Charging
+    static constexpr int PROFILES = 4;  // PowerProfile values plus the shared model
+
+    struct Model {
+        double mean;
+        double variance;
+        double lastTime;
+        int samples;
+    };
+
+    Model models[STATES][PROFILES];
+
+    // Anchor for deriving a rate from energy when the driver reports none
+    double anchorTime;
+    double anchorEnergy;
+    BatteryState anchorState;
+
+    static int stateIndex(BatteryState state);
+    static void update(Model& model, double time, double rate);
+};
+
+#endif // DISCHARGEESTIMATOR_H
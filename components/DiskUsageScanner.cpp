@@ -0,0 +1,414 @@
+#include "DiskUsageScanner.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+#include <unordered_set>
+
+struct DiskUsageScanner::Node {
+    uint64_t id = 0;
+    Node* parent = nullptr;
+    std::string name;
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> items{0};
+    std::atomic<size_t> pending{1};  // its own listing plus unfinished subdirectories
+    std::atomic<bool> complete{false};
+    bool aggregated = false;                      // guarded by treeMutex
+    std::vector<std::unique_ptr<Node>> children;  // guarded by treeMutex
+
+    size_t descendants() const {
+        size_t count = children.size();
+        for (const auto& child : children) count += child->descendants();
+        return count;
+    }
+};
+
+struct DiskUsageScanner::Worker {
+    std::mutex mutex;
+    std::deque<Node*> queue;  // the owner works at the back, thieves take the front
+    std::thread thread;
+};
+
+// Inodes of files with more than one link that were already counted,
+// sharded so workers rarely wait on each other
+class DiskUsageScanner::InodeSet {
+public:
+    bool insert(uint64_t inode) {
+        Shard& shard = shards[(inode * 0x9e3779b97f4a7c15ull) >> 58];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.inodes.insert(inode).second;
+    }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<uint64_t> inodes;
+    };
+    Shard shards[64];
+};
+
+// getdents64 records; glibc only wraps the syscall in newer releases
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+static constexpr size_t DIRENT_BUFFER = 64 * 1024;
+static constexpr unsigned STAT_FLAGS = AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT | AT_STATX_DONT_SYNC;
+
+DiskUsageScanner::DiskUsageScanner()
+    : notifyFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), rootFd(-1), rootDevice(0),
+      running(false), stopRequested(false), outstanding(0), idleWorkers(0),
+      nodeCount(0), nextId(0), errorCount(0) {
+}
+
+DiskUsageScanner::~DiskUsageScanner() {
+    stop();
+    if (rootFd >= 0) close(rootFd);
+    if (notifyFd >= 0) close(notifyFd);
+}
+
+bool DiskUsageScanner::start(const std::string& path, unsigned threads) {
+    stop();
+    if (notifyFd < 0) return false;
+
+    if (rootFd >= 0) close(rootFd);
+    rootFd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootFd < 0) return false;
+
+    struct statx status;
+    if (statx(rootFd, "", AT_EMPTY_PATH | AT_STATX_DONT_SYNC, STATX_TYPE, &status) != 0) {
+        close(rootFd);
+        rootFd = -1;
+        return false;
+    }
+    rootDevice = makedev(status.stx_dev_major, status.stx_dev_minor);
+
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min(threads, MAX_THREADS));
+
+    {
+        std::lock_guard<std::mutex> lock(treeMutex);
+        root = path;
+        tree = std::make_unique<Node>();
+        tree->id = 1;
+        inodes = std::make_unique<InodeSet>();
+    }
+    nodeCount = 1;
+    nextId = 2;
+    errorCount = 0;
+    idleWorkers = 0;
+    workers.clear();
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    workers[0]->queue.push_back(tree.get());
+    outstanding = 1;
+
+    stopRequested = false;
+    running = true;
+    coordinator = std::thread(&DiskUsageScanner::run, this, threads);
+    return true;
+}
+
+void DiskUsageScanner::stop() {
+    stopRequested = true;
+    idleCondition.notify_all();
+    if (coordinator.joinable()) {
+        coordinator.join();
+    }
+    running = false;
+}
+
+void DiskUsageScanner::acknowledge() {
+    uint64_t value;
+    while (read(notifyFd, &value, sizeof(value)) == sizeof(value)) {
+    }
+}
+
+bool DiskUsageScanner::list(const std::vector<std::string>& path, UsageEntry& total,
+                            std::vector<UsageEntry>& children) const {
+    children.clear();
+    std::lock_guard<std::mutex> lock(treeMutex);
+    if (!tree) return false;
+
+    const Node* node = tree.get();
+    for (const std::string& name : path) {
+        auto it = std::find_if(node->children.begin(), node->children.end(),
+                               [&](const std::unique_ptr<Node>& child) { return child->name == name; });
+        if (it == node->children.end()) return false;
+        node = it->get();
+    }
+
+    total.name = path.empty() ? root : path.back();
+    total.bytes = node->bytes;
+    total.items = node->items;
+    total.directory = true;
+    total.complete = node->complete;
+    total.expandable = !node->children.empty();
+
+    uint64_t childBytes = 0;
+    uint64_t childItems = 0;
+    children.reserve(node->children.size() + 1);
+    for (const auto& child : node->children) {
+        UsageEntry entry;
+        entry.name = child->name;
+        entry.bytes = child->bytes;
+        entry.items = child->items;
+        entry.directory = true;
+        entry.complete = child->complete;
+        // Until it is listed a directory may still turn out to have children
+        entry.expandable = !child->aggregated && (!child->complete || !child->children.empty());
+        childBytes += entry.bytes;
+        childItems += entry.items + 1;
+        children.push_back(std::move(entry));
+    }
+
+    // Files directly inside, and whatever was folded into the directory;
+    // the counters of parent and children are bumped one after the other
+    UsageEntry own;
+    own.name = ".";
+    own.bytes = total.bytes > childBytes ? total.bytes - childBytes : 0;
+    own.items = total.items > childItems ? total.items - childItems : 0;
+    own.complete = total.complete;
+    if (own.bytes > 0 || own.items > 0) children.push_back(std::move(own));
+    return true;
+}
+
+void DiskUsageScanner::snapshot(std::vector<TreemapSample>& samples, uint64_t namedFrom) const {
+    samples.clear();
+    std::vector<const Node*> order;
+
+    std::lock_guard<std::mutex> lock(treeMutex);
+    if (!tree) return;
+
+    // order[i] becomes samples[i]; children are queued together, so they stay together
+    samples.reserve(nodeCount);
+    order.reserve(nodeCount);
+    order.push_back(tree.get());
+    samples.emplace_back();
+    samples[0].parent = -1;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const Node* node = order[i];
+        TreemapSample& sample = samples[i];
+        sample.id = node->id;
+        sample.bytes = node->bytes;
+        if (node->id >= namedFrom) sample.name = node->name;
+
+        for (const auto& child : node->children) {
+            order.push_back(child.get());
+            TreemapSample queued;
+            queued.parent = static_cast<int32_t>(i);
+            samples.push_back(std::move(queued));
+        }
+    }
+}
+
+ScanProgress DiskUsageScanner::progress() const {
+    ScanProgress progress;
+    std::lock_guard<std::mutex> lock(treeMutex);
+    if (tree) {
+        progress.bytes = tree->bytes;
+        progress.items = tree->items;
+        progress.complete = tree->complete;
+    }
+    progress.errors = errorCount;
+    progress.nodes = nodeCount;
+    return progress;
+}
+
+void DiskUsageScanner::run(unsigned threads) {
+    for (unsigned i = 0; i < threads; ++i) {
+        workers[i]->thread = std::thread(&DiskUsageScanner::work, this, static_cast<size_t>(i));
+    }
+
+    // Publish on a fixed beat rather than per directory; the UI redraws at most this often
+    for (;;) {
+        bool done;
+        {
+            std::unique_lock<std::mutex> lock(idleMutex);
+            done = idleCondition.wait_for(lock, std::chrono::milliseconds(PUBLISH_INTERVAL_MS),
+                                          [this]() { return outstanding == 0 || stopRequested; });
+        }
+        if (done) break;
+        signal();
+    }
+
+    for (auto& worker : workers) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+    running = false;
+    signal();
+}
+
+void DiskUsageScanner::work(size_t self) {
+    while (!stopRequested) {
+        if (Node* node = take(self)) {
+            scan(self, node);
+            if (outstanding.fetch_sub(1) == 1) {
+                idleCondition.notify_all();
+            }
+            continue;
+        }
+        if (outstanding == 0) break;
+
+        // Someone is still listing and may hand out more work; the timeout
+        // covers a push that lands between the check and the wait
+        std::unique_lock<std::mutex> lock(idleMutex);
+        idleWorkers++;
+        idleCondition.wait_for(lock, std::chrono::milliseconds(5));
+        idleWorkers--;
+    }
+}
+
+DiskUsageScanner::Node* DiskUsageScanner::take(size_t self) {
+    {
+        Worker& own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.queue.empty()) {
+            Node* node = own.queue.back();
+            own.queue.pop_back();
+            return node;
+        }
+    }
+
+    // Steal the oldest, i.e. shallowest, directory: it likely holds the most work
+    for (size_t i = 1; i < workers.size(); ++i) {
+        Worker& victim = *workers[(self + i) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.queue.empty()) {
+            Node* node = victim.queue.front();
+            victim.queue.pop_front();
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+void DiskUsageScanner::scan(size_t self, Node* node) {
+    // Parents and names never change once queued, so the path needs no lock
+    std::string path;
+    for (const Node* n = node; n->parent; n = n->parent) {
+        path.insert(0, n->parent->parent ? "/" + n->name : n->name);
+    }
+    if (path.empty()) path = ".";
+
+    int fd = openat(rootFd, path.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) {
+        errorCount++;
+        finish(node);
+        return;
+    }
+
+    std::vector<std::unique_ptr<Node>> found;
+    uint64_t bytes = 0;
+    uint64_t items = 0;
+    char buffer[DIRENT_BUFFER];
+
+    for (;;) {
+        long length = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (length < 0 && errno == EINTR) continue;
+        if (length < 0) errorCount++;
+        if (length <= 0) break;
+
+        for (long offset = 0; offset < length;) {
+            const LinuxDirent64* entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+            offset += entry->d_reclen;
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+            if (stopRequested) break;
+
+            struct statx status;
+            if (statx(fd, name, STAT_FLAGS, STATX_TYPE | STATX_NLINK | STATX_INO | STATX_BLOCKS, &status) != 0) {
+                continue;  // deleted since listing
+            }
+            // Another filesystem mounted or bind-mounted here belongs to its own drive
+            if (makedev(status.stx_dev_major, status.stx_dev_minor) != rootDevice) continue;
+
+            items++;
+            bool directory = S_ISDIR(status.stx_mode);
+            if (!directory && status.stx_nlink > 1 && !inodes->insert(status.stx_ino)) continue;
+            bytes += status.stx_blocks * 512;
+
+            if (directory) {
+                auto child = std::make_unique<Node>();
+                child->parent = node;
+                child->name = name;
+                found.push_back(std::move(child));
+            }
+        }
+        if (stopRequested) break;
+    }
+    close(fd);
+
+    // Account the subdirectories before they can finish and release the parent
+    if (!found.empty()) {
+        node->pending += found.size();
+        outstanding += found.size();
+        nodeCount += found.size();
+
+        std::vector<Node*> queued;
+        queued.reserve(found.size());
+        {
+            // Ids are handed out as children are published, so every id below
+            // the highest one a snapshot saw was already in that snapshot
+            std::lock_guard<std::mutex> lock(treeMutex);
+            for (auto& child : found) {
+                child->id = nextId++;
+                queued.push_back(child.get());
+                node->children.push_back(std::move(child));
+            }
+        }
+        {
+            Worker& own = *workers[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.queue.insert(own.queue.end(), queued.begin(), queued.end());
+        }
+        if (idleWorkers > 0) idleCondition.notify_all();
+    }
+
+    // Partial totals show up in every ancestor straight away
+    for (Node* n = node; n; n = n->parent) {
+        n->bytes += bytes;
+        n->items += items;
+    }
+    finish(node);
+}
+
+void DiskUsageScanner::finish(Node* node) {
+    while (node && node->pending.fetch_sub(1) == 1) {
+        node->complete = true;
+
+        // Fold small directories, and any directory once the tree is full;
+        // the root always keeps its children
+        if (node->parent && (node->bytes < AGGREGATE_BYTES || nodeCount > MAX_NODES)) {
+            std::vector<std::unique_ptr<Node>> folded;
+            {
+                std::lock_guard<std::mutex> lock(treeMutex);
+                folded.swap(node->children);
+                node->aggregated = !folded.empty();
+            }
+            size_t count = folded.size();
+            for (const auto& child : folded) count += child->descendants();
+            nodeCount -= count;
+            // Freed outside the lock; every node below is complete, so no worker holds one
+        }
+        node = node->parent;
+    }
+}
+
+void DiskUsageScanner::signal() {
+    uint64_t one = 1;
+    ssize_t written = write(notifyFd, &one, sizeof(one));
+    (void)written;
+}
@@ -0,0 +1,118 @@
+#ifndef DISKUSAGESCANNER_H
+#define DISKUSAGESCANNER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "TreemapLayout.h"
+
+struct UsageEntry {
+    std::string name;
+    uint64_t bytes = 0;      // allocated on disk, like du; partial while scanning
+    uint64_t items = 0;      // files and directories below it
+    bool directory = false;
+    bool complete = false;   // every directory below has been listed
+    bool expandable = false; // has children to list; false once aggregated
+};
+
+struct ScanProgress {
+    uint64_t bytes = 0;
+    uint64_t items = 0;
+    uint64_t errors = 0;     // directories that could not be opened or read
+    size_t nodes = 0;        // directories held in memory
+    bool complete = false;   // the whole tree was listed, not cancelled
+};
+
+// Sizes the directory tree below one mountpoint, for the storage page's
+// "What's using space" view. Directories are listed by a small pool of
+// threads with openat()/getdents64()/statx(); each thread works depth-first
+// through its own deque and steals from the far end of the others' when it
+// runs dry, so one huge directory does not leave the rest idle.
+//
+// The walk stays on the device of the root and counts a file with several
+// hard links once. Only directories become nodes. Once a directory has been
+// listed completely and holds less than AGGREGATE_BYTES, or the tree already
+// holds MAX_NODES directories, its subdirectories are folded into it, which
+// keeps memory proportional to the directories worth showing rather than to
+// the number of entries on disk.
+//
+// Like the other engines nothing here touches GLib: while a scan runs,
+// eventFd() becomes readable at most every PUBLISH_INTERVAL_MS, and the
+// owner answers with acknowledge() and list().
+class DiskUsageScanner {
+public:
+    static constexpr int PUBLISH_INTERVAL_MS = 100;
+    static constexpr uint64_t AGGREGATE_BYTES = 16ull << 20;
+    static constexpr size_t MAX_NODES = 200000;
+    static constexpr unsigned MAX_THREADS = 8;
+
+    DiskUsageScanner();
+    ~DiskUsageScanner();
+
+    DiskUsageScanner(const DiskUsageScanner&) = delete;
+    DiskUsageScanner& operator=(const DiskUsageScanner&) = delete;
+
+    // Replaces any scan in progress; threads 0 picks one per core up to MAX_THREADS
+    bool start(const std::string& root, unsigned threads = 0);
+    // Cancels the scan; what was counted so far stays listable
+    void stop();
+    bool isRunning() const { return running; }
+    const std::string& rootPath() const { return root; }
+
+    int eventFd() const { return notifyFd; }
+    void acknowledge();
+
+    // The directory at path (names below the root) and its subdirectories,
+    // with its own files summed up as one entry named "."
+    bool list(const std::vector<std::string>& path, UsageEntry& total, std::vector<UsageEntry>& children) const;
+    // Breadth-first copy of every directory held, for the treemap; names
+    // are only copied for ids from namedFrom on. Ids grow in the order
+    // directories are published, so an earlier snapshot that saw id n
+    // also saw every directory below n still held
+    void snapshot(std::vector<TreemapSample>& samples, uint64_t namedFrom) const;
+    ScanProgress progress() const;
+
+private:
+    struct Node;
+    struct Worker;
+    class InodeSet;
+
+    std::string root;
+    int notifyFd;
+    int rootFd;
+    uint64_t rootDevice;
+    std::unique_ptr<Node> tree;
+    std::unique_ptr<InodeSet> inodes;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::thread coordinator;
+    std::atomic<bool> running;
+    std::atomic<bool> stopRequested;
+
+    // Scheduling: queued plus in-progress directories; zero ends the scan
+    std::atomic<size_t> outstanding;
+    std::atomic<unsigned> idleWorkers;
+    std::mutex idleMutex;
+    std::condition_variable idleCondition;
+
+    // Guards the children vectors; sizes are atomics read without it
+    mutable std::mutex treeMutex;
+    std::atomic<size_t> nodeCount;
+    std::atomic<uint64_t> nextId;
+    std::atomic<uint64_t> errorCount;
+
+    void run(unsigned threads);
+    void work(size_t self);
+    Node* take(size_t self);
+    void scan(size_t self, Node* node);
+    void finish(Node* node);
+    void signal();
+};
+
+#endif // DISKUSAGESCANNER_H
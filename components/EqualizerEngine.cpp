@@ -0,0 +1,371 @@
+#include "EqualizerEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+// Four float lanes; GCC and Clang lower this to SSE on x86-64 and NEON on ARM
+typedef float EqVec __attribute__((vector_size(16)));
+constexpr int VEC_WIDTH = 4;
+
+inline EqVec loadVec(const float* p) {
+    EqVec v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline void storeVec(float* p, EqVec v) {
+    std::memcpy(p, &v, sizeof(v));
+}
+
+const char* filterTypeName(EqualizerFilterType type) {
+    switch (type) {
+        case EqualizerFilterType::LowShelf: return "lowshelf";
+        case EqualizerFilterType::HighShelf: return "highshelf";
+        default: return "peaking";
+    }
+}
+
+EqualizerFilterType filterTypeFromName(const std::string& name) {
+    if (name == "lowshelf") return EqualizerFilterType::LowShelf;
+    if (name == "highshelf") return EqualizerFilterType::HighShelf;
+    return EqualizerFilterType::Peaking;
+}
+
+} // namespace
+
+BiquadCoefficients designBiquad(const EqualizerBand& band, double sampleRate) {
+    const double nyquist = sampleRate * 0.5;
+    const double freq = std::clamp(band.frequency, 10.0, nyquist * 0.99);
+    const double q = std::max(band.q, 0.05);
+    const double A = std::pow(10.0, band.gain / 40.0);
+    const double w0 = 2.0 * M_PI * freq / sampleRate;
+    const double cosW = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+
+    double b0, b1, b2, a0, a1, a2;
+    switch (band.type) {
+        case EqualizerFilterType::LowShelf: {
+            const double sqA = 2.0 * std::sqrt(A) * alpha;
+            b0 = A * ((A + 1) - (A - 1) * cosW + sqA);
+            b1 = 2 * A * ((A - 1) - (A + 1) * cosW);
+            b2 = A * ((A + 1) - (A - 1) * cosW - sqA);
+            a0 = (A + 1) + (A - 1) * cosW + sqA;
+            a1 = -2 * ((A - 1) + (A + 1) * cosW);
+            a2 = (A + 1) + (A - 1) * cosW - sqA;
+            break;
+        }
+        case EqualizerFilterType::HighShelf: {
+            const double sqA = 2.0 * std::sqrt(A) * alpha;
+            b0 = A * ((A + 1) + (A - 1) * cosW + sqA);
+            b1 = -2 * A * ((A - 1) + (A + 1) * cosW);
+            b2 = A * ((A + 1) + (A - 1) * cosW - sqA);
+            a0 = (A + 1) - (A - 1) * cosW + sqA;
+            a1 = 2 * ((A - 1) - (A + 1) * cosW);
+            a2 = (A + 1) - (A - 1) * cosW - sqA;
+            break;
+        }
+        default:
+            b0 = 1 + alpha * A;
+            b1 = -2 * cosW;
+            b2 = 1 - alpha * A;
+            a0 = 1 + alpha / A;
+            a1 = -2 * cosW;
+            a2 = 1 - alpha / A;
+            break;
+    }
+
+    return BiquadCoefficients{b0 / a0, b1 / a0, b2 / a0, a1 / a0, a2 / a0};
+}
+
+double biquadMagnitudeDb(const BiquadCoefficients& c, double frequency, double sampleRate) {
+    const double w = 2.0 * M_PI * frequency / sampleRate;
+    const std::complex<double> z1 = std::polar(1.0, -w);
+    const std::complex<double> z2 = z1 * z1;
+    const std::complex<double> num = c.b0 + c.b1 * z1 + c.b2 * z2;
+    const std::complex<double> den = 1.0 + c.a1 * z1 + c.a2 * z2;
+    const double mag = std::abs(num / den);
+    return 20.0 * std::log10(std::max(mag, 1e-12));
+}
+
+EqualizerEngine::EqualizerEngine(int channels, double sampleRate)
+    : channels(std::clamp(channels, 1, MAX_CHANNELS)), sampleRate(sampleRate),
+      bandCount(0), laneStride(VEC_WIDTH), laneCount(0), preampGain(1.0f) {
+    laneCount = this->channels * laneStride;
+    setBands({});
+}
+
+void EqualizerEngine::setBands(const std::vector<EqualizerBand>& bands) {
+    const int newCount = std::min(static_cast<int>(bands.size()), MAX_BANDS);
+    const int newStride = std::max(VEC_WIDTH, (newCount + VEC_WIDTH - 1) / VEC_WIDTH * VEC_WIDTH);
+    const bool layoutChanged = (newStride != laneStride) || (newCount != bandCount);
+
+    bandCount = newCount;
+    laneStride = newStride;
+    laneCount = channels * laneStride;
+
+    designed.clear();
+    for (int b = 0; b < bandCount; ++b) {
+        designed.push_back(designBiquad(bands[b], sampleRate));
+    }
+
+    for (int c = 0; c < channels; ++c) {
+        for (int b = 0; b < laneStride; ++b) {
+            const int lane = c * laneStride + b;
+            if (b < bandCount) {
+                b0[lane] = static_cast<float>(designed[b].b0);
+                b1[lane] = static_cast<float>(designed[b].b1);
+                b2[lane] = static_cast<float>(designed[b].b2);
+                a1[lane] = static_cast<float>(designed[b].a1);
+                a2[lane] = static_cast<float>(designed[b].a2);
+            } else {
+                // Padding lanes pass samples straight through
+                b0[lane] = 1.0f;
+                b1[lane] = b2[lane] = a1[lane] = a2[lane] = 0.0f;
+            }
+        }
+    }
+
+    // Keep filter memory across plain gain tweaks so sliders don't click
+    if (layoutChanged) {
+        reset();
+    }
+}
+
+void EqualizerEngine::setPreamp(double gainDb) {
+    preampGain = static_cast<float>(std::pow(10.0, gainDb / 20.0));
+}
+
+void EqualizerEngine::reset() {
+    std::fill(std::begin(x1), std::end(x1), 0.0f);
+    std::fill(std::begin(x2), std::end(x2), 0.0f);
+    std::fill(std::begin(y1), std::end(y1), 0.0f);
+    std::fill(std::begin(y2), std::end(y2), 0.0f);
+    std::fill(std::begin(stage), std::end(stage), 0.0f);
+    std::fill(std::begin(refX1), std::end(refX1), 0.0f);
+    std::fill(std::begin(refX2), std::end(refX2), 0.0f);
+    std::fill(std::begin(refY1), std::end(refY1), 0.0f);
+    std::fill(std::begin(refY2), std::end(refY2), 0.0f);
+}
+
+void EqualizerEngine::process(float* interleaved, size_t frames) {
+    if (!interleaved) return;
+
+    for (size_t n = 0; n < frames; ++n) {
+        float* frame = interleaved + n * channels;
+
+        for (int c = 0; c < channels; ++c) {
+            stage[c * laneStride] = frame[c] * preampGain;
+        }
+
+        // Walk the vectors backwards so each shifted store only overwrites
+        // lanes that have already been loaded for this frame
+        for (int l = laneCount - VEC_WIDTH; l >= 0; l -= VEC_WIDTH) {
+            const EqVec x = loadVec(stage + l);
+            const EqVec px1 = loadVec(x1 + l);
+            const EqVec px2 = loadVec(x2 + l);
+            const EqVec py1 = loadVec(y1 + l);
+            const EqVec py2 = loadVec(y2 + l);
+
+            const EqVec y = loadVec(b0 + l) * x + loadVec(b1 + l) * px1 + loadVec(b2 + l) * px2
+                          - loadVec(a1 + l) * py1 - loadVec(a2 + l) * py2;
+
+            storeVec(x2 + l, px1);
+            storeVec(x1 + l, x);
+            storeVec(y2 + l, py1);
+            storeVec(y1 + l, y);
+            storeVec(stage + l + 1, y);
+        }
+
+        // The last lane of each channel has now been shifted into the slot
+        // right after it, which is where the next channel's head lane lives
+        for (int c = 0; c < channels; ++c) {
+            frame[c] = stage[(c + 1) * laneStride];
+        }
+    }
+}
+
+void EqualizerEngine::processReference(float* interleaved, size_t frames) {
+    if (!interleaved) return;
+
+    for (size_t n = 0; n < frames; ++n) {
+        float* frame = interleaved + n * channels;
+        for (int c = 0; c < channels; ++c) {
+            float x = frame[c] * preampGain;
+            for (int b = 0; b < laneStride; ++b) {
+                const int lane = c * laneStride + b;
+                const float y = b0[lane] * x + b1[lane] * refX1[lane] + b2[lane] * refX2[lane]
+                              - a1[lane] * refY1[lane] - a2[lane] * refY2[lane];
+                refX2[lane] = refX1[lane];
+                refX1[lane] = x;
+                refY2[lane] = refY1[lane];
+                refY1[lane] = y;
+                x = y;
+            }
+            frame[c] = x;
+        }
+    }
+}
+
+double EqualizerEngine::magnitudeDb(double frequency) const {
+    double total = 20.0 * std::log10(std::max(static_cast<double>(preampGain), 1e-12));
+    for (const auto& coeffs : designed) {
+        total += biquadMagnitudeDb(coeffs, frequency, sampleRate);
+    }
+    return total;
+}
+
+std::vector<EqualizerBand> EqualizerEngine::defaultBands() {
+    static const double centres[] = {31, 62, 125, 250, 500, 1000, 2000, 4000, 8000, 16000};
+
+    std::vector<EqualizerBand> bands;
+    for (size_t i = 0; i < sizeof(centres) / sizeof(centres[0]); ++i) {
+        EqualizerFilterType type = EqualizerFilterType::Peaking;
+        if (i == 0) type = EqualizerFilterType::LowShelf;
+        else if (i == 9) type = EqualizerFilterType::HighShelf;
+        bands.push_back(EqualizerBand{type, centres[i], 0.0, 1.41});
+    }
+    return bands;
+}
+
+std::vector<EqualizerPreset> EqualizerEngine::builtinPresets() {
+    struct Curve {
+        const char* name;
+        double preamp;
+        double gains[10];
+    };
+    static const Curve curves[] = {
+        {"Flat",         0.0, { 0,  0,  0,  0,  0,  0,  0,  0,  0,  0}},
+        {"Bass Boost",  -5.0, { 6,  5,  4,  2,  0,  0,  0,  0,  0,  0}},
+        {"Treble Boost",-4.0, { 0,  0,  0,  0,  0,  1,  2,  3,  4,  5}},
+        {"Vocal",       -3.0, {-2, -2, -1,  1,  3,  3,  2,  1,  0, -1}},
+        {"Rock",        -4.0, { 4,  3,  2,  0, -1, -1,  1,  2,  3,  4}},
+        {"Classical",   -2.0, { 3,  2,  1,  0,  0,  0,  0,  1,  2,  3}},
+    };
+
+    std::vector<EqualizerPreset> presets;
+    for (const auto& curve : curves) {
+        EqualizerPreset preset{curve.name, curve.preamp, defaultBands()};
+        for (size_t i = 0; i < preset.bands.size(); ++i) {
+            preset.bands[i].gain = curve.gains[i];
+        }
+        presets.push_back(preset);
+    }
+    return presets;
+}
+
+EqualizerPresetStore::EqualizerPresetStore() {
+    const char* home = std::getenv("HOME");
+    if (home) {
+        configPath = std::string(home) + "/.config/Elysia/equalizer.conf";
+    }
+}
+
+std::vector<EqualizerPreset> EqualizerPresetStore::loadUserPresets() const {
+    std::vector<EqualizerPreset> presets;
+    if (configPath.empty()) return presets;
+
+    std::ifstream file(configPath);
+    if (!file.is_open()) return presets;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            presets.push_back(EqualizerPreset{line.substr(1, line.size() - 2), 0.0, {}});
+            continue;
+        }
+        if (presets.empty()) continue;
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        std::string key = line.substr(0, eq);
+        std::istringstream value(line.substr(eq + 1));
+
+        if (key == "preamp") {
+            value >> presets.back().preamp;
+        } else if (key == "band") {
+            std::string type;
+            EqualizerBand band{EqualizerFilterType::Peaking, 1000.0, 0.0, 1.41};
+            if (value >> type >> band.frequency >> band.gain >> band.q) {
+                band.type = filterTypeFromName(type);
+                presets.back().bands.push_back(band);
+            }
+        }
+    }
+
+    // Drop anything that didn't parse into a usable curve
+    presets.erase(std::remove_if(presets.begin(), presets.end(),
+                                 [](const EqualizerPreset& p) { return p.name.empty() || p.bands.empty(); }),
+                  presets.end());
+    return presets;
+}
+
+bool EqualizerPresetStore::saveUserPreset(const EqualizerPreset& preset) const {
+    std::vector<EqualizerPreset> presets = loadUserPresets();
+    auto it = std::find_if(presets.begin(), presets.end(),
+                           [&](const EqualizerPreset& p) { return p.name == preset.name; });
+    if (it != presets.end()) {
+        *it = preset;
+    } else {
+        presets.push_back(preset);
+    }
+    return writeAll(presets, loadActivePresetName());
+}
+
+bool EqualizerPresetStore::removeUserPreset(const std::string& name) const {
+    std::vector<EqualizerPreset> presets = loadUserPresets();
+    presets.erase(std::remove_if(presets.begin(), presets.end(),
+                                 [&](const EqualizerPreset& p) { return p.name == name; }),
+                  presets.end());
+    return writeAll(presets, loadActivePresetName());
+}
+
+std::string EqualizerPresetStore::loadActivePresetName() const {
+    if (configPath.empty()) return "";
+
+    std::ifstream file(configPath);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("active=", 0) == 0) {
+            return line.substr(7);
+        }
+        if (!line.empty() && line[0] == '[') break;
+    }
+    return "";
+}
+
+void EqualizerPresetStore::saveActivePresetName(const std::string& name) const {
+    writeAll(loadUserPresets(), name);
+}
+
+bool EqualizerPresetStore::writeAll(const std::vector<EqualizerPreset>& presets, const std::string& active) const {
+    if (configPath.empty()) return false;
+
+    std::ofstream file(configPath, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write equalizer presets to " << configPath << std::endl;
+        return false;
+    }
+
+    file << "# ElysiaOS equalizer presets\n";
+    if (!active.empty()) {
+        file << "active=" << active << "\n";
+    }
+    for (const auto& preset : presets) {
+        file << "\n[" << preset.name << "]\n";
+        file << "preamp=" << preset.preamp << "\n";
+        for (const auto& band : preset.bands) {
+            file << "band=" << filterTypeName(band.type) << " " << band.frequency << " "
+                 << band.gain << " " << band.q << "\n";
+        }
+    }
+    return true;
+}
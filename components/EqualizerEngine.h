@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Pure DSP core for the Sound page equalizer. Nothing in here depends on GTK
+// or the audio server, so it can be driven offline with synthetic buffers.
+
+enum class EqualizerFilterType {
+    Peaking,
+    LowShelf,
+    HighShelf
+};
+
+struct EqualizerBand {
+    EqualizerFilterType type;
+    double frequency; // Hz
+    double gain;      // dB
+    double q;
+};
+
+struct EqualizerPreset {
+    std::string name;
+    double preamp; // dB
+    std::vector<EqualizerBand> bands;
+};
+
+struct BiquadCoefficients {
+    double b0, b1, b2, a1, a2; // normalised so that a0 == 1
+};
+
+// RBJ "Audio EQ Cookbook" designs
+BiquadCoefficients designBiquad(const EqualizerBand& band, double sampleRate);
+
+// Magnitude response of a single section, in dB, at the given frequency
+double biquadMagnitudeDb(const BiquadCoefficients& coeffs, double frequency, double sampleRate);
+
+class EqualizerEngine {
+public:
+    static constexpr int MAX_CHANNELS = 8;
+    static constexpr int MAX_BANDS = 16;
+
+    EqualizerEngine(int channels, double sampleRate);
+
+    void setBands(const std::vector<EqualizerBand>& bands);
+    void setPreamp(double gainDb);
+    void reset();
+
+    // Processes interleaved float samples in place. The cascade runs as a
+    // wavefront: every band of every channel is one SIMD lane, and lane b
+    // works on the sample that left lane b-1 on the previous frame. That keeps
+    // all lanes busy at the cost of latencyFrames() samples of delay.
+    void process(float* interleaved, size_t frames);
+
+    // Unvectorised direct cascade with identical arithmetic and no delay.
+    // Used as the reference when validating process() offline.
+    void processReference(float* interleaved, size_t frames);
+
+    int latencyFrames() const { return laneStride - 1; }
+    int channelCount() const { return channels; }
+    double getSampleRate() const { return sampleRate; }
+
+    // Combined response of all bands plus preamp, for drawing the curve
+    double magnitudeDb(double frequency) const;
+
+    static std::vector<EqualizerBand> defaultBands();
+    static std::vector<EqualizerPreset> builtinPresets();
+
+private:
+    static constexpr int MAX_LANES = MAX_CHANNELS * MAX_BANDS;
+
+    int channels;
+    double sampleRate;
+    int bandCount;
+    int laneStride; // bands per channel rounded up to the vector width
+    int laneCount;
+    float preampGain;
+    std::vector<BiquadCoefficients> designed;
+
+    // Structure-of-arrays lane state; unused lanes are identity sections
+    alignas(16) float b0[MAX_LANES];
+    alignas(16) float b1[MAX_LANES];
+    alignas(16) float b2[MAX_LANES];
+    alignas(16) float a1[MAX_LANES];
+    alignas(16) float a2[MAX_LANES];
+    alignas(16) float x1[MAX_LANES];
+    alignas(16) float x2[MAX_LANES];
+    alignas(16) float y1[MAX_LANES];
+    alignas(16) float y2[MAX_LANES];
+    // Lane inputs; one spare slot so outputs can be stored shifted by a lane
+    alignas(16) float stage[MAX_LANES + 4];
+
+    // Per-band state for processReference()
+    float refX1[MAX_LANES], refX2[MAX_LANES], refY1[MAX_LANES], refY2[MAX_LANES];
+};
+
+// Presets live in ~/.config/Elysia/equalizer.conf as simple INI-style blocks
+class EqualizerPresetStore {
+public:
+    EqualizerPresetStore();
+
+    std::vector<EqualizerPreset> loadUserPresets() const;
+    bool saveUserPreset(const EqualizerPreset& preset) const;
+    bool removeUserPreset(const std::string& name) const;
+
+    std::string loadActivePresetName() const;
+    void saveActivePresetName(const std::string& name) const;
+
+private:
+    std::string configPath;
+
+    bool writeAll(const std::vector<EqualizerPreset>& presets, const std::string& active) const;
+};
@@ -0,0 +1,265 @@
+#include "EqualizerSink.h"
+#include <pulse/simple.h>
+#include <pulse/error.h>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+EqualizerSink::EqualizerSink()
+    : running(false), streaming(false), paramsDirty(false), failed(false), moduleIndex(-1),
+      pendingPreset{"Flat", 0.0, EqualizerEngine::defaultBands()},
+      engine(CHANNELS, SAMPLE_RATE) {
+    engine.setBands(pendingPreset.bands);
+}
+
+EqualizerSink::~EqualizerSink() {
+    stop();
+}
+
+bool EqualizerSink::start(const std::string& master) {
+    if (running.load()) return true;
+
+    std::string previous = executeCommand("pactl get-default-sink");
+    if (!previous.empty() && previous.back() == '\n') {
+        previous.pop_back();
+    }
+
+    // A previous session that didn't shut down cleanly may have left its sink behind
+    std::istringstream modules(executeCommand("pactl list short modules"));
+    std::string line;
+    while (std::getline(modules, line)) {
+        if (line.find(std::string("sink_name=") + SINK_NAME) != std::string::npos) {
+            executeCommand("pactl unload-module " + line.substr(0, line.find('\t')));
+        }
+    }
+
+    std::string command = std::string("pactl load-module module-null-sink sink_name=") + SINK_NAME +
+                          " rate=" + std::to_string(SAMPLE_RATE) +
+                          " channels=" + std::to_string(CHANNELS) +
+                          " sink_properties=device.description=Elysia-Equalizer";
+    std::string result = executeCommand(command);
+
+    int index = -1;
+    std::istringstream(result) >> index;
+    if (index < 0) {
+        std::cerr << "Failed to load equalizer sink module" << std::endl;
+        return false;
+    }
+
+    std::string target = master;
+    if (target.empty() || target == SINK_NAME) {
+        target = previous;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        moduleIndex = index;
+        masterSink = target;
+        previousDefaultSink = (previous == SINK_NAME) ? target : previous;
+    }
+
+    if (!startWorker(target)) {
+        executeCommand("pactl unload-module " + std::to_string(index));
+        std::lock_guard<std::mutex> lock(stateMutex);
+        moduleIndex = -1;
+        return false;
+    }
+    running = true;
+    executeCommand(std::string("pactl set-default-sink ") + SINK_NAME);
+
+    std::cout << "Equalizer active in front of sink: " << target << std::endl;
+    return true;
+}
+
+void EqualizerSink::stop() {
+    if (!running.exchange(false)) return;
+
+    stopWorker();
+    failed = false;
+
+    std::string restore;
+    int index;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        restore = masterSink.empty() ? previousDefaultSink : masterSink;
+        index = moduleIndex;
+        moduleIndex = -1;
+    }
+
+    if (!restore.empty()) {
+        executeCommand("pactl set-default-sink " + restore);
+    }
+    if (index >= 0) {
+        executeCommand("pactl unload-module " + std::to_string(index));
+    }
+
+    std::cout << "Equalizer removed, default sink restored to: " << restore << std::endl;
+}
+
+void EqualizerSink::setMasterSink(const std::string& master) {
+    if (master.empty() || master == SINK_NAME) return;
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (master == masterSink) return;
+        masterSink = master;
+    }
+
+    if (running.load()) {
+        stopWorker();
+        if (!startWorker(master)) {
+            // Without an output stream the null sink would just swallow audio
+            stop();
+        }
+    }
+}
+
+std::string EqualizerSink::getMasterSink() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return masterSink;
+}
+
+void EqualizerSink::setPreset(const EqualizerPreset& preset) {
+    std::lock_guard<std::mutex> lock(paramsMutex);
+    pendingPreset = preset;
+    paramsDirty = true;
+}
+
+bool EqualizerSink::startWorker(const std::string& master) {
+    // Streams are opened here rather than on the worker so failures reach the caller
+    pa_simple* capture = nullptr;
+    pa_simple* playback = nullptr;
+    if (!openStreams(master, capture, playback)) return false;
+
+    streaming = true;
+    failed = false;
+    paramsDirty = true;
+    worker = std::thread(&EqualizerSink::streamLoop, this, capture, playback);
+    return true;
+}
+
+bool EqualizerSink::openStreams(const std::string& master, pa_simple*& capture, pa_simple*& playback) {
+    const size_t blockBytes = BLOCK_FRAMES * CHANNELS * sizeof(float);
+
+    pa_sample_spec spec;
+    spec.format = PA_SAMPLE_FLOAT32LE;
+    spec.rate = SAMPLE_RATE;
+    spec.channels = CHANNELS;
+
+    pa_buffer_attr attr;
+    attr.maxlength = static_cast<uint32_t>(-1);
+    attr.tlength = static_cast<uint32_t>(blockBytes * 4);
+    attr.prebuf = static_cast<uint32_t>(-1);
+    attr.minreq = static_cast<uint32_t>(-1);
+    attr.fragsize = static_cast<uint32_t>(blockBytes);
+
+    int error = 0;
+    std::string monitor = std::string(SINK_NAME) + ".monitor";
+    capture = pa_simple_new(nullptr, CLIENT_NAME, PA_STREAM_RECORD, monitor.c_str(),
+                            "Equalizer input", &spec, nullptr, &attr, &error);
+    if (!capture) {
+        std::cerr << "Equalizer capture failed: " << pa_strerror(error) << std::endl;
+        return false;
+    }
+
+    playback = pa_simple_new(nullptr, CLIENT_NAME, PA_STREAM_PLAYBACK, master.c_str(),
+                             "Equalizer output", &spec, nullptr, &attr, &error);
+    if (!playback) {
+        std::cerr << "Equalizer playback failed: " << pa_strerror(error) << std::endl;
+        pa_simple_free(capture);
+        capture = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void EqualizerSink::stopWorker() {
+    streaming = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void EqualizerSink::streamLoop(pa_simple* capture, pa_simple* playback) {
+#if defined(__SSE__)
+    // Decaying filter tails would otherwise drop into denormals on silence
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+#endif
+
+    const size_t blockBytes = BLOCK_FRAMES * CHANNELS * sizeof(float);
+    int error = 0;
+
+    engine.reset();
+    std::vector<float> block(BLOCK_FRAMES * CHANNELS);
+
+    int retries = 0;
+    while (streaming.load()) {
+        // Never wait on the UI thread here; retry on the next block instead
+        if (paramsDirty.load() && paramsMutex.try_lock()) {
+            engine.setBands(pendingPreset.bands);
+            engine.setPreamp(pendingPreset.preamp);
+            paramsDirty = false;
+            paramsMutex.unlock();
+        }
+
+        bool ok = pa_simple_read(capture, block.data(), blockBytes, &error) >= 0;
+        if (!ok) {
+            std::cerr << "Equalizer read failed: " << pa_strerror(error) << std::endl;
+        } else {
+            engine.process(block.data(), BLOCK_FRAMES);
+            ok = pa_simple_write(playback, block.data(), blockBytes, &error) >= 0;
+            if (!ok) std::cerr << "Equalizer write failed: " << pa_strerror(error) << std::endl;
+        }
+        if (ok) {
+            retries = 0;
+            continue;
+        }
+
+        // The server restarted or the device went away; reopen with backoff,
+        // then give up and leave the owner to put the default sink back
+        pa_simple_free(playback);
+        pa_simple_free(capture);
+        capture = nullptr;
+        playback = nullptr;
+        while (!capture && streaming.load() && retries < STREAM_RETRIES) {
+            auto wake = std::chrono::steady_clock::now() + std::chrono::milliseconds(STREAM_RETRY_MS << retries);
+            while (streaming.load() && std::chrono::steady_clock::now() < wake) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            retries++;
+            if (streaming.load() && openStreams(getMasterSink(), capture, playback)) {
+                engine.reset();
+                std::cout << "Equalizer streams reopened" << std::endl;
+            }
+        }
+        if (!capture) {
+            if (streaming.load()) {
+                std::cerr << "Equalizer streams lost, giving up" << std::endl;
+                failed = true;
+            }
+            break;
+        }
+    }
+
+    if (playback) pa_simple_free(playback);
+    if (capture) pa_simple_free(capture);
+}
+
+std::string EqualizerSink::executeCommand(const std::string& command) {
+    std::array<char, 128> buffer;
+    std::string result;
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        return "";
+    }
+    while (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
+        result += buffer.data();
+    }
+    pclose(pipe);
+    return result;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "EqualizerEngine.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct pa_simple;
+
+// Routes the default sink through EqualizerEngine. A null sink is loaded as
+// the new default, its monitor is read on a worker thread, filtered, and
+// played into the real (master) sink picked in the Sound page.
+class EqualizerSink {
+public:
+    static constexpr const char* SINK_NAME = "elysia_equalizer";
+    static constexpr const char* CLIENT_NAME = "ElysiaSettings Equalizer";
+    static constexpr int SAMPLE_RATE = 48000;
+    static constexpr int CHANNELS = 2;
+    static constexpr int BLOCK_FRAMES = 256;
+    static constexpr int STREAM_RETRIES = 3;       // reopen attempts after a stream error
+    static constexpr int STREAM_RETRY_MS = 250;    // doubled after each failed attempt
+
+    EqualizerSink();
+    ~EqualizerSink();
+
+    bool start(const std::string& masterSink);
+    void stop();
+    bool isActive() const { return running.load(); }
+    // The streams broke and could not be reopened; audio is going nowhere
+    // until the owner calls stop(), which restores the default sink
+    bool hasFailed() const { return failed.load(); }
+
+    // Re-targets the output stream when the user picks another device
+    void setMasterSink(const std::string& masterSink);
+    std::string getMasterSink() const;
+
+    // Safe to call from the UI thread; picked up at the next block boundary
+    void setPreset(const EqualizerPreset& preset);
+
+private:
+    std::atomic<bool> running;   // equalizer routing is in place
+    std::atomic<bool> streaming; // worker thread should keep pumping audio
+    std::atomic<bool> paramsDirty;
+    std::atomic<bool> failed;    // worker gave up on the streams
+    std::thread worker;
+
+    mutable std::mutex stateMutex;
+    std::string masterSink;
+    std::string previousDefaultSink;
+    int moduleIndex;
+
+    std::mutex paramsMutex;
+    EqualizerPreset pendingPreset;
+
+    EqualizerEngine engine;
+
+    void streamLoop(pa_simple* capture, pa_simple* playback);
+    bool openStreams(const std::string& master, pa_simple*& capture, pa_simple*& playback);
+    bool startWorker(const std::string& master);
+    void stopWorker();
+    std::string executeCommand(const std::string& command);
+};
@@ -0,0 +1,258 @@
+#include "MountTable.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/statvfs.h>
+#include <sys/sysmacros.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+
+// Filesystems that live on a local block device. Looked up through a
+// perfect hash built at compile time; adding a name that collides fails the
+// build instead of slowing the lookup down.
+static constexpr const char* DRIVE_FILESYSTEMS[] = {
+    "ext4", "ext3", "ext2", "btrfs", "xfs", "f2fs",
+    "vfat", "exfat", "ntfs", "ntfs3", "fuseblk"
+};
+static constexpr size_t FILESYSTEM_SLOTS = 16;
+
+static constexpr size_t constLength(const char* text) {
+    size_t length = 0;
+    while (text[length]) ++length;
+    return length;
+}
+
+static constexpr size_t filesystemHash(const char* name, size_t length) {
+    return (static_cast<unsigned char>(name[0]) * 15u +
+            static_cast<unsigned char>(name[length - 1]) * 10u + length) % FILESYSTEM_SLOTS;
+}
+
+struct FilesystemTable {
+    const char* slots[FILESYSTEM_SLOTS];
+    bool perfect;
+};
+
+static constexpr FilesystemTable buildFilesystemTable() {
+    FilesystemTable table = {};
+    table.perfect = true;
+    for (const char* name : DRIVE_FILESYSTEMS) {
+        size_t slot = filesystemHash(name, constLength(name));
+        if (table.slots[slot]) table.perfect = false;
+        table.slots[slot] = name;
+    }
+    return table;
+}
+
+static constexpr FilesystemTable FILESYSTEM_TABLE = buildFilesystemTable();
+static_assert(FILESYSTEM_TABLE.perfect, "drive filesystem names collide; pick other hash multipliers");
+
+// mountinfo escapes space, tab, newline and backslash as \ooo
+static std::string unescape(const char* text, size_t length) {
+    std::string result;
+    result.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        if (text[i] == '\\' && i + 3 < length &&
+            text[i + 1] >= '0' && text[i + 1] <= '3' &&
+            text[i + 2] >= '0' && text[i + 2] <= '7' &&
+            text[i + 3] >= '0' && text[i + 3] <= '7') {
+            result += static_cast<char>((text[i + 1] - '0') * 64 + (text[i + 2] - '0') * 8 + (text[i + 3] - '0'));
+            i += 3;
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+struct MountTable::Shared {
+    std::mutex mutex;
+    std::unordered_set<std::string> busy;  // mountpoints whose statvfs has not returned
+};
+
+namespace {
+
+struct StatJob {
+    std::string path;
+    bool finished = false;
+    bool ok = false;
+    struct statvfs result;
+};
+
+struct StatBatch {
+    std::vector<StatJob> jobs;
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t remaining = 0;
+};
+
+}
+
+MountTable::MountTable() : watchFd(-1), shared(std::make_shared<Shared>()) {
+}
+
+MountTable::~MountTable() {
+    unwatch();
+}
+
+std::string MountTable::mountInfoPath() {
+    const char* path = getenv("ELYSIA_MOUNTINFO");
+    return (path && *path) ? path : "/proc/self/mountinfo";
+}
+
+bool MountTable::isDriveFilesystem(const char* fstype, size_t length) {
+    if (length == 0) return false;
+    const char* candidate = FILESYSTEM_TABLE.slots[filesystemHash(fstype, length)];
+    return candidate && strlen(candidate) == length && memcmp(candidate, fstype, length) == 0;
+}
+
+void MountTable::parse(const std::string& text, std::vector<MountEntry>& mounts) {
+    mounts.clear();
+
+    // 36 35 98:0 /root /mnt rw,noatime master:1 - ext4 /dev/sda1 rw,errors=continue
+    const char* cursor = text.data();
+    const char* end = cursor + text.size();
+    while (cursor < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor));
+        if (!lineEnd) lineEnd = end;
+
+        const size_t MAX_FIELDS = 32;
+        const char* fields[MAX_FIELDS];
+        size_t lengths[MAX_FIELDS];
+        size_t count = 0;
+        for (const char* p = cursor; p < lineEnd && count < MAX_FIELDS;) {
+            while (p < lineEnd && *p == ' ') ++p;
+            if (p == lineEnd) break;
+            fields[count] = p;
+            while (p < lineEnd && *p != ' ') ++p;
+            lengths[count] = p - fields[count];
+            ++count;
+        }
+        cursor = lineEnd + 1;
+
+        // A variable number of optional fields ends at a lone "-"
+        size_t separator = 6;
+        while (separator < count && !(lengths[separator] == 1 && fields[separator][0] == '-')) ++separator;
+        if (separator + 2 >= count) continue;
+
+        const char* fstype = fields[separator + 1];
+        size_t fstypeLength = lengths[separator + 1];
+        if (!isDriveFilesystem(fstype, fstypeLength)) continue;
+
+        MountEntry mount;
+        mount.mountId = atoi(fields[0]);
+        char* minor = nullptr;
+        unsigned long major = strtoul(fields[2], &minor, 10);
+        if (minor && *minor == ':') {
+            mount.deviceId = makedev(major, strtoul(minor + 1, nullptr, 10));
+        }
+        mount.mountpoint = unescape(fields[4], lengths[4]);
+        mount.fstype.assign(fstype, fstypeLength);
+        mount.device = unescape(fields[separator + 2], lengths[separator + 2]);
+        mounts.push_back(std::move(mount));
+    }
+}
+
+bool MountTable::read(std::vector<MountEntry>& mounts) const {
+    int fd = open(mountInfoPath().c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    // The kernel hands the table out in page-sized pieces; read it whole
+    std::string text;
+    char buffer[16384];
+    ssize_t length;
+    while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        text.append(buffer, length);
+    }
+    close(fd);
+    if (length < 0) return false;
+
+    parse(text, mounts);
+    return true;
+}
+
+void MountTable::measure(std::vector<MountEntry>& mounts, int timeoutMs) {
+    auto batch = std::make_shared<StatBatch>();
+
+    std::vector<size_t> jobIndex(mounts.size(), SIZE_MAX);
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        for (size_t i = 0; i < mounts.size(); ++i) {
+            mounts[i].measured = false;
+            // An overmounted path is listed twice; one call answers both
+            auto same = std::find_if(batch->jobs.begin(), batch->jobs.end(),
+                                     [&](const StatJob& job) { return job.path == mounts[i].mountpoint; });
+            if (same != batch->jobs.end()) {
+                jobIndex[i] = same - batch->jobs.begin();
+                continue;
+            }
+            // Still stuck from an earlier call: do not pile another thread on it
+            if (!shared->busy.insert(mounts[i].mountpoint).second) continue;
+
+            jobIndex[i] = batch->jobs.size();
+            batch->jobs.push_back(StatJob{mounts[i].mountpoint, false, false, {}});
+        }
+    }
+    if (batch->jobs.empty()) return;
+    batch->remaining = batch->jobs.size();
+
+    // Threads hold their own references; a stuck one may outlive the table
+    std::shared_ptr<Shared> state = shared;
+    size_t threads = std::min(batch->jobs.size(), MAX_THREADS);
+    for (size_t t = 0; t < threads; ++t) {
+        std::thread([batch, state]() {
+            for (;;) {
+                size_t i = batch->next.fetch_add(1);
+                if (i >= batch->jobs.size()) break;
+
+                StatJob& job = batch->jobs[i];
+                struct statvfs result;
+                bool ok = statvfs(job.path.c_str(), &result) == 0;
+                {
+                    std::lock_guard<std::mutex> lock(batch->mutex);
+                    job.result = result;
+                    job.ok = ok;
+                    job.finished = true;
+                    batch->remaining--;
+                }
+                batch->finished.notify_all();
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->busy.erase(job.path);
+            }
+        }).detach();
+    }
+
+    std::unique_lock<std::mutex> lock(batch->mutex);
+    batch->finished.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                             [&]() { return batch->remaining == 0; });
+
+    for (size_t i = 0; i < mounts.size(); ++i) {
+        if (jobIndex[i] == SIZE_MAX) continue;
+        const StatJob& job = batch->jobs[jobIndex[i]];
+        if (!job.finished || !job.ok) continue;
+
+        uint64_t unit = job.result.f_frsize ? job.result.f_frsize : job.result.f_bsize;
+        mounts[i].measured = true;
+        mounts[i].total = job.result.f_blocks * unit;
+        mounts[i].used = (job.result.f_blocks - job.result.f_bfree) * unit;
+        mounts[i].free = job.result.f_bavail * unit;
+    }
+}
+
+bool MountTable::watch() {
+    if (watchFd >= 0) return true;
+    watchFd = open(mountInfoPath().c_str(), O_RDONLY | O_CLOEXEC);
+    return watchFd >= 0;
+}
+
+void MountTable::unwatch() {
+    if (watchFd >= 0) close(watchFd);
+    watchFd = -1;
+}
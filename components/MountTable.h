@@ -0,0 +1,73 @@
+#ifndef MOUNTTABLE_H
+#define MOUNTTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct MountEntry {
+    int mountId = 0;         // unique while mounted; a remount keeps it
+    uint64_t deviceId = 0;   // st_dev of the filesystem, from major:minor
+    std::string device;      // mount source, e.g. /dev/nvme0n1p2
+    std::string mountpoint;
+    std::string fstype;
+
+    // Filled by measure(); false if statvfs failed or did not answer in time
+    bool measured = false;
+    uint64_t total = 0;
+    uint64_t used = 0;
+    uint64_t free = 0;       // available to unprivileged users, like df's Avail
+};
+
+// Local drives as listed in /proc/self/mountinfo, sized with statvfs. The
+// table is read with a few read() calls and parsed in place; only mounts
+// whose filesystem is in a small perfect-hash set of disk filesystems are
+// kept, so pseudo and network filesystems cost one lookup each.
+//
+// statvfs on a dead network or FUSE mount can block for minutes, so
+// measure() runs the calls on short-lived threads and stops waiting after
+// the timeout. A mount whose call is still stuck is not asked again until
+// that call returns, which keeps the number of blocked threads bounded by
+// the number of bad mounts.
+//
+// The kernel flags an open mountinfo with POLLPRI (and POLLERR) whenever the
+// mount namespace changes; it always reports POLLIN, so only PRI is worth
+// watching. watch() keeps such a descriptor open for the owner to poll, and
+// each poll that reports the change also clears it.
+//
+// ELYSIA_MOUNTINFO names another file to read in place of
+// /proc/self/mountinfo.
+class MountTable {
+public:
+    static constexpr int STATVFS_TIMEOUT_MS = 500;
+    static constexpr size_t MAX_THREADS = 8;
+
+    MountTable();
+    ~MountTable();
+
+    MountTable(const MountTable&) = delete;
+    MountTable& operator=(const MountTable&) = delete;
+
+    static std::string mountInfoPath();
+    static bool isDriveFilesystem(const char* fstype, size_t length);
+
+    // Parses mountinfo text, keeping drive filesystems only
+    static void parse(const std::string& text, std::vector<MountEntry>& mounts);
+
+    bool read(std::vector<MountEntry>& mounts) const;
+    void measure(std::vector<MountEntry>& mounts, int timeoutMs = STATVFS_TIMEOUT_MS);
+
+    // Opens the descriptor that signals mount changes; eventFd() is -1 until then
+    bool watch();
+    void unwatch();
+    int eventFd() const { return watchFd; }
+
+private:
+    int watchFd;
+    struct Shared;
+    std::shared_ptr<Shared> shared;  // outlives the table while calls are stuck
+};
+
+#endif // MOUNTTABLE_H
@@ -1,6 +1,7 @@
 #include "NetworkManager.h"
 #include "../MainWindow.h"
 #include "../translations/translations.h"
+#include "PowerSupply.h"
 #include <iostream>
 #include <glib.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
@@ -14,21 +15,35 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <glib-unix.h>
 
 // Forward declaration of callback data
 struct NetworkBackButtonCallbackData {
     NetworkManager* networkManager;
 };
 
-struct ConnectButtonData {
+// Widgets of one recycled Wi-Fi row, filled in again on every bind
+struct WifiRowWidgets {
     NetworkManager* networkManager;
-    std::string ssid;
-    NMAccessPoint* ap;
-    bool isSecured;
+    GtkListItem* listItem;
+    GtkWidget* rowBox;
+    GtkWidget* signalIcon;
+    GtkWidget* nameLabel;
+    GtkWidget* statusLabel;
+    GtkWidget* sparkline;
+    GtkWidget* lockIcon;
+    GtkWidget* settingsButton;
+    GtkWidget* connectButton;
+    ElysiaWifiItem* boundItem;
+    gulong changedHandler;
 };
 
+// Processes listed in the usage panel; the rest are still sampled but not shown
+static const size_t APP_USAGE_ROWS = 8;
+
 struct PasswordDialogData {
     NetworkManager* networkManager;
     NMDeviceWifi* wifiDev;
@@ -38,18 +53,38 @@ struct PasswordDialogData {
     GtkWidget* dialog;
 };
 
-struct NetworkSettingsData {
+// An add/activate call in flight. A user cancel abandons it rather than
+// cancelling it, so the reply still arrives and the connection NetworkManager
+// has already started can be taken down again; an abandoned request no
+// longer refers to the page, which may be gone by then.
+struct ActivationRequest {
     NetworkManager* networkManager;
-    std::string ssid;
-    NMActiveConnection* activeConnection;
+    NMClient* client;
+    bool abandoned;
 };
 
 NetworkManager::NetworkManager(MainWindow* mainWindow, GtkWidget* parentWindow, GtkWidget* overlay) 
     : mainWindow(mainWindow), parentWindow(parentWindow), overlay(overlay), 
       networkContainer(nullptr), backButton(nullptr), wifiSwitch(nullptr), 
-      wifiListBox(nullptr), refreshButton(nullptr), scrolledWindow(nullptr),
-      connectionStatusLabel(nullptr), nmClient(nullptr), updatingWifiSwitch(false), 
-      networkingEnabled(false), hasEthernetConnection(false), updateTimeoutId(0) {
+      wifiListBox(nullptr), wifiListView(nullptr), wifiStack(nullptr), refreshButton(nullptr), lastScanLabel(nullptr),
+      diagnosticsButton(nullptr), savedNetworksButton(nullptr),
+      scrolledWindow(nullptr), connectionStatusLabel(nullptr), throughputArea(nullptr),
+      activationBox(nullptr), activationLabel(nullptr), activationProgress(nullptr),
+      activationCancelButton(nullptr), nmClient(nullptr),
+      nmClientCancellable(nullptr), nmClientSignalsConnected(false), updatingWifiSwitch(false), 
+      networkingEnabled(false), hasEthernetConnection(false), wifiHardwareEnabled(false),
+      wifiSoftwareEnabled(false), updateTimeoutId(0), throughputTimeoutId(0),
+      throughputIntervalMs(ThroughputMonitor::FAST_INTERVAL_MS), activationStage(ActivationStage::Idle),
+      activationStartTime(0), activationCancellable(nullptr), activationRequest(nullptr), activationConnection(nullptr),
+      activationDevice(nullptr), activationHideTimeoutId(0), scanCancellable(nullptr),
+      scanRequestedAt(0), scanLabelTimeoutId(0), onBatteryPower(false), diagnosticsWindow(nullptr),
+      diagnosticsHostEntry(nullptr), diagnosticsSamplesSpin(nullptr), diagnosticsRunButton(nullptr),
+      diagnosticsGrid(nullptr), diagnosticsWatchId(0), diagnosticsCancellable(nullptr), diagnosticsRows(0),
+      appUsageBox(nullptr), appUsageEmptyLabel(nullptr), processBandwidthWatchId(0), savedWindow(nullptr),
+      savedSearchEntry(nullptr), savedStatusLabel(nullptr), savedProgress(nullptr), savedForgetButton(nullptr),
+      savedAutoOnButton(nullptr), savedAutoOffButton(nullptr), savedStore(nullptr), savedFilter(nullptr),
+      savedSelection(nullptr), bulkNext(0), bulkInFlight(0), bulkDone(0), bulkFailed(0), bulkForget(false),
+      bulkAutoconnect(false), bulkCancellable(nullptr) {
     setupUI();
 }
 
@@ -59,12 +94,66 @@ NetworkManager::~NetworkManager() {
         g_source_remove(updateTimeoutId);
         updateTimeoutId = 0;
     }
+    stopThroughputSampling();
+    if (activationHideTimeoutId > 0) {
+        g_source_remove(activationHideTimeoutId);
+        activationHideTimeoutId = 0;
+    }
+    endActivation();
+    stopLastScanLabelUpdates();
+    if (scanCancellable) {
+        g_cancellable_cancel(scanCancellable);
+        g_clear_object(&scanCancellable);
+    }
+    stopDiagnostics();
+    stopAppUsageSampling();
+    if (diagnosticsWindow) {
+        gtk_window_destroy(GTK_WINDOW(diagnosticsWindow));
+        diagnosticsWindow = nullptr;
+    }
+    
+    // Outstanding bulk calls finish without us
+    if (bulkCancellable) {
+        g_cancellable_cancel(bulkCancellable);
+        g_clear_object(&bulkCancellable);
+    }
+    for (NMRemoteConnection* connection : bulkQueue) {
+        g_object_unref(connection);
+    }
+    bulkQueue.clear();
+    if (savedWindow) {
+        gtk_window_destroy(GTK_WINDOW(savedWindow));
+        savedWindow = nullptr;
+    }
+    g_clear_object(&savedSelection);
+    savedFilter = nullptr;
+    g_clear_object(&savedStore);
     
     // Clear widget tracking
     networkWidgets.clear();
     
+    // Abort a client initialisation that is still in flight
+    if (nmClientCancellable) {
+        g_cancellable_cancel(nmClientCancellable);
+        g_object_unref(nmClientCancellable);
+        nmClientCancellable = nullptr;
+    }
+    
+    // Drop access point references before the client goes away
+    if (wifiModel) {
+        g_signal_handlers_disconnect_by_data(wifiModel->getModel(), this);
+        wifiModel->detach();
+    }
+    
+    clearSavedConnectionIndex();
+    
     // Clean up NetworkManager client
     if (nmClient) {
+        NMDeviceWifi* wifi = getPrimaryWifiDevice();
+        if (wifi) {
+            g_signal_handlers_disconnect_by_data(wifi, this);
+        }
+        g_signal_handlers_disconnect_by_data(nmClient, this);
         g_object_unref(nmClient);
         nmClient = nullptr;
     }
@@ -79,8 +168,20 @@ void NetworkManager::show() {
         if (mainWindow) {
             mainWindow->switchToBackground("background4.png");
         }
+        
+        // Independent of NetworkManager; reads the kernel's socket table directly
+        startAppUsageSampling();
+        
+        if (!nmClient) {
+            // First visit: bring the client up without blocking the UI
+            initNetworkClient();
+            return;
+        }
+        
+        if (!nmClientSignalsConnected) {
+            setupNetworkManager();
+        }
         refreshNetworks();
-        updateConnectionStatus();
     }
 }
 
@@ -88,6 +189,11 @@ void NetworkManager::hide() {
     if (networkContainer) {
         gtk_widget_set_visible(networkContainer, FALSE);
     }
+    
+    // Nobody is looking at the graph, the scan age or the app list; show() picks them up again
+    stopThroughputSampling();
+    stopLastScanLabelUpdates();
+    stopAppUsageSampling();
 }
 
 void NetworkManager::setupUI() {
@@ -99,7 +205,6 @@ void NetworkManager::setupUI() {
         
         initNetworkUI();
         setupBackButton();
-        setupNetworkManager();
     }
 }
 
@@ -129,6 +234,39 @@ void NetworkManager::initNetworkUI() {
         gtk_fixed_put(GTK_FIXED(networkContainer), connectionStatusLabel, 600, 70);
     }
     
+    // Progress of a connection attempt, shown under the status line while it runs
+    activationBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+    if (activationBox) {
+        gtk_widget_set_size_request(activationBox, 480, 24);
+        
+        activationLabel = gtk_label_new("");
+        gtk_widget_add_css_class(activationLabel, "activation-label");
+        gtk_label_set_ellipsize(GTK_LABEL(activationLabel), PANGO_ELLIPSIZE_END);
+        gtk_widget_set_size_request(activationLabel, 240, -1);
+        gtk_label_set_xalign(GTK_LABEL(activationLabel), 1.0f);
+        gtk_box_append(GTK_BOX(activationBox), activationLabel);
+        
+        activationProgress = gtk_progress_bar_new();
+        gtk_widget_add_css_class(activationProgress, "activation-progress");
+        gtk_widget_set_valign(activationProgress, GTK_ALIGN_CENTER);
+        gtk_widget_set_hexpand(activationProgress, TRUE);
+        gtk_box_append(GTK_BOX(activationBox), activationProgress);
+        
+        activationCancelButton = gtk_button_new();
+        GtkWidget* cancelIcon = gtk_image_new_from_icon_name("process-stop-symbolic");
+        gtk_image_set_pixel_size(GTK_IMAGE(cancelIcon), 14);
+        gtk_button_set_child(GTK_BUTTON(activationCancelButton), cancelIcon);
+        gtk_widget_add_css_class(activationCancelButton, "refresh-button");
+        gtk_widget_add_css_class(activationCancelButton, "flat");
+        gtk_widget_add_css_class(activationCancelButton, "circular");
+        gtk_widget_set_tooltip_text(activationCancelButton, TR(TranslationKeys::CANCEL));
+        g_signal_connect(activationCancelButton, "clicked", G_CALLBACK(onActivationCancelClicked), this);
+        gtk_box_append(GTK_BOX(activationBox), activationCancelButton);
+        
+        gtk_widget_set_visible(activationBox, FALSE);
+        gtk_fixed_put(GTK_FIXED(networkContainer), activationBox, 560, 98);
+    }
+    
     // Add title label
     GtkWidget* titleLabel = gtk_label_new(TR(TranslationKeys::NETWORK_TITLE));
     if (titleLabel) {
@@ -176,6 +314,13 @@ void NetworkManager::initNetworkUI() {
         gtk_widget_set_hexpand(spacer, TRUE);
         gtk_box_append(GTK_BOX(wifiHeader), spacer);
         
+        // Age of the scan results the list is showing
+        lastScanLabel = gtk_label_new("");
+        if (lastScanLabel) {
+            gtk_widget_add_css_class(lastScanLabel, "last-scan-label");
+            gtk_box_append(GTK_BOX(wifiHeader), lastScanLabel);
+        }
+        
         // WiFi switch
         wifiSwitch = gtk_switch_new();
         if (wifiSwitch) {
@@ -199,24 +344,129 @@ void NetworkManager::initNetworkUI() {
             gtk_box_append(GTK_BOX(wifiHeader), refreshButton);
         }
         
+        // Diagnostics button
+        diagnosticsButton = gtk_button_new();
+        if (diagnosticsButton) {
+            GtkWidget* diagnosticsIcon = gtk_image_new_from_icon_name("utilities-system-monitor-symbolic");
+            gtk_image_set_pixel_size(GTK_IMAGE(diagnosticsIcon), 16);
+            gtk_button_set_child(GTK_BUTTON(diagnosticsButton), diagnosticsIcon);
+            gtk_widget_add_css_class(diagnosticsButton, "refresh-button");
+            gtk_widget_add_css_class(diagnosticsButton, "flat");
+            gtk_widget_add_css_class(diagnosticsButton, "circular");
+            gtk_widget_set_tooltip_text(diagnosticsButton, TR(TranslationKeys::DIAGNOSTICS_TITLE));
+            g_signal_connect(diagnosticsButton, "clicked", G_CALLBACK(onDiagnosticsButtonClicked), this);
+            gtk_box_append(GTK_BOX(wifiHeader), diagnosticsButton);
+        }
+        
+        // Saved networks button
+        savedNetworksButton = gtk_button_new();
+        if (savedNetworksButton) {
+            GtkWidget* savedIcon = gtk_image_new_from_icon_name("view-list-symbolic");
+            gtk_image_set_pixel_size(GTK_IMAGE(savedIcon), 16);
+            gtk_button_set_child(GTK_BUTTON(savedNetworksButton), savedIcon);
+            gtk_widget_add_css_class(savedNetworksButton, "refresh-button");
+            gtk_widget_add_css_class(savedNetworksButton, "flat");
+            gtk_widget_add_css_class(savedNetworksButton, "circular");
+            gtk_widget_set_tooltip_text(savedNetworksButton, TR(TranslationKeys::SAVED_NETWORKS));
+            g_signal_connect(savedNetworksButton, "clicked", G_CALLBACK(onSavedNetworksClicked), this);
+            gtk_box_append(GTK_BOX(wifiHeader), savedNetworksButton);
+        }
+        
         gtk_fixed_put(GTK_FIXED(networkContainer), wifiHeader, 500, 180);
     }
     
-    // Create scrollable container for networks
-    scrolledWindow = gtk_scrolled_window_new();
-    if (scrolledWindow) {
-        gtk_widget_set_size_request(scrolledWindow, 620, 420);
-        gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrolledWindow), 
-                                      GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    // Networks and status messages share the same spot; only one is shown at a time
+    wifiStack = gtk_stack_new();
+    if (wifiStack) {
+        gtk_widget_set_size_request(wifiStack, 620, 420);
         
-        // Create list box for networks
+        // List box for status messages
         wifiListBox = gtk_list_box_new();
         if (wifiListBox) {
             gtk_widget_add_css_class(wifiListBox, "wifi-list");
-            gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scrolledWindow), wifiListBox);
+            gtk_widget_set_valign(wifiListBox, GTK_ALIGN_START);
+            gtk_stack_add_named(GTK_STACK(wifiStack), wifiListBox, "messages");
+        }
+        
+        // Create scrollable container for networks
+        scrolledWindow = gtk_scrolled_window_new();
+        if (scrolledWindow) {
+            gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scrolledWindow), 
+                                          GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+            
+            // Rows are created once per visible slot and re-bound as the model changes
+            wifiModel = std::make_unique<WifiNetworkModel>([this](const std::string& ssid) {
+                auto saved = savedConnectionsBySsid.find(ssid);
+                return saved != savedConnectionsBySsid.end() && !saved->second.empty();
+            });
+            g_signal_connect(wifiModel->getModel(), "items-changed",
+                            G_CALLBACK(onWifiModelItemsChanged), this);
+            
+            GtkListItemFactory* factory = gtk_signal_list_item_factory_new();
+            g_signal_connect(factory, "setup", G_CALLBACK(onNetworkRowSetup), this);
+            g_signal_connect(factory, "bind", G_CALLBACK(onNetworkRowBind), this);
+            g_signal_connect(factory, "unbind", G_CALLBACK(onNetworkRowUnbind), this);
+            
+            GtkNoSelection* selection = gtk_no_selection_new(
+                G_LIST_MODEL(g_object_ref(wifiModel->getModel())));
+            wifiListView = gtk_list_view_new(GTK_SELECTION_MODEL(selection), factory);
+            gtk_widget_add_css_class(wifiListView, "wifi-list");
+            gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scrolledWindow), wifiListView);
+            
+            gtk_stack_add_named(GTK_STACK(wifiStack), scrolledWindow, "networks");
+        }
+        
+        gtk_stack_set_visible_child_name(GTK_STACK(wifiStack), "messages");
+        gtk_fixed_put(GTK_FIXED(networkContainer), wifiStack, 490, 240);
+    }
+    
+    // Throughput of the connected device; redrawn only when a sample lands
+    throughputArea = gtk_drawing_area_new();
+    if (throughputArea) {
+        gtk_widget_set_size_request(throughputArea, 620, 90);
+        gtk_widget_add_css_class(throughputArea, "throughput-graph");
+        gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(throughputArea), drawThroughputGraph, this, nullptr);
+        gtk_widget_set_visible(throughputArea, FALSE);
+        gtk_fixed_put(GTK_FIXED(networkContainer), throughputArea, 490, 672);
+    }
+    
+    // Per-application usage next to the network list
+    appUsageBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 6);
+    if (appUsageBox) {
+        gtk_widget_set_size_request(appUsageBox, 300, -1);
+        gtk_widget_add_css_class(appUsageBox, "app-usage");
+        
+        GtkWidget* appUsageTitle = gtk_label_new(TR(TranslationKeys::APP_USAGE_TITLE));
+        gtk_widget_add_css_class(appUsageTitle, "app-usage-title");
+        gtk_label_set_xalign(GTK_LABEL(appUsageTitle), 0.0f);
+        gtk_box_append(GTK_BOX(appUsageBox), appUsageTitle);
+        
+        appUsageEmptyLabel = gtk_label_new(TR(TranslationKeys::APP_USAGE_NONE));
+        gtk_widget_add_css_class(appUsageEmptyLabel, "app-usage-rate");
+        gtk_label_set_xalign(GTK_LABEL(appUsageEmptyLabel), 0.0f);
+        gtk_box_append(GTK_BOX(appUsageBox), appUsageEmptyLabel);
+        
+        // A fixed pool of rows; each tick only rewrites the ones whose text changed
+        appUsageRows.resize(APP_USAGE_ROWS);
+        for (AppUsageRow& usage : appUsageRows) {
+            usage.row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+            
+            usage.nameLabel = gtk_label_new("");
+            gtk_widget_add_css_class(usage.nameLabel, "app-usage-name");
+            gtk_label_set_xalign(GTK_LABEL(usage.nameLabel), 0.0f);
+            gtk_label_set_ellipsize(GTK_LABEL(usage.nameLabel), PANGO_ELLIPSIZE_END);
+            gtk_widget_set_hexpand(usage.nameLabel, TRUE);
+            gtk_box_append(GTK_BOX(usage.row), usage.nameLabel);
+            
+            usage.rateLabel = gtk_label_new("");
+            gtk_widget_add_css_class(usage.rateLabel, "app-usage-rate");
+            gtk_box_append(GTK_BOX(usage.row), usage.rateLabel);
+            
+            gtk_widget_set_visible(usage.row, FALSE);
+            gtk_box_append(GTK_BOX(appUsageBox), usage.row);
         }
         
-        gtk_fixed_put(GTK_FIXED(networkContainer), scrolledWindow, 490, 240);
+        gtk_fixed_put(GTK_FIXED(networkContainer), appUsageBox, 1140, 240);
     }
     
     // CSS for network page with light pink ElysiaOS aesthetic
@@ -258,6 +508,11 @@ void NetworkManager::initNetworkUI() {
             "  font-weight: 600; "
             "  text-shadow: 0 1px 0 rgba(255, 255, 255, 0.7); "
             "} "
+            ".last-scan-label { "
+            "  color: rgba(255, 255, 255, 0.8); "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 12px; "
+            "} "
             ".wifi-switch { "
             "  background: linear-gradient(145deg, rgba(255, 255, 255, 0.2), rgba(255, 255, 255, 0.1)); "
             "  border: 1px solid rgba(192, 192, 192, 0.6); "
@@ -352,6 +607,52 @@ void NetworkManager::initNetworkUI() {
             ".enable-networking-button:hover { "
             "  background: linear-gradient(62deg, #fd84cb 20%, #fed0f4 70%); "
             "} "
+            ".activation-label { "
+            "  color: white; "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 13px; "
+            "  text-shadow: 0 1px 0 rgba(255, 255, 255, 0.7); "
+            "} "
+            ".activation-label.failed { "
+            "  color: #f87171; "
+            "} "
+            ".activation-progress trough { "
+            "  background: rgba(255, 255, 255, 0.25); "
+            "  border-radius: 4px; "
+            "  min-height: 6px; "
+            "} "
+            ".activation-progress progress { "
+            "  background: linear-gradient(90deg, #e5a7c6 0%, #edcee3 100%); "
+            "  border-radius: 4px; "
+            "  min-height: 6px; "
+            "} "
+            ".app-usage { "
+            "  background: rgba(255, 255, 255, 0.15); "
+            "  border: 1px solid rgba(192, 192, 192, 0.4); "
+            "  border-radius: 12px; "
+            "  padding: 12px; "
+            "} "
+            ".app-usage-title { "
+            "  color: white; "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 15px; "
+            "  font-weight: 600; "
+            "  text-shadow: 0 1px 0 rgba(255, 255, 255, 0.7); "
+            "} "
+            ".app-usage-name { "
+            "  color: white; "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 13px; "
+            "} "
+            ".app-usage-rate { "
+            "  color: rgba(255, 255, 255, 0.85); "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 12px; "
+            "} "
+            ".throughput-graph { "
+            "  font-family: ElysiaOSNew12; "
+            "  font-size: 12px; "
+            "} "
             ".message-label { "
             "  color: white; "
             "  font-family: ElysiaOSNew12; "
@@ -478,77 +779,177 @@ void NetworkManager::setupBackButton() {
     }
 }
 
+void NetworkManager::initNetworkClient() {
+    if (nmClient || nmClientCancellable) return;
+    
+    showNetworkLoadingState();
+    
+    nmClientCancellable = g_cancellable_new();
+    nm_client_new_async(nmClientCancellable, onNetworkClientReady, this);
+}
+
+void NetworkManager::onNetworkClientReady(GObject* source, GAsyncResult* result, gpointer user_data) {
+    (void)source;
+    
+    GError* error = nullptr;
+    NMClient* client = nm_client_new_finish(result, &error);
+    
+    // On cancellation the NetworkManager object is already gone
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    g_clear_object(&netMgr->nmClientCancellable);
+    
+    if (!client) {
+        std::cout << "Failed to initialize NetworkManager client: "
+                  << (error ? error->message : "Unknown error") << std::endl;
+        if (error) g_error_free(error);
+        netMgr->showNetworkManagerUnavailable();
+        return;
+    }
+    
+    std::cout << "NetworkManager client initialized successfully" << std::endl;
+    netMgr->nmClient = client;
+    
+    // Signals and the first population wait until the page is actually on screen
+    if (netMgr->networkContainer && gtk_widget_get_visible(netMgr->networkContainer)) {
+        netMgr->setupNetworkManager();
+        netMgr->refreshNetworks();
+    }
+}
+
 void NetworkManager::setupNetworkManager() {
-    // Initialize NetworkManager client
-    nmClient = nm_client_new(nullptr, nullptr);
-    if (nmClient) {
-        std::cout << "NetworkManager client initialized successfully" << std::endl;
-        
-        // Initialize network state
-        networkingEnabled = checkNetworkingEnabled();
-        hasEthernetConnection = checkEthernetConnection();
-        
-        std::cout << "Initial network state: networking=" << (networkingEnabled ? "enabled" : "disabled")
-                  << ", ethernet=" << (hasEthernetConnection ? "connected" : "disconnected") << std::endl;
-        
-        // Connect to NetworkManager state change signals
-        g_signal_connect(nmClient, "notify::wireless-enabled", 
-                        G_CALLBACK(onNetworkManagerChanged), this);
-        g_signal_connect(nmClient, "notify::wireless-hardware-enabled", 
-                        G_CALLBACK(onNetworkManagerChanged), this);
-        g_signal_connect(nmClient, "notify::networking-enabled", 
-                        G_CALLBACK(onNetworkManagerChanged), this);
-        
-        // Connect to Wi-Fi device signals
-        NMDeviceWifi* wifi = getPrimaryWifiDevice();
-        if (wifi) {
-            std::cout << "Found Wi-Fi device: " << nm_device_get_iface(NM_DEVICE(wifi)) << std::endl;
-            g_signal_connect(wifi, "notify::active-access-point", 
-                           G_CALLBACK(onWifiDeviceChanged), this);
-            g_signal_connect(wifi, "notify::access-points", 
-                           G_CALLBACK(onWifiDeviceChanged), this);
-        } else {
-            std::cout << "No Wi-Fi device found" << std::endl;
-        }
-        
-        // Initial state setup
-        reflectWifiSwitchState();
-        populateWifiList();
-        updateConnectionStatus();
-        
-        // Auto-enable networking if disabled
-        if (!networkingEnabled) {
-            std::cout << "Networking is disabled, auto-enabling..." << std::endl;
-            enableNetworking();
-        }
+    if (!nmClient || nmClientSignalsConnected) return;
+    nmClientSignalsConnected = true;
+    
+    // Initialize network state
+    networkingEnabled = checkNetworkingEnabled();
+    hasEthernetConnection = checkEthernetConnection();
+    wifiHardwareEnabled = nm_client_wireless_hardware_get_enabled(nmClient);
+    wifiSoftwareEnabled = nm_client_wireless_get_enabled(nmClient);
+    
+    std::cout << "Initial network state: networking=" << (networkingEnabled ? "enabled" : "disabled")
+              << ", ethernet=" << (hasEthernetConnection ? "connected" : "disconnected") << std::endl;
+    
+    // Connect to NetworkManager state change signals
+    g_signal_connect(nmClient, "notify::wireless-enabled", 
+                    G_CALLBACK(onNetworkManagerChanged), this);
+    g_signal_connect(nmClient, "notify::wireless-hardware-enabled", 
+                    G_CALLBACK(onNetworkManagerChanged), this);
+    g_signal_connect(nmClient, "notify::networking-enabled", 
+                    G_CALLBACK(onNetworkManagerChanged), this);
+    
+    // Index saved profiles once and follow additions/removals from then on
+    rebuildSavedConnectionIndex();
+    g_signal_connect(nmClient, "connection-added", G_CALLBACK(onConnectionAdded), this);
+    g_signal_connect(nmClient, "connection-removed", G_CALLBACK(onConnectionRemoved), this);
+    
+    // Connect to Wi-Fi device signals
+    NMDeviceWifi* wifi = getPrimaryWifiDevice();
+    if (wifi) {
+        std::cout << "Found Wi-Fi device: " << nm_device_get_iface(NM_DEVICE(wifi)) << std::endl;
+        g_signal_connect(wifi, "notify::active-access-point", 
+                       G_CALLBACK(onWifiDeviceChanged), this);
+        g_signal_connect(wifi, "notify::last-scan", 
+                       G_CALLBACK(onLastScanChanged), this);
         
+        // Access points are tracked one by one from here on
+        if (wifiModel) wifiModel->attach(wifi);
     } else {
-        std::cout << "Failed to initialize NetworkManager client" << std::endl;
-        
-        // Show error in the list
-        if (wifiListBox) {
-            GtkWidget* row = gtk_list_box_row_new();
-            GtkWidget* label = gtk_label_new(TR(TranslationKeys::NETWORKMANAGER_NOT_AVAILABLE));
-            gtk_widget_add_css_class(label, "message-label");
-            gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), label);
-            gtk_list_box_append(GTK_LIST_BOX(wifiListBox), row);
+        std::cout << "No Wi-Fi device found" << std::endl;
+    }
+    
+    // Initial state setup
+    reflectWifiSwitchState();
+    populateWifiList();
+    updateConnectionStatus();
+    
+    // Auto-enable networking if disabled
+    if (!networkingEnabled) {
+        std::cout << "Networking is disabled, auto-enabling..." << std::endl;
+        enableNetworking();
+    }
+}
+
+void NetworkManager::showNetworkLoadingState() {
+    if (!wifiListBox) return;
+    
+    GtkWidget* child = gtk_widget_get_first_child(wifiListBox);
+    while (child) {
+        GtkWidget* next = gtk_widget_get_next_sibling(child);
+        gtk_list_box_remove(GTK_LIST_BOX(wifiListBox), child);
+        child = next;
+    }
+    networkWidgets.clear();
+    
+    GtkWidget* row = gtk_list_box_row_new();
+    GtkWidget* rowBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    gtk_widget_set_halign(rowBox, GTK_ALIGN_CENTER);
+    gtk_widget_set_margin_top(rowBox, 20);
+    gtk_widget_set_margin_bottom(rowBox, 20);
+    
+    GtkWidget* spinner = gtk_spinner_new();
+    gtk_spinner_start(GTK_SPINNER(spinner));
+    gtk_box_append(GTK_BOX(rowBox), spinner);
+    
+    GtkWidget* label = gtk_label_new(TR(TranslationKeys::LOADING));
+    gtk_widget_add_css_class(label, "message-label");
+    gtk_box_append(GTK_BOX(rowBox), label);
+    
+    gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), rowBox);
+    gtk_list_box_row_set_activatable(GTK_LIST_BOX_ROW(row), FALSE);
+    gtk_list_box_append(GTK_LIST_BOX(wifiListBox), row);
+    networkWidgets.push_back(row);
+    if (wifiStack) gtk_stack_set_visible_child_name(GTK_STACK(wifiStack), "messages");
+    
+    // Nothing to toggle until the client is up
+    if (wifiSwitch) gtk_widget_set_sensitive(wifiSwitch, FALSE);
+    if (refreshButton) gtk_widget_set_sensitive(refreshButton, FALSE);
+}
+
+void NetworkManager::showNetworkManagerUnavailable() {
+    if (wifiListBox) {
+        GtkWidget* child = gtk_widget_get_first_child(wifiListBox);
+        while (child) {
+            GtkWidget* next = gtk_widget_get_next_sibling(child);
+            gtk_list_box_remove(GTK_LIST_BOX(wifiListBox), child);
+            child = next;
         }
+        networkWidgets.clear();
         
-        // Disable Wi-Fi controls
-        if (wifiSwitch) gtk_widget_set_sensitive(wifiSwitch, FALSE);
-        if (refreshButton) gtk_widget_set_sensitive(refreshButton, FALSE);
+        // Show error in the list
+        GtkWidget* row = gtk_list_box_row_new();
+        GtkWidget* label = gtk_label_new(TR(TranslationKeys::NETWORKMANAGER_NOT_AVAILABLE));
+        gtk_widget_add_css_class(label, "message-label");
+        gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), label);
+        gtk_list_box_append(GTK_LIST_BOX(wifiListBox), row);
+        networkWidgets.push_back(row);
+        if (wifiStack) gtk_stack_set_visible_child_name(GTK_STACK(wifiStack), "messages");
+    }
+    
+    // Disable Wi-Fi controls
+    if (wifiSwitch) gtk_widget_set_sensitive(wifiSwitch, FALSE);
+    if (refreshButton) gtk_widget_set_sensitive(refreshButton, FALSE);
+    
+    if (connectionStatusLabel) {
+        gtk_label_set_text(GTK_LABEL(connectionStatusLabel), TR(TranslationKeys::NETWORKMANAGER_NOT_AVAILABLE));
+        gtk_widget_add_css_class(connectionStatusLabel, "disconnected");
     }
 }
 
 void NetworkManager::refreshNetworks() {
-    scanWifiNetworks();
+    onBatteryPower = PowerSupply::onBatteryPower();
+    scanWifiNetworks(false);
     updateConnectionStatus();
 }
 
 void NetworkManager::populateWifiList() {
-    if (!wifiListBox) return;
+    if (!wifiListBox || !wifiStack) return;
     
-    // Clear existing list - GTK will handle cleanup of g_object_set_data_full callback data
+    // Clear existing messages; network rows live in wifiListView and are left alone
     GtkWidget* child = gtk_widget_get_first_child(wifiListBox);
     while (child) {
         GtkWidget* next = gtk_widget_get_next_sibling(child);
@@ -556,6 +957,7 @@ void NetworkManager::populateWifiList() {
         child = next;
     }
     networkWidgets.clear();
+    gtk_stack_set_visible_child_name(GTK_STACK(wifiStack), "messages");
     
     // Check if networking is enabled
     if (!networkingEnabled) {
@@ -630,10 +1032,7 @@ void NetworkManager::populateWifiList() {
         return;
     }
     
-    // Get available networks
-    std::vector<WifiNetwork> networks = getAvailableNetworks();
-    
-    if (networks.empty()) {
+    if (!wifiModel || wifiModel->size() == 0) {
         GtkWidget* row = gtk_list_box_row_new();
         GtkWidget* label = gtk_label_new(TR(TranslationKeys::NO_NETWORKS_FOUND));
         gtk_widget_add_css_class(label, "message-label");
@@ -646,198 +1045,128 @@ void NetworkManager::populateWifiList() {
         return;
     }
     
-    // Build network rows
-    for (const WifiNetwork& network : networks) {
-        buildNetworkRow(network);
-    }
+    // Rows are kept up to date by wifiModel; just reveal them
+    gtk_stack_set_visible_child_name(GTK_STACK(wifiStack), "networks");
 }
 
-void NetworkManager::buildNetworkRow(const WifiNetwork& network) {
-    if (!wifiListBox) return;
-    
-    GtkWidget* row = gtk_list_box_row_new();
-    gtk_widget_set_size_request(row, -1, 70);
+void NetworkManager::buildNetworkRow(GtkListItem* listItem) {
+    WifiRowWidgets* w = new WifiRowWidgets();
+    w->networkManager = this;
+    w->listItem = listItem;
+    w->boundItem = nullptr;
+    w->changedHandler = 0;
     
     GtkWidget* rowBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 15);
+    gtk_widget_set_size_request(rowBox, -1, 46);
     gtk_widget_set_margin_top(rowBox, 12);
     gtk_widget_set_margin_bottom(rowBox, 12);
     gtk_widget_set_margin_start(rowBox, 20);
     gtk_widget_set_margin_end(rowBox, 20);
+    w->rowBox = rowBox;
     
     // Signal strength icon
-    const char* iconName;
-    if (network.strength > 75) iconName = "network-wireless-signal-excellent-symbolic";
-    else if (network.strength > 50) iconName = "network-wireless-signal-good-symbolic";
-    else if (network.strength > 25) iconName = "network-wireless-signal-ok-symbolic";
-    else iconName = "network-wireless-signal-weak-symbolic";
-    
-    GtkWidget* signalIcon = gtk_image_new_from_icon_name(iconName);
-    gtk_image_set_pixel_size(GTK_IMAGE(signalIcon), 24);
-    gtk_box_append(GTK_BOX(rowBox), signalIcon);
+    w->signalIcon = gtk_image_new();
+    gtk_image_set_pixel_size(GTK_IMAGE(w->signalIcon), 24);
+    gtk_box_append(GTK_BOX(rowBox), w->signalIcon);
     
     // Network info box
     GtkWidget* infoBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 4);
     
     // Network name
-    GtkWidget* nameLabel = gtk_label_new(network.ssid.c_str());
-    gtk_widget_add_css_class(nameLabel, "network-name");
-    gtk_widget_set_halign(nameLabel, GTK_ALIGN_START);
-    gtk_box_append(GTK_BOX(infoBox), nameLabel);
+    w->nameLabel = gtk_label_new("");
+    gtk_widget_add_css_class(w->nameLabel, "network-name");
+    gtk_widget_set_halign(w->nameLabel, GTK_ALIGN_START);
+    gtk_box_append(GTK_BOX(infoBox), w->nameLabel);
     
     // Network status
-    if (!network.status.empty()) {
-        GtkWidget* statusLabel = gtk_label_new(network.status.c_str());
-        gtk_widget_add_css_class(statusLabel, "network-status");
-        if (network.isActive) {
-            gtk_widget_add_css_class(statusLabel, "connected");
-        } else if (network.isSaved) {
-            gtk_widget_add_css_class(statusLabel, "saved");
-        } else if (network.isSecured) {
-            gtk_widget_add_css_class(statusLabel, "secured");
-        }
-        gtk_widget_set_halign(statusLabel, GTK_ALIGN_START);
-        gtk_box_append(GTK_BOX(infoBox), statusLabel);
-    }
+    w->statusLabel = gtk_label_new("");
+    gtk_widget_add_css_class(w->statusLabel, "network-status");
+    gtk_widget_set_halign(w->statusLabel, GTK_ALIGN_START);
+    gtk_box_append(GTK_BOX(infoBox), w->statusLabel);
     
     gtk_widget_set_hexpand(infoBox, TRUE);
     gtk_box_append(GTK_BOX(rowBox), infoBox);
     
+    // Recent signal history; the tooltip carries the roaming log
+    w->sparkline = gtk_drawing_area_new();
+    gtk_widget_set_size_request(w->sparkline, 72, 24);
+    gtk_widget_set_valign(w->sparkline, GTK_ALIGN_CENTER);
+    gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(w->sparkline), drawSignalSparkline, w, nullptr);
+    gtk_box_append(GTK_BOX(rowBox), w->sparkline);
+    
+    gtk_widget_set_has_tooltip(rowBox, TRUE);
+    g_signal_connect(rowBox, "query-tooltip", G_CALLBACK(onNetworkRowQueryTooltip), w);
+    
     // Security icon
-    if (network.isSecured) {
-        GtkWidget* lockIcon = gtk_image_new_from_icon_name("network-wireless-encrypted-symbolic");
-        gtk_image_set_pixel_size(GTK_IMAGE(lockIcon), 16);
-        gtk_box_append(GTK_BOX(rowBox), lockIcon);
-    }
-    
-        // Settings button for connected networks
-    if (network.isActive) {
-        GtkWidget* settingsBtn = gtk_button_new();
-        GtkWidget* settingsIcon = gtk_image_new_from_icon_name("preferences-system-symbolic");
-        gtk_image_set_pixel_size(GTK_IMAGE(settingsIcon), 16);
-        gtk_button_set_child(GTK_BUTTON(settingsBtn), settingsIcon);
-        gtk_widget_add_css_class(settingsBtn, "settings-button");
-        gtk_widget_add_css_class(settingsBtn, "flat");
-        gtk_widget_add_css_class(settingsBtn, "circular");
-        gtk_widget_set_tooltip_text(settingsBtn, TR(TranslationKeys::NETWORK_SETTINGS));
-        
-        // Find active connection for this network
-        NMActiveConnection* activeConn = nullptr;
-        const GPtrArray* activeConnections = nm_client_get_active_connections(nmClient);
-        if (activeConnections) {
-            for (guint i = 0; i < activeConnections->len; i++) {
-                NMActiveConnection* conn = static_cast<NMActiveConnection*>(g_ptr_array_index(activeConnections, i));
-                if (conn) {
-                    const char* connId = nm_active_connection_get_id(conn);
-                    if (connId && network.ssid == std::string(connId)) {
-                        activeConn = conn;
-                        break;
-                    }
-                }
-            }
-        }
-        
-        // Store settings data with the button
-        NetworkSettingsData* settingsData = new NetworkSettingsData();
-        settingsData->networkManager = this;
-        settingsData->ssid = network.ssid;
-        settingsData->activeConnection = activeConn; // Don't ref here to avoid double-free
-        
-        g_object_set_data_full(G_OBJECT(settingsBtn), "settings-data", settingsData,
-                              [](gpointer data) {
-                                  NetworkSettingsData* d = static_cast<NetworkSettingsData*>(data);
-                                  delete d;
-                              });
-        
-        g_signal_connect(settingsBtn, "clicked", G_CALLBACK(onNetworkSettingsClicked), settingsData);
-        gtk_box_append(GTK_BOX(rowBox), settingsBtn);
-    }
+    w->lockIcon = gtk_image_new_from_icon_name("network-wireless-encrypted-symbolic");
+    gtk_image_set_pixel_size(GTK_IMAGE(w->lockIcon), 16);
+    gtk_box_append(GTK_BOX(rowBox), w->lockIcon);
+    
+    // Settings button for connected networks
+    w->settingsButton = gtk_button_new();
+    GtkWidget* settingsIcon = gtk_image_new_from_icon_name("preferences-system-symbolic");
+    gtk_image_set_pixel_size(GTK_IMAGE(settingsIcon), 16);
+    gtk_button_set_child(GTK_BUTTON(w->settingsButton), settingsIcon);
+    gtk_widget_add_css_class(w->settingsButton, "settings-button");
+    gtk_widget_add_css_class(w->settingsButton, "flat");
+    gtk_widget_add_css_class(w->settingsButton, "circular");
+    gtk_widget_set_tooltip_text(w->settingsButton, TR(TranslationKeys::NETWORK_SETTINGS));
+    g_signal_connect(w->settingsButton, "clicked", G_CALLBACK(onNetworkSettingsClicked), w);
+    gtk_box_append(GTK_BOX(rowBox), w->settingsButton);
     
     // Connect button
-    GtkWidget* connectBtn = gtk_button_new();
+    w->connectButton = gtk_button_new();
     GtkWidget* connectIcon = gtk_image_new_from_icon_name("go-next-symbolic");
     gtk_image_set_pixel_size(GTK_IMAGE(connectIcon), 16);
-    gtk_button_set_child(GTK_BUTTON(connectBtn), connectIcon);
-    gtk_widget_add_css_class(connectBtn, "connect-button");
-    gtk_widget_add_css_class(connectBtn, "flat");
-    gtk_widget_add_css_class(connectBtn, "circular");
-    
-    // Store network data with the button
-    ConnectButtonData* btnData = new ConnectButtonData();
-    btnData->networkManager = this;
-    btnData->ssid = network.ssid;
-    btnData->ap = nullptr; // Find AP dynamically to avoid reference issues
-    btnData->isSecured = network.isSecured;
-    
-    g_object_set_data_full(G_OBJECT(connectBtn), "connect-data", btnData,
+    gtk_button_set_child(GTK_BUTTON(w->connectButton), connectIcon);
+    gtk_widget_add_css_class(w->connectButton, "connect-button");
+    gtk_widget_add_css_class(w->connectButton, "flat");
+    gtk_widget_add_css_class(w->connectButton, "circular");
+    g_signal_connect(w->connectButton, "clicked", G_CALLBACK(onConnectButtonClicked), w);
+    gtk_box_append(GTK_BOX(rowBox), w->connectButton);
+    
+    // The row widgets are recycled, so the lookup table lives as long as they do
+    g_object_set_data_full(G_OBJECT(listItem), "row-widgets", w,
                           [](gpointer data) {
-                              ConnectButtonData* d = static_cast<ConnectButtonData*>(data);
-                              delete d;
+                              delete static_cast<WifiRowWidgets*>(data);
                           });
     
-    g_signal_connect(connectBtn, "clicked", G_CALLBACK(onConnectButtonClicked), btnData);
-    gtk_box_append(GTK_BOX(rowBox), connectBtn);
-    
-    gtk_list_box_row_set_child(GTK_LIST_BOX_ROW(row), rowBox);
-    gtk_list_box_append(GTK_LIST_BOX(wifiListBox), row);
-    networkWidgets.push_back(row);
+    gtk_list_item_set_child(listItem, rowBox);
+    gtk_list_item_set_activatable(listItem, FALSE);
 }
 
-std::vector<WifiNetwork> NetworkManager::getAvailableNetworks() {
-    std::vector<WifiNetwork> networks;
+void NetworkManager::bindNetworkRow(GtkListItem* listItem) {
+    WifiRowWidgets* w = static_cast<WifiRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    const WifiNetwork* network = elysia_wifi_item_get_network(
+        ELYSIA_WIFI_ITEM(gtk_list_item_get_item(listItem)));
+    if (!w || !network) return;
     
-    if (!nmClient) return networks;
-    
-    NMDeviceWifi* wifi = getPrimaryWifiDevice();
-    if (!wifi) return networks;
-    
-    const GPtrArray* aps = nm_device_wifi_get_access_points(wifi);
-    if (!aps || aps->len == 0) return networks;
-    
-    NMAccessPoint* activeAp = nm_device_wifi_get_active_access_point(wifi);
-    
-    for (guint i = 0; i < aps->len; ++i) {
-        NMAccessPoint* ap = static_cast<NMAccessPoint*>(g_ptr_array_index(aps, i));
-        if (!ap) continue;
-        
-        std::string ssid = ssidFromBytes(nm_access_point_get_ssid(ap));
-        if (ssid.empty()) ssid = "<hidden>";
-        
-        WifiNetwork network;
-        network.ssid = ssid;
-        network.strength = nm_access_point_get_strength(ap);
-        network.isSecured = isAccessPointSecured(ap);
-        network.ap = nullptr; // Don't store raw pointers to avoid double-free
-        
-        // Check if this is the active connection
-        network.isActive = false;
-        if (activeAp) {
-            const char* activePath = nm_object_get_path(NM_OBJECT(activeAp));
-            const char* apPath = nm_object_get_path(NM_OBJECT(ap));
-            if (activePath && apPath && g_strcmp0(activePath, apPath) == 0) {
-                network.isActive = true;
-            }
-        }
-        
-        // Check if this network is saved
-        NMRemoteConnection* saved = findSavedConnection(ssid);
-        network.isSaved = (saved != nullptr);
-        if (saved) g_object_unref(saved);
-        
-        // Set status
-        if (network.isActive) {
-            network.status = "Connected";
-        } else if (network.isSaved) {
-            network.status = "Saved";
-        } else if (network.isSecured) {
-            network.status = "Secured";
-        } else {
-            network.status = "Open";
-        }
-        
-        networks.push_back(network);
+    // Signal strength icon
+    const char* iconName;
+    if (network->strength > 75) iconName = "network-wireless-signal-excellent-symbolic";
+    else if (network->strength > 50) iconName = "network-wireless-signal-good-symbolic";
+    else if (network->strength > 25) iconName = "network-wireless-signal-ok-symbolic";
+    else iconName = "network-wireless-signal-weak-symbolic";
+    gtk_image_set_from_icon_name(GTK_IMAGE(w->signalIcon), iconName);
+    
+    gtk_label_set_text(GTK_LABEL(w->nameLabel), network->ssid.c_str());
+    
+    gtk_label_set_text(GTK_LABEL(w->statusLabel), network->status.c_str());
+    gtk_widget_remove_css_class(w->statusLabel, "connected");
+    gtk_widget_remove_css_class(w->statusLabel, "saved");
+    gtk_widget_remove_css_class(w->statusLabel, "secured");
+    if (network->isActive) {
+        gtk_widget_add_css_class(w->statusLabel, "connected");
+    } else if (network->isSaved) {
+        gtk_widget_add_css_class(w->statusLabel, "saved");
+    } else if (network->isSecured) {
+        gtk_widget_add_css_class(w->statusLabel, "secured");
     }
     
-    return networks;
+    gtk_widget_set_visible(w->lockIcon, network->isSecured);
+    gtk_widget_set_visible(w->settingsButton, network->isActive);
+    
+    gtk_widget_queue_draw(w->sparkline);
 }
 
 void NetworkManager::updateConnectionStatus() {
@@ -849,6 +1178,7 @@ void NetworkManager::updateConnectionStatus() {
     
     std::string statusText = "";
     std::string cssClass = "";
+    NMDevice* activeDevice = nullptr;
     
     // Check ethernet connection first
     if (hasEthernetConnection) {
@@ -860,6 +1190,7 @@ void NetworkManager::updateConnectionStatus() {
                 if (NM_IS_DEVICE_ETHERNET(dev)) {
                     NMDeviceState state = nm_device_get_state(dev);
                     if (state == NM_DEVICE_STATE_ACTIVATED) {
+                        activeDevice = dev;
                         NMActiveConnection* activeConn = nm_device_get_active_connection(dev);
                         if (activeConn) {
                             const char* connName = nm_active_connection_get_id(activeConn);
@@ -882,6 +1213,7 @@ void NetworkManager::updateConnectionStatus() {
         if (wifi) {
             NMDeviceState state = nm_device_get_state(NM_DEVICE(wifi));
             if (state == NM_DEVICE_STATE_ACTIVATED) {
+                activeDevice = NM_DEVICE(wifi);
                 NMAccessPoint* activeAp = nm_device_wifi_get_active_access_point(wifi);
                 if (activeAp) {
                     std::string ssid = ssidFromBytes(nm_access_point_get_ssid(activeAp));
@@ -926,6 +1258,122 @@ void NetworkManager::updateConnectionStatus() {
     if (!cssClass.empty()) {
         gtk_widget_add_css_class(connectionStatusLabel, cssClass.c_str());
     }
+    
+    updateThroughputDevice(activeDevice);
+}
+
+void NetworkManager::updateThroughputDevice(NMDevice* device) {
+    if (!throughputArea) return;
+    
+    const char* iface = device ? nm_device_get_ip_iface(device) : nullptr;
+    if (!iface) iface = device ? nm_device_get_iface(device) : nullptr;
+    
+    if (!iface) {
+        stopThroughputSampling();
+        throughputMonitor.close();
+        gtk_widget_set_visible(throughputArea, FALSE);
+        return;
+    }
+    
+    if (throughputMonitor.interfaceName() != iface) {
+        stopThroughputSampling();
+        if (!throughputMonitor.open(iface)) {
+            gtk_widget_set_visible(throughputArea, FALSE);
+            return;
+        }
+    }
+    
+    gtk_widget_set_visible(throughputArea, TRUE);
+    if (networkContainer && gtk_widget_get_visible(networkContainer)) {
+        startThroughputSampling();
+    }
+}
+
+void NetworkManager::startAppUsageSampling() {
+    if (!appUsageBox) return;
+    if (!processBandwidth) processBandwidth = std::make_unique<ProcessBandwidth>();
+    if (!processBandwidth->start()) return;
+    
+    if (processBandwidthWatchId == 0) {
+        processBandwidthWatchId = g_unix_fd_add(processBandwidth->eventFd(), G_IO_IN, onProcessBandwidthEvent, this);
+    }
+}
+
+void NetworkManager::stopAppUsageSampling() {
+    if (processBandwidthWatchId > 0) {
+        g_source_remove(processBandwidthWatchId);
+        processBandwidthWatchId = 0;
+    }
+    if (processBandwidth) {
+        processBandwidth->stop();
+        processBandwidth->acknowledge();
+    }
+}
+
+void NetworkManager::updateAppUsageRows() {
+    if (!processBandwidth) return;
+    
+    std::vector<ProcessTraffic> usage = processBandwidth->snapshot();
+    size_t shown = std::min(usage.size(), appUsageRows.size());
+    
+    for (size_t i = 0; i < appUsageRows.size(); ++i) {
+        AppUsageRow& row = appUsageRows[i];
+        if (i >= shown) {
+            if (!row.nameText.empty()) {
+                row.nameText.clear();
+                row.rateText.clear();
+                gtk_widget_set_visible(row.row, FALSE);
+            }
+            continue;
+        }
+        
+        const ProcessTraffic& traffic = usage[i];
+        std::string name = traffic.pid > 0 && !traffic.name.empty() ? traffic.name
+                                                                    : TR(TranslationKeys::APP_USAGE_OTHER);
+        std::string rate = "\u2193 " + ThroughputMonitor::formatBytes(traffic.rxRate) + "/s  \u2191 " +
+                           ThroughputMonitor::formatBytes(traffic.txRate) + "/s";
+        
+        if (row.nameText.empty()) gtk_widget_set_visible(row.row, TRUE);
+        if (name != row.nameText) {
+            row.nameText = name;
+            gtk_label_set_text(GTK_LABEL(row.nameLabel), name.c_str());
+        }
+        if (rate != row.rateText) {
+            row.rateText = rate;
+            gtk_label_set_text(GTK_LABEL(row.rateLabel), rate.c_str());
+        }
+        
+        std::string tooltip = (traffic.pid > 0 ? "PID " + std::to_string(traffic.pid) + ", " : std::string()) +
+                              std::to_string(traffic.sockets) + " TCP connections\n" +
+                              TR(TranslationKeys::THROUGHPUT_TOTAL) + ": \u2193 " +
+                              ThroughputMonitor::formatBytes(static_cast<double>(traffic.rxTotal)) + "  \u2191 " +
+                              ThroughputMonitor::formatBytes(static_cast<double>(traffic.txTotal));
+        if (tooltip != row.tooltipText) {
+            row.tooltipText = tooltip;
+            gtk_widget_set_tooltip_text(row.row, tooltip.c_str());
+        }
+    }
+    
+    if (appUsageEmptyLabel) gtk_widget_set_visible(appUsageEmptyLabel, shown == 0);
+}
+
+// Slowest pace is kept, but the graph never redraws faster than this on battery
+static const int BATTERY_THROUGHPUT_INTERVAL_MS = 2000;
+
+void NetworkManager::startThroughputSampling() {
+    if (throughputTimeoutId > 0 || !throughputMonitor.isOpen()) return;
+    
+    throughputMonitor.sample(g_get_monotonic_time() / 1e6);
+    throughputIntervalMs = throughputMonitor.nextIntervalMs();
+    if (onBatteryPower) throughputIntervalMs = std::max(throughputIntervalMs, BATTERY_THROUGHPUT_INTERVAL_MS);
+    throughputTimeoutId = g_timeout_add(throughputIntervalMs, throughputSampleTimeout, this);
+}
+
+void NetworkManager::stopThroughputSampling() {
+    if (throughputTimeoutId > 0) {
+        g_source_remove(throughputTimeoutId);
+        throughputTimeoutId = 0;
+    }
 }
 
 
@@ -946,45 +1394,119 @@ NMDeviceWifi* NetworkManager::getPrimaryWifiDevice() {
 }
 
 std::string NetworkManager::ssidFromBytes(GBytes* ssidBytes) {
-    if (!ssidBytes) return "";
-    
-    gsize len = 0;
-    const guint8* data = static_cast<const guint8*>(g_bytes_get_data(ssidBytes, &len));
-    if (!data || len == 0) return "";
-    
-    return std::string(reinterpret_cast<const char*>(data), len);
+    return WifiNetworkModel::ssidFromBytes(ssidBytes);
 }
 
 bool NetworkManager::isAccessPointSecured(NMAccessPoint* ap) {
-    if (!ap) return false;
-    
-    return (nm_access_point_get_flags(ap) != NM_802_11_AP_FLAGS_NONE) ||
-           (nm_access_point_get_wpa_flags(ap) != NM_802_11_AP_SEC_NONE) ||
-           (nm_access_point_get_rsn_flags(ap) != NM_802_11_AP_SEC_NONE);
+    return WifiNetworkModel::isAccessPointSecured(ap);
 }
 
 NMRemoteConnection* NetworkManager::findSavedConnection(const std::string& ssid) {
     if (!nmClient || ssid.empty()) return nullptr;
     
+    auto it = savedConnectionsBySsid.find(ssid);
+    if (it == savedConnectionsBySsid.end() || it->second.empty()) return nullptr;
+    
+    return NM_REMOTE_CONNECTION(g_object_ref(it->second.front()));
+}
+
+void NetworkManager::rebuildSavedConnectionIndex() {
+    clearSavedConnectionIndex();
+    if (!nmClient) return;
+    
     const GPtrArray* conns = nm_client_get_connections(nmClient);
-    if (!conns) return nullptr;
+    if (!conns) return;
     
     for (guint i = 0; i < conns->len; ++i) {
-        NMRemoteConnection* rc = static_cast<NMRemoteConnection*>(g_ptr_array_index(conns, i));
-        if (!rc) continue;
-        
-        NMConnection* c = NM_CONNECTION(rc);
-        NMSettingWireless* sWifi = nm_connection_get_setting_wireless(c);
-        if (!sWifi) continue;
-        
-        GBytes* bytes = nm_setting_wireless_get_ssid(sWifi);
-        std::string connSsid = ssidFromBytes(bytes);
-        
-        if (connSsid == ssid) {
-            return NM_REMOTE_CONNECTION(g_object_ref(rc));
-        }
+        indexSavedConnection(static_cast<NMRemoteConnection*>(g_ptr_array_index(conns, i)));
+    }
+    
+    std::cout << "Indexed " << savedConnectionsBySsid.size() << " saved Wi-Fi SSIDs" << std::endl;
+}
+
+void NetworkManager::indexSavedConnection(NMRemoteConnection* connection) {
+    if (!connection) return;
+    
+    NMSettingWireless* sWifi = nm_connection_get_setting_wireless(NM_CONNECTION(connection));
+    if (!sWifi) return;
+    
+    std::string ssid = ssidFromBytes(nm_setting_wireless_get_ssid(sWifi));
+    if (ssid.empty()) return;
+    
+    savedConnectionsBySsid[ssid].push_back(NM_REMOTE_CONNECTION(g_object_ref(connection)));
+    
+    // An edit can change the SSID, so follow it while indexed
+    g_signal_connect(connection, "changed", G_CALLBACK(onSavedConnectionChanged), this);
+}
+
+void NetworkManager::unindexSavedConnection(NMRemoteConnection* connection) {
+    if (!connection) return;
+    
+    for (auto it = savedConnectionsBySsid.begin(); it != savedConnectionsBySsid.end(); ) {
+        auto& bucket = it->second;
+        for (auto c = bucket.begin(); c != bucket.end(); ) {
+            if (*c == connection) {
+                g_signal_handlers_disconnect_by_data(*c, this);
+                g_object_unref(*c);
+                c = bucket.erase(c);
+            } else {
+                ++c;
+            }
+        }
+        it = bucket.empty() ? savedConnectionsBySsid.erase(it) : std::next(it);
+    }
+}
+
+void NetworkManager::clearSavedConnectionIndex() {
+    for (auto& entry : savedConnectionsBySsid) {
+        for (NMRemoteConnection* connection : entry.second) {
+            g_signal_handlers_disconnect_by_data(connection, this);
+            g_object_unref(connection);
+        }
+    }
+    savedConnectionsBySsid.clear();
+}
+
+void NetworkManager::onConnectionAdded(NMClient* client, NMRemoteConnection* connection, gpointer user_data) {
+    (void)client;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->indexSavedConnection(connection);
+        if (netMgr->wifiModel) netMgr->wifiModel->refreshSavedState();
+        if (netMgr->savedStore) {
+            g_list_store_append(netMgr->savedStore, connection);
+            netMgr->updateSavedSummary();
+        }
+    }
+}
+
+void NetworkManager::onConnectionRemoved(NMClient* client, NMRemoteConnection* connection, gpointer user_data) {
+    (void)client;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->unindexSavedConnection(connection);
+        if (netMgr->wifiModel) netMgr->wifiModel->refreshSavedState();
+        
+        guint position;
+        if (netMgr->savedStore && g_list_store_find(netMgr->savedStore, connection, &position)) {
+            g_list_store_remove(netMgr->savedStore, position);
+            netMgr->updateSavedSummary();
+        }
+    }
+}
+
+void NetworkManager::onSavedConnectionChanged(NMRemoteConnection* connection, gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        // Hold a ref across the unindex so the object survives the re-add
+        g_object_ref(connection);
+        netMgr->unindexSavedConnection(connection);
+        netMgr->indexSavedConnection(connection);
+        g_object_unref(connection);
+        if (netMgr->wifiModel) netMgr->wifiModel->refreshSavedState();
     }
-    return nullptr;
 }
 
 bool NetworkManager::checkNetworkingEnabled() {
@@ -1015,16 +1537,23 @@ void NetworkManager::updateNetworkState() {
     
     bool newNetworkingEnabled = checkNetworkingEnabled();
     bool newEthernetConnection = checkEthernetConnection();
+    bool newWifiHardwareEnabled = nm_client_wireless_hardware_get_enabled(nmClient);
+    bool newWifiSoftwareEnabled = nm_client_wireless_get_enabled(nmClient);
     
     bool stateChanged = (networkingEnabled != newNetworkingEnabled) ||
-                       (hasEthernetConnection != newEthernetConnection);
+                       (hasEthernetConnection != newEthernetConnection) ||
+                       (wifiHardwareEnabled != newWifiHardwareEnabled) ||
+                       (wifiSoftwareEnabled != newWifiSoftwareEnabled);
     
     networkingEnabled = newNetworkingEnabled;
     hasEthernetConnection = newEthernetConnection;
+    wifiHardwareEnabled = newWifiHardwareEnabled;
+    wifiSoftwareEnabled = newWifiSoftwareEnabled;
     
     if (stateChanged) {
         std::cout << "Network state changed: networking=" << (newNetworkingEnabled ? "enabled" : "disabled")
-                  << ", ethernet=" << (newEthernetConnection ? "connected" : "disconnected") << std::endl;
+                  << ", ethernet=" << (newEthernetConnection ? "connected" : "disconnected")
+                  << ", wifi=" << (newWifiSoftwareEnabled ? "enabled" : "disabled") << std::endl;
         
         // Update UI with debounced timeout
         if (updateTimeoutId > 0) {
@@ -1077,16 +1606,112 @@ void NetworkManager::reflectWifiSwitchState() {
     if (refreshButton) {
         gtk_widget_set_sensitive(refreshButton, hwEnabled && swEnabled && networkingEnabled);
     }
+    
+    // A scan still in flight keeps the button disabled
+    updateLastScanLabel();
+}
+
+// Results younger than this are reused instead of waking the radio again.
+// Opening the page tolerates older results than the refresh button does, and
+// both back off further on battery.
+static const gint64 SCAN_MAX_AGE_MS = 30000;
+static const gint64 SCAN_MAX_AGE_BATTERY_MS = 120000;
+static const gint64 SCAN_MANUAL_MAX_AGE_MS = 5000;
+static const gint64 SCAN_MANUAL_MAX_AGE_BATTERY_MS = 15000;
+
+// A request that never produced a new last-scan stamp stops blocking new ones
+static const gint64 SCAN_PENDING_TIMEOUT_MS = 15000;
+
+static std::string formatAgo(uint32_t seconds) {
+    if (seconds < 60) return TRF(TranslationKeys::TIME_AGO_SECONDS, std::to_string(seconds));
+    if (seconds < 3600) return TRF(TranslationKeys::TIME_AGO_MINUTES, std::to_string(seconds / 60));
+    if (seconds < 86400) return TRF(TranslationKeys::TIME_AGO_HOURS, std::to_string(seconds / 3600));
+    return TRF(TranslationKeys::TIME_AGO_DAYS, std::to_string(seconds / 86400));
 }
 
-void NetworkManager::scanWifiNetworks() {
+void NetworkManager::scanWifiNetworks(bool userRequested) {
     if (!nmClient) return;
     
     NMDeviceWifi* wifi = getPrimaryWifiDevice();
     if (!wifi) return;
     
-    nm_device_wifi_request_scan_async(wifi, nullptr, nullptr, nullptr);
-    g_timeout_add(2000, populateWifiListTimeout, this);
+    // One request at a time; repeated clicks join the scan already running
+    gint64 now = nm_utils_get_timestamp_msec();
+    if (isScanPending(now)) return;
+    
+    gint64 maxAge;
+    if (userRequested) {
+        maxAge = onBatteryPower ? SCAN_MANUAL_MAX_AGE_BATTERY_MS : SCAN_MANUAL_MAX_AGE_MS;
+    } else {
+        maxAge = onBatteryPower ? SCAN_MAX_AGE_BATTERY_MS : SCAN_MAX_AGE_MS;
+    }
+    
+    gint64 lastScan = nm_device_wifi_get_last_scan(wifi);
+    if (lastScan >= 0 && now - lastScan < maxAge) {
+        updateLastScanLabel();
+        return;
+    }
+    
+    // Results arrive through access-point-added/removed on wifiModel
+    scanRequestedAt = now;
+    scanCancellable = g_cancellable_new();
+    nm_device_wifi_request_scan_async(wifi, scanCancellable, onScanRequestFinished, this);
+    updateLastScanLabel();
+}
+
+bool NetworkManager::isScanPending(gint64 now) const {
+    if (scanCancellable) return true;
+    return scanRequestedAt > 0 && now - scanRequestedAt < SCAN_PENDING_TIMEOUT_MS;
+}
+
+void NetworkManager::updateLastScanLabel() {
+    if (!lastScanLabel) return;
+    
+    stopLastScanLabelUpdates();
+    
+    NMDeviceWifi* wifi = nmClient ? getPrimaryWifiDevice() : nullptr;
+    if (!wifi || !wifiSoftwareEnabled || !wifiHardwareEnabled || !networkingEnabled) {
+        // populateWifiList owns the refresh button while Wi-Fi is off
+        gtk_label_set_text(GTK_LABEL(lastScanLabel), "");
+        return;
+    }
+    
+    gint64 now = nm_utils_get_timestamp_msec();
+    bool pending = isScanPending(now);
+    if (refreshButton) gtk_widget_set_sensitive(refreshButton, !pending);
+    
+    gint64 lastScan = nm_device_wifi_get_last_scan(wifi);
+    guint nextTickSeconds;
+    if (pending) {
+        gtk_label_set_text(GTK_LABEL(lastScanLabel), TR(TranslationKeys::SCANNING));
+        // Only to notice a request that timed out without results
+        nextTickSeconds = SCAN_PENDING_TIMEOUT_MS / 1000;
+    } else if (lastScan >= 0) {
+        uint32_t age = static_cast<uint32_t>(std::max<gint64>(0, now - lastScan) / 1000);
+        std::string text = std::string(TR(TranslationKeys::LAST_SCANNED)) + " " + formatAgo(age);
+        gtk_label_set_text(GTK_LABEL(lastScanLabel), text.c_str());
+        
+        // Seconds are only worth redrawing for the first minute, and coarser on battery
+        if (age < 60) {
+            nextTickSeconds = onBatteryPower ? 5 : 1;
+        } else {
+            nextTickSeconds = 60;
+        }
+    } else {
+        gtk_label_set_text(GTK_LABEL(lastScanLabel), "");
+        return;
+    }
+    
+    if (networkContainer && gtk_widget_get_visible(networkContainer)) {
+        scanLabelTimeoutId = g_timeout_add_seconds(nextTickSeconds, lastScanLabelTimeout, this);
+    }
+}
+
+void NetworkManager::stopLastScanLabelUpdates() {
+    if (scanLabelTimeoutId > 0) {
+        g_source_remove(scanLabelTimeoutId);
+        scanLabelTimeoutId = 0;
+    }
 }
 
 void NetworkManager::connectToNetwork(const std::string& ssid, NMAccessPoint* ap, bool isSecured) {
@@ -1099,8 +1724,10 @@ void NetworkManager::connectToNetwork(const std::string& ssid, NMAccessPoint* ap
     NMRemoteConnection* saved = findSavedConnection(ssid);
     if (saved) {
         // Activate saved connection
+        beginActivation(ssid, NM_DEVICE(wifi));
         nm_client_activate_connection_async(nmClient, NM_CONNECTION(saved), 
-                                          NM_DEVICE(wifi), nullptr, nullptr, nullptr, nullptr);
+                                          NM_DEVICE(wifi), nullptr, activationCancellable,
+                                          onActivateConnectionFinished, activationRequest);
         g_object_unref(saved);
         return;
     }
@@ -1132,9 +1759,787 @@ void NetworkManager::connectToNetwork(const std::string& ssid, NMAccessPoint* ap
         nm_connection_add_setting(c, NM_SETTING(sWifi));
         
         const char* apPath = nm_object_get_path(NM_OBJECT(ap));
+        beginActivation(ssid, NM_DEVICE(wifi));
         nm_client_add_and_activate_connection_async(nmClient, c, NM_DEVICE(wifi), 
-                                                   apPath, nullptr, nullptr, nullptr);
+                                                   apPath, activationCancellable,
+                                                   onAddAndActivateFinished, activationRequest);
+        g_object_unref(c);
+    }
+}
+
+void NetworkManager::beginActivation(const std::string& ssid, NMDevice* device) {
+    // A new attempt supersedes whatever was being tracked
+    endActivation();
+    if (activationHideTimeoutId > 0) {
+        g_source_remove(activationHideTimeoutId);
+        activationHideTimeoutId = 0;
+    }
+    
+    activationSsid = ssid;
+    activationStartTime = g_get_monotonic_time();
+    activationCancellable = g_cancellable_new();
+    activationRequest = new ActivationRequest{this, NM_CLIENT(g_object_ref(nmClient)), false};
+    
+    // Device states give the fine-grained stages before the active connection exists
+    if (device) {
+        activationDevice = NM_DEVICE(g_object_ref(device));
+        g_signal_connect(activationDevice, "state-changed", G_CALLBACK(onActivationDeviceStateChanged), this);
+    }
+    
+    setActivationStage(ActivationStage::Requesting);
+}
+
+void NetworkManager::trackActiveConnection(NMActiveConnection* connection) {
+    activationConnection = connection;
+    g_signal_connect(activationConnection, "state-changed", G_CALLBACK(onActiveConnectionStateChanged), this);
+    
+    // The connection may already be up by the time the reply arrives
+    NMActiveConnectionState state = nm_active_connection_get_state(activationConnection);
+    if (state == NM_ACTIVE_CONNECTION_STATE_ACTIVATED) {
+        setActivationStage(ActivationStage::Activated);
+    } else if (state == NM_ACTIVE_CONNECTION_STATE_DEACTIVATED) {
+        setActivationStage(ActivationStage::Failed,
+                           deviceReasonText(activationDevice ? nm_device_get_state_reason(activationDevice) : 0));
+    }
+}
+
+void NetworkManager::setActivationStage(ActivationStage stage, const std::string& detail) {
+    // Terminal states stick until the next attempt
+    if (activationStage == ActivationStage::Activated || activationStage == ActivationStage::Failed ||
+        activationStage == ActivationStage::Cancelled) {
+        if (stage != ActivationStage::Requesting) return;
+    }
+    // Device notifications can repeat or arrive late; never step backwards
+    if (stage > ActivationStage::Requesting && stage < ActivationStage::Activated && stage < activationStage) return;
+    
+    activationStage = stage;
+    if (!activationBox) return;
+    
+    double fraction = 0.0;
+    std::string text;
+    switch (stage) {
+        case ActivationStage::Idle:
+            gtk_widget_set_visible(activationBox, FALSE);
+            return;
+        case ActivationStage::Requesting:
+            fraction = 0.05;
+            text = TR(TranslationKeys::ACTIVATION_REQUESTING);
+            break;
+        case ActivationStage::Prepare:
+            fraction = 0.2;
+            text = TR(TranslationKeys::ACTIVATION_PREPARE);
+            break;
+        case ActivationStage::Config:
+            fraction = 0.4;
+            text = TR(TranslationKeys::ACTIVATION_CONFIG);
+            break;
+        case ActivationStage::NeedAuth:
+            fraction = 0.5;
+            text = TR(TranslationKeys::ACTIVATION_NEED_AUTH);
+            break;
+        case ActivationStage::IpConfig:
+            fraction = 0.7;
+            text = TR(TranslationKeys::ACTIVATION_IP_CONFIG);
+            break;
+        case ActivationStage::IpCheck:
+            fraction = 0.85;
+            text = TR(TranslationKeys::ACTIVATION_IP_CHECK);
+            break;
+        case ActivationStage::Activated: {
+            fraction = 1.0;
+            gint64 elapsedMs = (g_get_monotonic_time() - activationStartTime) / 1000;
+            connectDurations[activationSsid] = elapsedMs;
+            
+            char seconds[32];
+            snprintf(seconds, sizeof(seconds), "%.1f s", elapsedMs / 1000.0);
+            text = std::string(TR(TranslationKeys::ACTIVATION_DONE)) + " " + seconds;
+            std::cout << "Connected to " << activationSsid << " in " << elapsedMs << " ms" << std::endl;
+            break;
+        }
+        case ActivationStage::Failed:
+            text = std::string(TR(TranslationKeys::ACTIVATION_FAILED)) + " " + detail;
+            std::cout << "Connection to " << activationSsid << " failed: " << detail << std::endl;
+            break;
+        case ActivationStage::Cancelled:
+            text = TR(TranslationKeys::ACTIVATION_CANCELLED);
+            break;
+    }
+    
+    bool finished = stage == ActivationStage::Activated || stage == ActivationStage::Failed ||
+                    stage == ActivationStage::Cancelled;
+    
+    std::string label = activationSsid + ": " + text;
+    gtk_label_set_text(GTK_LABEL(activationLabel), label.c_str());
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(activationProgress), fraction);
+    gtk_widget_set_visible(activationProgress, stage != ActivationStage::Failed && stage != ActivationStage::Cancelled);
+    gtk_widget_set_visible(activationCancelButton, !finished);
+    if (stage == ActivationStage::Failed) {
+        gtk_widget_add_css_class(activationLabel, "failed");
+    } else {
+        gtk_widget_remove_css_class(activationLabel, "failed");
+    }
+    gtk_widget_set_visible(activationBox, TRUE);
+    
+    if (finished) {
+        endActivation();
+        
+        // Leave the outcome up briefly, failures a little longer
+        activationHideTimeoutId = g_timeout_add_seconds(stage == ActivationStage::Failed ? 8 : 4,
+                                                        hideActivationTimeout, this);
+    }
+}
+
+void NetworkManager::endActivation() {
+    // The request is freed by its reply, cancelled or not
+    activationRequest = nullptr;
+    if (activationCancellable) {
+        g_cancellable_cancel(activationCancellable);
+        g_clear_object(&activationCancellable);
+    }
+    if (activationConnection) {
+        g_signal_handlers_disconnect_by_data(activationConnection, this);
+        g_clear_object(&activationConnection);
+    }
+    if (activationDevice) {
+        g_signal_handlers_disconnect_by_func(activationDevice, (gpointer)onActivationDeviceStateChanged, this);
+        g_clear_object(&activationDevice);
+    }
+}
+
+void NetworkManager::cancelActivation() {
+    if (activationStage == ActivationStage::Idle || activationStage == ActivationStage::Activated ||
+        activationStage == ActivationStage::Failed || activationStage == ActivationStage::Cancelled) {
+        return;
+    }
+    
+    // Before the reply NetworkManager may already be activating; the reply
+    // handler takes that connection down once it knows which one it is
+    if (activationRequest) {
+        activationRequest->abandoned = true;
+        activationRequest = nullptr;
+        g_clear_object(&activationCancellable);
+    }
+    
+    // Disconnecting the device stops the attempt whichever stage it reached
+    if (activationDevice) {
+        nm_device_disconnect_async(activationDevice, nullptr, nullptr, nullptr);
+    }
+    setActivationStage(ActivationStage::Cancelled);
+}
+
+std::string NetworkManager::deviceReasonText(guint reason) {
+    switch (reason) {
+        case NM_DEVICE_STATE_REASON_NO_SECRETS:
+            return TR(TranslationKeys::DEVICE_REASON_NO_SECRETS);
+        case NM_DEVICE_STATE_REASON_SUPPLICANT_DISCONNECT:
+            return TR(TranslationKeys::DEVICE_REASON_AP_REJECTED);
+        case NM_DEVICE_STATE_REASON_SUPPLICANT_TIMEOUT:
+            return TR(TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT);
+        case NM_DEVICE_STATE_REASON_SUPPLICANT_FAILED:
+        case NM_DEVICE_STATE_REASON_SUPPLICANT_CONFIG_FAILED:
+            return TR(TranslationKeys::DEVICE_REASON_SUPPLICANT);
+        case NM_DEVICE_STATE_REASON_SSID_NOT_FOUND:
+            return TR(TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND);
+        case NM_DEVICE_STATE_REASON_IP_CONFIG_UNAVAILABLE:
+        case NM_DEVICE_STATE_REASON_DHCP_FAILED:
+        case NM_DEVICE_STATE_REASON_DHCP_ERROR:
+            return TR(TranslationKeys::DEVICE_REASON_DHCP_FAILED);
+        case NM_DEVICE_STATE_REASON_IP_CONFIG_EXPIRED:
+            return TR(TranslationKeys::DEVICE_REASON_LEASE_EXPIRED);
+        case NM_DEVICE_STATE_REASON_CARRIER:
+            return TR(TranslationKeys::DEVICE_REASON_LINK_LOST);
+        case NM_DEVICE_STATE_REASON_USER_REQUESTED:
+            return TR(TranslationKeys::DEVICE_REASON_USER);
+        case NM_DEVICE_STATE_REASON_NEW_ACTIVATION:
+            return TR(TranslationKeys::DEVICE_REASON_REPLACED);
+        default:
+            return TRF(TranslationKeys::DEVICE_REASON_OTHER, std::to_string(reason));
+    }
+}
+
+// Samples per target when the spin button is left alone
+static const int DIAGNOSTICS_DEFAULT_SAMPLES = 20;
+static const guint16 DIAGNOSTICS_DEFAULT_PORT = 443;
+
+enum DiagnosticsColumn {
+    DIAG_COL_TARGET,
+    DIAG_COL_METHOD,
+    DIAG_COL_REPLIES,
+    DIAG_COL_MIN,
+    DIAG_COL_P50,
+    DIAG_COL_P90,
+    DIAG_COL_P99,
+    DIAG_COL_STATUS,
+    DIAG_COLUMNS
+};
+
+struct DiagnosticsLookupData {
+    NetworkManager* networkManager;
+    guint16 port;
+    std::string label;
+    std::string host;
+};
+
+// Accepts "host", "host:port" and "[v6-address]:port"
+static bool parseHostPort(const std::string& text, std::string& host, guint16& port) {
+    std::string trimmed = text;
+    trimmed.erase(0, trimmed.find_first_not_of(" \t"));
+    trimmed.erase(trimmed.find_last_not_of(" \t") + 1);
+    
+    host.clear();
+    port = DIAGNOSTICS_DEFAULT_PORT;
+    if (trimmed.empty()) return true;
+    
+    std::string portText;
+    if (trimmed[0] == '[') {
+        size_t close = trimmed.find(']');
+        if (close == std::string::npos) return false;
+        host = trimmed.substr(1, close - 1);
+        if (close + 1 < trimmed.size()) {
+            if (trimmed[close + 1] != ':') return false;
+            portText = trimmed.substr(close + 2);
+        }
+    } else if (std::count(trimmed.begin(), trimmed.end(), ':') == 1) {
+        size_t colon = trimmed.find(':');
+        host = trimmed.substr(0, colon);
+        portText = trimmed.substr(colon + 1);
+    } else {
+        // Bare IPv6 addresses carry several colons and no port
+        host = trimmed;
+    }
+    
+    if (!portText.empty()) {
+        char* end = nullptr;
+        unsigned long value = strtoul(portText.c_str(), &end, 10);
+        if (*end != '\0' || value == 0 || value > 65535) return false;
+        port = static_cast<guint16>(value);
+    }
+    return !host.empty();
+}
+
+static std::string formatLatency(double ms) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), ms < 10.0 ? "%.2f ms" : "%.1f ms", ms);
+    return buffer;
+}
+
+void NetworkManager::showDiagnostics() {
+    if (diagnosticsWindow) {
+        gtk_window_present(GTK_WINDOW(diagnosticsWindow));
+        return;
+    }
+    
+    diagnosticsWindow = gtk_window_new();
+    gtk_window_set_title(GTK_WINDOW(diagnosticsWindow), TR(TranslationKeys::DIAGNOSTICS_TITLE));
+    gtk_window_set_transient_for(GTK_WINDOW(diagnosticsWindow), GTK_WINDOW(parentWindow));
+    gtk_window_set_default_size(GTK_WINDOW(diagnosticsWindow), 760, 360);
+    g_signal_connect(diagnosticsWindow, "close-request", G_CALLBACK(onDiagnosticsCloseRequest), this);
+    
+    GtkWidget* content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 16);
+    gtk_widget_set_margin_top(content, 20);
+    gtk_widget_set_margin_bottom(content, 20);
+    gtk_widget_set_margin_start(content, 20);
+    gtk_widget_set_margin_end(content, 20);
+    
+    // Controls: TCP host, sample count, run/stop
+    GtkWidget* controls = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+    
+    diagnosticsHostEntry = gtk_entry_new();
+    // Empty by default: the gateway and resolvers are probed anyway, and no
+    // outside host is contacted unless the user names one
+    gtk_entry_set_placeholder_text(GTK_ENTRY(diagnosticsHostEntry), TR(TranslationKeys::DIAGNOSTICS_HOST_PLACEHOLDER));
+    gtk_widget_set_hexpand(diagnosticsHostEntry, TRUE);
+    gtk_box_append(GTK_BOX(controls), diagnosticsHostEntry);
+    
+    GtkWidget* samplesLabel = gtk_label_new(TR(TranslationKeys::DIAGNOSTICS_SAMPLES));
+    gtk_box_append(GTK_BOX(controls), samplesLabel);
+    
+    diagnosticsSamplesSpin = gtk_spin_button_new_with_range(1, 200, 1);
+    gtk_spin_button_set_value(GTK_SPIN_BUTTON(diagnosticsSamplesSpin), DIAGNOSTICS_DEFAULT_SAMPLES);
+    gtk_box_append(GTK_BOX(controls), diagnosticsSamplesSpin);
+    
+    diagnosticsRunButton = gtk_button_new_with_label(TR(TranslationKeys::DIAGNOSTICS_RUN));
+    g_signal_connect(diagnosticsRunButton, "clicked", G_CALLBACK(onDiagnosticsRunClicked), this);
+    gtk_box_append(GTK_BOX(controls), diagnosticsRunButton);
+    
+    gtk_box_append(GTK_BOX(content), controls);
+    
+    // Results table; row 0 is the header, one row per target below it
+    diagnosticsGrid = gtk_grid_new();
+    gtk_grid_set_column_spacing(GTK_GRID(diagnosticsGrid), 18);
+    gtk_grid_set_row_spacing(GTK_GRID(diagnosticsGrid), 8);
+    
+    const TranslationKeys headers[DIAG_COLUMNS] = {
+        TranslationKeys::DIAGNOSTICS_TARGET, TranslationKeys::DIAGNOSTICS_METHOD,
+        TranslationKeys::DIAGNOSTICS_REPLIES, TranslationKeys::DIAGNOSTICS_MIN,
+        TranslationKeys::DIAGNOSTICS_P50, TranslationKeys::DIAGNOSTICS_P90,
+        TranslationKeys::DIAGNOSTICS_P99, TranslationKeys::DIAGNOSTICS_STATUS
+    };
+    for (int column = 0; column < DIAG_COLUMNS; ++column) {
+        GtkWidget* header = gtk_label_new(TR(headers[column]));
+        gtk_widget_add_css_class(header, "heading");
+        gtk_label_set_xalign(GTK_LABEL(header), 0.0f);
+        gtk_grid_attach(GTK_GRID(diagnosticsGrid), header, column, 0, 1, 1);
+    }
+    diagnosticsRows = 0;
+    
+    GtkWidget* scroller = gtk_scrolled_window_new();
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroller), GTK_POLICY_AUTOMATIC, GTK_POLICY_AUTOMATIC);
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroller), diagnosticsGrid);
+    gtk_widget_set_vexpand(scroller, TRUE);
+    gtk_box_append(GTK_BOX(content), scroller);
+    
+    gtk_window_set_child(GTK_WINDOW(diagnosticsWindow), content);
+    gtk_window_present(GTK_WINDOW(diagnosticsWindow));
+}
+
+void NetworkManager::startDiagnostics() {
+    if (!diagnosticsHostEntry) return;
+    
+    std::string host;
+    guint16 port;
+    if (!parseHostPort(gtk_editable_get_text(GTK_EDITABLE(diagnosticsHostEntry)), host, port)) {
+        gtk_widget_add_css_class(diagnosticsHostEntry, "error");
+        return;
+    }
+    gtk_widget_remove_css_class(diagnosticsHostEntry, "error");
+    
+    gtk_button_set_label(GTK_BUTTON(diagnosticsRunButton), TR(TranslationKeys::DIAGNOSTICS_STOP));
+    
+    std::string label = host.empty() ? "" : host + ":" + std::to_string(port);
+    if (host.empty() || g_hostname_is_ip_address(host.c_str())) {
+        runDiagnostics(host, port, label, "example.com");
+        return;
+    }
+    
+    // Names are resolved here so the probe worker never blocks on the system resolver
+    diagnosticsCancellable = g_cancellable_new();
+    DiagnosticsLookupData* data = new DiagnosticsLookupData{this, port, label, host};
+    GResolver* resolver = g_resolver_get_default();
+    g_resolver_lookup_by_name_async(resolver, host.c_str(), diagnosticsCancellable, onDiagnosticsHostResolved, data);
+    g_object_unref(resolver);
+}
+
+void NetworkManager::runDiagnostics(const std::string& tcpAddress, uint16_t tcpPort, const std::string& tcpLabel,
+                                    const std::string& queryName) {
+    if (!diagnosticsGrid) return;
+    
+    std::vector<ProbeTarget> targets = collectDiagnosticsTargets(queryName);
+    if (!tcpAddress.empty()) {
+        targets.push_back(ProbeTarget{ProbeTarget::Kind::Tcp, "TCP " + tcpLabel, tcpAddress, tcpPort, ""});
+    }
+    
+    // Fresh rows for this run
+    for (int i = 0; i < diagnosticsRows; ++i) {
+        gtk_grid_remove_row(GTK_GRID(diagnosticsGrid), 1);
+    }
+    diagnosticsRows = static_cast<int>(targets.size());
+    for (int row = 1; row <= diagnosticsRows; ++row) {
+        for (int column = 0; column < DIAG_COLUMNS; ++column) {
+            GtkWidget* cell = gtk_label_new("");
+            gtk_label_set_xalign(GTK_LABEL(cell), 0.0f);
+            if (column == DIAG_COL_STATUS) {
+                gtk_label_set_ellipsize(GTK_LABEL(cell), PANGO_ELLIPSIZE_END);
+                gtk_label_set_max_width_chars(GTK_LABEL(cell), 24);
+            }
+            gtk_grid_attach(GTK_GRID(diagnosticsGrid), cell, column, row, 1, 1);
+        }
+    }
+    
+    if (targets.empty()) {
+        gtk_button_set_label(GTK_BUTTON(diagnosticsRunButton), TR(TranslationKeys::DIAGNOSTICS_RUN));
+        gtk_grid_attach(GTK_GRID(diagnosticsGrid), gtk_label_new(TR(TranslationKeys::NOT_CONNECTED_STATUS)), 0, 1, DIAG_COLUMNS, 1);
+        diagnosticsRows = 1;
+        return;
+    }
+    
+    if (!networkProbe) networkProbe = std::make_unique<NetworkProbe>();
+    int samples = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(diagnosticsSamplesSpin));
+    if (!networkProbe->start(std::move(targets), samples)) {
+        gtk_button_set_label(GTK_BUTTON(diagnosticsRunButton), TR(TranslationKeys::DIAGNOSTICS_RUN));
+        return;
+    }
+    
+    if (diagnosticsWatchId == 0) {
+        diagnosticsWatchId = g_unix_fd_add(networkProbe->eventFd(), G_IO_IN, onDiagnosticsProbeEvent, this);
+    }
+}
+
+void NetworkManager::stopDiagnostics() {
+    if (diagnosticsCancellable) {
+        g_cancellable_cancel(diagnosticsCancellable);
+        g_clear_object(&diagnosticsCancellable);
+    }
+    if (diagnosticsWatchId > 0) {
+        g_source_remove(diagnosticsWatchId);
+        diagnosticsWatchId = 0;
+    }
+    if (networkProbe) {
+        networkProbe->stop();
+        networkProbe->acknowledge();
+        updateDiagnosticsResults();
+    }
+    if (diagnosticsRunButton) {
+        gtk_button_set_label(GTK_BUTTON(diagnosticsRunButton), TR(TranslationKeys::DIAGNOSTICS_RUN));
+    }
+}
+
+void NetworkManager::updateDiagnosticsResults() {
+    if (!networkProbe || !diagnosticsGrid) return;
+    
+    std::vector<ProbeResult> results = networkProbe->results();
+    int rows = std::min(diagnosticsRows, static_cast<int>(results.size()));
+    for (int i = 0; i < rows; ++i) {
+        const ProbeResult& r = results[i];
+        std::string cells[DIAG_COLUMNS];
+        cells[DIAG_COL_TARGET] = r.label;
+        cells[DIAG_COL_METHOD] = r.method;
+        cells[DIAG_COL_REPLIES] = std::to_string(r.received) + "/" + std::to_string(r.sent);
+        if (r.received > 0) {
+            cells[DIAG_COL_MIN] = formatLatency(r.minMs);
+            cells[DIAG_COL_P50] = formatLatency(r.p50Ms);
+            cells[DIAG_COL_P90] = formatLatency(r.p90Ms);
+            cells[DIAG_COL_P99] = formatLatency(r.p99Ms);
+        } else {
+            cells[DIAG_COL_MIN] = cells[DIAG_COL_P50] = cells[DIAG_COL_P90] = cells[DIAG_COL_P99] = "-";
+        }
+        if (!r.error.empty()) {
+            cells[DIAG_COL_STATUS] = r.error;
+        } else {
+            cells[DIAG_COL_STATUS] = r.done ? "OK" : "...";
+        }
+        
+        for (int column = 0; column < DIAG_COLUMNS; ++column) {
+            GtkWidget* cell = gtk_grid_get_child_at(GTK_GRID(diagnosticsGrid), column, i + 1);
+            if (cell && GTK_IS_LABEL(cell)) {
+                gtk_label_set_text(GTK_LABEL(cell), cells[column].c_str());
+            }
+        }
+    }
+}
+
+std::vector<ProbeTarget> NetworkManager::collectDiagnosticsTargets(const std::string& queryName) {
+    std::vector<ProbeTarget> targets;
+    if (!nmClient) return targets;
+    
+    // Same gateway and resolvers NetworkManager configured on the primary connection
+    NMActiveConnection* primary = nm_client_get_primary_connection(nmClient);
+    if (!primary) return targets;
+    
+    // Link-local addresses only work with the interface they belong to
+    std::string iface;
+    const GPtrArray* devices = nm_active_connection_get_devices(primary);
+    if (devices && devices->len > 0) {
+        const char* ipIface = nm_device_get_ip_iface(NM_DEVICE(g_ptr_array_index(devices, 0)));
+        if (ipIface) iface = ipIface;
+    }
+    auto scoped = [&iface](const char* address) {
+        std::string result = address;
+        if (g_str_has_prefix(address, "fe80") && result.find('%') == std::string::npos && !iface.empty()) {
+            result += "%" + iface;
+        }
+        return result;
+    };
+    
+    NMIPConfig* configs[] = {
+        nm_active_connection_get_ip4_config(primary),
+        nm_active_connection_get_ip6_config(primary)
+    };
+    for (NMIPConfig* config : configs) {
+        if (!config) continue;
+        
+        const char* gateway = nm_ip_config_get_gateway(config);
+        if (gateway && *gateway) {
+            targets.push_back(ProbeTarget{ProbeTarget::Kind::Ping, std::string("Gateway ") + gateway,
+                                          scoped(gateway), 80, ""});
+        }
+        
+        const char* const* nameservers = nm_ip_config_get_nameservers(config);
+        for (int i = 0; nameservers && nameservers[i]; ++i) {
+            targets.push_back(ProbeTarget{ProbeTarget::Kind::Dns, std::string("DNS ") + nameservers[i],
+                                          scoped(nameservers[i]), 53, queryName});
+        }
+    }
+    return targets;
+}
+
+// Bulk calls allowed in flight at once; NetworkManager serialises disk writes anyway
+static const int BULK_MAX_IN_FLIGHT = 16;
+
+// Widgets of one recycled saved-connection row
+struct SavedRowWidgets {
+    NetworkManager* networkManager;
+    GtkWidget* typeIcon;
+    GtkWidget* nameLabel;
+    GtkWidget* detailLabel;
+    GtkWidget* autoLabel;
+    NMRemoteConnection* boundConnection;
+    gulong changedHandler;
+};
+
+static const char* connectionTypeIcon(NMConnection* connection) {
+    const char* type = nm_connection_get_connection_type(connection);
+    if (!type) return "network-workgroup-symbolic";
+    if (strcmp(type, NM_SETTING_WIRELESS_SETTING_NAME) == 0) return "network-wireless-symbolic";
+    if (strcmp(type, NM_SETTING_WIRED_SETTING_NAME) == 0) return "network-wired-symbolic";
+    if (strcmp(type, NM_SETTING_VPN_SETTING_NAME) == 0 || strcmp(type, NM_SETTING_WIREGUARD_SETTING_NAME) == 0) {
+        return "network-vpn-symbolic";
+    }
+    return "network-workgroup-symbolic";
+}
+
+void NetworkManager::showSavedConnections() {
+    if (!nmClient) return;
+    
+    if (savedWindow) {
+        // Last-used times may have moved since the window was built
+        populateSavedStore();
+        gtk_window_present(GTK_WINDOW(savedWindow));
+        return;
+    }
+    
+    savedStore = g_list_store_new(NM_TYPE_REMOTE_CONNECTION);
+    populateSavedStore();
+    
+    // store -> sorted by last use -> filtered by search -> multi-selection
+    GtkCustomSorter* sorter = gtk_custom_sorter_new(savedSortCompare, nullptr, nullptr);
+    GtkSortListModel* sorted = gtk_sort_list_model_new(G_LIST_MODEL(g_object_ref(savedStore)), GTK_SORTER(sorter));
+    
+    savedFilter = gtk_custom_filter_new(savedFilterMatch, this, nullptr);
+    GtkFilterListModel* filtered = gtk_filter_list_model_new(G_LIST_MODEL(sorted), GTK_FILTER(savedFilter));
+    gtk_filter_list_model_set_incremental(filtered, TRUE);
+    
+    savedSelection = gtk_multi_selection_new(G_LIST_MODEL(filtered));
+    g_signal_connect(savedSelection, "selection-changed", G_CALLBACK(onSavedSelectionChanged), this);
+    // The filter runs incrementally, so the count is only known as its batches land
+    g_signal_connect(savedSelection, "items-changed", G_CALLBACK(onSavedItemsChanged), this);
+    
+    savedWindow = gtk_window_new();
+    gtk_window_set_title(GTK_WINDOW(savedWindow), TR(TranslationKeys::SAVED_NETWORKS));
+    gtk_window_set_transient_for(GTK_WINDOW(savedWindow), GTK_WINDOW(parentWindow));
+    gtk_window_set_default_size(GTK_WINDOW(savedWindow), 560, 640);
+    gtk_window_set_hide_on_close(GTK_WINDOW(savedWindow), TRUE);
+    
+    GtkWidget* content = gtk_box_new(GTK_ORIENTATION_VERTICAL, 12);
+    gtk_widget_set_margin_top(content, 20);
+    gtk_widget_set_margin_bottom(content, 20);
+    gtk_widget_set_margin_start(content, 20);
+    gtk_widget_set_margin_end(content, 20);
+    
+    savedSearchEntry = gtk_search_entry_new();
+    gtk_search_entry_set_placeholder_text(GTK_SEARCH_ENTRY(savedSearchEntry), TR(TranslationKeys::SAVED_SEARCH_PLACEHOLDER));
+    g_signal_connect(savedSearchEntry, "search-changed", G_CALLBACK(onSavedSearchChanged), this);
+    gtk_box_append(GTK_BOX(content), savedSearchEntry);
+    
+    GtkListItemFactory* factory = gtk_signal_list_item_factory_new();
+    g_signal_connect(factory, "setup", G_CALLBACK(onSavedRowSetup), this);
+    g_signal_connect(factory, "bind", G_CALLBACK(onSavedRowBind), this);
+    g_signal_connect(factory, "unbind", G_CALLBACK(onSavedRowUnbind), this);
+    
+    GtkWidget* listView = gtk_list_view_new(GTK_SELECTION_MODEL(g_object_ref(savedSelection)), factory);
+    GtkWidget* scroller = gtk_scrolled_window_new();
+    gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(scroller), GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+    gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scroller), listView);
+    gtk_widget_set_vexpand(scroller, TRUE);
+    gtk_box_append(GTK_BOX(content), scroller);
+    
+    savedProgress = gtk_progress_bar_new();
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(savedProgress), TRUE);
+    gtk_widget_set_visible(savedProgress, FALSE);
+    gtk_box_append(GTK_BOX(content), savedProgress);
+    
+    // Selection summary and the bulk actions
+    GtkWidget* actions = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+    
+    savedStatusLabel = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(savedStatusLabel), 0.0f);
+    gtk_widget_set_hexpand(savedStatusLabel, TRUE);
+    gtk_box_append(GTK_BOX(actions), savedStatusLabel);
+    
+    savedAutoOffButton = gtk_button_new_with_label(TR(TranslationKeys::SAVED_AUTOCONNECT_OFF));
+    g_signal_connect(savedAutoOffButton, "clicked", G_CALLBACK(onSavedAutoconnectOffClicked), this);
+    gtk_box_append(GTK_BOX(actions), savedAutoOffButton);
+    
+    savedAutoOnButton = gtk_button_new_with_label(TR(TranslationKeys::SAVED_AUTOCONNECT_ON));
+    g_signal_connect(savedAutoOnButton, "clicked", G_CALLBACK(onSavedAutoconnectOnClicked), this);
+    gtk_box_append(GTK_BOX(actions), savedAutoOnButton);
+    
+    savedForgetButton = gtk_button_new_with_label(TR(TranslationKeys::FORGET));
+    gtk_widget_add_css_class(savedForgetButton, "destructive-action");
+    g_signal_connect(savedForgetButton, "clicked", G_CALLBACK(onSavedForgetClicked), this);
+    gtk_box_append(GTK_BOX(actions), savedForgetButton);
+    
+    gtk_box_append(GTK_BOX(content), actions);
+    
+    gtk_window_set_child(GTK_WINDOW(savedWindow), content);
+    updateSavedSummary();
+    gtk_window_present(GTK_WINDOW(savedWindow));
+}
+
+void NetworkManager::populateSavedStore() {
+    if (!savedStore || !nmClient) return;
+    
+    // One splice instead of an items-changed per profile
+    const GPtrArray* connections = nm_client_get_connections(nmClient);
+    guint count = connections ? connections->len : 0;
+    g_list_store_splice(savedStore, 0, g_list_model_get_n_items(G_LIST_MODEL(savedStore)),
+                        connections ? connections->pdata : nullptr, count);
+}
+
+void NetworkManager::updateSavedSummary() {
+    if (!savedSelection || !savedStatusLabel) return;
+    
+    guint total = g_list_model_get_n_items(G_LIST_MODEL(savedStore));
+    guint shown = g_list_model_get_n_items(G_LIST_MODEL(savedSelection));
+    GtkBitset* selected = gtk_selection_model_get_selection(GTK_SELECTION_MODEL(savedSelection));
+    guint64 selectedCount = gtk_bitset_get_size(selected);
+    gtk_bitset_unref(selected);
+    
+    std::string text = std::to_string(shown);
+    if (shown != total) text += " / " + std::to_string(total);
+    text += std::string(" ") + TR(TranslationKeys::SAVED_COUNT);
+    if (selectedCount > 0) {
+        text += ", " + std::to_string(selectedCount) + " " + TR(TranslationKeys::SAVED_SELECTED);
+    }
+    gtk_label_set_text(GTK_LABEL(savedStatusLabel), text.c_str());
+    
+    bool idle = bulkQueue.empty();
+    gtk_widget_set_sensitive(savedForgetButton, idle && selectedCount > 0);
+    gtk_widget_set_sensitive(savedAutoOnButton, idle && selectedCount > 0);
+    gtk_widget_set_sensitive(savedAutoOffButton, idle && selectedCount > 0);
+}
+
+void NetworkManager::bindSavedRow(GtkListItem* listItem) {
+    SavedRowWidgets* w = static_cast<SavedRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    NMConnection* connection = NM_CONNECTION(gtk_list_item_get_item(listItem));
+    if (!w || !connection) return;
+    
+    gtk_image_set_from_icon_name(GTK_IMAGE(w->typeIcon), connectionTypeIcon(connection));
+    
+    const char* id = nm_connection_get_id(connection);
+    gtk_label_set_text(GTK_LABEL(w->nameLabel), id ? id : "");
+    
+    // SSID only when it differs from the profile name
+    std::string detail;
+    NMSettingWireless* sWifi = nm_connection_get_setting_wireless(connection);
+    if (sWifi) {
+        std::string ssid = WifiNetworkModel::ssidFromBytes(nm_setting_wireless_get_ssid(sWifi));
+        if (!ssid.empty() && (!id || ssid != id)) detail = ssid + " · ";
+    }
+    
+    NMSettingConnection* sCon = nm_connection_get_setting_connection(connection);
+    guint64 timestamp = sCon ? nm_setting_connection_get_timestamp(sCon) : 0;
+    if (timestamp == 0) {
+        detail += TR(TranslationKeys::SAVED_NEVER_USED);
+    } else {
+        gint64 age = std::max<gint64>(0, g_get_real_time() / G_USEC_PER_SEC - static_cast<gint64>(timestamp));
+        detail += std::string(TR(TranslationKeys::SAVED_LAST_USED)) + " " +
+                  formatAgo(static_cast<uint32_t>(std::min<gint64>(age, G_MAXUINT32)));
+    }
+    gtk_label_set_text(GTK_LABEL(w->detailLabel), detail.c_str());
+    
+    bool autoconnect = sCon && nm_setting_connection_get_autoconnect(sCon);
+    gtk_label_set_text(GTK_LABEL(w->autoLabel),
+                       autoconnect ? TR(TranslationKeys::SAVED_AUTOCONNECT) : TR(TranslationKeys::SAVED_MANUAL));
+}
+
+void NetworkManager::startBulkOperation(bool forget, bool autoconnect) {
+    if (!savedSelection || !bulkQueue.empty()) return;
+    
+    GtkBitset* selected = gtk_selection_model_get_selection(GTK_SELECTION_MODEL(savedSelection));
+    GtkBitsetIter iter;
+    guint position;
+    for (bool more = gtk_bitset_iter_init_first(&iter, selected, &position); more;
+         more = gtk_bitset_iter_next(&iter, &position)) {
+        gpointer item = g_list_model_get_item(G_LIST_MODEL(savedSelection), position);
+        if (item) bulkQueue.push_back(NM_REMOTE_CONNECTION(item));
+    }
+    gtk_bitset_unref(selected);
+    if (bulkQueue.empty()) return;
+    
+    bulkForget = forget;
+    bulkAutoconnect = autoconnect;
+    bulkNext = 0;
+    bulkInFlight = 0;
+    bulkDone = 0;
+    bulkFailed = 0;
+    bulkCancellable = g_cancellable_new();
+    
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(savedProgress), 0.0);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(savedProgress), ("0 / " + std::to_string(bulkQueue.size())).c_str());
+    gtk_widget_set_visible(savedProgress, TRUE);
+    updateSavedSummary();
+    
+    launchBulkCalls();
+}
+
+void NetworkManager::launchBulkCalls() {
+    while (bulkInFlight < BULK_MAX_IN_FLIGHT && bulkNext < bulkQueue.size()) {
+        NMRemoteConnection* connection = bulkQueue[bulkNext++];
+        
+        if (bulkForget) {
+            ++bulkInFlight;
+            nm_remote_connection_delete_async(connection, bulkCancellable, onBulkDeleteFinished, this);
+            continue;
+        }
+        
+        // Profiles already in the wanted state need no round trip
+        NMSettingConnection* sCon = nm_connection_get_setting_connection(NM_CONNECTION(connection));
+        if (!sCon || nm_setting_connection_get_autoconnect(sCon) == bulkAutoconnect) {
+            ++bulkDone;
+            if (!sCon) ++bulkFailed;
+            continue;
+        }
+        
+        NMConnection* copy = nm_simple_connection_new_clone(NM_CONNECTION(connection));
+        g_object_set(nm_connection_get_setting_connection(copy),
+                     NM_SETTING_CONNECTION_AUTOCONNECT, bulkAutoconnect, nullptr);
+        ++bulkInFlight;
+        nm_remote_connection_update2(connection, nm_connection_to_dbus(copy, NM_CONNECTION_SERIALIZE_ALL),
+                                     NM_SETTINGS_UPDATE2_FLAG_NONE, nullptr, bulkCancellable,
+                                     onBulkUpdateFinished, this);
+        g_object_unref(copy);
+    }
+    
+    if (bulkInFlight == 0 && bulkDone == static_cast<int>(bulkQueue.size())) {
+        completeBulkOperation();
+    }
+}
+
+void NetworkManager::finishBulkCall(bool ok) {
+    --bulkInFlight;
+    ++bulkDone;
+    if (!ok) ++bulkFailed;
+    
+    size_t total = bulkQueue.size();
+    std::string progress = std::to_string(bulkDone) + " / " + std::to_string(total);
+    if (bulkFailed > 0) {
+        progress += " (" + std::to_string(bulkFailed) + " " + TR(TranslationKeys::SAVED_FAILED) + ")";
+    }
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(savedProgress), static_cast<double>(bulkDone) / total);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(savedProgress), progress.c_str());
+    
+    if (static_cast<size_t>(bulkDone) < total) {
+        launchBulkCalls();
+        return;
+    }
+    completeBulkOperation();
+}
+
+void NetworkManager::completeBulkOperation() {
+    size_t total = bulkQueue.size();
+    std::cout << (bulkForget ? "Forgot " : "Updated ") << (bulkDone - bulkFailed) << " of " << total
+              << " saved connections" << std::endl;
+    for (NMRemoteConnection* connection : bulkQueue) {
+        g_object_unref(connection);
     }
+    bulkQueue.clear();
+    g_clear_object(&bulkCancellable);
+    
+    // Failures stay visible; a clean run just hides the bar
+    if (bulkFailed == 0) gtk_widget_set_visible(savedProgress, FALSE);
+    gtk_selection_model_unselect_all(GTK_SELECTION_MODEL(savedSelection));
+    updateSavedSummary();
 }
 
 void NetworkManager::showPasswordDialog(const std::string& ssid, NMAccessPoint* ap) {
@@ -1231,12 +2636,16 @@ void NetworkManager::onPasswordConnectClicked(GtkButton* button, gpointer user_d
             // AP object path as specific_object
             const char* apPath = nm_object_get_path(NM_OBJECT(data->ap));
             
+            NetworkManager* netMgr = data->networkManager;
+            netMgr->beginActivation(data->ssid, NM_DEVICE(data->wifiDev));
             nm_client_add_and_activate_connection_async(
-                data->networkManager->nmClient,
+                netMgr->nmClient,
                 c,
                 NM_DEVICE(data->wifiDev),
                 apPath,
-                nullptr, nullptr, nullptr);
+                netMgr->activationCancellable,
+                onAddAndActivateFinished, netMgr->activationRequest);
+            g_object_unref(c);
         }
     }
     
@@ -1302,17 +2711,8 @@ gboolean NetworkManager::onWifiSwitchStateSet(GtkSwitch* sw, gboolean state, gpo
         nm_client_wireless_set_enabled(netMgr->nmClient, state);
         #pragma GCC diagnostic pop
         
-        // Give some time for the change to take effect before updating UI
-        if (state) {
-            // Enabling Wi-Fi - scan after a delay
-            g_timeout_add(1000, scanWifiNetworksTimeout, netMgr);
-        } else {
-            // Disabling Wi-Fi - update list immediately
-            g_timeout_add(500, populateWifiListTimeout, netMgr);
-        }
-        
-        // Reflect the state change after a short delay
-        g_timeout_add(300, reflectWifiSwitchStateTimeout, netMgr);
+        // notify::wireless-enabled updates the switch and the list once the radio
+        // actually changes, and NetworkManager scans by itself when it comes up
     }
     
     return TRUE; // Prevent default toggle handling
@@ -1323,35 +2723,45 @@ void NetworkManager::onRefreshButtonClicked(GtkButton* button, gpointer user_dat
     
     NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
     if (netMgr) {
-        netMgr->scanWifiNetworks();
+        // Fresh results stay on screen; only stale ones trigger a new scan
+        netMgr->onBatteryPower = PowerSupply::onBatteryPower();
+        netMgr->scanWifiNetworks(true);
     }
 }
 
 void NetworkManager::onConnectButtonClicked(GtkButton* button, gpointer user_data) {
     (void)button;
     
-    ConnectButtonData* data = static_cast<ConnectButtonData*>(user_data);
-    if (data && data->networkManager && data->networkManager->nmClient) {
-        // Find the AP dynamically by SSID to avoid stale pointer issues
-        NMAccessPoint* ap = nullptr;
-        NMDeviceWifi* wifi = data->networkManager->getPrimaryWifiDevice();
-        if (wifi) {
-            const GPtrArray* aps = nm_device_wifi_get_access_points(wifi);
-            if (aps) {
-                for (guint i = 0; i < aps->len; ++i) {
-                    NMAccessPoint* currentAp = static_cast<NMAccessPoint*>(g_ptr_array_index(aps, i));
-                    if (currentAp) {
-                        std::string ssid = data->networkManager->ssidFromBytes(nm_access_point_get_ssid(currentAp));
-                        if (ssid == data->ssid) {
-                            ap = currentAp;
-                            break;
-                        }
+    WifiRowWidgets* row = static_cast<WifiRowWidgets*>(user_data);
+    if (!row || !row->networkManager || !row->networkManager->nmClient) return;
+    
+    // The row may have been re-bound since it was drawn, so read the item now
+    const WifiNetwork* network = elysia_wifi_item_get_network(
+        ELYSIA_WIFI_ITEM(gtk_list_item_get_item(row->listItem)));
+    if (!network) return;
+    
+    std::string targetSsid = network->ssid;
+    bool isSecured = network->isSecured;
+    
+    // Find the AP dynamically by SSID to avoid stale pointer issues
+    NMAccessPoint* ap = nullptr;
+    NMDeviceWifi* wifi = row->networkManager->getPrimaryWifiDevice();
+    if (wifi) {
+        const GPtrArray* aps = nm_device_wifi_get_access_points(wifi);
+        if (aps) {
+            for (guint i = 0; i < aps->len; ++i) {
+                NMAccessPoint* currentAp = static_cast<NMAccessPoint*>(g_ptr_array_index(aps, i));
+                if (currentAp) {
+                    std::string ssid = row->networkManager->ssidFromBytes(nm_access_point_get_ssid(currentAp));
+                    if (ssid == targetSsid) {
+                        ap = currentAp;
+                        break;
                     }
                 }
             }
         }
-        data->networkManager->connectToNetwork(data->ssid, ap, data->isSecured);
     }
+    row->networkManager->connectToNetwork(targetSsid, ap, isSecured);
 }
 
 void NetworkManager::onEnableNetworkingClicked(GtkButton* button, gpointer user_data) {
@@ -1378,15 +2788,116 @@ void NetworkManager::onWifiDeviceChanged(GObject* gobj, GParamSpec* pspec, gpoin
     NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
     if (netMgr) {
         netMgr->updateNetworkState();
+        netMgr->updateConnectionStatus();
     }
 }
 
-gboolean NetworkManager::updateNetworkStateTimeout(gpointer user_data) {
+void NetworkManager::onScanRequestFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
+    GError* error = nullptr;
+    gboolean ok = nm_device_wifi_request_scan_finish(NM_DEVICE_WIFI(source), result, &error);
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+    
     NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
-    if (netMgr && netMgr->nmClient) {
-        netMgr->updateTimeoutId = 0;
-        
-        if (!netMgr->updatingWifiSwitch) {
+    g_clear_object(&netMgr->scanCancellable);
+    
+    if (!ok) {
+        // Usually a scan NetworkManager started itself is still running; its results still arrive
+        std::cout << "Wi-Fi scan request rejected: " << (error ? error->message : "Unknown error") << std::endl;
+        if (error) g_error_free(error);
+        netMgr->scanRequestedAt = 0;
+    }
+    netMgr->updateLastScanLabel();
+}
+
+void NetworkManager::onLastScanChanged(GObject* gobj, GParamSpec* pspec, gpointer user_data) {
+    (void)gobj; (void)pspec;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        // Whoever started it, fresh results satisfy our request too
+        netMgr->scanRequestedAt = 0;
+        netMgr->updateLastScanLabel();
+    }
+}
+
+gboolean NetworkManager::lastScanLabelTimeout(gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->scanLabelTimeoutId = 0;
+        netMgr->updateLastScanLabel();
+    }
+    return G_SOURCE_REMOVE;
+}
+
+void NetworkManager::onWifiModelItemsChanged(GListModel* model, guint position, guint removed, guint added, gpointer user_data) {
+    (void)position;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr || removed == added) return;
+    
+    // Only switching between "no networks" and the list needs the page touched
+    guint count = g_list_model_get_n_items(model);
+    guint before = count - added + removed;
+    if ((count == 0) != (before == 0)) {
+        netMgr->populateWifiList();
+    }
+}
+
+void NetworkManager::onNetworkRowSetup(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data) {
+    (void)factory;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->buildNetworkRow(listItem);
+    }
+}
+
+void NetworkManager::onNetworkRowBind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data) {
+    (void)factory;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    WifiRowWidgets* w = static_cast<WifiRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    if (!netMgr || !w) return;
+    
+    // Follow the item so strength and status changes redraw only this row
+    w->boundItem = ELYSIA_WIFI_ITEM(gtk_list_item_get_item(listItem));
+    if (w->boundItem) {
+        w->changedHandler = g_signal_connect(w->boundItem, "changed",
+                                             G_CALLBACK(onNetworkItemChanged), listItem);
+    }
+    netMgr->bindNetworkRow(listItem);
+}
+
+void NetworkManager::onNetworkRowUnbind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data) {
+    (void)factory; (void)user_data;
+    
+    WifiRowWidgets* w = static_cast<WifiRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    if (w && w->boundItem) {
+        g_signal_handler_disconnect(w->boundItem, w->changedHandler);
+        w->boundItem = nullptr;
+        w->changedHandler = 0;
+    }
+}
+
+void NetworkManager::onNetworkItemChanged(ElysiaWifiItem* item, gpointer user_data) {
+    (void)item;
+    
+    GtkListItem* listItem = GTK_LIST_ITEM(user_data);
+    WifiRowWidgets* w = static_cast<WifiRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    if (w && w->networkManager) {
+        w->networkManager->bindNetworkRow(listItem);
+    }
+}
+
+gboolean NetworkManager::updateNetworkStateTimeout(gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr && netMgr->nmClient) {
+        netMgr->updateTimeoutId = 0;
+        
+        if (!netMgr->updatingWifiSwitch) {
             netMgr->reflectWifiSwitchState();
             netMgr->populateWifiList();
             netMgr->updateConnectionStatus();
@@ -1396,36 +2907,719 @@ gboolean NetworkManager::updateNetworkStateTimeout(gpointer user_data) {
     return G_SOURCE_REMOVE;
 }
 
-gboolean NetworkManager::populateWifiListTimeout(gpointer user_data) {
+gboolean NetworkManager::throughputSampleTimeout(gpointer user_data) {
     NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
-    if (netMgr && netMgr->nmClient) {
-        netMgr->populateWifiList();
+    if (!netMgr) return G_SOURCE_REMOVE;
+    
+    if (!netMgr->throughputMonitor.sample(g_get_monotonic_time() / 1e6)) {
+        // The interface went away underneath us
+        netMgr->throughputTimeoutId = 0;
+        netMgr->throughputMonitor.close();
+        gtk_widget_set_visible(netMgr->throughputArea, FALSE);
+        return G_SOURCE_REMOVE;
     }
-    return G_SOURCE_REMOVE;
+    gtk_widget_queue_draw(netMgr->throughputArea);
+    
+    // Idle links are sampled less often; re-arm when the pace changes
+    int interval = netMgr->throughputMonitor.nextIntervalMs();
+    if (netMgr->onBatteryPower) interval = std::max(interval, BATTERY_THROUGHPUT_INTERVAL_MS);
+    if (interval != netMgr->throughputIntervalMs) {
+        netMgr->throughputIntervalMs = interval;
+        netMgr->throughputTimeoutId = g_timeout_add(interval, throughputSampleTimeout, netMgr);
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
 }
 
-gboolean NetworkManager::scanWifiNetworksTimeout(gpointer user_data) {
+gboolean NetworkManager::onProcessBandwidthEvent(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd; (void)condition;
+    
     NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
-    if (netMgr && netMgr->nmClient) {
-        netMgr->scanWifiNetworks();
+    if (!netMgr || !netMgr->processBandwidth) return G_SOURCE_REMOVE;
+    
+    netMgr->processBandwidth->acknowledge();
+    netMgr->updateAppUsageRows();
+    
+    // The sampler gives up when sock_diag is unavailable
+    if (!netMgr->processBandwidth->isRunning()) {
+        netMgr->processBandwidthWatchId = 0;
+        return G_SOURCE_REMOVE;
     }
-    return G_SOURCE_REMOVE;
+    return G_SOURCE_CONTINUE;
 }
 
-gboolean NetworkManager::reflectWifiSwitchStateTimeout(gpointer user_data) {
+void NetworkManager::drawThroughputGraph(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data) {
     NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
-    if (netMgr && netMgr->nmClient) {
-        netMgr->reflectWifiSwitchState();
+    if (!netMgr || width <= 0 || height <= 0) return;
+    
+    const ThroughputMonitor& monitor = netMgr->throughputMonitor;
+    const double textHeight = 22.0;
+    
+    // Current rates on the left, totals since the link came up on the right
+    std::string rates = "\u2193 " + ThroughputMonitor::formatBytes(monitor.currentRxRate()) + "/s   "
+                        "\u2191 " + ThroughputMonitor::formatBytes(monitor.currentTxRate()) + "/s";
+    std::string totals = std::string(TR(TranslationKeys::THROUGHPUT_TOTAL)) +
+                         "  \u2193 " + ThroughputMonitor::formatBytes(monitor.totalRxBytes()) +
+                         "  \u2191 " + ThroughputMonitor::formatBytes(monitor.totalTxBytes());
+    
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.95);
+    PangoLayout* layout = gtk_widget_create_pango_layout(GTK_WIDGET(area), rates.c_str());
+    cairo_move_to(cr, 4, 0);
+    pango_cairo_show_layout(cr, layout);
+    
+    int totalsWidth = 0;
+    pango_layout_set_text(layout, totals.c_str(), -1);
+    pango_layout_get_pixel_size(layout, &totalsWidth, nullptr);
+    cairo_move_to(cr, width - totalsWidth - 4, 0);
+    pango_cairo_show_layout(cr, layout);
+    g_object_unref(layout);
+    
+    const double graphTop = textHeight;
+    const double graphHeight = height - graphTop - 2.0;
+    
+    // Baseline
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.35);
+    cairo_set_line_width(cr, 1.0);
+    cairo_move_to(cr, 0, graphTop + graphHeight + 0.5);
+    cairo_line_to(cr, width, graphTop + graphHeight + 0.5);
+    cairo_stroke(cr);
+    
+    if (monitor.size() < 2 || graphHeight <= 0) return;
+    
+    // Keep a floor so an idle link doesn't blow noise up to full height
+    const double peak = std::max(monitor.peakRate(), 16.0 * 1024.0);
+    const double newest = monitor.at(monitor.size() - 1).timestamp;
+    auto xFor = [&](double t) {
+        return width * (1.0 - (newest - t) / ThroughputMonitor::WINDOW_SECONDS);
+    };
+    auto yFor = [&](double rate) {
+        return graphTop + graphHeight * (1.0 - rate / peak);
+    };
+    
+    // Download as a filled area
+    cairo_move_to(cr, xFor(monitor.at(0).timestamp), graphTop + graphHeight);
+    for (size_t i = 0; i < monitor.size(); ++i) {
+        const ThroughputSample& s = monitor.at(i);
+        cairo_line_to(cr, xFor(s.timestamp), yFor(s.rxRate));
+    }
+    cairo_line_to(cr, width, graphTop + graphHeight);
+    cairo_close_path(cr);
+    cairo_set_source_rgba(cr, 0.29, 0.87, 0.50, 0.35);
+    cairo_fill(cr);
+    
+    // Upload as a line on top
+    for (size_t i = 0; i < monitor.size(); ++i) {
+        const ThroughputSample& s = monitor.at(i);
+        if (i == 0) cairo_move_to(cr, xFor(s.timestamp), yFor(s.txRate));
+        else cairo_line_to(cr, xFor(s.timestamp), yFor(s.txRate));
+    }
+    cairo_set_source_rgba(cr, 0.99, 0.52, 0.80, 1.0);
+    cairo_set_line_width(cr, 1.5);
+    cairo_stroke(cr);
+}
+
+gboolean NetworkManager::hideActivationTimeout(gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->activationHideTimeoutId = 0;
+        netMgr->activationStage = ActivationStage::Idle;
+        if (netMgr->activationBox) gtk_widget_set_visible(netMgr->activationBox, FALSE);
     }
     return G_SOURCE_REMOVE;
 }
 
+void NetworkManager::onActivateConnectionFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
+    GError* error = nullptr;
+    NMActiveConnection* connection = nm_client_activate_connection_finish(NM_CLIENT(source), result, &error);
+    onActivationRequestDone(connection, error, user_data, false);
+}
+
+void NetworkManager::onAddAndActivateFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
+    GError* error = nullptr;
+    NMActiveConnection* connection = nm_client_add_and_activate_connection_finish(NM_CLIENT(source), result, &error);
+    onActivationRequestDone(connection, error, user_data, true);
+}
+
+void NetworkManager::onActivationRequestDone(NMActiveConnection* connection, GError* error, gpointer user_data, bool addedProfile) {
+    ActivationRequest* request = static_cast<ActivationRequest*>(user_data);
+    
+    // Cancel was pressed before this reply: undo what the request started,
+    // including the profile it created for a network not saved before
+    if (request->abandoned) {
+        if (connection) {
+            NMRemoteConnection* profile = nm_active_connection_get_connection(connection);
+            nm_client_deactivate_connection_async(request->client, connection, nullptr, nullptr, nullptr);
+            if (addedProfile && profile) {
+                nm_remote_connection_delete_async(profile, nullptr, nullptr, nullptr);
+            }
+            g_object_unref(connection);
+        }
+        if (error) g_error_free(error);
+        g_object_unref(request->client);
+        delete request;
+        return;
+    }
+    
+    NetworkManager* netMgr = request->networkManager;
+    g_object_unref(request->client);
+    delete request;
+    
+    // Cancelled means the attempt was superseded or the page is gone
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        if (connection) g_object_unref(connection);
+        return;
+    }
+    
+    netMgr->activationRequest = nullptr;
+    g_clear_object(&netMgr->activationCancellable);
+    
+    if (!connection) {
+        netMgr->setActivationStage(ActivationStage::Failed, error ? error->message : "unknown error");
+        if (error) g_error_free(error);
+        return;
+    }
+    
+    netMgr->trackActiveConnection(connection);
+}
+
+void NetworkManager::onActiveConnectionStateChanged(NMActiveConnection* connection, guint state, guint reason, gpointer user_data) {
+    (void)connection; (void)reason;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr) return;
+    
+    if (state == NM_ACTIVE_CONNECTION_STATE_ACTIVATED) {
+        netMgr->setActivationStage(ActivationStage::Activated);
+    } else if (state == NM_ACTIVE_CONNECTION_STATE_DEACTIVATED) {
+        // The device reason says more than the active-connection one
+        guint deviceReason = netMgr->activationDevice ? nm_device_get_state_reason(netMgr->activationDevice) : 0;
+        netMgr->setActivationStage(ActivationStage::Failed, deviceReasonText(deviceReason));
+    }
+}
+
+void NetworkManager::onActivationDeviceStateChanged(NMDevice* device, guint newState, guint oldState, guint reason, gpointer user_data) {
+    (void)device; (void)oldState;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr) return;
+    
+    switch (newState) {
+        case NM_DEVICE_STATE_PREPARE:
+            netMgr->setActivationStage(ActivationStage::Prepare);
+            break;
+        case NM_DEVICE_STATE_CONFIG:
+            netMgr->setActivationStage(ActivationStage::Config);
+            break;
+        case NM_DEVICE_STATE_NEED_AUTH:
+            netMgr->setActivationStage(ActivationStage::NeedAuth);
+            break;
+        case NM_DEVICE_STATE_IP_CONFIG:
+            netMgr->setActivationStage(ActivationStage::IpConfig);
+            break;
+        case NM_DEVICE_STATE_IP_CHECK:
+        case NM_DEVICE_STATE_SECONDARIES:
+            netMgr->setActivationStage(ActivationStage::IpCheck);
+            break;
+        case NM_DEVICE_STATE_ACTIVATED:
+            netMgr->setActivationStage(ActivationStage::Activated);
+            break;
+        case NM_DEVICE_STATE_FAILED:
+            netMgr->setActivationStage(ActivationStage::Failed, deviceReasonText(reason));
+            break;
+        default:
+            break;
+    }
+}
+
+void NetworkManager::onActivationCancelClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->cancelActivation();
+    }
+}
+
+void NetworkManager::onDiagnosticsButtonClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->showDiagnostics();
+    }
+}
+
+void NetworkManager::onDiagnosticsRunClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr) return;
+    
+    // The same button stops a run that is still going
+    bool busy = netMgr->diagnosticsCancellable || (netMgr->networkProbe && netMgr->networkProbe->isRunning());
+    if (busy) {
+        netMgr->stopDiagnostics();
+    } else {
+        netMgr->startDiagnostics();
+    }
+}
+
+gboolean NetworkManager::onDiagnosticsCloseRequest(GtkWindow* window, gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->stopDiagnostics();
+    }
+    
+    // Kept around so the last results are still there next time
+    gtk_widget_set_visible(GTK_WIDGET(window), FALSE);
+    return TRUE;
+}
+
+void NetworkManager::onDiagnosticsHostResolved(GObject* source, GAsyncResult* result, gpointer user_data) {
+    DiagnosticsLookupData* data = static_cast<DiagnosticsLookupData*>(user_data);
+    
+    GError* error = nullptr;
+    GList* addresses = g_resolver_lookup_by_name_finish(G_RESOLVER(source), result, &error);
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        delete data;
+        return;
+    }
+    
+    NetworkManager* netMgr = data->networkManager;
+    g_clear_object(&netMgr->diagnosticsCancellable);
+    
+    std::string address;
+    if (addresses) {
+        gchar* text = g_inet_address_to_string(G_INET_ADDRESS(addresses->data));
+        address = text;
+        g_free(text);
+        g_resolver_free_addresses(addresses);
+    } else {
+        std::cout << "Diagnostics: cannot resolve " << data->host << ": "
+                  << (error ? error->message : "Unknown error") << std::endl;
+    }
+    if (error) g_error_free(error);
+    
+    // Without an address only the gateway and resolvers are measured
+    netMgr->runDiagnostics(address, data->port, data->label, data->host);
+    delete data;
+}
+
+gboolean NetworkManager::onDiagnosticsProbeEvent(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd; (void)condition;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr || !netMgr->networkProbe) return G_SOURCE_REMOVE;
+    
+    // Checked first: once the worker has stopped, every result it published is visible
+    bool finished = !netMgr->networkProbe->isRunning();
+    netMgr->networkProbe->acknowledge();
+    netMgr->updateDiagnosticsResults();
+    
+    if (finished) {
+        netMgr->diagnosticsWatchId = 0;
+        if (netMgr->diagnosticsRunButton) {
+            gtk_button_set_label(GTK_BUTTON(netMgr->diagnosticsRunButton), TR(TranslationKeys::DIAGNOSTICS_RUN));
+        }
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void NetworkManager::onSavedNetworksClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->showSavedConnections();
+    }
+}
+
+void NetworkManager::onSavedSearchChanged(GtkSearchEntry* entry, gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr || !netMgr->savedFilter) return;
+    
+    gchar* folded = g_utf8_casefold(gtk_editable_get_text(GTK_EDITABLE(entry)), -1);
+    std::string query = folded;
+    g_free(folded);
+    if (query == netMgr->savedQuery) return;
+    
+    // Typing more only narrows the current matches, deleting only widens them
+    GtkFilterChange change = GTK_FILTER_CHANGE_DIFFERENT;
+    if (query.find(netMgr->savedQuery) != std::string::npos) {
+        change = GTK_FILTER_CHANGE_MORE_STRICT;
+    } else if (netMgr->savedQuery.find(query) != std::string::npos) {
+        change = GTK_FILTER_CHANGE_LESS_STRICT;
+    }
+    netMgr->savedQuery = query;
+    gtk_filter_changed(GTK_FILTER(netMgr->savedFilter), change);
+}
+
+gboolean NetworkManager::savedFilterMatch(gpointer item, gpointer user_data) {
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr || netMgr->savedQuery.empty()) return TRUE;
+    
+    NMConnection* connection = NM_CONNECTION(item);
+    const char* id = nm_connection_get_id(connection);
+    if (id) {
+        gchar* folded = g_utf8_casefold(id, -1);
+        bool match = strstr(folded, netMgr->savedQuery.c_str()) != nullptr;
+        g_free(folded);
+        if (match) return TRUE;
+    }
+    
+    // Profiles are often renamed; the SSID still finds them
+    NMSettingWireless* sWifi = nm_connection_get_setting_wireless(connection);
+    if (sWifi) {
+        std::string ssid = WifiNetworkModel::ssidFromBytes(nm_setting_wireless_get_ssid(sWifi));
+        gchar* folded = g_utf8_casefold(ssid.c_str(), -1);
+        bool match = strstr(folded, netMgr->savedQuery.c_str()) != nullptr;
+        g_free(folded);
+        return match;
+    }
+    return FALSE;
+}
+
+int NetworkManager::savedSortCompare(gconstpointer a, gconstpointer b, gpointer user_data) {
+    (void)user_data;
+    
+    NMConnection* first = NM_CONNECTION(const_cast<gpointer>(a));
+    NMConnection* second = NM_CONNECTION(const_cast<gpointer>(b));
+    NMSettingConnection* sFirst = nm_connection_get_setting_connection(first);
+    NMSettingConnection* sSecond = nm_connection_get_setting_connection(second);
+    guint64 tFirst = sFirst ? nm_setting_connection_get_timestamp(sFirst) : 0;
+    guint64 tSecond = sSecond ? nm_setting_connection_get_timestamp(sSecond) : 0;
+    
+    // Most recently used first, so stale profiles collect at the bottom
+    if (tFirst != tSecond) return tFirst > tSecond ? -1 : 1;
+    return g_strcmp0(nm_connection_get_id(first), nm_connection_get_id(second));
+}
+
+void NetworkManager::onSavedRowSetup(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data) {
+    (void)factory;
+    
+    SavedRowWidgets* w = new SavedRowWidgets();
+    w->networkManager = static_cast<NetworkManager*>(user_data);
+    w->boundConnection = nullptr;
+    w->changedHandler = 0;
+    
+    GtkWidget* rowBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    gtk_widget_set_margin_top(rowBox, 6);
+    gtk_widget_set_margin_bottom(rowBox, 6);
+    gtk_widget_set_margin_start(rowBox, 8);
+    gtk_widget_set_margin_end(rowBox, 8);
+    
+    w->typeIcon = gtk_image_new();
+    gtk_image_set_pixel_size(GTK_IMAGE(w->typeIcon), 20);
+    gtk_box_append(GTK_BOX(rowBox), w->typeIcon);
+    
+    GtkWidget* textBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+    gtk_widget_set_hexpand(textBox, TRUE);
+    
+    w->nameLabel = gtk_label_new("");
+    gtk_label_set_xalign(GTK_LABEL(w->nameLabel), 0.0f);
+    gtk_label_set_ellipsize(GTK_LABEL(w->nameLabel), PANGO_ELLIPSIZE_END);
+    gtk_box_append(GTK_BOX(textBox), w->nameLabel);
+    
+    w->detailLabel = gtk_label_new("");
+    gtk_widget_add_css_class(w->detailLabel, "dim-label");
+    gtk_label_set_xalign(GTK_LABEL(w->detailLabel), 0.0f);
+    gtk_label_set_ellipsize(GTK_LABEL(w->detailLabel), PANGO_ELLIPSIZE_END);
+    gtk_box_append(GTK_BOX(textBox), w->detailLabel);
+    gtk_box_append(GTK_BOX(rowBox), textBox);
+    
+    w->autoLabel = gtk_label_new("");
+    gtk_widget_add_css_class(w->autoLabel, "dim-label");
+    gtk_box_append(GTK_BOX(rowBox), w->autoLabel);
+    
+    gtk_list_item_set_child(listItem, rowBox);
+    g_object_set_data_full(G_OBJECT(listItem), "row-widgets", w,
+                           [](gpointer data) { delete static_cast<SavedRowWidgets*>(data); });
+}
+
+void NetworkManager::onSavedRowBind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data) {
+    (void)factory;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    SavedRowWidgets* w = static_cast<SavedRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    if (!netMgr || !w) return;
+    
+    // Renames and autoconnect flips show up without rebuilding the list
+    w->boundConnection = NM_REMOTE_CONNECTION(gtk_list_item_get_item(listItem));
+    if (w->boundConnection) {
+        w->changedHandler = g_signal_connect(w->boundConnection, "changed",
+                                             G_CALLBACK(onSavedRowConnectionChanged), listItem);
+    }
+    netMgr->bindSavedRow(listItem);
+}
+
+void NetworkManager::onSavedRowUnbind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data) {
+    (void)factory; (void)user_data;
+    
+    SavedRowWidgets* w = static_cast<SavedRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    if (w && w->boundConnection) {
+        g_signal_handler_disconnect(w->boundConnection, w->changedHandler);
+        w->boundConnection = nullptr;
+        w->changedHandler = 0;
+    }
+}
+
+void NetworkManager::onSavedRowConnectionChanged(NMRemoteConnection* connection, gpointer user_data) {
+    (void)connection;
+    
+    GtkListItem* listItem = GTK_LIST_ITEM(user_data);
+    SavedRowWidgets* w = static_cast<SavedRowWidgets*>(g_object_get_data(G_OBJECT(listItem), "row-widgets"));
+    if (w && w->networkManager) {
+        w->networkManager->bindSavedRow(listItem);
+    }
+}
+
+void NetworkManager::onSavedSelectionChanged(GtkSelectionModel* model, guint position, guint count, gpointer user_data) {
+    (void)model; (void)position; (void)count;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->updateSavedSummary();
+    }
+}
+
+void NetworkManager::onSavedItemsChanged(GListModel* model, guint position, guint removed, guint added, gpointer user_data) {
+    (void)model; (void)position; (void)removed; (void)added;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->updateSavedSummary();
+    }
+}
+
+void NetworkManager::onSavedForgetClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (!netMgr || !netMgr->savedWindow) return;
+    
+    // Forgetting drops stored passwords too, so ask once for the whole batch
+    GtkAlertDialog* confirm = gtk_alert_dialog_new("%s", TR(TranslationKeys::SAVED_FORGET_CONFIRM));
+    const char* buttons[] = {TR(TranslationKeys::CANCEL), TR(TranslationKeys::FORGET), nullptr};
+    gtk_alert_dialog_set_buttons(confirm, buttons);
+    gtk_alert_dialog_set_cancel_button(confirm, 0);
+    gtk_alert_dialog_set_default_button(confirm, 0);
+    gtk_alert_dialog_choose(confirm, GTK_WINDOW(netMgr->savedWindow), nullptr, onSavedForgetConfirmed, netMgr);
+    g_object_unref(confirm);
+}
+
+void NetworkManager::onSavedForgetConfirmed(GObject* source, GAsyncResult* result, gpointer user_data) {
+    int choice = gtk_alert_dialog_choose_finish(GTK_ALERT_DIALOG(source), result, nullptr);
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr && choice == 1) {
+        netMgr->startBulkOperation(true, false);
+    }
+}
+
+void NetworkManager::onSavedAutoconnectOnClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->startBulkOperation(false, true);
+    }
+}
+
+void NetworkManager::onSavedAutoconnectOffClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    NetworkManager* netMgr = static_cast<NetworkManager*>(user_data);
+    if (netMgr) {
+        netMgr->startBulkOperation(false, false);
+    }
+}
+
+void NetworkManager::onBulkDeleteFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
+    GError* error = nullptr;
+    gboolean ok = nm_remote_connection_delete_finish(NM_REMOTE_CONNECTION(source), result, &error);
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+    if (error) {
+        std::cout << "Failed to forget " << nm_connection_get_id(NM_CONNECTION(source)) << ": "
+                  << error->message << std::endl;
+        g_error_free(error);
+    }
+    
+    static_cast<NetworkManager*>(user_data)->finishBulkCall(ok);
+}
+
+void NetworkManager::onBulkUpdateFinished(GObject* source, GAsyncResult* result, gpointer user_data) {
+    GError* error = nullptr;
+    GVariant* reply = nm_remote_connection_update2_finish(NM_REMOTE_CONNECTION(source), result, &error);
+    if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        return;
+    }
+    if (reply) g_variant_unref(reply);
+    if (error) {
+        std::cout << "Failed to update " << nm_connection_get_id(NM_CONNECTION(source)) << ": "
+                  << error->message << std::endl;
+        g_error_free(error);
+    }
+    
+    static_cast<NetworkManager*>(user_data)->finishBulkCall(reply != nullptr);
+}
+
+static const char* frequencyBand(int frequency) {
+    if (frequency <= 0) return "?";
+    if (frequency < 3000) return "2.4 GHz";
+    if (frequency < 5925) return "5 GHz";
+    return "6 GHz";
+}
+
+gboolean NetworkManager::onNetworkRowQueryTooltip(GtkWidget* widget, int x, int y, gboolean keyboard, GtkTooltip* tooltip, gpointer user_data) {
+    (void)widget; (void)x; (void)y; (void)keyboard;
+    
+    WifiRowWidgets* w = static_cast<WifiRowWidgets*>(user_data);
+    if (!w || !w->networkManager || !w->networkManager->wifiModel) return FALSE;
+    
+    ElysiaWifiItem* item = ELYSIA_WIFI_ITEM(gtk_list_item_get_item(w->listItem));
+    const WifiNetwork* network = elysia_wifi_item_get_network(item);
+    if (!network || network->bssid.empty()) return FALSE;
+    
+    // Built on demand so idle rows never format anything
+    std::string text = network->bssid;
+    if (network->apCount > 1) {
+        text += " " + TRF(TranslationKeys::WIFI_MORE_ACCESS_POINTS, std::to_string(network->apCount - 1));
+    }
+    
+    const SignalHistory& history = w->networkManager->wifiModel->getHistory();
+    const SignalTrack* track = history.find(elysia_wifi_item_get_key(item));
+    uint32_t now = WifiNetworkModel::currentTime();
+    if (track && track->count > 0) {
+        int low = 100, high = 0;
+        for (size_t i = 0; i < track->count; ++i) {
+            low = std::min<int>(low, track->at(i).strength);
+            high = std::max<int>(high, track->at(i).strength);
+        }
+        text += "\n" + TRF(TranslationKeys::WIFI_SIGNAL_RANGE, std::to_string(low), std::to_string(high),
+                           formatAgo(now - track->at(0).time));
+    }
+    
+    auto duration = w->networkManager->connectDurations.find(network->ssid);
+    if (duration != w->networkManager->connectDurations.end()) {
+        char seconds[32];
+        snprintf(seconds, sizeof(seconds), "%.1f s", duration->second / 1000.0);
+        text += "\n" + TRF(TranslationKeys::WIFI_LAST_CONNECT, seconds);
+    }
+    
+    // Newest roaming events for this SSID
+    int shown = 0;
+    for (size_t i = history.eventCount(); i > 0 && shown < 5; --i) {
+        const RoamEvent& e = history.event(i - 1);
+        if (e.ssid != network->ssid) continue;
+        
+        text += "\n";
+        switch (e.kind) {
+            case RoamEvent::Kind::Connected:
+                text += TRF(TranslationKeys::ROAM_CONNECTED, SignalHistory::formatBssid(e.toBssid),
+                            frequencyBand(e.toFrequency));
+                break;
+            case RoamEvent::Kind::Roamed:
+                text += TRF(TranslationKeys::ROAM_ROAMED, SignalHistory::formatBssid(e.fromBssid),
+                            SignalHistory::formatBssid(e.toBssid), frequencyBand(e.fromFrequency),
+                            frequencyBand(e.toFrequency));
+                break;
+            case RoamEvent::Kind::Lost:
+                text += TRF(TranslationKeys::ROAM_LOST, SignalHistory::formatBssid(e.fromBssid));
+                break;
+        }
+        text += ", " + formatAgo(now - e.time);
+        ++shown;
+    }
+    
+    gtk_tooltip_set_text(tooltip, text.c_str());
+    return TRUE;
+}
+
+void NetworkManager::drawSignalSparkline(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data) {
+    (void)area;
+    
+    WifiRowWidgets* w = static_cast<WifiRowWidgets*>(user_data);
+    if (!w || !w->networkManager || !w->networkManager->wifiModel || width <= 0 || height <= 0) return;
+    
+    ElysiaWifiItem* item = ELYSIA_WIFI_ITEM(gtk_list_item_get_item(w->listItem));
+    const SignalTrack* track = w->networkManager->wifiModel->getHistory().find(elysia_wifi_item_get_key(item));
+    if (!track || track->count < 2) return;
+    
+    // Points arrive irregularly, so x follows time; at least a minute is shown
+    const double first = track->at(0).time;
+    const double span = std::max(60.0, static_cast<double>(WifiNetworkModel::currentTime()) - first);
+    auto xFor = [&](uint32_t t) { return (t - first) / span * (width - 1); };
+    auto yFor = [&](uint8_t strength) { return 1.0 + (height - 2.0) * (1.0 - strength / 100.0); };
+    
+    cairo_set_line_width(cr, 1.5);
+    cairo_set_line_join(cr, CAIRO_LINE_JOIN_ROUND);
+    
+    // Each segment is coloured by band; a tick marks every BSSID change
+    for (size_t i = 1; i < track->count; ++i) {
+        const SignalPoint& a = track->at(i - 1);
+        const SignalPoint& b = track->at(i);
+        
+        if (b.frequency < 3000) cairo_set_source_rgba(cr, 0.98, 0.75, 0.14, 1.0);
+        else if (b.frequency < 5925) cairo_set_source_rgba(cr, 0.29, 0.87, 0.50, 1.0);
+        else cairo_set_source_rgba(cr, 0.38, 0.65, 0.98, 1.0);
+        
+        cairo_move_to(cr, xFor(a.time), yFor(a.strength));
+        cairo_line_to(cr, xFor(b.time), yFor(a.strength));
+        cairo_line_to(cr, xFor(b.time), yFor(b.strength));
+        cairo_stroke(cr);
+        
+        if (a.bssidSlot != b.bssidSlot) {
+            cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.7);
+            cairo_set_line_width(cr, 1.0);
+            cairo_move_to(cr, xFor(b.time) + 0.5, 0);
+            cairo_line_to(cr, xFor(b.time) + 0.5, height);
+            cairo_stroke(cr);
+            cairo_set_line_width(cr, 1.5);
+        }
+    }
+    
+    // Hold the last value up to now
+    const SignalPoint& last = track->at(track->count - 1);
+    cairo_move_to(cr, xFor(last.time), yFor(last.strength));
+    cairo_line_to(cr, width - 1, yFor(last.strength));
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.5);
+    cairo_stroke(cr);
+}
+
 void NetworkManager::onNetworkSettingsClicked(GtkButton* button, gpointer user_data) {
     (void)button;
-    NetworkSettingsData* data = static_cast<NetworkSettingsData*>(user_data);
-    if (data && data->networkManager && data->networkManager->nmClient) {
-        data->networkManager->showNetworkSettings(data->ssid, data->activeConnection);
+    
+    WifiRowWidgets* row = static_cast<WifiRowWidgets*>(user_data);
+    if (!row || !row->networkManager || !row->networkManager->nmClient) return;
+    
+    const WifiNetwork* network = elysia_wifi_item_get_network(
+        ELYSIA_WIFI_ITEM(gtk_list_item_get_item(row->listItem)));
+    if (!network) return;
+    
+    // Find active connection for this network
+    NMActiveConnection* activeConn = nullptr;
+    const GPtrArray* activeConnections = nm_client_get_active_connections(row->networkManager->nmClient);
+    if (activeConnections) {
+        for (guint i = 0; i < activeConnections->len; i++) {
+            NMActiveConnection* conn = static_cast<NMActiveConnection*>(g_ptr_array_index(activeConnections, i));
+            if (conn) {
+                const char* connId = nm_active_connection_get_id(conn);
+                if (connId && network->ssid == std::string(connId)) {
+                    activeConn = conn;
+                    break;
+                }
+            }
+        }
     }
+    
+    row->networkManager->showNetworkSettings(network->ssid, activeConn);
 }
 
 void NetworkManager::showNetworkSettings(const std::string& ssid, NMActiveConnection* activeConnection) {
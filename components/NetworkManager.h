@@ -4,19 +4,40 @@
 #include <gtk/gtk.h>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <memory>
 #include <NetworkManager.h>
+#include "WifiNetworkModel.h"
+#include "ThroughputMonitor.h"
+#include "NetworkProbe.h"
+#include "ProcessBandwidth.h"
 
 class MainWindow; // Forward declaration
+struct ActivationRequest;
 
-struct WifiNetwork {
-    std::string ssid;
-    std::string security;
-    int strength;
-    bool isActive;
-    bool isSaved;
-    bool isSecured;
-    NMAccessPoint* ap;
-    std::string status;
+// Where the connection attempt started from the Wi-Fi list currently is
+enum class ActivationStage {
+    Idle,
+    Requesting,
+    Prepare,
+    Config,
+    NeedAuth,
+    IpConfig,
+    IpCheck,
+    Activated,
+    Failed,
+    Cancelled
+};
+
+// One pooled line of the per-application usage list; texts are cached so
+// unchanged rows are never touched
+struct AppUsageRow {
+    GtkWidget* row;
+    GtkWidget* nameLabel;
+    GtkWidget* rateLabel;
+    std::string nameText;
+    std::string rateText;
+    std::string tooltipText;
 };
 
 class NetworkManager {
@@ -35,42 +56,159 @@ private:
     GtkWidget* networkContainer;
     GtkWidget* backButton;
     GtkWidget* wifiSwitch;
-    GtkWidget* wifiListBox;
+    GtkWidget* wifiListBox;      // status messages (loading, disabled, ...)
+    GtkWidget* wifiListView;     // recycled rows backed by wifiModel
+    GtkWidget* wifiStack;
     GtkWidget* refreshButton;
+    GtkWidget* lastScanLabel;
+    GtkWidget* diagnosticsButton;
+    GtkWidget* savedNetworksButton;
     GtkWidget* scrolledWindow;
     GtkWidget* connectionStatusLabel;
+    GtkWidget* throughputArea;
+    GtkWidget* activationBox;
+    GtkWidget* activationLabel;
+    GtkWidget* activationProgress;
+    GtkWidget* activationCancelButton;
     
-    // NetworkManager client
+    // NetworkManager client, created asynchronously the first time the page is shown
     NMClient* nmClient;
+    GCancellable* nmClientCancellable;
+    bool nmClientSignalsConnected;
     std::vector<GtkWidget*> networkWidgets;
+    std::unique_ptr<WifiNetworkModel> wifiModel;
+    
+    // Saved Wi-Fi profiles keyed by SSID, kept current from client signals
+    std::unordered_map<std::string, std::vector<NMRemoteConnection*>> savedConnectionsBySsid;
     
     // State tracking
     bool updatingWifiSwitch;
     bool networkingEnabled;
     bool hasEthernetConnection;
+    bool wifiHardwareEnabled;
+    bool wifiSoftwareEnabled;
     guint updateTimeoutId;
     
+    // Live rx/tx of the device shown in connectionStatusLabel
+    ThroughputMonitor throughputMonitor;
+    guint throughputTimeoutId;
+    int throughputIntervalMs;
+    
+    // Connection attempt, advanced only by NMActiveConnection/NMDevice signals
+    ActivationStage activationStage;
+    std::string activationSsid;
+    gint64 activationStartTime;
+    GCancellable* activationCancellable;
+    ActivationRequest* activationRequest;  // the add/activate call awaiting its reply
+    NMActiveConnection* activationConnection;
+    NMDevice* activationDevice;
+    guint activationHideTimeoutId;
+    std::unordered_map<std::string, gint64> connectDurations; // ms, last attempt per SSID
+    
+    // Scan requests; NetworkManager's own last-scan stamp decides whether one is needed
+    GCancellable* scanCancellable;
+    gint64 scanRequestedAt;   // boottime ms of the request still waiting for results, 0 if none
+    guint scanLabelTimeoutId;
+    bool onBatteryPower;
+    
+    // Diagnostics window; probes run on NetworkProbe's worker and report back through its eventfd
+    GtkWidget* diagnosticsWindow;
+    GtkWidget* diagnosticsHostEntry;
+    GtkWidget* diagnosticsSamplesSpin;
+    GtkWidget* diagnosticsRunButton;
+    GtkWidget* diagnosticsGrid;
+    guint diagnosticsWatchId;
+    GCancellable* diagnosticsCancellable;
+    int diagnosticsRows;
+    std::unique_ptr<NetworkProbe> networkProbe;
+    
+    // Which processes use the network, sampled off the UI thread while the page is shown
+    GtkWidget* appUsageBox;
+    GtkWidget* appUsageEmptyLabel;
+    std::vector<AppUsageRow> appUsageRows;
+    std::unique_ptr<ProcessBandwidth> processBandwidth;
+    guint processBandwidthWatchId;
+    
+    // Saved profiles window: every NMRemoteConnection, sorted by last use and filtered by the search text
+    GtkWidget* savedWindow;
+    GtkWidget* savedSearchEntry;
+    GtkWidget* savedStatusLabel;
+    GtkWidget* savedProgress;
+    GtkWidget* savedForgetButton;
+    GtkWidget* savedAutoOnButton;
+    GtkWidget* savedAutoOffButton;
+    GListStore* savedStore;
+    GtkCustomFilter* savedFilter;
+    GtkMultiSelection* savedSelection;
+    std::string savedQuery; // case-folded
+    
+    // Bulk forget/autoconnect: calls run in parallel, at most a few in flight at once
+    std::vector<NMRemoteConnection*> bulkQueue;
+    size_t bulkNext;
+    int bulkInFlight;
+    int bulkDone;
+    int bulkFailed;
+    bool bulkForget;
+    bool bulkAutoconnect;
+    GCancellable* bulkCancellable;
+    
     void setupUI();
     void setupBackButton();
     void initNetworkUI();
+    void initNetworkClient();
     void setupNetworkManager();
+    void showNetworkLoadingState();
+    void showNetworkManagerUnavailable();
     void populateWifiList();
-    void scanWifiNetworks();
+    void scanWifiNetworks(bool userRequested);
+    bool isScanPending(gint64 now) const;
+    void updateLastScanLabel();
+    void stopLastScanLabelUpdates();
     void reflectWifiSwitchState();
     void updateNetworkState();
     void enableNetworking();
-    void buildNetworkRow(const WifiNetwork& network);
+    void buildNetworkRow(GtkListItem* listItem);
+    void bindNetworkRow(GtkListItem* listItem);
     void updateConnectionStatus();
+    void updateThroughputDevice(NMDevice* device);
+    void startThroughputSampling();
+    void stopThroughputSampling();
+    void startAppUsageSampling();
+    void stopAppUsageSampling();
+    void updateAppUsageRows();
     void connectToNetwork(const std::string& ssid, NMAccessPoint* ap, bool isSecured);
     void showPasswordDialog(const std::string& ssid, NMAccessPoint* ap);
+    void beginActivation(const std::string& ssid, NMDevice* device);
+    void trackActiveConnection(NMActiveConnection* connection);
+    void setActivationStage(ActivationStage stage, const std::string& detail = "");
+    void endActivation();
+    void cancelActivation();
     void showNetworkSettings(const std::string& ssid, NMActiveConnection* activeConnection);
+    void showDiagnostics();
+    void startDiagnostics();
+    void runDiagnostics(const std::string& tcpAddress, uint16_t tcpPort, const std::string& tcpLabel,
+                        const std::string& queryName);
+    void stopDiagnostics();
+    void updateDiagnosticsResults();
+    std::vector<ProbeTarget> collectDiagnosticsTargets(const std::string& queryName);
+    void showSavedConnections();
+    void populateSavedStore();
+    void updateSavedSummary();
+    void bindSavedRow(GtkListItem* listItem);
+    void startBulkOperation(bool forget, bool autoconnect);
+    void launchBulkCalls();
+    void finishBulkCall(bool ok);
+    void completeBulkOperation();
     
     // Network utility functions
     NMDeviceWifi* getPrimaryWifiDevice();
     std::string ssidFromBytes(GBytes* ssidBytes);
     bool isAccessPointSecured(NMAccessPoint* ap);
     NMRemoteConnection* findSavedConnection(const std::string& ssid);
-    std::vector<WifiNetwork> getAvailableNetworks();
+    void rebuildSavedConnectionIndex();
+    void indexSavedConnection(NMRemoteConnection* connection);
+    void unindexSavedConnection(NMRemoteConnection* connection);
+    void clearSavedConnectionIndex();
     bool checkNetworkingEnabled();
     bool checkEthernetConnection();
     
@@ -81,7 +219,21 @@ private:
     static void onConnectButtonClicked(GtkButton* button, gpointer user_data);
     static void onEnableNetworkingClicked(GtkButton* button, gpointer user_data);
     static void onNetworkManagerChanged(NMClient* client, gpointer user_data);
+    static void onNetworkClientReady(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onConnectionAdded(NMClient* client, NMRemoteConnection* connection, gpointer user_data);
+    static void onConnectionRemoved(NMClient* client, NMRemoteConnection* connection, gpointer user_data);
+    static void onSavedConnectionChanged(NMRemoteConnection* connection, gpointer user_data);
     static void onWifiDeviceChanged(GObject* gobj, GParamSpec* pspec, gpointer user_data);
+    static void onScanRequestFinished(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onLastScanChanged(GObject* gobj, GParamSpec* pspec, gpointer user_data);
+    static gboolean lastScanLabelTimeout(gpointer user_data);
+    static void onWifiModelItemsChanged(GListModel* model, guint position, guint removed, guint added, gpointer user_data);
+    static void onNetworkRowSetup(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data);
+    static void onNetworkRowBind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data);
+    static void onNetworkRowUnbind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data);
+    static void onNetworkItemChanged(ElysiaWifiItem* item, gpointer user_data);
+    static gboolean onNetworkRowQueryTooltip(GtkWidget* widget, int x, int y, gboolean keyboard, GtkTooltip* tooltip, gpointer user_data);
+    static void drawSignalSparkline(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data);
     static void onPasswordConnectClicked(GtkButton* button, gpointer user_data);
     static void onPasswordDialogDestroy(GtkWidget* dialog, gpointer user_data);
     static void onNetworkSettingsClicked(GtkButton* button, gpointer user_data);
@@ -91,9 +243,38 @@ private:
     static void onIPv6MethodChanged(GtkComboBox* combo, gpointer user_data);
     static void onIPv6DNSAutoToggled(GtkCheckButton* check, gpointer user_data);
     static gboolean updateNetworkStateTimeout(gpointer user_data);
-    static gboolean populateWifiListTimeout(gpointer user_data);
-    static gboolean scanWifiNetworksTimeout(gpointer user_data);
-    static gboolean reflectWifiSwitchStateTimeout(gpointer user_data);
+    static gboolean throughputSampleTimeout(gpointer user_data);
+    static gboolean onProcessBandwidthEvent(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean hideActivationTimeout(gpointer user_data);
+    static void onActivateConnectionFinished(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onAddAndActivateFinished(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onActivationRequestDone(NMActiveConnection* connection, GError* error, gpointer user_data, bool addedProfile);
+    static void onActiveConnectionStateChanged(NMActiveConnection* connection, guint state, guint reason, gpointer user_data);
+    static void onActivationDeviceStateChanged(NMDevice* device, guint newState, guint oldState, guint reason, gpointer user_data);
+    static void onActivationCancelClicked(GtkButton* button, gpointer user_data);
+    static std::string deviceReasonText(guint reason);
+    static void onDiagnosticsButtonClicked(GtkButton* button, gpointer user_data);
+    static void onDiagnosticsRunClicked(GtkButton* button, gpointer user_data);
+    static gboolean onDiagnosticsCloseRequest(GtkWindow* window, gpointer user_data);
+    static void onDiagnosticsHostResolved(GObject* source, GAsyncResult* result, gpointer user_data);
+    static gboolean onDiagnosticsProbeEvent(gint fd, GIOCondition condition, gpointer user_data);
+    static void onSavedNetworksClicked(GtkButton* button, gpointer user_data);
+    static void onSavedSearchChanged(GtkSearchEntry* entry, gpointer user_data);
+    static gboolean savedFilterMatch(gpointer item, gpointer user_data);
+    static int savedSortCompare(gconstpointer a, gconstpointer b, gpointer user_data);
+    static void onSavedRowSetup(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data);
+    static void onSavedRowBind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data);
+    static void onSavedRowUnbind(GtkSignalListItemFactory* factory, GtkListItem* listItem, gpointer user_data);
+    static void onSavedRowConnectionChanged(NMRemoteConnection* connection, gpointer user_data);
+    static void onSavedSelectionChanged(GtkSelectionModel* model, guint position, guint count, gpointer user_data);
+    static void onSavedItemsChanged(GListModel* model, guint position, guint removed, guint added, gpointer user_data);
+    static void onSavedForgetClicked(GtkButton* button, gpointer user_data);
+    static void onSavedForgetConfirmed(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onSavedAutoconnectOnClicked(GtkButton* button, gpointer user_data);
+    static void onSavedAutoconnectOffClicked(GtkButton* button, gpointer user_data);
+    static void onBulkDeleteFinished(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void onBulkUpdateFinished(GObject* source, GAsyncResult* result, gpointer user_data);
+    static void drawThroughputGraph(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data);
     
     // Utility functions
     std::string getAssetPath(const std::string& filename);
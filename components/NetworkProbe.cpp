@@ -0,0 +1,406 @@
+#include "NetworkProbe.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct NetworkProbe::Slot {
+    ProbeTarget target;
+    size_t index = 0;
+    sockaddr_storage addr{};
+    socklen_t addrLen = 0;
+    bool icmp = false;
+    int fd = -1;
+    double sentAt = 0.0;
+    double nextAt = 0.0;
+    uint16_t sequence = 0;
+    int sent = 0;
+    int completed = 0;
+    int samples = 0;
+    int intervalMs = 0;
+    std::vector<double> latencies;
+    std::string method;
+    std::string error;
+    bool done = false;
+};
+
+static double nowMs() {
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+NetworkProbe::NetworkProbe()
+    : notifyFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      running(false), stopRequested(false) {
+}
+
+NetworkProbe::~NetworkProbe() {
+    stop();
+    if (notifyFd >= 0) ::close(notifyFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+}
+
+bool NetworkProbe::start(std::vector<ProbeTarget> targets, int samples, int timeoutMs, int intervalMs) {
+    stop();
+    if (notifyFd < 0 || wakeFd < 0 || targets.empty() || samples <= 0) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        published.assign(targets.size(), ProbeResult());
+        for (size_t i = 0; i < targets.size(); ++i) {
+            published[i].label = targets[i].label;
+        }
+    }
+
+    stopRequested = false;
+    running = true;
+    worker = std::thread(&NetworkProbe::run, this, std::move(targets), samples, timeoutMs, intervalMs);
+    signal();
+    return true;
+}
+
+void NetworkProbe::stop() {
+    stopRequested = true;
+    if (worker.joinable()) {
+        // Interrupts the worker's poll so joining never waits on a probe timeout
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;
+        worker.join();
+
+        uint64_t value;
+        while (read(wakeFd, &value, sizeof(value)) == sizeof(value)) {
+        }
+    }
+    running = false;
+}
+
+void NetworkProbe::acknowledge() {
+    uint64_t value;
+    while (read(notifyFd, &value, sizeof(value)) == sizeof(value)) {
+    }
+}
+
+std::vector<ProbeResult> NetworkProbe::results() const {
+    std::lock_guard<std::mutex> lock(resultsMutex);
+    return published;
+}
+
+void NetworkProbe::summarize(std::vector<double> latencies, ProbeResult& result) {
+    result.received = static_cast<int>(latencies.size());
+    if (latencies.empty()) {
+        result.minMs = result.p50Ms = result.p90Ms = result.p99Ms = result.maxMs = 0.0;
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto rank = [&latencies](double percent) {
+        size_t n = latencies.size();
+        size_t r = static_cast<size_t>(std::ceil(percent / 100.0 * n));
+        return latencies[std::min(n, std::max<size_t>(r, 1)) - 1];
+    };
+
+    result.minMs = latencies.front();
+    result.p50Ms = rank(50.0);
+    result.p90Ms = rank(90.0);
+    result.p99Ms = rank(99.0);
+    result.maxMs = latencies.back();
+}
+
+size_t NetworkProbe::buildDnsQuery(uint8_t* buffer, size_t capacity, uint16_t id, const std::string& name) {
+    if (name.empty() || name.size() > 253 || capacity < 12 + name.size() + 2 + 4) return 0;
+
+    // Header: recursion desired, one question
+    const uint8_t header[12] = {
+        static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id & 0xff),
+        0x01, 0x00,
+        0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    std::memcpy(buffer, header, sizeof(header));
+    size_t pos = sizeof(header);
+
+    size_t start = 0;
+    while (start < name.size()) {
+        size_t dot = name.find('.', start);
+        if (dot == std::string::npos) dot = name.size();
+        size_t length = dot - start;
+        if (length == 0 || length > 63) return 0;
+
+        buffer[pos++] = static_cast<uint8_t>(length);
+        std::memcpy(buffer + pos, name.data() + start, length);
+        pos += length;
+        start = dot + 1;
+    }
+    buffer[pos++] = 0;
+
+    // QTYPE A, QCLASS IN
+    buffer[pos++] = 0x00;
+    buffer[pos++] = 0x01;
+    buffer[pos++] = 0x00;
+    buffer[pos++] = 0x01;
+    return pos;
+}
+
+void NetworkProbe::run(std::vector<ProbeTarget> targets, int samples, int timeoutMs, int intervalMs) {
+    std::mt19937 random(std::random_device{}());
+    std::vector<Slot> slots(targets.size());
+
+    // Addresses are resolved once up front so the samples time the network only
+    for (size_t i = 0; i < targets.size(); ++i) {
+        Slot& slot = slots[i];
+        slot.target = std::move(targets[i]);
+        slot.index = i;
+        slot.samples = samples;
+        slot.intervalMs = intervalMs;
+        slot.sequence = static_cast<uint16_t>(random());
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_flags = AI_NUMERICSERV;
+        hints.ai_socktype = slot.target.kind == ProbeTarget::Kind::Dns ? SOCK_DGRAM : SOCK_STREAM;
+        if (slot.target.kind != ProbeTarget::Kind::Tcp) hints.ai_flags |= AI_NUMERICHOST;
+
+        addrinfo* info = nullptr;
+        std::string port = std::to_string(slot.target.port);
+        int status = getaddrinfo(slot.target.host.c_str(), port.c_str(), &hints, &info);
+        if (status != 0 || !info) {
+            slot.error = gai_strerror(status);
+            slot.done = true;
+        } else {
+            std::memcpy(&slot.addr, info->ai_addr, info->ai_addrlen);
+            slot.addrLen = info->ai_addrlen;
+            freeaddrinfo(info);
+        }
+
+        switch (slot.target.kind) {
+            case ProbeTarget::Kind::Ping:
+                slot.icmp = true;
+                slot.method = "ICMP";
+                break;
+            case ProbeTarget::Kind::Dns:
+                slot.method = "UDP " + port;
+                break;
+            case ProbeTarget::Kind::Tcp:
+                slot.method = "TCP " + port;
+                break;
+        }
+        publish(slot, i);
+    }
+
+    std::vector<pollfd> fds;
+    std::vector<Slot*> polled;
+    fds.reserve(slots.size() + 1);
+    polled.reserve(slots.size());
+
+    while (!stopRequested) {
+        double now = nowMs();
+        bool active = false;
+        double wakeAt = now + 100.0;
+
+        fds.clear();
+        polled.clear();
+        for (Slot& slot : slots) {
+            if (slot.done) continue;
+            active = true;
+
+            if (slot.fd < 0 && now >= slot.nextAt) {
+                launch(slot);
+                if (slot.done) continue;
+            }
+
+            if (slot.fd >= 0) {
+                bool connecting = slot.target.kind == ProbeTarget::Kind::Tcp ||
+                                  (slot.target.kind == ProbeTarget::Kind::Ping && !slot.icmp);
+                fds.push_back(pollfd{slot.fd, static_cast<short>(connecting ? POLLOUT : POLLIN), 0});
+                polled.push_back(&slot);
+                wakeAt = std::min(wakeAt, slot.sentAt + timeoutMs);
+            } else {
+                wakeAt = std::min(wakeAt, slot.nextAt);
+            }
+        }
+        if (!active) break;
+        fds.push_back(pollfd{wakeFd, POLLIN, 0});
+
+        int waitMs = static_cast<int>(std::ceil(std::max(0.0, wakeAt - now)));
+        int ready = poll(fds.data(), fds.size(), waitMs);
+        if (ready < 0 && errno != EINTR) break;
+        now = nowMs();
+
+        for (size_t i = 0; i < polled.size(); ++i) {
+            Slot& slot = *polled[i];
+            short revents = fds[i].revents;
+
+            if (revents && (fds[i].events & POLLOUT)) {
+                int error = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(slot.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+
+                // A refused connection still proves the gateway is answering
+                if (error == 0 || (error == ECONNREFUSED && slot.target.kind == ProbeTarget::Kind::Ping)) {
+                    finishSample(slot, now, true, nullptr);
+                } else {
+                    finishSample(slot, now, false, strerror(error));
+                }
+                continue;
+            }
+
+            if (revents) {
+                uint8_t reply[512];
+                ssize_t n;
+                while (slot.fd >= 0 && (n = recv(slot.fd, reply, sizeof(reply), 0)) != 0) {
+                    if (n < 0) {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                            finishSample(slot, now, false, strerror(errno));
+                        }
+                        break;
+                    }
+
+                    // Stale replies to an earlier, timed-out sample are skipped
+                    uint16_t sequence;
+                    if (slot.target.kind == ProbeTarget::Kind::Dns) {
+                        if (n < 12 || !(reply[2] & 0x80)) continue;
+                        sequence = static_cast<uint16_t>((reply[0] << 8) | reply[1]);
+                    } else {
+                        uint8_t echoReply = slot.addr.ss_family == AF_INET6 ? 129 : 0;
+                        if (n < 8 || reply[0] != echoReply) continue;
+                        sequence = static_cast<uint16_t>((reply[6] << 8) | reply[7]);
+                    }
+                    if (sequence == slot.sequence) {
+                        finishSample(slot, now, true, nullptr);
+                    }
+                }
+            }
+        }
+
+        for (Slot& slot : slots) {
+            if (slot.fd >= 0 && now - slot.sentAt >= timeoutMs) {
+                finishSample(slot, now, false, "timed out");
+            }
+        }
+    }
+
+    for (Slot& slot : slots) {
+        if (slot.fd >= 0) ::close(slot.fd);
+        slot.fd = -1;
+        slot.done = true;
+        publish(slot, slot.index);
+    }
+    running = false;
+    signal();
+}
+
+bool NetworkProbe::launch(Slot& slot) {
+    int family = slot.addr.ss_family;
+    ++slot.sent;
+    ++slot.sequence;
+    // Its own clock reading: slots launched in one pass go out one after another
+    double now = nowMs();
+    slot.sentAt = now;
+
+    if (slot.target.kind == ProbeTarget::Kind::Ping && slot.icmp) {
+        // Unprivileged ping sockets; the kernel fills in the identifier and checksum
+        int protocol = family == AF_INET6 ? static_cast<int>(IPPROTO_ICMPV6) : static_cast<int>(IPPROTO_ICMP);
+        slot.fd = socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+        if (slot.fd < 0) {
+            // Not in net.ipv4.ping_group_range: time a TCP connect instead
+            slot.icmp = false;
+            slot.method = "TCP " + std::to_string(slot.target.port);
+        } else {
+            uint8_t packet[16] = {};
+            packet[0] = family == AF_INET6 ? 128 : 8;
+            packet[6] = static_cast<uint8_t>(slot.sequence >> 8);
+            packet[7] = static_cast<uint8_t>(slot.sequence & 0xff);
+            if (connect(slot.fd, reinterpret_cast<sockaddr*>(&slot.addr), slot.addrLen) < 0 ||
+                send(slot.fd, packet, sizeof(packet), 0) < 0) {
+                finishSample(slot, now, false, strerror(errno));
+                return false;
+            }
+            return true;
+        }
+    }
+
+    if (slot.target.kind == ProbeTarget::Kind::Dns) {
+        uint8_t query[300];
+        size_t length = buildDnsQuery(query, sizeof(query), slot.sequence, slot.target.queryName);
+        if (length == 0) {
+            slot.done = true;
+            finishSample(slot, now, false, "invalid query name");
+            return false;
+        }
+
+        slot.fd = socket(family, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (slot.fd < 0 ||
+            connect(slot.fd, reinterpret_cast<sockaddr*>(&slot.addr), slot.addrLen) < 0 ||
+            send(slot.fd, query, length, 0) < 0) {
+            finishSample(slot, now, false, strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    slot.fd = socket(family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (slot.fd < 0) {
+        finishSample(slot, now, false, strerror(errno));
+        return false;
+    }
+    if (connect(slot.fd, reinterpret_cast<sockaddr*>(&slot.addr), slot.addrLen) == 0) {
+        finishSample(slot, nowMs(), true, nullptr);
+        return true;
+    }
+    if (errno != EINPROGRESS) {
+        int error = errno;
+        bool answered = error == ECONNREFUSED && slot.target.kind == ProbeTarget::Kind::Ping;
+        finishSample(slot, nowMs(), answered, answered ? nullptr : strerror(error));
+        return answered;
+    }
+    return true;
+}
+
+void NetworkProbe::finishSample(Slot& slot, double now, bool ok, const char* error) {
+    if (slot.fd >= 0) {
+        ::close(slot.fd);
+        slot.fd = -1;
+    }
+
+    ++slot.completed;
+    if (ok) {
+        slot.latencies.push_back(now - slot.sentAt);
+    } else if (error) {
+        slot.error = error;
+    }
+
+    slot.nextAt = slot.sentAt + slot.intervalMs;
+    if (slot.completed >= slot.samples) slot.done = true;
+    publish(slot, slot.index);
+}
+
+void NetworkProbe::publish(const Slot& slot, size_t index) {
+    ProbeResult result;
+    result.label = slot.target.label;
+    result.method = slot.method;
+    result.sent = slot.completed;
+    result.error = slot.error;
+    result.done = slot.done;
+    summarize(slot.latencies, result);
+
+    {
+        std::lock_guard<std::mutex> lock(resultsMutex);
+        if (index < published.size()) published[index] = std::move(result);
+    }
+    signal();
+}
+
+void NetworkProbe::signal() {
+    uint64_t one = 1;
+    ssize_t written = write(notifyFd, &one, sizeof(one));
+    (void)written;
+}
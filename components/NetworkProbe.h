@@ -0,0 +1,92 @@
+#ifndef NETWORKPROBE_H
+#define NETWORKPROBE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ProbeTarget {
+    enum class Kind : uint8_t {
+        Ping, // ICMP echo, or a TCP connect to port where ping sockets are not allowed
+        Dns,  // one A query per sample sent straight to the resolver at host:port
+        Tcp   // time until the three-way handshake completes
+    };
+
+    Kind kind;
+    std::string label;     // shown in the results table
+    std::string host;      // numeric address for Ping/Dns; name or address for Tcp
+    uint16_t port;
+    std::string queryName; // Dns only
+};
+
+struct ProbeResult {
+    std::string label;
+    std::string method;  // how the target is being measured, e.g. "ICMP"
+    int sent = 0;
+    int received = 0;
+    double minMs = 0.0;
+    double p50Ms = 0.0;
+    double p90Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    std::string error;   // most recent failure, empty if none
+    bool done = false;
+};
+
+// Latency probes for the diagnostics panel. All targets are measured at the
+// same time from one worker thread multiplexing non-blocking sockets with
+// poll(), each target sending its samples one after another. Nothing here
+// touches GLib: progress is announced on eventFd(), which the UI watches and
+// answers with acknowledge() and results(). Tcp hosts given by name are
+// resolved on the worker; callers that must not wait on a slow resolver in
+// stop() pass numeric addresses.
+class NetworkProbe {
+public:
+    static constexpr int DEFAULT_TIMEOUT_MS = 2000;
+    static constexpr int DEFAULT_INTERVAL_MS = 250;
+
+    NetworkProbe();
+    ~NetworkProbe();
+
+    NetworkProbe(const NetworkProbe&) = delete;
+    NetworkProbe& operator=(const NetworkProbe&) = delete;
+
+    // Replaces any run in progress
+    bool start(std::vector<ProbeTarget> targets, int samples,
+               int timeoutMs = DEFAULT_TIMEOUT_MS, int intervalMs = DEFAULT_INTERVAL_MS);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Readable whenever results() has changed
+    int eventFd() const { return notifyFd; }
+    void acknowledge();
+    std::vector<ProbeResult> results() const;
+
+    // Nearest-rank percentiles over the successful samples
+    static void summarize(std::vector<double> latencies, ProbeResult& result);
+    static size_t buildDnsQuery(uint8_t* buffer, size_t capacity, uint16_t id, const std::string& name);
+
+private:
+    struct Slot;
+
+    int notifyFd;
+    int wakeFd;
+    std::thread worker;
+    std::atomic<bool> running;
+    std::atomic<bool> stopRequested;
+
+    mutable std::mutex resultsMutex;
+    std::vector<ProbeResult> published;
+
+    void run(std::vector<ProbeTarget> targets, int samples, int timeoutMs, int intervalMs);
+    bool launch(Slot& slot);
+    void finishSample(Slot& slot, double now, bool ok, const char* error);
+    void publish(const Slot& slot, size_t index);
+    void signal();
+};
+
+#endif // NETWORKPROBE_H
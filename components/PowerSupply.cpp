@@ -0,0 +1,268 @@
+#include "PowerSupply.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Indexed by PowerSupply::Attribute
+static const char* const ATTRIBUTE_NAMES[] = {
+    "status",
+    "present",
+    "capacity",
+    "capacity_level",
+    "energy_now",
+    "energy_full",
+    "charge_now",
+    "charge_full",
+    "power_now",
+    "current_now",
+    "voltage_now",
+    "cycle_count"
+};
+
+static void trimTrailing(char* text, size_t length) {
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == ' ')) {
+        text[--length] = '\0';
+    }
+}
+
+PowerSupply::PowerSupply() : peripheral(false), energyFullDesign(-1.0), designVoltage(0.0) {
+    std::fill(std::begin(fds), std::end(fds), -1);
+}
+
+PowerSupply::~PowerSupply() {
+    close();
+}
+
+std::string PowerSupply::sysfsRoot() {
+    const char* root = getenv("ELYSIA_SYSFS_ROOT");
+    return (root && *root) ? root : "/sys";
+}
+
+std::string PowerSupply::classDirectory() {
+    return sysfsRoot() + "/class/power_supply";
+}
+
+bool PowerSupply::isBattery(const std::string& name) {
+    std::string type;
+    return readFile(classDirectory() + "/" + name + "/type", type) && (type == "Battery" || type == "UPS");
+}
+
+std::vector<std::string> PowerSupply::listBatteries() {
+    std::vector<std::string> names;
+    std::string directory = classDirectory();
+
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return names;
+
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        if (isBattery(entry->d_name)) names.push_back(entry->d_name);
+    }
+    closedir(dir);
+
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+bool PowerSupply::isPeripheralBattery(const std::string& name) {
+    // scope is "Device" for peripherals reported over HID or Bluetooth;
+    // internal batteries have "System" or no scope at all
+    std::string directory = classDirectory() + "/" + name + "/";
+    std::string value;
+    return (readFile(directory + "scope", value) && value == "Device") ||
+           (readFile(directory + "type", value) && value == "UPS");
+}
+
+bool PowerSupply::onBatteryPower() {
+    std::string directory = classDirectory();
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) return false;
+
+    bool hasBattery = false;
+    bool externalOnline = false;
+    std::string value;
+    while (dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') continue;
+        if (isBattery(entry->d_name)) {
+            if (!isPeripheralBattery(entry->d_name)) hasBattery = true;
+        } else if (readFile(directory + "/" + entry->d_name + "/online", value) && value == "1") {
+            externalOnline = true;
+        }
+    }
+    closedir(dir);
+
+    return hasBattery && !externalOnline;
+}
+
+bool PowerSupply::open(const std::string& name) {
+    close();
+
+    std::string directory = classDirectory() + "/" + name + "/";
+    for (int i = 0; i < AttributeCount; ++i) {
+        // Missing attributes are normal: drivers report either energy_* or charge_*
+        fds[i] = ::open((directory + ATTRIBUTE_NAMES[i]).c_str(), O_RDONLY | O_CLOEXEC);
+    }
+    if (fds[Status] < 0 && fds[Capacity] < 0) {
+        close();
+        return false;
+    }
+
+    supplyName = name;
+
+    std::string value;
+    peripheral = isPeripheralBattery(name);
+
+    modelName = readFile(directory + "model_name", value) ? value : name;
+    if (readFile(directory + "manufacturer", value) && modelName.compare(0, value.size(), value) != 0) {
+        modelName = value + " " + modelName;
+    }
+    if (readFile(directory + "technology", value)) technology = value;
+
+    if (readFile(directory + "voltage_min_design", value)) {
+        designVoltage = strtoll(value.c_str(), nullptr, 10) / 1e6;
+    }
+    if (readFile(directory + "energy_full_design", value)) {
+        energyFullDesign = strtoll(value.c_str(), nullptr, 10) / 1e6;
+    } else if (readFile(directory + "charge_full_design", value)) {
+        long long charge = strtoll(value.c_str(), nullptr, 10);
+        if (designVoltage > 0.0) energyFullDesign = charge / 1e6 * designVoltage;
+    }
+    return true;
+}
+
+void PowerSupply::close() {
+    for (int& fd : fds) {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+    supplyName.clear();
+    modelName.clear();
+    peripheral = false;
+    technology.clear();
+    energyFullDesign = -1.0;
+    designVoltage = 0.0;
+}
+
+bool PowerSupply::read(BatteryInfo& info) {
+    info = BatteryInfo{};
+    if (!isOpen()) return false;
+
+    char text[64];
+    if (fds[Status] >= 0) {
+        // ENODEV once the supply has been unplugged
+        if (!readText(fds[Status], text, sizeof(text))) return false;
+        info.state = parseState(text);
+    }
+    if (fds[CapacityLevel] >= 0 && readText(fds[CapacityLevel], text, sizeof(text))) {
+        info.level = parseLevel(text);
+    }
+
+    long long value;
+    info.present = !readNumber(Present, value) || value != 0;
+    info.isCharging = info.state == BatteryState::Charging;
+    info.technology = technology;
+
+    if (readNumber(VoltageNow, value)) info.voltage = value / 1e6;
+    if (readNumber(CycleCount, value) && value > 0) info.chargeCycles = static_cast<int>(value);
+
+    // charge_* is in µAh; convert with the design voltage like UPower does,
+    // falling back to the present voltage
+    double chargeVoltage = designVoltage > 0.0 ? designVoltage : info.voltage;
+    if (readNumber(EnergyNow, value)) {
+        info.energyNow = value / 1e6;
+    } else if (readNumber(ChargeNow, value) && chargeVoltage > 0.0) {
+        info.energyNow = value / 1e6 * chargeVoltage;
+    }
+    if (readNumber(EnergyFull, value)) {
+        info.energyFull = value / 1e6;
+    } else if (readNumber(ChargeFull, value) && chargeVoltage > 0.0) {
+        info.energyFull = value / 1e6 * chargeVoltage;
+    }
+    info.energyFullDesign = energyFullDesign;
+
+    // Some drivers sign current_now by direction; the state already says which way
+    if (readNumber(PowerNow, value)) {
+        info.energyRate = std::fabs(value / 1e6);
+    } else if (readNumber(CurrentNow, value) && info.voltage > 0.0) {
+        info.energyRate = std::fabs(value / 1e6) * info.voltage;
+    }
+
+    if (readNumber(Capacity, value)) {
+        info.percentage = static_cast<double>(value);
+    } else if (info.energyNow >= 0.0 && info.energyFull > 0.0) {
+        info.percentage = info.energyNow / info.energyFull * 100.0;
+    }
+    if (info.percentage >= 0.0) info.percentage = std::min(info.percentage, 100.0);
+
+    if (info.energyFull > 0.0 && info.energyFullDesign > 0.0) {
+        info.capacity = std::min(info.energyFull / info.energyFullDesign * 100.0, 100.0);
+    }
+
+    if (info.energyRate > 0.0 && info.energyNow >= 0.0) {
+        if (info.state == BatteryState::Discharging) {
+            info.timeToEmpty = info.energyNow / info.energyRate * 3600.0;
+        } else if (info.state == BatteryState::Charging && info.energyFull > info.energyNow) {
+            info.timeToFull = (info.energyFull - info.energyNow) / info.energyRate * 3600.0;
+        }
+    }
+    return true;
+}
+
+bool PowerSupply::readText(int fd, char* buffer, size_t size) const {
+    ssize_t length;
+    do {
+        length = pread(fd, buffer, size - 1, 0);
+    } while (length < 0 && errno == EINTR);
+    if (length <= 0) return false;
+
+    buffer[length] = '\0';
+    trimTrailing(buffer, static_cast<size_t>(length));
+    return true;
+}
+
+bool PowerSupply::readNumber(Attribute attribute, long long& value) const {
+    if (fds[attribute] < 0) return false;
+
+    char text[32];
+    if (!readText(fds[attribute], text, sizeof(text))) return false;
+
+    char* end = nullptr;
+    value = strtoll(text, &end, 10);
+    return end != text;
+}
+
+bool PowerSupply::readFile(const std::string& path, std::string& value) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    char text[128];
+    ssize_t length = ::read(fd, text, sizeof(text) - 1);
+    ::close(fd);
+    if (length <= 0) return false;
+
+    text[length] = '\0';
+    trimTrailing(text, static_cast<size_t>(length));
+    value = text;
+    return true;
+}
+
+BatteryState PowerSupply::parseState(const char* text) {
+    if (strcmp(text, "Charging") == 0) return BatteryState::Charging;
+    if (strcmp(text, "Discharging") == 0) return BatteryState::Discharging;
+    if (strcmp(text, "Not charging") == 0) return BatteryState::NotCharging;
+    if (strcmp(text, "Full") == 0) return BatteryState::Full;
+    return BatteryState::Unknown;
+}
+
+BatteryLevel PowerSupply::parseLevel(const char* text) {
+    if (strcmp(text, "Normal") == 0 || strcmp(text, "High") == 0) return BatteryLevel::Normal;
+    if (strcmp(text, "Low") == 0) return BatteryLevel::Low;
+    if (strcmp(text, "Critical") == 0) return BatteryLevel::Critical;
+    if (strcmp(text, "Full") == 0) return BatteryLevel::Full;
+    return BatteryLevel::Unknown;
+}
@@ -0,0 +1,121 @@
+#ifndef POWERSUPPLY_H
+#define POWERSUPPLY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class BatteryState : uint8_t {
+    Unknown,
+    Charging,
+    Discharging,
+    NotCharging,
+    Full
+};
+
+// capacity_level as reported by the driver
+enum class BatteryLevel : uint8_t {
+    Unknown,
+    Normal,
+    Low,
+    Critical,
+    Full
+};
+
+// One reading of a battery. Energies are in Wh, rates in W and times in
+// seconds; values the driver does not report stay negative.
+struct BatteryInfo {
+    BatteryState state = BatteryState::Unknown;
+    BatteryLevel level = BatteryLevel::Unknown;
+    bool present = false;
+    bool isCharging = false;
+    double percentage = -1.0;
+    double energyNow = -1.0;
+    double energyFull = -1.0;
+    double energyFullDesign = -1.0;
+    double energyRate = -1.0;     // always positive, whichever way energy flows
+    double voltage = -1.0;
+    double capacity = -1.0;       // energyFull against energyFullDesign, in percent
+    double timeToEmpty = -1.0;
+    double timeToFull = -1.0;
+    int chargeCycles = -1;
+    std::string technology;
+};
+
+// A power supply under /sys/class/power_supply. The attributes that change
+// are opened once and re-read with pread() at offset 0, which makes the
+// kernel format a fresh value, so a refresh costs a handful of syscalls and
+// no process. Attributes that cannot change while the supply exists
+// (technology, design capacity) are read once in open().
+//
+// ELYSIA_SYSFS_ROOT replaces /sys, so a fake tree of plain files can stand
+// in for the kernel.
+class PowerSupply {
+public:
+    PowerSupply();
+    ~PowerSupply();
+
+    PowerSupply(const PowerSupply&) = delete;
+    PowerSupply& operator=(const PowerSupply&) = delete;
+
+    // /sys, or ELYSIA_SYSFS_ROOT when set
+    static std::string sysfsRoot();
+    // The power_supply class directory under sysfsRoot()
+    static std::string classDirectory();
+    // Whether the named supply is of type "Battery" or "UPS"
+    static bool isBattery(const std::string& name);
+    // Names of all such supplies, in name order
+    static std::vector<std::string> listBatteries();
+    // Whether the named battery is a peripheral's (see isPeripheral())
+    static bool isPeripheralBattery(const std::string& name);
+    // True when a battery powers the machine and no mains, USB or other
+    // external supply is online
+    static bool onBatteryPower();
+
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return !supplyName.empty(); }
+    const std::string& name() const { return supplyName; }
+    // model_name, prefixed with the manufacturer when there is one
+    const std::string& model() const { return modelName; }
+    // Batteries in mice, keyboards, headsets and UPSes, as opposed to the
+    // ones powering the machine
+    bool isPeripheral() const { return peripheral; }
+
+    // False if the supply has gone away
+    bool read(BatteryInfo& info);
+
+private:
+    enum Attribute {
+        Status,
+        Present,
+        Capacity,
+        CapacityLevel,
+        EnergyNow,
+        EnergyFull,
+        ChargeNow,
+        ChargeFull,
+        PowerNow,
+        CurrentNow,
+        VoltageNow,
+        CycleCount,
+        AttributeCount
+    };
+
+    std::string supplyName;
+    std::string modelName;
+    bool peripheral;
+    int fds[AttributeCount];
+    std::string technology;
+    double energyFullDesign;
+    double designVoltage;  // converts charge_* readings to energy, 0 if unknown
+
+    bool readText(int fd, char* buffer, size_t size) const;
+    bool readNumber(Attribute attribute, long long& value) const;
+
+    static bool readFile(const std::string& path, std::string& value);
+    static BatteryState parseState(const char* text);
+    static BatteryLevel parseLevel(const char* text);
+};
+
+#endif // POWERSUPPLY_H
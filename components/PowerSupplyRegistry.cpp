@@ -0,0 +1,266 @@
+#include "PowerSupplyRegistry.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+PowerSupplyRegistry::PowerSupplyRegistry() : ueventFd(-1), nextRescan(0.0) {
+}
+
+PowerSupplyRegistry::~PowerSupplyRegistry() {
+    stop();
+}
+
+void PowerSupplyRegistry::start(double now) {
+    stop();
+
+    // Subscribe before enumerating so a supply plugged in between is not missed
+    if (!getenv("ELYSIA_SYSFS_ROOT")) {
+        ueventFd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+        if (ueventFd >= 0) {
+            sockaddr_nl address = {};
+            address.nl_family = AF_NETLINK;
+            address.nl_groups = 1;  // kernel events; udevd's rebroadcasts use group 2
+            if (bind(ueventFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                close(ueventFd);
+                ueventFd = -1;
+            }
+        }
+    }
+
+    rescan(now);
+}
+
+void PowerSupplyRegistry::stop() {
+    if (ueventFd >= 0) close(ueventFd);
+    ueventFd = -1;
+    entries.clear();
+}
+
+bool PowerSupplyRegistry::processEvents(double now) {
+    if (ueventFd < 0) return false;
+
+    bool changed = false;
+    char buffer[8192];
+    for (;;) {
+        sockaddr_nl sender = {};
+        iovec iov = {buffer, sizeof(buffer) - 1};
+        msghdr message = {};
+        message.msg_name = &sender;
+        message.msg_namelen = sizeof(sender);
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+
+        ssize_t length = recvmsg(ueventFd, &message, 0);
+        if (length < 0) {
+            if (errno == EINTR) continue;
+            if (errno == ENOBUFS) {
+                // Events were dropped; the directory is the only truth left
+                rescan(now);
+                changed = true;
+                continue;
+            }
+            break;  // EAGAIN: drained
+        }
+        if (sender.nl_pid != 0) continue;  // only trust the kernel
+        buffer[length] = '\0';
+
+        // "ACTION@DEVPATH" followed by NUL-separated KEY=VALUE fields
+        const char* action = nullptr;
+        const char* subsystem = nullptr;
+        const char* name = nullptr;
+        for (size_t offset = strlen(buffer) + 1; offset < static_cast<size_t>(length);
+             offset += strlen(buffer + offset) + 1) {
+            const char* field = buffer + offset;
+            if (strncmp(field, "ACTION=", 7) == 0) action = field + 7;
+            else if (strncmp(field, "SUBSYSTEM=", 10) == 0) subsystem = field + 10;
+            else if (strncmp(field, "POWER_SUPPLY_NAME=", 18) == 0) name = field + 18;
+        }
+        if (!action || !subsystem || !name || strcmp(subsystem, "power_supply") != 0) continue;
+
+        if (strcmp(action, "remove") == 0) {
+            changed |= remove(name);
+        } else if (Entry* entry = find(name)) {
+            changed |= read(*entry, now);
+        } else {
+            changed |= add(name, now);
+        }
+    }
+    return changed;
+}
+
+bool PowerSupplyRegistry::refresh(double now) {
+    bool changed = false;
+    if (ueventFd < 0 && now >= nextRescan) {
+        size_t before = entries.size();
+        rescan(now);
+        changed = entries.size() != before;
+    }
+
+    for (auto& entry : entries) {
+        if (now >= entry->nextRefresh) {
+            changed |= read(*entry, now);
+        }
+    }
+    return changed;
+}
+
+size_t PowerSupplyRegistry::systemCount() const {
+    return std::count_if(entries.begin(), entries.end(),
+                         [](const std::unique_ptr<Entry>& entry) { return !entry->status.peripheral; });
+}
+
+BatteryInfo PowerSupplyRegistry::aggregate() const {
+    std::vector<const BatteryInfo*> batteries;
+    for (const auto& entry : entries) {
+        if (!entry->status.peripheral) batteries.push_back(&entry->status.info);
+    }
+    if (batteries.empty()) return BatteryInfo{};
+    if (batteries.size() == 1) return *batteries.front();
+
+    BatteryInfo total;
+    total.energyNow = 0.0;
+    total.energyFull = 0.0;
+    total.energyFullDesign = 0.0;
+    bool energyKnown = true;
+    bool designKnown = true;
+    bool anyCharging = false;
+    bool anyDischarging = false;
+    bool allFull = true;
+    double netRate = 0.0;
+    double percentageSum = 0.0;
+    int percentageCount = 0;
+
+    for (const BatteryInfo* info : batteries) {
+        total.present |= info->present;
+        anyCharging |= info->state == BatteryState::Charging;
+        anyDischarging |= info->state == BatteryState::Discharging;
+        allFull &= info->state == BatteryState::Full;
+        // Critical outranks Low, which outranks Normal and Full
+        if (info->level == BatteryLevel::Critical ||
+            (info->level == BatteryLevel::Low && total.level != BatteryLevel::Critical) ||
+            total.level == BatteryLevel::Unknown) {
+            total.level = info->level;
+        }
+
+        if (info->energyNow >= 0.0 && info->energyFull > 0.0) {
+            total.energyNow += info->energyNow;
+            total.energyFull += info->energyFull;
+        } else {
+            energyKnown = false;
+        }
+        if (info->energyFullDesign > 0.0) total.energyFullDesign += info->energyFullDesign;
+        else designKnown = false;
+
+        // One pack may charge while the other discharges
+        if (info->energyRate > 0.0) {
+            netRate += info->state == BatteryState::Discharging ? -info->energyRate : info->energyRate;
+        }
+        if (info->percentage >= 0.0) {
+            percentageSum += info->percentage;
+            percentageCount++;
+        }
+        // Voltages of separate packs do not add up; show the first one's
+        if (total.voltage < 0.0) total.voltage = info->voltage;
+        total.chargeCycles = std::max(total.chargeCycles, info->chargeCycles);
+        if (total.technology.empty()) total.technology = info->technology;
+    }
+
+    // Packs that disagree (one topping up the other) go the way of the net flow
+    if (anyCharging && anyDischarging && netRate < 0.0) total.state = BatteryState::Discharging;
+    else if (anyCharging) total.state = BatteryState::Charging;
+    else if (anyDischarging) total.state = BatteryState::Discharging;
+    else if (allFull) total.state = BatteryState::Full;
+    else total.state = BatteryState::NotCharging;
+    total.isCharging = total.state == BatteryState::Charging;
+
+    if (energyKnown) {
+        total.percentage = std::min(total.energyNow / total.energyFull * 100.0, 100.0);
+    } else {
+        // Without energies the packs cannot be weighted; count them alike
+        total.energyNow = -1.0;
+        total.energyFull = -1.0;
+        if (percentageCount > 0) total.percentage = percentageSum / percentageCount;
+    }
+    if (!designKnown) total.energyFullDesign = -1.0;
+    if (energyKnown && designKnown) {
+        total.capacity = std::min(total.energyFull / total.energyFullDesign * 100.0, 100.0);
+    }
+
+    total.energyRate = std::fabs(netRate);
+    if (energyKnown && total.energyRate > 0.0) {
+        if (total.state == BatteryState::Discharging) {
+            total.timeToEmpty = total.energyNow / total.energyRate * 3600.0;
+        } else if (total.state == BatteryState::Charging && total.energyFull > total.energyNow) {
+            total.timeToFull = (total.energyFull - total.energyNow) / total.energyRate * 3600.0;
+        }
+    }
+    return total;
+}
+
+void PowerSupplyRegistry::rescan(double now) {
+    std::vector<std::string> names = PowerSupply::listBatteries();
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&](const std::unique_ptr<Entry>& entry) {
+                                     return !std::binary_search(names.begin(), names.end(), entry->status.name);
+                                 }),
+                  entries.end());
+    for (const std::string& name : names) {
+        add(name, now);
+    }
+    nextRescan = now + RESCAN_INTERVAL;
+}
+
+bool PowerSupplyRegistry::add(const std::string& name, double now) {
+    if (find(name) || !PowerSupply::isBattery(name)) return false;
+
+    auto entry = std::make_unique<Entry>();
+    if (!entry->reader.open(name)) return false;
+
+    entry->status.name = name;
+    entry->status.model = entry->reader.model();
+    entry->status.peripheral = entry->reader.isPeripheral();
+    read(*entry, now);
+
+    entries.push_back(std::move(entry));
+    sort();
+    return true;
+}
+
+bool PowerSupplyRegistry::remove(const std::string& name) {
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&](const std::unique_ptr<Entry>& entry) { return entry->status.name == name; });
+    if (it == entries.end()) return false;
+
+    entries.erase(it);
+    return true;
+}
+
+bool PowerSupplyRegistry::read(Entry& entry, double now) {
+    entry.nextRefresh = now + (entry.status.peripheral ? PERIPHERAL_INTERVAL : SYSTEM_INTERVAL);
+
+    // A sleeping peripheral may fail to answer; keep its last reading
+    BatteryInfo info;
+    if (!entry.reader.read(info)) return false;
+    entry.status.info = info;
+    return true;
+}
+
+void PowerSupplyRegistry::sort() {
+    std::sort(entries.begin(), entries.end(), [](const std::unique_ptr<Entry>& a, const std::unique_ptr<Entry>& b) {
+        if (a->status.peripheral != b->status.peripheral) return !a->status.peripheral;
+        return a->status.name < b->status.name;
+    });
+}
+
+PowerSupplyRegistry::Entry* PowerSupplyRegistry::find(const std::string& name) {
+    for (auto& entry : entries) {
+        if (entry->status.name == name) return entry.get();
+    }
+    return nullptr;
+}
@@ -0,0 +1,80 @@
+#ifndef POWERSUPPLYREGISTRY_H
+#define POWERSUPPLYREGISTRY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "PowerSupply.h"
+
+struct PowerSupplyStatus {
+    std::string name;   // sysfs name, e.g. "BAT1" or "hidpp_battery_0"
+    std::string model;
+    bool peripheral = false;
+    BatteryInfo info;
+};
+
+// Every battery the kernel knows about. The power_supply directory is read
+// once in start(); after that supplies come and go through kernel uevents on
+// a NETLINK_KOBJECT_UEVENT socket, which also announce most changes of an
+// existing supply so it can be re-read at once. Each supply keeps its own
+// refresh schedule: batteries powering the machine every SYSTEM_INTERVAL,
+// peripherals (whose drivers may have to ask the device over the air) only
+// every PERIPHERAL_INTERVAL or when a uevent says they changed. Where the
+// socket cannot be opened, as in some containers or under ELYSIA_SYSFS_ROOT,
+// the directory is rescanned every RESCAN_INTERVAL instead.
+//
+// Like the other engines nothing here touches GLib; the owner watches
+// eventFd() and calls processEvents().
+class PowerSupplyRegistry {
+public:
+    static constexpr double SYSTEM_INTERVAL = 1.5;  // a little under the page's 2 s refresh
+    static constexpr double PERIPHERAL_INTERVAL = 60.0;
+    static constexpr double RESCAN_INTERVAL = 10.0;
+
+    PowerSupplyRegistry();
+    ~PowerSupplyRegistry();
+
+    PowerSupplyRegistry(const PowerSupplyRegistry&) = delete;
+    PowerSupplyRegistry& operator=(const PowerSupplyRegistry&) = delete;
+
+    void start(double now);
+    void stop();
+
+    // The uevent socket, or -1 when hotplug is found by rescanning
+    int eventFd() const { return ueventFd; }
+
+    // Drains the uevent socket; true if a supply was added, removed or re-read
+    bool processEvents(double now);
+    // Re-reads the supplies that are due; true if any was
+    bool refresh(double now);
+
+    // System batteries first, then peripherals, each in name order
+    size_t size() const { return entries.size(); }
+    const PowerSupplyStatus& at(size_t index) const { return entries[index]->status; }
+    size_t systemCount() const;
+
+    // The system batteries as one: energies and rates are summed and the
+    // charge is weighted by each battery's capacity
+    BatteryInfo aggregate() const;
+
+private:
+    struct Entry {
+        PowerSupplyStatus status;
+        PowerSupply reader;
+        double nextRefresh = 0.0;
+    };
+
+    std::vector<std::unique_ptr<Entry>> entries;
+    int ueventFd;
+    double nextRescan;
+
+    void rescan(double now);
+    bool add(const std::string& name, double now);
+    bool remove(const std::string& name);
+    bool read(Entry& entry, double now);
+    void sort();
+    Entry* find(const std::string& name);
+};
+
+#endif // POWERSUPPLYREGISTRY_H
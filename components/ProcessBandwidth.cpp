@@ -0,0 +1,404 @@
+#include "ProcessBandwidth.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/sock_diag.h>
+#include <linux/tcp.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static double monotonicSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+static double threadCpuMs() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+static size_t slotFor(uint64_t inode, size_t mask) {
+    // Inodes are close to sequential; mix them before masking
+    inode ^= inode >> 33;
+    inode *= 0xff51afd7ed558ccdULL;
+    inode ^= inode >> 33;
+    return static_cast<size_t>(inode) & mask;
+}
+
+void ProcessBandwidth::SocketTable::reset(size_t minCapacity) {
+    size_t capacity = 64;
+    while (capacity < minCapacity * 2) capacity <<= 1;
+
+    // Only grows; a table that is big enough is just cleared
+    if (slots.size() < capacity) {
+        slots.assign(capacity, SocketEntry{});
+    } else {
+        std::fill(slots.begin(), slots.end(), SocketEntry{});
+    }
+    used = 0;
+}
+
+ProcessBandwidth::SocketEntry* ProcessBandwidth::SocketTable::find(uint64_t inode) {
+    if (slots.empty()) return nullptr;
+
+    size_t mask = slots.size() - 1;
+    for (size_t i = slotFor(inode, mask);; i = (i + 1) & mask) {
+        if (slots[i].inode == inode) return &slots[i];
+        if (slots[i].inode == 0) return nullptr;
+    }
+}
+
+ProcessBandwidth::SocketEntry* ProcessBandwidth::SocketTable::insert(uint64_t inode) {
+    // Keep the load under one half so probes stay short
+    if ((used + 1) * 2 > slots.size()) {
+        std::vector<SocketEntry> old;
+        old.swap(slots);
+        reset(used + 1);
+        for (const SocketEntry& entry : old) {
+            if (entry.inode != 0) *insert(entry.inode) = entry;
+        }
+    }
+
+    size_t mask = slots.size() - 1;
+    for (size_t i = slotFor(inode, mask);; i = (i + 1) & mask) {
+        if (slots[i].inode == inode) return &slots[i];
+        if (slots[i].inode == 0) {
+            slots[i].inode = inode;
+            ++used;
+            return &slots[i];
+        }
+    }
+}
+
+ProcessBandwidth::ProcessBandwidth()
+    : notifyFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)), wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      running(false), stopRequested(false), netlinkFd(-1), lastProcScan(0.0), ownUid(getuid()) {
+}
+
+ProcessBandwidth::~ProcessBandwidth() {
+    stop();
+    if (notifyFd >= 0) ::close(notifyFd);
+    if (wakeFd >= 0) ::close(wakeFd);
+}
+
+bool ProcessBandwidth::start() {
+    if (running || notifyFd < 0 || wakeFd < 0) return running;
+
+    stopRequested = false;
+    running = true;
+    worker = std::thread(&ProcessBandwidth::run, this);
+    return true;
+}
+
+void ProcessBandwidth::stop() {
+    stopRequested = true;
+    if (worker.joinable()) {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFd, &one, sizeof(one));
+        (void)written;
+        worker.join();
+
+        uint64_t value;
+        while (read(wakeFd, &value, sizeof(value)) == sizeof(value)) {
+        }
+    }
+    running = false;
+}
+
+void ProcessBandwidth::acknowledge() {
+    uint64_t value;
+    while (read(notifyFd, &value, sizeof(value)) == sizeof(value)) {
+    }
+}
+
+std::vector<ProcessTraffic> ProcessBandwidth::snapshot() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    return published;
+}
+
+void ProcessBandwidth::run() {
+    netlinkFd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+    if (netlinkFd < 0) {
+        running = false;
+        signal();
+        return;
+    }
+
+    receiveBuffer.resize(32768);
+    previous.reset(previous.used);
+    current.reset(previous.used);
+    processes.clear();
+    lastProcScan = 0.0;
+
+    bool primed = false;
+    double lastTick = monotonicSeconds();
+    int intervalMs = BASE_INTERVAL_MS;
+
+    while (!stopRequested) {
+        double cpuStart = threadCpuMs();
+        double now = monotonicSeconds();
+
+        current.reset(previous.used);
+        bool dumped = dumpSockets(AF_INET);
+        if (!dumped) discardReplies();
+        // IPv6 disabled or without sock_diag support only means there are no IPv6 sockets
+        if (dumped && !dumpSockets(AF_INET6)) discardReplies();
+        if (dumped) {
+            resolveOwners(now);
+            account(now, primed ? now - lastTick : 0.0);
+            std::swap(previous, current);
+            primed = true;
+            signal();
+        }
+        lastTick = now;
+
+        // Stretch the interval until a tick costs no more than CPU_BUDGET of it
+        double costMs = threadCpuMs() - cpuStart;
+        intervalMs = std::clamp(static_cast<int>(costMs / CPU_BUDGET), BASE_INTERVAL_MS, MAX_INTERVAL_MS);
+
+        pollfd wake{wakeFd, POLLIN, 0};
+        poll(&wake, 1, intervalMs);
+    }
+
+    ::close(netlinkFd);
+    netlinkFd = -1;
+    running = false;
+    signal();
+}
+
+bool ProcessBandwidth::dumpSockets(int family) {
+    struct {
+        nlmsghdr header;
+        inet_diag_req_v2 request;
+    } message{};
+
+    message.header.nlmsg_len = sizeof(message);
+    message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+    message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    message.request.sdiag_family = static_cast<uint8_t>(family);
+    message.request.sdiag_protocol = IPPROTO_TCP;
+    message.request.idiag_states = ~(1U << 10); // everything but LISTEN
+    message.request.idiag_ext = 1 << (INET_DIAG_INFO - 1);
+
+    sockaddr_nl kernel{};
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(netlinkFd, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0) {
+        return false;
+    }
+
+    // tcp_info grew over time; only kernels that report both byte counters are useful
+    const size_t needed = offsetof(struct tcp_info, tcpi_bytes_received) + sizeof(uint64_t);
+
+    while (true) {
+        ssize_t length = recv(netlinkFd, receiveBuffer.data(), receiveBuffer.size(), 0);
+        if (length < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+
+        for (nlmsghdr* header = reinterpret_cast<nlmsghdr*>(receiveBuffer.data());
+             NLMSG_OK(header, static_cast<unsigned int>(length));
+             header = NLMSG_NEXT(header, length)) {
+            if (header->nlmsg_type == NLMSG_DONE) return true;
+            if (header->nlmsg_type == NLMSG_ERROR) return false;
+
+            inet_diag_msg* diag = static_cast<inet_diag_msg*>(NLMSG_DATA(header));
+            if (diag->idiag_inode == 0) continue; // TIME_WAIT and orphans belong to nobody
+
+            const tcp_info* info = nullptr;
+            int attributesLength = static_cast<int>(header->nlmsg_len - NLMSG_LENGTH(sizeof(*diag)));
+            for (rtattr* attribute = reinterpret_cast<rtattr*>(diag + 1);
+                 RTA_OK(attribute, attributesLength);
+                 attribute = RTA_NEXT(attribute, attributesLength)) {
+                if (attribute->rta_type == INET_DIAG_INFO && RTA_PAYLOAD(attribute) >= needed) {
+                    info = static_cast<const tcp_info*>(RTA_DATA(attribute));
+                }
+            }
+            if (!info) continue;
+
+            SocketEntry* before = previous.find(diag->idiag_inode);
+            SocketEntry* entry = current.insert(diag->idiag_inode);
+            entry->sent = info->tcpi_bytes_acked;
+            entry->received = info->tcpi_bytes_received;
+            entry->uid = diag->idiag_uid;
+            if (before) {
+                entry->pid = before->pid;
+                entry->pendingRx = before->pendingRx;
+                entry->pendingTx = before->pendingTx;
+                entry->scans = before->scans;
+            } else if (ownUid != 0 && entry->uid != ownUid) {
+                // Another user's fds are unreadable, so there is nothing to search for
+                entry->pid = 0;
+            }
+        }
+    }
+}
+
+void ProcessBandwidth::discardReplies() {
+    // Whatever is left of a failed dump would be read as the start of the next one
+    while (recv(netlinkFd, receiveBuffer.data(), receiveBuffer.size(), MSG_DONTWAIT) > 0) {
+    }
+}
+
+void ProcessBandwidth::resolveOwners(double now) {
+    bool unknown = false;
+    for (const SocketEntry& entry : current.slots) {
+        if (entry.inode != 0 && entry.pid < 0) {
+            unknown = true;
+            break;
+        }
+    }
+    if (!unknown || (now - lastProcScan) * 1000.0 < PROC_SCAN_INTERVAL_MS) return;
+    lastProcScan = now;
+
+    DIR* proc = opendir("/proc");
+    if (!proc) return;
+
+    char path[64];
+    char target[64];
+    while (dirent* process = readdir(proc)) {
+        if (!isdigit(static_cast<unsigned char>(process->d_name[0]))) continue;
+        int pid = atoi(process->d_name);
+
+        // Other users' fd directories are unreadable unless we are root
+        snprintf(path, sizeof(path), "/proc/%d/fd", pid);
+        int fdDir = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fdDir < 0) continue;
+        DIR* fds = fdopendir(fdDir);
+        if (!fds) {
+            ::close(fdDir);
+            continue;
+        }
+
+        while (dirent* fd = readdir(fds)) {
+            if (fd->d_name[0] == '.') continue;
+            ssize_t n = readlinkat(fdDir, fd->d_name, target, sizeof(target) - 1);
+            if (n <= 9 || strncmp(target, "socket:[", 8) != 0) continue;
+            target[n] = '\0';
+
+            SocketEntry* entry = current.find(strtoull(target + 8, nullptr, 10));
+            if (entry && entry->pid < 0) entry->pid = pid;
+        }
+        closedir(fds);
+    }
+    closedir(proc);
+
+    // Our own sockets can be missed by a socket opened after its process was
+    // walked, so they get another scan before they are given up on
+    for (SocketEntry& entry : current.slots) {
+        if (entry.inode == 0 || entry.pid >= 0) continue;
+        if (entry.uid != ownUid || ++entry.scans >= OWNER_SCAN_ATTEMPTS) entry.pid = 0;
+    }
+}
+
+void ProcessBandwidth::account(double now, double elapsedSeconds) {
+    for (auto& item : processes) {
+        item.second.tickRx = 0;
+        item.second.tickTx = 0;
+        item.second.traffic.sockets = 0;
+    }
+
+    for (SocketEntry& entry : current.slots) {
+        if (entry.inode == 0) continue;
+        const SocketEntry* before = previous.find(entry.inode);
+
+        // Held back from every row until the owner is known
+        if (entry.pid < 0) {
+            if (before) {
+                if (entry.received >= before->received) entry.pendingRx += entry.received - before->received;
+                if (entry.sent >= before->sent) entry.pendingTx += entry.sent - before->sent;
+            }
+            continue;
+        }
+        int pid = entry.pid;
+
+        auto found = processes.find(pid);
+        if (found == processes.end()) {
+            // New processes are the only allocation in a steady tick
+            ProcessState state;
+            state.traffic.pid = pid;
+            state.lastActive = now;
+            if (pid > 0) {
+                char path[64];
+                snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+                int fd = open(path, O_RDONLY | O_CLOEXEC);
+                if (fd >= 0) {
+                    char comm[32];
+                    ssize_t n = read(fd, comm, sizeof(comm) - 1);
+                    ::close(fd);
+                    if (n > 0) {
+                        if (comm[n - 1] == '\n') --n;
+                        state.traffic.name.assign(comm, n);
+                    }
+                }
+            }
+            found = processes.emplace(pid, std::move(state)).first;
+        }
+
+        ProcessState& state = found->second;
+        ++state.traffic.sockets;
+
+        // Held-back traffic spans several ticks, so it counts towards the
+        // totals but not this tick's rate
+        state.traffic.rxTotal += entry.pendingRx;
+        state.traffic.txTotal += entry.pendingTx;
+        entry.pendingRx = 0;
+        entry.pendingTx = 0;
+
+        if (before) {
+            if (entry.received >= before->received) state.tickRx += entry.received - before->received;
+            if (entry.sent >= before->sent) state.tickTx += entry.sent - before->sent;
+        }
+    }
+
+    staging.clear();
+    for (auto it = processes.begin(); it != processes.end();) {
+        ProcessState& state = it->second;
+        ProcessTraffic& traffic = state.traffic;
+
+        traffic.rxTotal += state.tickRx;
+        traffic.txTotal += state.tickTx;
+        traffic.rxRate = elapsedSeconds > 0.0 ? state.tickRx / elapsedSeconds : 0.0;
+        traffic.txRate = elapsedSeconds > 0.0 ? state.tickTx / elapsedSeconds : 0.0;
+        if (traffic.sockets > 0 || state.tickRx > 0 || state.tickTx > 0) {
+            state.lastActive = now;
+        }
+
+        if (now - state.lastActive > IDLE_FORGET_SECONDS) {
+            it = processes.erase(it);
+            continue;
+        }
+        staging.push_back(traffic);
+        ++it;
+    }
+
+    std::sort(staging.begin(), staging.end(), [](const ProcessTraffic& a, const ProcessTraffic& b) {
+        double rateA = a.rxRate + a.txRate;
+        double rateB = b.rxRate + b.txRate;
+        if (rateA != rateB) return rateA > rateB;
+        return a.rxTotal + a.txTotal > b.rxTotal + b.txTotal;
+    });
+
+    // Hand the buffer over; the one coming back is reused next tick
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    published.swap(staging);
+}
+
+void ProcessBandwidth::signal() {
+    uint64_t one = 1;
+    ssize_t written = write(notifyFd, &one, sizeof(one));
+    (void)written;
+}
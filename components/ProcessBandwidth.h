@@ -0,0 +1,117 @@
+#ifndef PROCESSBANDWIDTH_H
+#define PROCESSBANDWIDTH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+struct ProcessTraffic {
+    int pid = 0;          // 0 collects sockets owned by processes we may not inspect
+    std::string name;
+    double rxRate = 0.0;  // bytes per second
+    double txRate = 0.0;
+    uint64_t rxTotal = 0; // since sampling started
+    uint64_t txTotal = 0;
+    int sockets = 0;
+};
+
+// Per-process TCP traffic. A worker thread dumps every TCP socket with its
+// tcp_info byte counters over NETLINK_SOCK_DIAG, diffs them against the
+// previous dump, and charges the delta to the process owning the socket
+// inode (found by walking /proc/<pid>/fd, only when unknown inodes show up
+// and at most every PROC_SCAN_INTERVAL_MS). Until its owner is found a
+// socket's traffic is held on the socket and handed to the owner with the
+// first tick that knows it; only other users' sockets, whose fds we may not
+// read, go to pid 0 straight away. Socket state lives in two flat
+// open-addressing tables that are swapped each tick, so steady-state ticks
+// do not allocate per socket. The worker measures its own CPU time and
+// stretches its interval to stay under CPU_BUDGET. Like NetworkProbe, it
+// announces new snapshots on eventFd().
+class ProcessBandwidth {
+public:
+    static constexpr int BASE_INTERVAL_MS = 1000;
+    static constexpr int MAX_INTERVAL_MS = 10000;
+    static constexpr int PROC_SCAN_INTERVAL_MS = 3000;
+    static constexpr int OWNER_SCAN_ATTEMPTS = 2;  // then our own unfindable sockets go to pid 0 too
+    static constexpr double CPU_BUDGET = 0.02;  // fraction of one core
+    static constexpr int IDLE_FORGET_SECONDS = 60;
+
+    ProcessBandwidth();
+    ~ProcessBandwidth();
+
+    ProcessBandwidth(const ProcessBandwidth&) = delete;
+    ProcessBandwidth& operator=(const ProcessBandwidth&) = delete;
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    int eventFd() const { return notifyFd; }
+    void acknowledge();
+
+    // Busiest first; processes idle for IDLE_FORGET_SECONDS drop out
+    std::vector<ProcessTraffic> snapshot() const;
+
+private:
+    struct SocketEntry {
+        uint64_t inode = 0;      // 0 marks an empty slot
+        uint64_t sent = 0;
+        uint64_t received = 0;
+        uint64_t pendingRx = 0;  // traffic seen while the owner was unknown
+        uint64_t pendingTx = 0;
+        uint32_t uid = 0;
+        int pid = -1;            // -1 until /proc has been searched for the inode
+        int scans = 0;           // /proc searches that did not find it
+    };
+
+    // Linear-probing table keyed by socket inode
+    struct SocketTable {
+        std::vector<SocketEntry> slots;
+        size_t used = 0;
+
+        void reset(size_t minCapacity);
+        SocketEntry* find(uint64_t inode);
+        SocketEntry* insert(uint64_t inode);
+    };
+
+    struct ProcessState {
+        ProcessTraffic traffic;
+        uint64_t tickRx = 0;
+        uint64_t tickTx = 0;
+        double lastActive = 0.0;
+    };
+
+    int notifyFd;
+    int wakeFd;
+    std::thread worker;
+    std::atomic<bool> running;
+    std::atomic<bool> stopRequested;
+
+    mutable std::mutex snapshotMutex;
+    std::vector<ProcessTraffic> published;
+
+    // Worker-only state
+    int netlinkFd;
+    std::vector<uint8_t> receiveBuffer;
+    SocketTable previous;
+    SocketTable current;
+    std::unordered_map<int, ProcessState> processes;
+    std::vector<ProcessTraffic> staging;
+    double lastProcScan;
+    uid_t ownUid;
+
+    void run();
+    bool dumpSockets(int family);
+    void discardReplies();
+    void resolveOwners(double now);
+    void account(double now, double elapsedSeconds);
+    void signal();
+};
+
+#endif // PROCESSBANDWIDTH_H
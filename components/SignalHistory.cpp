@@ -0,0 +1,153 @@
+#include "SignalHistory.h"
+#include <algorithm>
+#include <cstdio>
+
+bool SignalHistory::record(const std::string& key, uint32_t time, int strength, int frequency, const std::string& bssid) {
+    auto it = tracks.find(key);
+    if (it == tracks.end()) {
+        if (tracks.size() >= MAX_NETWORKS) {
+            evictOldest();
+        }
+        it = tracks.emplace(key, SignalTrack()).first;
+    }
+
+    SignalTrack& track = it->second;
+    track.lastUpdate = time;
+
+    SignalPoint point;
+    point.time = time;
+    point.frequency = static_cast<uint16_t>(std::clamp(frequency, 0, 0xffff));
+    point.strength = static_cast<uint8_t>(std::clamp(strength, 0, 100));
+    point.bssidSlot = slotFor(track, packBssid(bssid));
+
+    if (track.count > 0) {
+        SignalPoint& last = track.points[(track.head + track.count - 1) % SignalTrack::POINTS];
+        if (last.strength == point.strength && last.frequency == point.frequency &&
+            last.bssidSlot == point.bssidSlot) {
+            return false;
+        }
+        // Several updates within one second collapse into the latest
+        if (last.time == point.time) {
+            last = point;
+            return true;
+        }
+    }
+
+    if (track.count == SignalTrack::POINTS) {
+        track.head = (track.head + 1) % SignalTrack::POINTS;
+        --track.count;
+    }
+    track.points[(track.head + track.count) % SignalTrack::POINTS] = point;
+    ++track.count;
+    return true;
+}
+
+void SignalHistory::recordActive(const std::string& ssid, const std::string& bssid, int frequency, uint32_t time) {
+    uint64_t packed = packBssid(bssid);
+    uint16_t freq = static_cast<uint16_t>(std::clamp(frequency, 0, 0xffff));
+
+    if (activeKnown && activeSsid == ssid && activeBssid == packed) return;
+
+    RoamEvent event;
+    event.time = time;
+    event.ssid = ssid;
+    event.toBssid = packed;
+    event.toFrequency = freq;
+
+    // A hop inside the same SSID is a roam, even across a brief drop
+    if (activeSsid == ssid && activeBssid != 0 && activeBssid != packed) {
+        event.kind = RoamEvent::Kind::Roamed;
+        event.fromBssid = activeBssid;
+        event.fromFrequency = activeFrequency;
+    } else {
+        event.kind = RoamEvent::Kind::Connected;
+        event.fromBssid = 0;
+        event.fromFrequency = 0;
+    }
+    pushEvent(std::move(event));
+
+    activeKnown = true;
+    activeSsid = ssid;
+    activeBssid = packed;
+    activeFrequency = freq;
+}
+
+void SignalHistory::recordActiveLost(uint32_t time) {
+    if (!activeKnown) return;
+    activeKnown = false;
+
+    RoamEvent event;
+    event.kind = RoamEvent::Kind::Lost;
+    event.time = time;
+    event.ssid = activeSsid;
+    event.fromBssid = activeBssid;
+    event.toBssid = 0;
+    event.fromFrequency = activeFrequency;
+    event.toFrequency = 0;
+    pushEvent(std::move(event));
+}
+
+const SignalTrack* SignalHistory::find(const std::string& key) const {
+    auto it = tracks.find(key);
+    return it != tracks.end() ? &it->second : nullptr;
+}
+
+uint64_t SignalHistory::packBssid(const std::string& bssid) {
+    unsigned int b[6];
+    if (std::sscanf(bssid.c_str(), "%x:%x:%x:%x:%x:%x", &b[0], &b[1], &b[2], &b[3], &b[4], &b[5]) != 6) {
+        return 0;
+    }
+
+    uint64_t packed = 0;
+    for (unsigned int byte : b) {
+        packed = (packed << 8) | (byte & 0xff);
+    }
+    return packed;
+}
+
+std::string SignalHistory::formatBssid(uint64_t packed) {
+    char buffer[18];
+    std::snprintf(buffer, sizeof(buffer), "%02X:%02X:%02X:%02X:%02X:%02X",
+                  static_cast<unsigned int>((packed >> 40) & 0xff), static_cast<unsigned int>((packed >> 32) & 0xff),
+                  static_cast<unsigned int>((packed >> 24) & 0xff), static_cast<unsigned int>((packed >> 16) & 0xff),
+                  static_cast<unsigned int>((packed >> 8) & 0xff), static_cast<unsigned int>(packed & 0xff));
+    return buffer;
+}
+
+uint8_t SignalHistory::slotFor(SignalTrack& track, uint64_t bssid) {
+    for (uint8_t i = 0; i < track.bssidCount; ++i) {
+        if (track.bssids[i] == bssid) return i;
+    }
+
+    if (track.bssidCount < SignalTrack::BSSIDS) {
+        track.bssids[track.bssidCount] = bssid;
+        return track.bssidCount++;
+    }
+
+    // Table full: recycle slots round-robin; old points then show the newer BSSID
+    uint8_t slot = track.nextBssidSlot;
+    track.nextBssidSlot = (track.nextBssidSlot + 1) % SignalTrack::BSSIDS;
+    track.bssids[slot] = bssid;
+    return slot;
+}
+
+void SignalHistory::evictOldest() {
+    auto oldest = tracks.end();
+    for (auto it = tracks.begin(); it != tracks.end(); ++it) {
+        if (oldest == tracks.end() || it->second.lastUpdate < oldest->second.lastUpdate) {
+            oldest = it;
+        }
+    }
+    if (oldest != tracks.end()) {
+        tracks.erase(oldest);
+    }
+}
+
+void SignalHistory::pushEvent(RoamEvent event) {
+    if (eventTotal == MAX_EVENTS) {
+        eventHead = (eventHead + 1) % MAX_EVENTS;
+        --eventTotal;
+    }
+    events[(eventHead + eventTotal) % MAX_EVENTS] = std::move(event);
+    ++eventTotal;
+}
@@ -0,0 +1,87 @@
+#ifndef SIGNALHISTORY_H
+#define SIGNALHISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// One observation of a network: 8 bytes so a full track stays small
+struct SignalPoint {
+    uint32_t time;      // seconds, monotonic
+    uint16_t frequency; // MHz
+    uint8_t strength;   // percent
+    uint8_t bssidSlot;  // index into SignalTrack::bssids
+};
+
+struct SignalTrack {
+    static constexpr size_t POINTS = 64;
+    static constexpr size_t BSSIDS = 8;
+
+    std::array<SignalPoint, POINTS> points;
+    std::array<uint64_t, BSSIDS> bssids;
+    uint8_t head = 0;  // index of the oldest point
+    uint8_t count = 0;
+    uint8_t bssidCount = 0;
+    uint8_t nextBssidSlot = 0;
+    uint32_t lastUpdate = 0;
+
+    const SignalPoint& at(size_t index) const { return points[(head + index) % POINTS]; }
+};
+
+struct RoamEvent {
+    enum class Kind : uint8_t { Connected, Roamed, Lost };
+
+    Kind kind;
+    uint32_t time;
+    std::string ssid;
+    uint64_t fromBssid;
+    uint64_t toBssid;
+    uint16_t fromFrequency;
+    uint16_t toFrequency;
+};
+
+// Rolling per-SSID record of strength, frequency and BSSID plus a log of
+// roams between access points. Everything is fed from NetworkManager signals
+// rather than polled, and memory is capped: at most MAX_NETWORKS tracks of
+// SignalTrack::POINTS points each (the least recently updated track is
+// dropped first) and MAX_EVENTS log entries.
+class SignalHistory {
+public:
+    static constexpr size_t MAX_NETWORKS = 64;
+    static constexpr size_t MAX_EVENTS = 32;
+
+    // Returns true if a new point was stored
+    bool record(const std::string& key, uint32_t time, int strength, int frequency, const std::string& bssid);
+
+    // Feeds the device's active access point; emits Connected/Roamed/Lost
+    void recordActive(const std::string& ssid, const std::string& bssid, int frequency, uint32_t time);
+    void recordActiveLost(uint32_t time);
+
+    const SignalTrack* find(const std::string& key) const;
+
+    size_t eventCount() const { return eventTotal; }
+    const RoamEvent& event(size_t index) const { return events[(eventHead + index) % MAX_EVENTS]; }
+
+    static uint64_t packBssid(const std::string& bssid);
+    static std::string formatBssid(uint64_t packed);
+
+private:
+    std::unordered_map<std::string, SignalTrack> tracks;
+
+    std::array<RoamEvent, MAX_EVENTS> events;
+    size_t eventHead = 0;
+    size_t eventTotal = 0;
+
+    bool activeKnown = false;
+    std::string activeSsid;
+    uint64_t activeBssid = 0;
+    uint16_t activeFrequency = 0;
+
+    uint8_t slotFor(SignalTrack& track, uint64_t bssid);
+    void evictOldest();
+    void pushEvent(RoamEvent event);
+};
+
+#endif // SIGNALHISTORY_H
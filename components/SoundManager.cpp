@@ -9,6 +9,7 @@
 #include <cstdio>
 #include <memory>
 #include <array>
+#include <cmath>
 
 SoundManager::SoundManager(MainWindow* mainWindow, GtkWindow* parentWindow, GtkWidget* overlay)
     : mainWindow(mainWindow), parentWindow(parentWindow), overlay(overlay),
@@ -16,8 +17,14 @@ SoundManager::SoundManager(MainWindow* mainWindow, GtkWindow* parentWindow, GtkW
       outputLabel(nullptr), outputDeviceCombo(nullptr), outputVolumeScale(nullptr), outputVolumeLabel(nullptr),
       inputLabel(nullptr), inputDeviceCombo(nullptr), inputVolumeScale(nullptr), inputVolumeLabel(nullptr),
       playbackLabel(nullptr), playbackScrolledWindow(nullptr), playbackBox(nullptr),
+      equalizerLabel(nullptr), equalizerSwitch(nullptr), equalizerPresetCombo(nullptr),
+      equalizerSaveButton(nullptr), equalizerSaveAsButton(nullptr), equalizerCurve(nullptr),
+      equalizerSink(std::make_unique<EqualizerSink>()),
+      currentEqualizerPreset{"Flat", 0.0, EqualizerEngine::defaultBands()},
+      equalizerPreview(EqualizerSink::CHANNELS, EqualizerSink::SAMPLE_RATE),
       outputVolumeTimer(0), inputVolumeTimer(0), refreshTimer(0) {
     
+    loadEqualizerPresets();
     setupUI();
     
     // Start refresh timer (every 2 seconds)
@@ -38,6 +45,9 @@ SoundManager::~SoundManager() {
         inputVolumeTimer = 0;
     }
     
+    // Stopping the equalizer puts the real sink back as default
+    equalizerSink.reset();
+    
     clientWidgets.clear();
 }
 
@@ -216,6 +226,7 @@ void SoundManager::initSoundUI() {
         gtk_fixed_put(GTK_FIXED(soundContainer), playbackScrolledWindow, 480, 410);
     }
     
+    initEqualizerUI();
     
     // Apply CSS styling to match NetworkManager
     GtkCssProvider* provider = gtk_css_provider_new();
@@ -353,6 +364,49 @@ void SoundManager::initSoundUI() {
          "  color: white; "
          "  text-shadow: 0 1px 0 rgba(0, 0, 0, 0.3); "
          "} "
+        ".equalizer-switch { "
+        "  background: linear-gradient(145deg, rgba(255, 255, 255, 0.2), rgba(255, 255, 255, 0.1)); "
+        "  border: 1px solid rgba(192, 192, 192, 0.6); "
+        "  border-radius: 12px; "
+        "} "
+        ".equalizer-switch:checked { "
+        "  background: linear-gradient(90deg, #e5a7c6 0%, #edcee3 100%); "
+        "} "
+        ".equalizer-save-button { "
+        "  background: linear-gradient(145deg, rgba(255, 255, 255, 0.3), rgba(255, 255, 255, 0.18)); "
+        "  border: 2px solid rgba(229, 167, 198, 0.4); "
+        "  border-radius: 15px; "
+        "  color: white; "
+        "  font-family: ElysiaOSNew12; "
+        "  font-size: 14px; "
+        "} "
+        ".equalizer-save-button:hover { "
+        "  background: linear-gradient(62deg, #fd84cb 20%, #fed0f4 70%); "
+        "} "
+        ".equalizer-curve { "
+        "  background: linear-gradient(145deg, rgba(255, 255, 255, 0.1), rgba(255, 255, 255, 0.05)); "
+        "  border: 1px solid rgba(192, 192, 192, 0.3); "
+        "  border-radius: 12px; "
+        "} "
+        ".equalizer-scale trough { "
+        "  background: linear-gradient(180deg, rgba(255, 255, 255, 0.15), rgba(255, 255, 255, 0.1)); "
+        "  border: 1px solid rgba(192, 192, 192, 0.3); "
+        "  border-radius: 8px; "
+        "  min-width: 8px; "
+        "} "
+        ".equalizer-scale slider { "
+        "  background: linear-gradient(145deg, #e5a7c6, #edcee3); "
+        "  border: 1px solid rgba(255, 255, 255, 0.8); "
+        "  border-radius: 10px; "
+        "  min-width: 20px; "
+        "  min-height: 20px; "
+        "} "
+        ".equalizer-band-label { "
+        "  font-family: ElysiaOSNew12; "
+        "  font-size: 11px; "
+        "  color: white; "
+        "  text-shadow: 0 1px 0 rgba(0, 0, 0, 0.3); "
+        "} "
 ;
     
     gtk_css_provider_load_from_string(provider, css);
@@ -365,6 +419,153 @@ void SoundManager::initSoundUI() {
     g_object_unref(provider);
 }
 
+void SoundManager::initEqualizerUI() {
+    if (!soundContainer) return;
+    
+    // Equalizer section sits in the free column left of the device controls
+    equalizerLabel = gtk_label_new(TR(TranslationKeys::EQUALIZER));
+    if (equalizerLabel) {
+        PangoAttrList* eqAttrList = pango_attr_list_new();
+        pango_attr_list_insert(eqAttrList, pango_attr_size_new(16 * PANGO_SCALE));
+        pango_attr_list_insert(eqAttrList, pango_attr_weight_new(PANGO_WEIGHT_BOLD));
+        gtk_label_set_attributes(GTK_LABEL(equalizerLabel), eqAttrList);
+        pango_attr_list_unref(eqAttrList);
+        gtk_widget_add_css_class(equalizerLabel, "section-label");
+        
+        gtk_fixed_put(GTK_FIXED(soundContainer), equalizerLabel, 40, 120);
+    }
+    
+    equalizerSwitch = gtk_switch_new();
+    if (equalizerSwitch) {
+        gtk_switch_set_active(GTK_SWITCH(equalizerSwitch), FALSE);
+        gtk_widget_add_css_class(equalizerSwitch, "equalizer-switch");
+        g_signal_connect(equalizerSwitch, "state-set", G_CALLBACK(onEqualizerSwitchStateSet), this);
+        gtk_fixed_put(GTK_FIXED(soundContainer), equalizerSwitch, 370, 118);
+    }
+    
+    equalizerPresetCombo = gtk_combo_box_text_new();
+    if (equalizerPresetCombo) {
+        gtk_widget_set_size_request(equalizerPresetCombo, 170, 40);
+        gtk_widget_add_css_class(equalizerPresetCombo, "device-combo");
+        
+        int activeIndex = -1;
+        for (size_t i = 0; i < equalizerPresets.size(); ++i) {
+            gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(equalizerPresetCombo),
+                                      equalizerPresets[i].name.c_str(),
+                                      equalizerPresets[i].name.c_str());
+            if (equalizerPresets[i].name == currentEqualizerPreset.name) {
+                activeIndex = static_cast<int>(i);
+            }
+        }
+        gtk_combo_box_set_active(GTK_COMBO_BOX(equalizerPresetCombo), activeIndex);
+        
+        gtk_fixed_put(GTK_FIXED(soundContainer), equalizerPresetCombo, 40, 150);
+        g_signal_connect(equalizerPresetCombo, "changed", G_CALLBACK(onEqualizerPresetChanged), this);
+    }
+    
+    equalizerSaveButton = gtk_button_new_with_label(TR(TranslationKeys::EQUALIZER_SAVE_PRESET));
+    if (equalizerSaveButton) {
+        gtk_widget_set_size_request(equalizerSaveButton, 100, 40);
+        gtk_widget_add_css_class(equalizerSaveButton, "equalizer-save-button");
+        g_signal_connect(equalizerSaveButton, "clicked", G_CALLBACK(onEqualizerSaveClicked), this);
+        gtk_fixed_put(GTK_FIXED(soundContainer), equalizerSaveButton, 220, 150);
+    }
+    
+    equalizerSaveAsButton = gtk_button_new_with_label(TR(TranslationKeys::EQUALIZER_SAVE_PRESET_AS));
+    if (equalizerSaveAsButton) {
+        gtk_widget_set_size_request(equalizerSaveAsButton, 100, 40);
+        gtk_widget_add_css_class(equalizerSaveAsButton, "equalizer-save-button");
+        g_signal_connect(equalizerSaveAsButton, "clicked", G_CALLBACK(onEqualizerSaveAsClicked), this);
+        gtk_fixed_put(GTK_FIXED(soundContainer), equalizerSaveAsButton, 330, 150);
+    }
+    
+    // Response curve, computed from the same coefficients the DSP runs
+    equalizerCurve = gtk_drawing_area_new();
+    if (equalizerCurve) {
+        gtk_widget_set_size_request(equalizerCurve, 390, 70);
+        gtk_widget_add_css_class(equalizerCurve, "equalizer-curve");
+        gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(equalizerCurve), drawEqualizerCurve, this, nullptr);
+        gtk_fixed_put(GTK_FIXED(soundContainer), equalizerCurve, 40, 205);
+    }
+    
+    // One vertical slider per band
+    for (size_t i = 0; i < currentEqualizerPreset.bands.size(); ++i) {
+        const int x = 40 + static_cast<int>(i) * 39;
+        
+        GtkWidget* bandScale = gtk_scale_new_with_range(GTK_ORIENTATION_VERTICAL, -12.0, 12.0, 0.5);
+        gtk_scale_set_draw_value(GTK_SCALE(bandScale), FALSE);
+        gtk_range_set_inverted(GTK_RANGE(bandScale), TRUE);
+        gtk_scale_add_mark(GTK_SCALE(bandScale), 0.0, GTK_POS_LEFT, nullptr);
+        gtk_widget_set_size_request(bandScale, 30, 210);
+        gtk_widget_add_css_class(bandScale, "equalizer-scale");
+        gtk_range_set_value(GTK_RANGE(bandScale), currentEqualizerPreset.bands[i].gain);
+        g_object_set_data(G_OBJECT(bandScale), "band-index", GINT_TO_POINTER(static_cast<int>(i)));
+        g_signal_connect(bandScale, "value-changed", G_CALLBACK(onEqualizerBandChanged), this);
+        gtk_fixed_put(GTK_FIXED(soundContainer), bandScale, x, 290);
+        equalizerBandScales.push_back(bandScale);
+        
+        double freq = currentEqualizerPreset.bands[i].frequency;
+        std::string freqText = freq >= 1000.0
+            ? std::to_string(static_cast<int>(freq / 1000.0)) + "k"
+            : std::to_string(static_cast<int>(freq));
+        GtkWidget* bandLabel = gtk_label_new(freqText.c_str());
+        gtk_widget_set_size_request(bandLabel, 30, -1);
+        gtk_widget_add_css_class(bandLabel, "equalizer-band-label");
+        gtk_fixed_put(GTK_FIXED(soundContainer), bandLabel, x, 505);
+    }
+}
+
+void SoundManager::loadEqualizerPresets() {
+    equalizerPresets = EqualizerEngine::builtinPresets();
+    for (const auto& preset : equalizerPresetStore.loadUserPresets()) {
+        auto it = std::find_if(equalizerPresets.begin(), equalizerPresets.end(),
+                               [&](const EqualizerPreset& p) { return p.name == preset.name; });
+        if (it != equalizerPresets.end()) {
+            *it = preset;
+        } else {
+            equalizerPresets.push_back(preset);
+        }
+    }
+    
+    std::string activeName = equalizerPresetStore.loadActivePresetName();
+    for (const auto& preset : equalizerPresets) {
+        if (preset.name == activeName) {
+            currentEqualizerPreset = preset;
+            break;
+        }
+    }
+    
+    equalizerPreview.setBands(currentEqualizerPreset.bands);
+    equalizerPreview.setPreamp(currentEqualizerPreset.preamp);
+    equalizerSink->setPreset(currentEqualizerPreset);
+}
+
+void SoundManager::applyEqualizerPreset(const EqualizerPreset& preset) {
+    currentEqualizerPreset = preset;
+    
+    for (size_t i = 0; i < equalizerBandScales.size() && i < preset.bands.size(); ++i) {
+        g_signal_handlers_block_by_func(equalizerBandScales[i], (gpointer)onEqualizerBandChanged, this);
+        gtk_range_set_value(GTK_RANGE(equalizerBandScales[i]), preset.bands[i].gain);
+        g_signal_handlers_unblock_by_func(equalizerBandScales[i], (gpointer)onEqualizerBandChanged, this);
+    }
+    
+    equalizerPreview.setBands(preset.bands);
+    equalizerPreview.setPreamp(preset.preamp);
+    equalizerSink->setPreset(preset);
+    
+    if (equalizerCurve) {
+        gtk_widget_queue_draw(equalizerCurve);
+    }
+}
+
+std::string SoundManager::getOutputSink() {
+    // While the equalizer is in front, volume and ports belong to the real device
+    if (equalizerSink && equalizerSink->isActive()) {
+        return equalizerSink->getMasterSink();
+    }
+    return getDefaultDevice("sink");
+}
+
 void SoundManager::setupBackButton() {
     if (!soundContainer) return;
     
@@ -568,6 +769,9 @@ std::vector<AudioDevice> SoundManager::getAudioDevices(const std::string& type)
         if (parts.size() < 2) continue;
         
         std::string devName = parts[1];
+        // The equalizer's own null sink and its monitor are plumbing, not devices
+        if (devName.rfind(EqualizerSink::SINK_NAME, 0) == 0) continue;
+        
         if (!devName.empty()) {
             AudioDevice device;
             device.name = devName;
@@ -650,6 +854,11 @@ std::vector<PlaybackClient> SoundManager::getPlaybackClients() {
         clients.push_back(currentClient);
     }
     
+    // Hide the equalizer's own output stream
+    clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                 [](const PlaybackClient& c) { return c.applicationName == EqualizerSink::CLIENT_NAME; }),
+                  clients.end());
+    
     std::cout << "Found " << clients.size() << " playback clients" << std::endl;
     return clients;
 }
@@ -706,7 +915,7 @@ void SoundManager::refreshAudioDevices() {
     inputDevices = getAudioDevices("source");
     
     // Get default devices - just for volume control
-    std::string defaultSink = getDefaultDevice("sink");
+    std::string defaultSink = getOutputSink();
     std::string defaultSource = getDefaultDevice("source");
     
     std::cout << "Default sink: " << defaultSink << std::endl;
@@ -992,6 +1201,15 @@ gboolean SoundManager::onRefreshTimer(gpointer user_data) {
     SoundManager* manager = static_cast<SoundManager*>(user_data);
     if (!manager) return G_SOURCE_REMOVE;
     
+    // The equalizer lost its streams for good; put the real sink back and turn it off
+    if (manager->equalizerSink && manager->equalizerSink->hasFailed()) {
+        std::cerr << "Equalizer stopped: its audio streams could not be reopened" << std::endl;
+        manager->equalizerSink->stop();
+        if (manager->equalizerSwitch) {
+            gtk_switch_set_active(GTK_SWITCH(manager->equalizerSwitch), FALSE);
+        }
+    }
+    
     // Refresh devices and clients periodically
     static int counter = 0;
     if (++counter >= 5) { // Every 10 seconds (5 * 2 seconds)
@@ -1036,10 +1254,17 @@ void SoundManager::onClientVolumeLabelUpdate(GtkRange* range, gpointer user_data
 
 // Device control methods using pactl commands
 void SoundManager::setOutputDevice(const std::string& deviceName, const std::string& portName) {
-    // Set default sink
-    std::string command = "pactl set-default-sink " + deviceName;
-    executeCommand(command);
-    std::cout << "Setting output device: " << deviceName << std::endl;
+    std::string command;
+    if (equalizerSink && equalizerSink->isActive()) {
+        // Keep the equalizer as default and move its output to the new device
+        equalizerSink->setMasterSink(deviceName);
+        std::cout << "Routing equalizer output to: " << deviceName << std::endl;
+    } else {
+        // Set default sink
+        command = "pactl set-default-sink " + deviceName;
+        executeCommand(command);
+        std::cout << "Setting output device: " << deviceName << std::endl;
+    }
     
     // Set sink port
     if (!portName.empty()) {
@@ -1065,7 +1290,7 @@ void SoundManager::setInputDevice(const std::string& deviceName, const std::stri
 
 void SoundManager::setOutputVolume(int volume) {
     // Use the default sink directly
-    std::string defaultSink = getDefaultDevice("sink");
+    std::string defaultSink = getOutputSink();
     if (!defaultSink.empty()) {
         std::string command = "pactl set-sink-volume " + defaultSink + " " + std::to_string(volume) + "%";
         executeCommand(command);
@@ -1088,3 +1313,193 @@ void SoundManager::setPlaybackClientVolume(uint32_t index, int volume) {
     executeCommand(command);
     std::cout << "Setting client " << index << " volume: " << volume << "%" << std::endl;
 }
+
+gboolean SoundManager::onEqualizerSwitchStateSet(GtkSwitch* sw, gboolean state, gpointer user_data) {
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    if (!manager || !manager->equalizerSink) return TRUE;
+    
+    if (state) {
+        // Insert in front of whatever device is selected in the output combo
+        std::string master;
+        const char* devicePort = manager->outputDeviceCombo
+            ? gtk_combo_box_get_active_id(GTK_COMBO_BOX(manager->outputDeviceCombo)) : nullptr;
+        if (devicePort) {
+            master = devicePort;
+            master = master.substr(0, master.find('|'));
+        } else {
+            master = manager->getDefaultDevice("sink");
+        }
+        
+        manager->equalizerSink->setPreset(manager->currentEqualizerPreset);
+        if (!manager->equalizerSink->start(master)) {
+            gtk_switch_set_state(sw, FALSE);
+            return TRUE;
+        }
+    } else {
+        manager->equalizerSink->stop();
+    }
+    
+    gtk_switch_set_state(sw, state);
+    return TRUE;
+}
+
+void SoundManager::onEqualizerPresetChanged(GtkComboBox* combo, gpointer user_data) {
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    if (!manager) return;
+    
+    const char* name = gtk_combo_box_get_active_id(combo);
+    if (!name) return;
+    
+    for (const auto& preset : manager->equalizerPresets) {
+        if (preset.name == name) {
+            manager->applyEqualizerPreset(preset);
+            manager->equalizerPresetStore.saveActivePresetName(preset.name);
+            break;
+        }
+    }
+}
+
+void SoundManager::onEqualizerBandChanged(GtkRange* range, gpointer user_data) {
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    if (!manager) return;
+    
+    size_t band = static_cast<size_t>(GPOINTER_TO_INT(g_object_get_data(G_OBJECT(range), "band-index")));
+    if (band >= manager->currentEqualizerPreset.bands.size()) return;
+    
+    // The preset keeps its name; Save writes the edit back, Save As forks it
+    manager->currentEqualizerPreset.bands[band].gain = gtk_range_get_value(range);
+    
+    manager->equalizerPreview.setBands(manager->currentEqualizerPreset.bands);
+    manager->equalizerSink->setPreset(manager->currentEqualizerPreset);
+    if (manager->equalizerCurve) {
+        gtk_widget_queue_draw(manager->equalizerCurve);
+    }
+}
+
+void SoundManager::onEqualizerSaveClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    if (!manager) return;
+    
+    manager->saveEqualizerPreset(manager->currentEqualizerPreset.name);
+}
+
+void SoundManager::onEqualizerSaveAsClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    if (!manager) return;
+    
+    GtkWidget* dialog = gtk_window_new();
+    gtk_window_set_title(GTK_WINDOW(dialog), TR(TranslationKeys::EQUALIZER_SAVE_PRESET_AS));
+    gtk_window_set_transient_for(GTK_WINDOW(dialog), manager->parentWindow);
+    gtk_window_set_modal(GTK_WINDOW(dialog), TRUE);
+    gtk_window_set_default_size(GTK_WINDOW(dialog), 360, 150);
+    
+    GtkWidget* mainBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 15);
+    gtk_widget_set_margin_top(mainBox, 20);
+    gtk_widget_set_margin_bottom(mainBox, 20);
+    gtk_widget_set_margin_start(mainBox, 20);
+    gtk_widget_set_margin_end(mainBox, 20);
+    
+    GtkWidget* label = gtk_label_new(TR(TranslationKeys::EQUALIZER_PRESET_NAME));
+    gtk_widget_set_halign(label, GTK_ALIGN_START);
+    gtk_box_append(GTK_BOX(mainBox), label);
+    
+    // Starts from the current name so a small change needs little typing
+    GtkWidget* entry = gtk_entry_new();
+    gtk_editable_set_text(GTK_EDITABLE(entry), manager->currentEqualizerPreset.name.c_str());
+    gtk_box_append(GTK_BOX(mainBox), entry);
+    
+    GtkWidget* buttonBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+    gtk_widget_set_halign(buttonBox, GTK_ALIGN_END);
+    
+    GtkWidget* cancelBtn = gtk_button_new_with_label(TR(TranslationKeys::CANCEL));
+    GtkWidget* saveBtn = gtk_button_new_with_label(TR(TranslationKeys::EQUALIZER_SAVE_PRESET));
+    gtk_widget_add_css_class(saveBtn, "suggested-action");
+    
+    gtk_box_append(GTK_BOX(buttonBox), cancelBtn);
+    gtk_box_append(GTK_BOX(buttonBox), saveBtn);
+    gtk_box_append(GTK_BOX(mainBox), buttonBox);
+    
+    gtk_window_set_child(GTK_WINDOW(dialog), mainBox);
+    
+    g_object_set_data(G_OBJECT(saveBtn), "entry", entry);
+    g_object_set_data(G_OBJECT(saveBtn), "dialog", dialog);
+    g_signal_connect_swapped(cancelBtn, "clicked", G_CALLBACK(gtk_window_destroy), dialog);
+    g_signal_connect(saveBtn, "clicked", G_CALLBACK(onEqualizerSaveAsConfirmed), manager);
+    g_signal_connect_swapped(entry, "activate", G_CALLBACK(gtk_widget_activate), saveBtn);
+    
+    gtk_window_present(GTK_WINDOW(dialog));
+    gtk_widget_grab_focus(entry);
+}
+
+void SoundManager::onEqualizerSaveAsConfirmed(GtkButton* button, gpointer user_data) {
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    GtkWidget* entry = static_cast<GtkWidget*>(g_object_get_data(G_OBJECT(button), "entry"));
+    GtkWidget* dialog = static_cast<GtkWidget*>(g_object_get_data(G_OBJECT(button), "dialog"));
+    if (!manager || !entry || !dialog) return;
+    
+    std::string name = gtk_editable_get_text(GTK_EDITABLE(entry));
+    name.erase(0, name.find_first_not_of(" \t"));
+    name.erase(name.find_last_not_of(" \t") + 1);
+    // The preset file is line based, with the name in a [section] header
+    if (name.empty() || name.find_first_of("[]\n") != std::string::npos) {
+        gtk_widget_grab_focus(entry);
+        return;
+    }
+    
+    manager->saveEqualizerPreset(name);
+    gtk_window_destroy(GTK_WINDOW(dialog));
+}
+
+void SoundManager::saveEqualizerPreset(const std::string& name) {
+    EqualizerPreset preset = currentEqualizerPreset;
+    preset.name = name;
+    if (!equalizerPresetStore.saveUserPreset(preset)) return;
+    equalizerPresetStore.saveActivePresetName(preset.name);
+    currentEqualizerPreset.name = preset.name;
+    
+    auto it = std::find_if(equalizerPresets.begin(), equalizerPresets.end(),
+                           [&](const EqualizerPreset& p) { return p.name == preset.name; });
+    if (it != equalizerPresets.end()) {
+        *it = preset;
+    } else {
+        equalizerPresets.push_back(preset);
+        gtk_combo_box_text_append(GTK_COMBO_BOX_TEXT(equalizerPresetCombo),
+                                  preset.name.c_str(), preset.name.c_str());
+    }
+    
+    g_signal_handlers_block_by_func(equalizerPresetCombo, (gpointer)onEqualizerPresetChanged, this);
+    gtk_combo_box_set_active_id(GTK_COMBO_BOX(equalizerPresetCombo), preset.name.c_str());
+    g_signal_handlers_unblock_by_func(equalizerPresetCombo, (gpointer)onEqualizerPresetChanged, this);
+    
+    std::cout << "Saved equalizer preset: " << preset.name << std::endl;
+}
+
+void SoundManager::drawEqualizerCurve(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data) {
+    (void)area;
+    SoundManager* manager = static_cast<SoundManager*>(user_data);
+    if (!manager || width <= 0 || height <= 0) return;
+    
+    const double rangeDb = 15.0;
+    const double midY = height / 2.0;
+    
+    // 0 dB reference line
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.35);
+    cairo_set_line_width(cr, 1.0);
+    cairo_move_to(cr, 0, midY);
+    cairo_line_to(cr, width, midY);
+    cairo_stroke(cr);
+    
+    // Log-frequency sweep from 20 Hz to 20 kHz
+    cairo_set_source_rgba(cr, 0.90, 0.65, 0.78, 1.0);
+    cairo_set_line_width(cr, 2.0);
+    for (int x = 0; x < width; ++x) {
+        double freq = 20.0 * std::pow(1000.0, static_cast<double>(x) / (width - 1));
+        double db = std::clamp(manager->equalizerPreview.magnitudeDb(freq), -rangeDb, rangeDb);
+        double y = midY - (db / rangeDb) * (midY - 4.0);
+        if (x == 0) cairo_move_to(cr, x, y);
+        else cairo_line_to(cr, x, y);
+    }
+    cairo_stroke(cr);
+}
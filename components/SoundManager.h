@@ -4,6 +4,9 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <memory>
+#include "EqualizerEngine.h"
+#include "EqualizerSink.h"
 
 // Forward declaration
 class MainWindow;
@@ -61,6 +64,13 @@ private:
     GtkWidget* playbackScrolledWindow;
     GtkWidget* playbackBox;
     
+    GtkWidget* equalizerLabel;
+    GtkWidget* equalizerSwitch;
+    GtkWidget* equalizerPresetCombo;
+    GtkWidget* equalizerSaveButton;
+    GtkWidget* equalizerSaveAsButton;
+    GtkWidget* equalizerCurve;
+    std::vector<GtkWidget*> equalizerBandScales;
     
     // Data
     std::vector<AudioDevice> outputDevices;
@@ -68,6 +78,13 @@ private:
     std::vector<PlaybackClient> playbackClients;
     std::map<uint32_t, GtkWidget*> clientWidgets;
     
+    // Equalizer
+    std::unique_ptr<EqualizerSink> equalizerSink;
+    EqualizerPresetStore equalizerPresetStore;
+    std::vector<EqualizerPreset> equalizerPresets;
+    EqualizerPreset currentEqualizerPreset;
+    EqualizerEngine equalizerPreview; // coefficients only, for drawing the curve
+    
     // Timers for debouncing
     guint outputVolumeTimer;
     guint inputVolumeTimer;
@@ -87,6 +104,11 @@ private:
     void setOutputVolume(int volume);
     void setInputVolume(int volume);
     void setPlaybackClientVolume(uint32_t index, int volume);
+    void initEqualizerUI();
+    void loadEqualizerPresets();
+    void applyEqualizerPreset(const EqualizerPreset& preset);
+    void saveEqualizerPreset(const std::string& name);
+    std::string getOutputSink();
     std::string getAssetPath(const std::string& filename);
     std::string simplifyDeviceDescription(const std::string& description);
     std::string executeCommand(const std::string& command);
@@ -105,6 +127,13 @@ private:
     static gboolean onOutputVolumeDebounce(gpointer user_data);
     static gboolean onInputVolumeDebounce(gpointer user_data);
     static void onClientVolumeLabelUpdate(GtkRange* range, gpointer user_data);
+    static gboolean onEqualizerSwitchStateSet(GtkSwitch* sw, gboolean state, gpointer user_data);
+    static void onEqualizerPresetChanged(GtkComboBox* combo, gpointer user_data);
+    static void onEqualizerBandChanged(GtkRange* range, gpointer user_data);
+    static void onEqualizerSaveClicked(GtkButton* button, gpointer user_data);
+    static void onEqualizerSaveAsClicked(GtkButton* button, gpointer user_data);
+    static void onEqualizerSaveAsConfirmed(GtkButton* button, gpointer user_data);
+    static void drawEqualizerCurve(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data);
 };
 
 struct SoundBackButtonCallbackData {
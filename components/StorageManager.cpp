@@ -1,14 +1,14 @@
 #include "StorageManager.h"
 #include "../MainWindow.h"
 #include "../translations/translations.h"
+#include "ThroughputMonitor.h"
 #include <iostream>
 #include <glib.h>
+#include <glib-unix.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
 #include <unistd.h>
-#include <fstream>
-#include <sstream>
-#include <sys/wait.h>
 #include <memory>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <cstdio>
@@ -22,13 +22,31 @@ struct StorageBackButtonCallbackData {
 
 StorageManager::StorageManager(MainWindow* mainWindow, GtkWidget* parentWindow, GtkWidget* overlay) 
     : mainWindow(mainWindow), parentWindow(parentWindow), overlay(overlay), 
-      storageContainer(nullptr), backButton(nullptr), drivesContainer(nullptr) {
+      storageContainer(nullptr), backButton(nullptr), drivesContainer(nullptr), drivesScroller(nullptr),
+      mountWatchId(0), usageTimer(0), usageInterval(USAGE_INTERVAL_MIN),
+      usagePanel(nullptr), usagePathLabel(nullptr), usageStatusLabel(nullptr), usageUpButton(nullptr),
+      usageStopButton(nullptr), usageSortDropDown(nullptr), usageViewButton(nullptr), usageList(nullptr),
+      usageScanWatchId(0), treemapArea(nullptr), treemapScale(0.0),
+      treemapOffsetX(0.0), treemapOffsetY(0.0), treemapZoomStart(0), treemapTickId(0), nextTreemapRefresh(0) {
     setupUI();
 }
 
 StorageManager::~StorageManager() {
+    if (mountWatchId > 0) {
+        g_source_remove(mountWatchId);
+        mountWatchId = 0;
+    }
+    if (usageTimer > 0) {
+        g_source_remove(usageTimer);
+        usageTimer = 0;
+    }
+    if (usageScanWatchId > 0) {
+        g_source_remove(usageScanWatchId);
+        usageScanWatchId = 0;
+    }
+    
     // Clear widget tracking
-    driveWidgets.clear();
+    driveRows.clear();
     
     // All GTK widgets are managed by GTK and will be cleaned up automatically
 }
@@ -40,13 +58,37 @@ void StorageManager::show() {
         if (mainWindow) {
             mainWindow->switchToBackground("background4.png");
         }
+        
+        // Mounts and unmounts show up as they happen while the page is open
+        if (mountWatchId == 0 && mountTable.watch()) {
+            mountWatchId = g_unix_fd_add(mountTable.eventFd(), static_cast<GIOCondition>(G_IO_PRI | G_IO_ERR),
+                                         onMountsChanged, this);
+        }
+        
+        // Frames kept from the last visit only need fresh numbers
+        refreshUsage();
         updateDisks();
+        
+        usageInterval = USAGE_INTERVAL_MIN;
+        scheduleUsageRefresh();
     }
 }
 
 void StorageManager::hide() {
     if (storageContainer) {
         gtk_widget_set_visible(storageContainer, FALSE);
+        
+        // Nothing is watched or measured while the page is closed
+        if (mountWatchId > 0) {
+            g_source_remove(mountWatchId);
+            mountWatchId = 0;
+        }
+        mountTable.unwatch();
+        if (usageTimer > 0) {
+            g_source_remove(usageTimer);
+            usageTimer = 0;
+        }
+        closeUsage();
     }
 }
 
@@ -105,9 +147,12 @@ void StorageManager::initUI() {
             
             gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(scrolledWindow), drivesContainer);
             gtk_fixed_put(GTK_FIXED(storageContainer), scrolledWindow, 490, 230);
+            drivesScroller = scrolledWindow;
         }
     }
     
+    setupUsagePanel();
+    
     // CSS for storage page with ElysiaOS aesthetic
     GtkCssProvider* provider = gtk_css_provider_new();
     if (provider) {
@@ -197,6 +242,15 @@ void StorageManager::initUI() {
             "} "
             "scrollbar slider:hover { "
             "  background: linear-gradient(62deg, #fd84cb 20%, #fed0f4 70%); "
+            "} "
+            ".usage-row { "
+            "  background: linear-gradient(145deg, rgba(255, 255, 255, 0.2), rgba(255, 255, 255, 0.1)); "
+            "  border: 1px solid rgba(192, 192, 192, 0.6); "
+            "  border-radius: 10px; "
+            "  padding: 4px 10px; "
+            "} "
+            ".usage-row:hover { "
+            "  background: linear-gradient(62deg, rgba(253, 132, 203, 0.35) 20%, rgba(254, 208, 244, 0.35) 70%); "
             "} ";
 
         gtk_css_provider_load_from_string(provider, css);
@@ -301,196 +355,724 @@ void StorageManager::setupBackButton() {
 }
 
 void StorageManager::updateDisks() {
-    // Clear previous widgets
-    for (GtkWidget* widget : driveWidgets) {
-        gtk_box_remove(GTK_BOX(drivesContainer), widget);
+    if (!drivesContainer) return;
+    
+    // Local disk filesystems from the kernel's mount table, no df involved
+    std::vector<MountEntry> mounts;
+    if (!mountTable.read(mounts)) {
+        std::cerr << "ERROR: Could not read " << MountTable::mountInfoPath() << std::endl;
+        return;
     }
-    driveWidgets.clear();
     
-    // Get disk info
-    std::vector<DriveInfo> drives = getDiskInfo();
+    // A mount id can be reused after an unmount, so the path must match too
+    auto sameMount = [](const DriveRow& row, const MountEntry& mount) {
+        return row.mountId == mount.mountId && row.info.mountpoint == mount.mountpoint &&
+               row.info.device == mount.device;
+    };
     
-    for (const DriveInfo& drive : drives) {
-        // Create frame for each drive
-        GtkWidget* driveFrame = gtk_frame_new(nullptr);
-        gtk_widget_add_css_class(driveFrame, "drive-frame");
-        gtk_widget_set_size_request(driveFrame, 580, 65);
-        
-        GtkWidget* driveBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
-        gtk_widget_set_margin_start(driveBox, 12);
-        gtk_widget_set_margin_end(driveBox, 12);
-        gtk_widget_set_margin_top(driveBox, 10);
-        gtk_widget_set_margin_bottom(driveBox, 10);
-        
-        // Icon
-        std::string iconPath = getAssetPath("drive.png");
-        GtkWidget* iconImage = gtk_picture_new_for_filename(iconPath.c_str());
-        if (!iconImage) {
-            iconImage = gtk_label_new("HD");
-            gtk_widget_add_css_class(iconImage, "drive-label");
+    // Drop the frames of drives that went away
+    for (auto it = driveRows.begin(); it != driveRows.end();) {
+        bool mounted = std::any_of(mounts.begin(), mounts.end(),
+                                   [&](const MountEntry& mount) { return sameMount(*it, mount); });
+        if (mounted) {
+            ++it;
         } else {
-            gtk_widget_set_size_request(iconImage, 35, 35);
-            gtk_picture_set_can_shrink(GTK_PICTURE(iconImage), TRUE);
-            gtk_picture_set_content_fit(GTK_PICTURE(iconImage), GTK_CONTENT_FIT_CONTAIN);
+            gtk_box_remove(GTK_BOX(drivesContainer), it->frame);
+            it = driveRows.erase(it);
         }
-        
-        // Info container
-        GtkWidget* infoBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
-        
-        // Drive label
-        std::string driveText = drive.device + " (" + drive.mountpoint + ")";
-        GtkWidget* driveLabel = gtk_label_new(driveText.c_str());
-        gtk_widget_add_css_class(driveLabel, "drive-label");
-        gtk_label_set_xalign(GTK_LABEL(driveLabel), 0.0);
-        
-        // Size label
-        std::string sizeText = bytesToGB(drive.used) + " / " + bytesToGB(drive.total);
-        GtkWidget* sizeLabel = gtk_label_new(sizeText.c_str());
-        gtk_widget_add_css_class(sizeLabel, "size-label");
-        gtk_label_set_xalign(GTK_LABEL(sizeLabel), 0.0);
-        
-        // Progress bar
-        GtkWidget* progressBar = gtk_progress_bar_new();
-        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progressBar), drive.percent / 100.0);
-        gtk_widget_add_css_class(progressBar, "progress-bar");
-        gtk_widget_set_size_request(progressBar, 320, 16);
-        
-        std::string freeText = bytesToGB(drive.free) + " free";
-        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progressBar), freeText.c_str());
-        gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(progressBar), TRUE);
-        
-        // Pack widgets
-        gtk_box_append(GTK_BOX(infoBox), driveLabel);
-        gtk_box_append(GTK_BOX(infoBox), sizeLabel);
-        gtk_box_append(GTK_BOX(infoBox), progressBar);
-        
-        gtk_box_append(GTK_BOX(driveBox), iconImage);
-        gtk_box_append(GTK_BOX(driveBox), infoBox);
-        
-        gtk_frame_set_child(GTK_FRAME(driveFrame), driveBox);
-        
-        gtk_box_append(GTK_BOX(drivesContainer), driveFrame);
-        driveWidgets.push_back(driveFrame);
     }
+    
+    // Only new drives are measured here; the others keep their numbers
+    std::vector<MountEntry> added;
+    for (const MountEntry& mount : mounts) {
+        bool known = std::any_of(driveRows.begin(), driveRows.end(),
+                                 [&](const DriveRow& row) { return sameMount(row, mount); });
+        if (!known) added.push_back(mount);
+    }
+    if (added.empty()) return;
+    mountTable.measure(added);
+    
+    // Merge in mountinfo order, slotting each new frame in after its predecessor
+    std::vector<DriveRow> rows;
+    rows.reserve(mounts.size());
+    size_t fresh = 0;
+    for (const MountEntry& mount : mounts) {
+        auto known = std::find_if(driveRows.begin(), driveRows.end(),
+                                  [&](const DriveRow& row) { return sameMount(row, mount); });
+        if (known != driveRows.end()) {
+            rows.push_back(*known);
+        } else {
+            DriveRow row;
+            row.mountId = mount.mountId;
+            createDriveFrame(row, toDriveInfo(added[fresh++]), rows.empty() ? nullptr : rows.back().frame);
+            rows.push_back(row);
+        }
+    }
+    driveRows.swap(rows);
 }
 
-std::vector<DriveInfo> StorageManager::getDiskInfo() {
-    std::vector<DriveInfo> drives;
+void StorageManager::createDriveFrame(DriveRow& row, const DriveInfo& drive, GtkWidget* previousFrame) {
+    // Create frame for the drive
+    GtkWidget* driveFrame = gtk_frame_new(nullptr);
+    gtk_widget_add_css_class(driveFrame, "drive-frame");
+    gtk_widget_set_size_request(driveFrame, 580, 65);
     
-    // Using popen to execute df command
-    std::string command = "df -T -B1";
-    FILE* pipe = popen(command.c_str(), "r");
+    GtkWidget* driveBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 12);
+    gtk_widget_set_margin_start(driveBox, 12);
+    gtk_widget_set_margin_end(driveBox, 12);
+    gtk_widget_set_margin_top(driveBox, 10);
+    gtk_widget_set_margin_bottom(driveBox, 10);
     
-    if (!pipe) {
-        std::cerr << "ERROR: Could not execute df command" << std::endl;
-        return drives;
+    // Icon
+    std::string iconPath = getAssetPath("drive.png");
+    GtkWidget* iconImage = gtk_picture_new_for_filename(iconPath.c_str());
+    if (!iconImage) {
+        iconImage = gtk_label_new("HD");
+        gtk_widget_add_css_class(iconImage, "drive-label");
+    } else {
+        gtk_widget_set_size_request(iconImage, 35, 35);
+        gtk_picture_set_can_shrink(GTK_PICTURE(iconImage), TRUE);
+        gtk_picture_set_content_fit(GTK_PICTURE(iconImage), GTK_CONTENT_FIT_CONTAIN);
     }
     
-    char buffer[1024];
-    std::vector<std::string> lines;
+    // Info container
+    GtkWidget* infoBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
     
-    while (fgets(buffer, sizeof buffer, pipe) != nullptr) {
-        std::string line(buffer);
-        // Remove trailing newline and carriage return
-        while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
-            line.pop_back();
-        }
-        lines.push_back(line);
+    // Drive label
+    std::string driveText = drive.device + " (" + drive.mountpoint + ")";
+    GtkWidget* driveLabel = gtk_label_new(driveText.c_str());
+    gtk_widget_add_css_class(driveLabel, "drive-label");
+    gtk_label_set_xalign(GTK_LABEL(driveLabel), 0.0);
+    
+    // Size label
+    row.sizeLabel = gtk_label_new("");
+    gtk_widget_add_css_class(row.sizeLabel, "size-label");
+    gtk_label_set_xalign(GTK_LABEL(row.sizeLabel), 0.0);
+    
+    // Progress bar
+    row.progressBar = gtk_progress_bar_new();
+    gtk_widget_add_css_class(row.progressBar, "progress-bar");
+    gtk_widget_set_size_request(row.progressBar, 320, 16);
+    gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(row.progressBar), TRUE);
+    
+    // Pack widgets
+    gtk_box_append(GTK_BOX(infoBox), driveLabel);
+    gtk_box_append(GTK_BOX(infoBox), row.sizeLabel);
+    gtk_box_append(GTK_BOX(infoBox), row.progressBar);
+    
+    // Opens the breakdown of this drive
+    GtkWidget* analyzeButton = gtk_button_new_with_label(TR(TranslationKeys::USAGE_ANALYZE));
+    gtk_widget_add_css_class(analyzeButton, "size-label");
+    gtk_widget_set_hexpand(analyzeButton, TRUE);
+    gtk_widget_set_halign(analyzeButton, GTK_ALIGN_END);
+    gtk_widget_set_valign(analyzeButton, GTK_ALIGN_CENTER);
+    g_object_set_data_full(G_OBJECT(analyzeButton), "mountpoint", g_strdup(drive.mountpoint.c_str()), g_free);
+    g_signal_connect(analyzeButton, "clicked", G_CALLBACK(onAnalyzeClicked), this);
+    
+    gtk_box_append(GTK_BOX(driveBox), iconImage);
+    gtk_box_append(GTK_BOX(driveBox), infoBox);
+    gtk_box_append(GTK_BOX(driveBox), analyzeButton);
+    
+    gtk_frame_set_child(GTK_FRAME(driveFrame), driveBox);
+    
+    gtk_box_insert_child_after(GTK_BOX(drivesContainer), driveFrame, previousFrame);
+    row.frame = driveFrame;
+    
+    // Fill the numbers through the same path later refreshes take
+    updateDriveRow(row, drive, true);
+}
+
+void StorageManager::updateDriveRow(DriveRow& row, const DriveInfo& info, bool force) {
+    bool sizeChanged = force || info.measured != row.info.measured || info.used != row.info.used ||
+                       info.total != row.info.total;
+    bool freeChanged = force || info.measured != row.info.measured || info.free != row.info.free;
+    row.info = info;
+    
+    if (sizeChanged) {
+        std::string sizeText = info.measured
+            ? bytesToGB(info.used) + " / " + bytesToGB(info.total)
+            : std::string(TR(TranslationKeys::DRIVE_NOT_RESPONDING));
+        gtk_label_set_text(GTK_LABEL(row.sizeLabel), sizeText.c_str());
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(row.progressBar), info.percent / 100.0);
     }
+    if (freeChanged) {
+        std::string freeText = info.measured ? bytesToGB(info.free) + " free" : "";
+        gtk_progress_bar_set_text(GTK_PROGRESS_BAR(row.progressBar), freeText.c_str());
+    }
+}
+
+bool StorageManager::refreshUsage() {
+    if (driveRows.empty()) return false;
     
-    pclose(pipe);
+    std::vector<MountEntry> mounts(driveRows.size());
+    for (size_t i = 0; i < driveRows.size(); ++i) {
+        mounts[i].mountId = driveRows[i].mountId;
+        mounts[i].device = driveRows[i].info.device;
+        mounts[i].mountpoint = driveRows[i].info.mountpoint;
+        mounts[i].fstype = driveRows[i].info.fstype;
+    }
+    mountTable.measure(mounts);
     
-    if (lines.size() < 2) return drives;
+    bool changed = false;
+    for (size_t i = 0; i < driveRows.size(); ++i) {
+        DriveInfo info = toDriveInfo(mounts[i]);
+        const DriveInfo& shown = driveRows[i].info;
+        changed |= info.measured != shown.measured || info.used != shown.used || info.total != shown.total;
+        updateDriveRow(driveRows[i], info);
+    }
+    return changed;
+}
+
+void StorageManager::scheduleUsageRefresh() {
+    if (usageTimer > 0) {
+        g_source_remove(usageTimer);
+    }
+    usageTimer = g_timeout_add_seconds(usageInterval, onUsageTimer, this);
+}
+
+gboolean StorageManager::onUsageTimer(gpointer user_data) {
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager) return G_SOURCE_REMOVE;
     
-    // Valid filesystem types
-    std::vector<std::string> validTypes = {"ext4", "btrfs", "xfs", "vfat", "ntfs", "fuseblk", "exfat"};
+    // Back off while the disks sit still; any change brings the pace back
+    manager->usageTimer = 0;
+    if (manager->refreshUsage()) {
+        manager->usageInterval = USAGE_INTERVAL_MIN;
+    } else {
+        manager->usageInterval = std::min(manager->usageInterval * 2, USAGE_INTERVAL_MAX);
+    }
+    manager->scheduleUsageRefresh();
+    return G_SOURCE_REMOVE;
+}
+
+gboolean StorageManager::onMountsChanged(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd; (void)condition;
     
-    // Skip header line and process each line
-    for (size_t i = 1; i < lines.size(); ++i) {
-        std::string line = lines[i];
-        if (line.empty()) continue;
-        
-        // Parse the line using strtok
-        char* lineCopy = strdup(line.c_str());
-        char* token = strtok(lineCopy, " \t");
-        
-        if (!token) {
-            free(lineCopy);
-            continue;
-        }
-        
-        DriveInfo drive;
-        drive.device = std::string(token);
-        
-        token = strtok(nullptr, " \t");
-        if (!token) {
-            free(lineCopy);
-            continue;
-        }
-        
-        drive.fstype = std::string(token);
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager) return G_SOURCE_REMOVE;
+    
+    // The poll that woke us already cleared the flag; reading the table is enough
+    manager->updateDisks();
+    return G_SOURCE_CONTINUE;
+}
+
+void StorageManager::setupUsagePanel() {
+    if (!storageContainer) return;
+    
+    usagePanel = gtk_box_new(GTK_ORIENTATION_VERTICAL, 6);
+    gtk_widget_set_size_request(usagePanel, 620, 520);
+    gtk_widget_set_margin_start(usagePanel, 12);
+    gtk_widget_set_margin_end(usagePanel, 12);
+    gtk_widget_set_margin_top(usagePanel, 12);
+    gtk_widget_set_visible(usagePanel, FALSE);
+    gtk_fixed_put(GTK_FIXED(storageContainer), usagePanel, 490, 230);
+    
+    // Back to the drives, up one level, where we are, sort order, stop/rescan
+    GtkWidget* header = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 8);
+    
+    GtkWidget* closeButton = gtk_button_new_with_label(TR(TranslationKeys::USAGE_DRIVES));
+    g_signal_connect(closeButton, "clicked", G_CALLBACK(onUsageCloseClicked), this);
+    
+    usageUpButton = gtk_button_new_with_label(TR(TranslationKeys::USAGE_UP));
+    g_signal_connect(usageUpButton, "clicked", G_CALLBACK(onUsageUpClicked), this);
+    
+    usagePathLabel = gtk_label_new("");
+    gtk_widget_add_css_class(usagePathLabel, "drive-label");
+    gtk_label_set_xalign(GTK_LABEL(usagePathLabel), 0.0);
+    gtk_label_set_ellipsize(GTK_LABEL(usagePathLabel), PANGO_ELLIPSIZE_START);
+    gtk_widget_set_hexpand(usagePathLabel, TRUE);
+    
+    const char* sortOrders[] = {
+        TR(TranslationKeys::SORT_BY_SIZE),
+        TR(TranslationKeys::SORT_BY_NAME),
+        TR(TranslationKeys::SORT_BY_ITEMS),
+        nullptr
+    };
+    usageSortDropDown = gtk_drop_down_new_from_strings(sortOrders);
+    gtk_widget_set_size_request(usageSortDropDown, 90, 36);
+    g_signal_connect(usageSortDropDown, "notify::selected", G_CALLBACK(onUsageSortChanged), this);
+    
+    usageViewButton = gtk_button_new_with_label(TR(TranslationKeys::USAGE_TREEMAP));
+    g_signal_connect(usageViewButton, "clicked", G_CALLBACK(onUsageViewClicked), this);
+    
+    usageStopButton = gtk_button_new_with_label(TR(TranslationKeys::USAGE_STOP));
+    g_signal_connect(usageStopButton, "clicked", G_CALLBACK(onUsageStopClicked), this);
+    
+    gtk_box_append(GTK_BOX(header), closeButton);
+    gtk_box_append(GTK_BOX(header), usageUpButton);
+    gtk_box_append(GTK_BOX(header), usagePathLabel);
+    gtk_box_append(GTK_BOX(header), usageSortDropDown);
+    gtk_box_append(GTK_BOX(header), usageViewButton);
+    gtk_box_append(GTK_BOX(header), usageStopButton);
+    gtk_box_append(GTK_BOX(usagePanel), header);
+    
+    usageStatusLabel = gtk_label_new("");
+    gtk_widget_add_css_class(usageStatusLabel, "size-label");
+    gtk_label_set_xalign(GTK_LABEL(usageStatusLabel), 0.0);
+    gtk_box_append(GTK_BOX(usagePanel), usageStatusLabel);
+    
+    // A fixed pool of rows, refilled in place as results stream in
+    usageList = gtk_box_new(GTK_ORIENTATION_VERTICAL, 6);
+    gtk_box_append(GTK_BOX(usagePanel), usageList);
+    usageSlots.resize(USAGE_ROWS);
+    for (int i = 0; i < USAGE_ROWS; ++i) {
+        UsageSlot& slot = usageSlots[i];
         
-        // Check if filesystem type is valid
-        bool validType = false;
-        for (const std::string& type : validTypes) {
-            if (drive.fstype == type) {
-                validType = true;
-                break;
-            }
-        }
+        GtkWidget* rowBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 10);
+        slot.nameLabel = gtk_label_new("");
+        gtk_widget_add_css_class(slot.nameLabel, "drive-label");
+        gtk_label_set_xalign(GTK_LABEL(slot.nameLabel), 0.0);
+        gtk_label_set_ellipsize(GTK_LABEL(slot.nameLabel), PANGO_ELLIPSIZE_MIDDLE);
+        gtk_widget_set_size_request(slot.nameLabel, 240, -1);
         
-        if (!validType) {
-            free(lineCopy);
-            continue;
-        }
+        slot.bar = gtk_progress_bar_new();
+        gtk_widget_add_css_class(slot.bar, "progress-bar");
+        gtk_widget_set_size_request(slot.bar, 180, 12);
+        gtk_widget_set_valign(slot.bar, GTK_ALIGN_CENTER);
         
-        token = strtok(nullptr, " \t");
-        if (!token) {
-            free(lineCopy);
-            continue;
-        }
-        drive.total = std::stoll(std::string(token));
+        slot.sizeLabel = gtk_label_new("");
+        gtk_widget_add_css_class(slot.sizeLabel, "size-label");
+        gtk_label_set_xalign(GTK_LABEL(slot.sizeLabel), 1.0);
+        gtk_widget_set_hexpand(slot.sizeLabel, TRUE);
         
-        token = strtok(nullptr, " \t");
-        if (!token) {
-            free(lineCopy);
-            continue;
-        }
-        drive.used = std::stoll(std::string(token));
+        gtk_box_append(GTK_BOX(rowBox), slot.nameLabel);
+        gtk_box_append(GTK_BOX(rowBox), slot.bar);
+        gtk_box_append(GTK_BOX(rowBox), slot.sizeLabel);
         
-        token = strtok(nullptr, " \t");
-        if (!token) {
-            free(lineCopy);
-            continue;
+        slot.button = gtk_button_new();
+        gtk_widget_add_css_class(slot.button, "usage-row");
+        gtk_button_set_child(GTK_BUTTON(slot.button), rowBox);
+        g_object_set_data(G_OBJECT(slot.button), "slot", GINT_TO_POINTER(i));
+        g_signal_connect(slot.button, "clicked", G_CALLBACK(onUsageRowClicked), this);
+        gtk_widget_set_visible(slot.button, FALSE);
+        gtk_box_append(GTK_BOX(usageList), slot.button);
+    }
+    
+    // The treemap is one drawing area; rectangles are never widgets
+    treemapArea = gtk_drawing_area_new();
+    gtk_widget_set_size_request(treemapArea, 596, 420);
+    gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(treemapArea), drawTreemap, this, nullptr);
+    gtk_widget_set_visible(treemapArea, FALSE);
+    treemap.setBounds(596.0, 420.0);
+    
+    // Primary button zooms into a directory, secondary back out
+    GtkGesture* treemapClick = gtk_gesture_click_new();
+    gtk_gesture_single_set_button(GTK_GESTURE_SINGLE(treemapClick), 0);
+    g_signal_connect(treemapClick, "pressed", G_CALLBACK(onTreemapPressed), this);
+    gtk_widget_add_controller(treemapArea, GTK_EVENT_CONTROLLER(treemapClick));
+    gtk_box_append(GTK_BOX(usagePanel), treemapArea);
+}
+
+void StorageManager::openUsage(const std::string& mountpoint) {
+    if (!usagePanel) return;
+    
+    if (drivesScroller) gtk_widget_set_visible(drivesScroller, FALSE);
+    gtk_widget_set_visible(usagePanel, TRUE);
+    
+    // A second look at the same drive reuses a scan that ran to the end
+    if (usageScanner.rootPath() != mountpoint || !usageScanner.progress().complete) {
+        usagePath.clear();
+        startUsageScan(mountpoint);
+    }
+    refreshUsageList();
+    refreshTreemap(true);
+}
+
+void StorageManager::closeUsage() {
+    stopUsageScan();
+    if (treemapTickId > 0) {
+        gtk_widget_remove_tick_callback(treemapArea, treemapTickId);
+        treemapTickId = 0;
+    }
+    if (usagePanel) gtk_widget_set_visible(usagePanel, FALSE);
+    if (drivesScroller) gtk_widget_set_visible(drivesScroller, TRUE);
+}
+
+void StorageManager::startUsageScan(const std::string& mountpoint) {
+    stopUsageScan();
+    treemap.clear();
+    treemapView = TreemapLayout::Rect();
+    nextTreemapRefresh = 0;
+    if (!usageScanner.start(mountpoint)) {
+        std::cerr << "ERROR: Could not scan " << mountpoint << std::endl;
+        return;
+    }
+    usageScanWatchId = g_unix_fd_add(usageScanner.eventFd(), G_IO_IN, onUsageScanEvent, this);
+    if (usageStopButton) {
+        gtk_button_set_label(GTK_BUTTON(usageStopButton), TR(TranslationKeys::USAGE_STOP));
+    }
+}
+
+void StorageManager::stopUsageScan() {
+    if (usageScanWatchId > 0) {
+        g_source_remove(usageScanWatchId);
+        usageScanWatchId = 0;
+    }
+    usageScanner.stop();
+    usageScanner.acknowledge();
+    if (usageStopButton) {
+        gtk_button_set_label(GTK_BUTTON(usageStopButton), TR(TranslationKeys::USAGE_RESCAN));
+    }
+}
+
+void StorageManager::refreshUsageList() {
+    if (!usagePanel || usageSlots.empty()) return;
+    
+    UsageEntry total;
+    std::vector<UsageEntry> entries;
+    if (!usageScanner.list(usagePath, total, entries)) {
+        // The directory was folded into its parent once it turned out small
+        usagePath.clear();
+        if (!usageScanner.list(usagePath, total, entries)) return;
+    }
+    
+    guint order = gtk_drop_down_get_selected(GTK_DROP_DOWN(usageSortDropDown));
+    std::sort(entries.begin(), entries.end(), [order](const UsageEntry& a, const UsageEntry& b) {
+        if (order == 1) return a.name < b.name;
+        if (order == 2 && a.items != b.items) return a.items > b.items;
+        if (a.bytes != b.bytes) return a.bytes > b.bytes;
+        return a.name < b.name;
+    });
+    
+    std::string path = usageScanner.rootPath();
+    for (const std::string& name : usagePath) {
+        path += (path.empty() || path.back() != '/') ? "/" + name : name;
+    }
+    gtk_label_set_text(GTK_LABEL(usagePathLabel), path.c_str());
+    gtk_widget_set_sensitive(usageUpButton, !usagePath.empty());
+    
+    // Status of the whole scan, not of the level shown
+    ScanProgress progress = usageScanner.progress();
+    const char* state = usageScanner.isRunning() ? TR(TranslationKeys::USAGE_SCANNING)
+                      : progress.complete ? TR(TranslationKeys::USAGE_COMPLETE)
+                      : TR(TranslationKeys::USAGE_STOPPED);
+    std::string status = std::string(state) + " - " + ThroughputMonitor::formatBytes(static_cast<double>(progress.bytes)) +
+                         ", " + std::to_string(progress.items) + " " + TR(TranslationKeys::USAGE_ITEMS);
+    if (progress.errors > 0) {
+        status += ", " + std::to_string(progress.errors) + " " + TR(TranslationKeys::USAGE_UNREADABLE);
+    }
+    gtk_label_set_text(GTK_LABEL(usageStatusLabel), status.c_str());
+    
+    for (size_t i = 0; i < usageSlots.size(); ++i) {
+        UsageSlot& slot = usageSlots[i];
+        bool show = i < entries.size();
+        if (show != slot.shown) {
+            gtk_widget_set_visible(slot.button, show);
+            slot.shown = show;
         }
-        drive.free = std::stoll(std::string(token));
+        if (!show) continue;
         
-        // Skip usage percentage
-        token = strtok(nullptr, " \t");
-        if (!token) {
-            free(lineCopy);
-            continue;
+        const UsageEntry& entry = entries[i];
+        if (entry.name != slot.name) {
+            slot.name = entry.name;
+            const char* text = entry.name == "." ? TR(TranslationKeys::USAGE_FILES_HERE) : entry.name.c_str();
+            gtk_label_set_text(GTK_LABEL(slot.nameLabel), text);
         }
-        
-        token = strtok(nullptr, " \t");
-        if (!token) {
-            free(lineCopy);
-            continue;
+        std::string size = ThroughputMonitor::formatBytes(static_cast<double>(entry.bytes));
+        if (size != slot.size) {
+            slot.size = size;
+            gtk_label_set_text(GTK_LABEL(slot.sizeLabel), size.c_str());
         }
-        drive.mountpoint = std::string(token);
-        
-        // Calculate percentage
-        if (drive.total > 0) {
-            drive.percent = (int)((drive.used * 100.0) / drive.total);
+        gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(slot.bar),
+                                      total.bytes > 0 ? static_cast<double>(entry.bytes) / total.bytes : 0.0);
+        slot.expandable = entry.expandable;
+    }
+}
+
+gboolean StorageManager::onUsageScanEvent(gint fd, GIOCondition condition, gpointer user_data) {
+    (void)fd; (void)condition;
+    
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager) return G_SOURCE_REMOVE;
+    
+    // Checked first: once the scan has ended, every count it made is visible
+    bool finished = !manager->usageScanner.isRunning();
+    manager->usageScanner.acknowledge();
+    manager->refreshUsageList();
+    manager->refreshTreemap(finished);
+    
+    if (finished) {
+        manager->usageScanWatchId = 0;
+        gtk_button_set_label(GTK_BUTTON(manager->usageStopButton), TR(TranslationKeys::USAGE_RESCAN));
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void StorageManager::onAnalyzeClicked(GtkButton* button, gpointer user_data) {
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    const char* mountpoint = static_cast<const char*>(g_object_get_data(G_OBJECT(button), "mountpoint"));
+    if (manager && mountpoint) {
+        manager->openUsage(mountpoint);
+    }
+}
+
+void StorageManager::onUsageRowClicked(GtkButton* button, gpointer user_data) {
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager) return;
+    
+    int index = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(button), "slot"));
+    if (index < 0 || index >= static_cast<int>(manager->usageSlots.size())) return;
+    
+    const UsageSlot& slot = manager->usageSlots[index];
+    if (slot.expandable && slot.name != ".") {
+        manager->usagePath.push_back(slot.name);
+        manager->refreshUsageList();
+        manager->zoomTreemap(true);
+    }
+}
+
+void StorageManager::onUsageUpClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (manager && !manager->usagePath.empty()) {
+        manager->usagePath.pop_back();
+        manager->refreshUsageList();
+        manager->zoomTreemap(true);
+    }
+}
+
+void StorageManager::onUsageCloseClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (manager) {
+        manager->closeUsage();
+    }
+}
+
+void StorageManager::onUsageStopClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager) return;
+    
+    if (manager->usageScanner.isRunning()) {
+        manager->stopUsageScan();
+    } else {
+        std::string mountpoint = manager->usageScanner.rootPath();
+        manager->usagePath.clear();
+        manager->startUsageScan(mountpoint);
+    }
+    manager->refreshUsageList();
+    manager->refreshTreemap(true);
+}
+
+void StorageManager::onUsageSortChanged(GObject*, GParamSpec*, gpointer user_data) {
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (manager) {
+        manager->refreshUsageList();
+    }
+}
+
+void StorageManager::onUsageViewClicked(GtkButton* button, gpointer user_data) {
+    (void)button;
+    
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager || !manager->treemapArea) return;
+    
+    bool treemapShown = !gtk_widget_get_visible(manager->treemapArea);
+    gtk_widget_set_visible(manager->treemapArea, treemapShown);
+    gtk_widget_set_visible(manager->usageList, !treemapShown);
+    gtk_button_set_label(GTK_BUTTON(manager->usageViewButton),
+                         TR(treemapShown ? TranslationKeys::USAGE_LIST : TranslationKeys::USAGE_TREEMAP));
+    if (treemapShown) {
+        manager->refreshTreemap(true);
+        manager->zoomTreemap(false);
+    }
+}
+
+void StorageManager::refreshTreemap(bool force) {
+    if (!treemapArea || !gtk_widget_get_visible(treemapArea)) return;
+    
+    // Copying and laying out grows with the tree while the scan publishes
+    // at a fixed pace; on big trees skip beats so drawing keeps its frames
+    gint64 now = g_get_monotonic_time();
+    if (!force && now < nextTreemapRefresh) return;
+    
+    usageScanner.snapshot(treemapSamples, treemap.namedFrom());
+    treemap.update(treemapSamples);
+    gint64 cost = g_get_monotonic_time() - now;
+    nextTreemapRefresh = now + std::max<gint64>(DiskUsageScanner::PUBLISH_INTERVAL_MS * 1000, cost * 4);
+    
+    // Rectangles move as sizes come in; keep the zoomed directory filling the view
+    int root = treemap.findPath(usagePath);
+    if (root < 0) root = 0;
+    if (!treemap.empty()) {
+        treemapTo = treemap.nodes()[root].rect;
+        if (treemapTickId == 0) treemapView = treemapTo;
+    }
+    gtk_widget_queue_draw(treemapArea);
+}
+
+void StorageManager::zoomTreemap(bool animate) {
+    if (!treemapArea || treemap.empty()) return;
+    
+    int root = treemap.findPath(usagePath);
+    if (root < 0) root = 0;
+    treemapTo = treemap.nodes()[root].rect;
+    
+    if (!animate || !gtk_widget_get_visible(treemapArea) || treemapView.w <= 0.0) {
+        treemapView = treemapTo;
+        gtk_widget_queue_draw(treemapArea);
+        return;
+    }
+    
+    // Zooming only moves the view; the layout stays as it is
+    treemapFrom = treemapView;
+    treemapZoomStart = g_get_monotonic_time();
+    if (treemapTickId == 0) {
+        treemapTickId = gtk_widget_add_tick_callback(treemapArea, onTreemapTick, this, nullptr);
+    }
+}
+
+gboolean StorageManager::onTreemapTick(GtkWidget* widget, GdkFrameClock* clock, gpointer user_data) {
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager) return G_SOURCE_REMOVE;
+    
+    double t = (gdk_frame_clock_get_frame_time(clock) - manager->treemapZoomStart) / (TREEMAP_ZOOM_MS * 1000.0);
+    t = std::min(std::max(t, 0.0), 1.0);
+    double ease = t * t * (3.0 - 2.0 * t);
+    
+    const TreemapLayout::Rect& from = manager->treemapFrom;
+    const TreemapLayout::Rect& to = manager->treemapTo;
+    manager->treemapView.x = from.x + (to.x - from.x) * ease;
+    manager->treemapView.y = from.y + (to.y - from.y) * ease;
+    manager->treemapView.w = from.w + (to.w - from.w) * ease;
+    manager->treemapView.h = from.h + (to.h - from.h) * ease;
+    gtk_widget_queue_draw(widget);
+    
+    if (t >= 1.0) {
+        manager->treemapTickId = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void StorageManager::onTreemapPressed(GtkGestureClick* gesture, int n_press, double x, double y, gpointer user_data) {
+    (void)n_press;
+    
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager || manager->treemap.empty()) return;
+    
+    if (gtk_gesture_single_get_current_button(GTK_GESTURE_SINGLE(gesture)) == GDK_BUTTON_SECONDARY) {
+        onUsageUpClicked(nullptr, manager);
+        return;
+    }
+    
+    // Back from widget to layout coordinates the way the last frame was drawn
+    const TreemapLayout::Rect& view = manager->treemapView;
+    if (manager->treemapScale <= 0.0) return;
+    double layoutX = view.x + (x - manager->treemapOffsetX) / manager->treemapScale;
+    double layoutY = view.y + (y - manager->treemapOffsetY) / manager->treemapScale;
+    
+    int root = manager->treemap.findPath(manager->usagePath);
+    int child = manager->treemap.childAt(root < 0 ? 0 : root, layoutX, layoutY);
+    if (child < 0) return;
+    
+    const TreemapLayout::Node& node = manager->treemap.nodes()[child];
+    if (node.files || node.childCount == 0 || node.name.empty()) return;
+    manager->usagePath.push_back(node.name);
+    manager->refreshUsageList();
+    manager->zoomTreemap(true);
+}
+
+void StorageManager::drawTreemap(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data) {
+    StorageManager* manager = static_cast<StorageManager*>(user_data);
+    if (!manager || manager->treemap.empty()) return;
+    const TreemapLayout::Rect& view = manager->treemapView;
+    if (view.w <= 0.0 || view.h <= 0.0 || width <= 0 || height <= 0) return;
+    
+    // The same scale on both axes keeps the squarified shapes of a zoomed
+    // directory; it is centred and the spare side left empty
+    manager->treemapScale = std::min(width / view.w, height / view.h);
+    manager->treemapOffsetX = (width - view.w * manager->treemapScale) / 2.0;
+    manager->treemapOffsetY = (height - view.h * manager->treemapScale) / 2.0;
+    cairo_rectangle(cr, manager->treemapOffsetX, manager->treemapOffsetY,
+                    view.w * manager->treemapScale, view.h * manager->treemapScale);
+    cairo_clip(cr);
+    
+    // One pass over the layout from the top; whatever is off screen or
+    // smaller than a pixel is skipped together with everything below it
+    PangoLayout* layout = gtk_widget_create_pango_layout(GTK_WIDGET(area), nullptr);
+    pango_layout_set_ellipsize(layout, PANGO_ELLIPSIZE_END);
+    cairo_set_line_width(cr, 1.0);
+    manager->drawTreemapNode(cr, layout, 0, -1);
+    g_object_unref(layout);
+}
+
+void StorageManager::drawTreemapNode(cairo_t* cr, PangoLayout* layout, int index, int band) const {
+    // Top-level directories each get a colour of the page's palette
+    static const double PALETTE[][3] = {
+        {0.898, 0.655, 0.776},  // #e5a7c6
+        {0.992, 0.518, 0.796},  // #fd84cb
+        {0.788, 0.627, 0.863},  // #c9a0dc
+        {0.929, 0.808, 0.890},  // #edcee3
+        {0.706, 0.557, 0.812},  // #b48ecf
+        {0.969, 0.698, 0.851}   // #f7b2d9
+    };
+    const int PALETTE_SIZE = sizeof(PALETTE) / sizeof(PALETTE[0]);
+    
+    const TreemapLayout::Node& node = treemap.nodes()[index];
+    double x = treemapOffsetX + (node.rect.x - treemapView.x) * treemapScale;
+    double y = treemapOffsetY + (node.rect.y - treemapView.y) * treemapScale;
+    double w = node.rect.w * treemapScale;
+    double h = node.rect.h * treemapScale;
+    
+    // The parent's fill already covers anything this small
+    if (x >= treemapOffsetX + treemapView.w * treemapScale || x + w <= treemapOffsetX ||
+        y >= treemapOffsetY + treemapView.h * treemapScale || y + h <= treemapOffsetY) return;
+    if (w < 1.0 || h < 1.0) return;
+    
+    if (index > 0) {
+        if (node.files) {
+            cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.25);
         } else {
-            drive.percent = 0;
+            const double* color = PALETTE[band % PALETTE_SIZE];
+            double light = std::min(0.6, 0.12 * (node.depth - 1));
+            cairo_set_source_rgba(cr, color[0] + (1.0 - color[0]) * light, color[1] + (1.0 - color[1]) * light,
+                                  color[2] + (1.0 - color[2]) * light, 0.85);
         }
+        cairo_rectangle(cr, x, y, w, h);
+        cairo_fill_preserve(cr);
+        cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.5);
+        cairo_stroke(cr);
         
-        drives.push_back(drive);
-        free(lineCopy);
+        // Names only where they fit; few rectangles are this large
+        if (w >= 60.0 && h >= 18.0) {
+            const char* name = node.files ? TR(TranslationKeys::USAGE_FILES_HERE) : node.name.c_str();
+            pango_layout_set_text(layout, name, -1);
+            pango_layout_set_width(layout, static_cast<int>((w - 6.0) * PANGO_SCALE));
+            cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.95);
+            cairo_move_to(cr, x + 3.0, y + 2.0);
+            pango_cairo_show_layout(cr, layout);
+        }
     }
     
-    return drives;
+    if (w < TREEMAP_MIN_PARENT_PX || h < TREEMAP_MIN_PARENT_PX) return;
+    for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+        drawTreemapNode(cr, layout, c, index == 0 ? c - node.firstChild : band);
+    }
+}
+
+DriveInfo StorageManager::toDriveInfo(const MountEntry& mount) {
+    DriveInfo drive;
+    drive.device = mount.device;
+    drive.mountpoint = mount.mountpoint;
+    drive.fstype = mount.fstype;
+    drive.total = static_cast<long long>(mount.total);
+    drive.used = static_cast<long long>(mount.used);
+    drive.free = static_cast<long long>(mount.free);
+    drive.measured = mount.measured;
+    
+    // Calculate percentage
+    if (drive.total > 0) {
+        drive.percent = (int)((drive.used * 100.0) / drive.total);
+    } else {
+        drive.percent = 0;
+    }
+    return drive;
 }
 
 std::string StorageManager::bytesToGB(long long bytes) {
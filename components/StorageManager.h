@@ -4,6 +4,8 @@
 #include <gtk/gtk.h>
 #include <vector>
 #include <string>
+#include "MountTable.h"
+#include "DiskUsageScanner.h"
 
 class MainWindow; // Forward declaration
 
@@ -15,16 +17,42 @@ struct DriveInfo {
     long long used;
     long long free;
     int percent;
+    bool measured;  // false if the filesystem did not answer statvfs in time
 };
 
 class StorageManager {
 public:
+    // Seconds between usage refreshes; the interval doubles while nothing changes
+    static constexpr guint USAGE_INTERVAL_MIN = 5;
+    static constexpr guint USAGE_INTERVAL_MAX = 60;
+    // Rows in the "What's using space" list
+    static constexpr int USAGE_ROWS = 10;
+    // Treemap: zoom animation length, and the smallest rectangle whose
+    // children are still drawn
+    static constexpr int TREEMAP_ZOOM_MS = 250;
+    static constexpr double TREEMAP_MIN_PARENT_PX = 4.0;
+    
     StorageManager(MainWindow* mainWindow, GtkWidget* parentWindow, GtkWidget* overlay);
     ~StorageManager();
     
     void show();
     void hide();
     void updateDisks();
+    
+    // Static callback functions
+    static gboolean onMountsChanged(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean onUsageTimer(gpointer user_data);
+    static gboolean onUsageScanEvent(gint fd, GIOCondition condition, gpointer user_data);
+    static void onAnalyzeClicked(GtkButton* button, gpointer user_data);
+    static void onUsageRowClicked(GtkButton* button, gpointer user_data);
+    static void onUsageUpClicked(GtkButton* button, gpointer user_data);
+    static void onUsageCloseClicked(GtkButton* button, gpointer user_data);
+    static void onUsageStopClicked(GtkButton* button, gpointer user_data);
+    static void onUsageSortChanged(GObject* dropDown, GParamSpec* pspec, gpointer user_data);
+    static void onUsageViewClicked(GtkButton* button, gpointer user_data);
+    static void onTreemapPressed(GtkGestureClick* gesture, int n_press, double x, double y, gpointer user_data);
+    static gboolean onTreemapTick(GtkWidget* widget, GdkFrameClock* clock, gpointer user_data);
+    static void drawTreemap(GtkDrawingArea* area, cairo_t* cr, int width, int height, gpointer user_data);
 
 private:
     MainWindow* mainWindow;
@@ -33,16 +61,82 @@ private:
     GtkWidget* storageContainer;
     GtkWidget* backButton;
     GtkWidget* drivesContainer;
-    std::vector<GtkWidget*> driveWidgets;
+    GtkWidget* drivesScroller;
+    MountTable mountTable;
+    guint mountWatchId;
+    guint usageTimer;
+    guint usageInterval;
+    
+    // A drive frame and the widgets refreshed in place; info caches what they show
+    struct DriveRow {
+        int mountId = 0;
+        GtkWidget* frame = nullptr;
+        GtkWidget* sizeLabel = nullptr;
+        GtkWidget* progressBar = nullptr;
+        DriveInfo info;
+    };
+    std::vector<DriveRow> driveRows;  // in mountinfo order, like the frames
+    
+    // "What's using space": one level of the scanned tree at a time
+    struct UsageSlot {
+        GtkWidget* button = nullptr;
+        GtkWidget* nameLabel = nullptr;
+        GtkWidget* sizeLabel = nullptr;
+        GtkWidget* bar = nullptr;
+        std::string name;   // directory name, or "." for the files beside them
+        std::string size;   // what sizeLabel shows
+        bool expandable = false;
+        bool shown = false;
+    };
+    GtkWidget* usagePanel;
+    GtkWidget* usagePathLabel;
+    GtkWidget* usageStatusLabel;
+    GtkWidget* usageUpButton;
+    GtkWidget* usageStopButton;
+    GtkWidget* usageSortDropDown;
+    GtkWidget* usageViewButton;
+    GtkWidget* usageList;   // holds the rows; swapped with treemapArea
+    std::vector<UsageSlot> usageSlots;
+    DiskUsageScanner usageScanner;
+    guint usageScanWatchId;
+    std::vector<std::string> usagePath;  // names below the scanned mountpoint
+    
+    // Treemap of the same scan; the view is the part of the layout on screen
+    GtkWidget* treemapArea;
+    TreemapLayout treemap;
+    std::vector<TreemapSample> treemapSamples;
+    TreemapLayout::Rect treemapView;
+    TreemapLayout::Rect treemapFrom;
+    TreemapLayout::Rect treemapTo;
+    // Layout to widget as last drawn: one scale for both axes, view centred
+    double treemapScale;
+    double treemapOffsetX;
+    double treemapOffsetY;
+    gint64 treemapZoomStart;
+    guint treemapTickId;
+    gint64 nextTreemapRefresh;
     
     void setupUI();
     void setupBackButton();
     void loadBackground();
     void initUI();
+    void createDriveFrame(DriveRow& row, const DriveInfo& drive, GtkWidget* previousFrame);
+    void updateDriveRow(DriveRow& row, const DriveInfo& info, bool force = false);
+    bool refreshUsage();
+    void scheduleUsageRefresh();
+    void setupUsagePanel();
+    void openUsage(const std::string& mountpoint);
+    void closeUsage();
+    void startUsageScan(const std::string& mountpoint);
+    void stopUsageScan();
+    void refreshUsageList();
+    void refreshTreemap(bool force);
+    void zoomTreemap(bool animate);
+    void drawTreemapNode(cairo_t* cr, PangoLayout* layout, int index, int band) const;
     
     // Utility functions
     std::string getAssetPath(const std::string& filename);
-    std::vector<DriveInfo> getDiskInfo();
+    static DriveInfo toDriveInfo(const MountEntry& mount);
     std::string bytesToGB(long long bytes);
 };
 
@@ -0,0 +1,131 @@
+#include "ThroughputMonitor.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+ThroughputMonitor::ThroughputMonitor()
+    : rxFd(-1), txFd(-1), ring(), head(0), count(0), primed(false),
+      lastRx(0), lastTx(0), lastTime(0.0), intervalMs(FAST_INTERVAL_MS) {
+}
+
+ThroughputMonitor::~ThroughputMonitor() {
+    close();
+}
+
+bool ThroughputMonitor::open(const std::string& name) {
+    close();
+    if (name.empty()) return false;
+
+    std::string base = "/sys/class/net/" + name + "/statistics/";
+    rxFd = ::open((base + "rx_bytes").c_str(), O_RDONLY | O_CLOEXEC);
+    txFd = ::open((base + "tx_bytes").c_str(), O_RDONLY | O_CLOEXEC);
+    if (!isOpen()) {
+        close();
+        return false;
+    }
+
+    iface = name;
+    return true;
+}
+
+void ThroughputMonitor::close() {
+    if (rxFd >= 0) ::close(rxFd);
+    if (txFd >= 0) ::close(txFd);
+    rxFd = -1;
+    txFd = -1;
+
+    iface.clear();
+    head = 0;
+    count = 0;
+    primed = false;
+    lastRx = 0;
+    lastTx = 0;
+    lastTime = 0.0;
+    intervalMs = FAST_INTERVAL_MS;
+}
+
+bool ThroughputMonitor::readCounter(int fd, uint64_t& value) {
+    char buffer[32];
+    ssize_t n = pread(fd, buffer, sizeof(buffer) - 1, 0);
+    if (n <= 0) return false;
+
+    buffer[n] = '\0';
+    value = std::strtoull(buffer, nullptr, 10);
+    return true;
+}
+
+bool ThroughputMonitor::sample(double now) {
+    if (!isOpen()) return false;
+
+    uint64_t rx = 0, tx = 0;
+    if (!readCounter(rxFd, rx) || !readCounter(txFd, tx)) return false;
+
+    if (!primed) {
+        // The first read only establishes the baseline
+        primed = true;
+        lastRx = rx;
+        lastTx = tx;
+        lastTime = now;
+        return true;
+    }
+
+    double elapsed = now - lastTime;
+    if (elapsed <= 0.0) return true;
+
+    // Counters restart from zero when the interface is re-created
+    double rxRate = rx >= lastRx ? (rx - lastRx) / elapsed : 0.0;
+    double txRate = tx >= lastTx ? (tx - lastTx) / elapsed : 0.0;
+    lastRx = rx;
+    lastTx = tx;
+    lastTime = now;
+
+    dropExpired(now);
+    if (count == CAPACITY) {
+        head = (head + 1) % CAPACITY;
+        --count;
+    }
+    ring[(head + count) % CAPACITY] = ThroughputSample{now, rxRate, txRate};
+    ++count;
+
+    if (std::max(rxRate, txRate) < IDLE_BYTES_PER_SECOND) {
+        intervalMs = std::min(intervalMs * 2, SLOW_INTERVAL_MS);
+    } else {
+        intervalMs = FAST_INTERVAL_MS;
+    }
+    return true;
+}
+
+const ThroughputSample& ThroughputMonitor::at(size_t index) const {
+    return ring[(head + index) % CAPACITY];
+}
+
+double ThroughputMonitor::peakRate() const {
+    double peak = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const ThroughputSample& s = at(i);
+        peak = std::max(peak, std::max(s.rxRate, s.txRate));
+    }
+    return peak;
+}
+
+void ThroughputMonitor::dropExpired(double now) {
+    while (count > 0 && now - ring[head].timestamp > WINDOW_SECONDS) {
+        head = (head + 1) % CAPACITY;
+        --count;
+    }
+}
+
+std::string ThroughputMonitor::formatBytes(double bytes) {
+    static const char* units[] = {"B", "KB", "MB", "GB", "TB"};
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), unit == 0 ? "%.0f %s" : "%.1f %s", bytes, units[unit]);
+    return buffer;
+}
@@ -0,0 +1,77 @@
+#ifndef THROUGHPUTMONITOR_H
+#define THROUGHPUTMONITOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct ThroughputSample {
+    double timestamp; // seconds, monotonic
+    double rxRate;    // bytes per second
+    double txRate;
+};
+
+// Samples /sys/class/net/<iface>/statistics byte counters into a fixed ring
+// of rates covering the last WINDOW_SECONDS. The counter files stay open and
+// are re-read with pread, so a sample is two syscalls and no allocation. The
+// suggested interval backs off while the link is idle and snaps back to
+// FAST_INTERVAL_MS on the first sample with traffic.
+class ThroughputMonitor {
+public:
+    static constexpr size_t CAPACITY = 300;
+    static constexpr double WINDOW_SECONDS = 300.0;
+    static constexpr int FAST_INTERVAL_MS = 1000;
+    static constexpr int SLOW_INTERVAL_MS = 5000;
+    static constexpr double IDLE_BYTES_PER_SECOND = 2048.0;
+
+    ThroughputMonitor();
+    ~ThroughputMonitor();
+
+    ThroughputMonitor(const ThroughputMonitor&) = delete;
+    ThroughputMonitor& operator=(const ThroughputMonitor&) = delete;
+
+    // Starts a fresh history for the given interface
+    bool open(const std::string& iface);
+    void close();
+    bool isOpen() const { return rxFd >= 0 && txFd >= 0; }
+    const std::string& interfaceName() const { return iface; }
+
+    // Reads both counters and appends one rate sample; false if they vanished
+    bool sample(double now);
+    int nextIntervalMs() const { return intervalMs; }
+
+    // Oldest first; only samples within WINDOW_SECONDS of the newest count
+    size_t size() const { return count; }
+    const ThroughputSample& at(size_t index) const;
+
+    double currentRxRate() const { return count ? at(count - 1).rxRate : 0.0; }
+    double currentTxRate() const { return count ? at(count - 1).txRate : 0.0; }
+    uint64_t totalRxBytes() const { return lastRx; }
+    uint64_t totalTxBytes() const { return lastTx; }
+
+    // Largest rx or tx rate in the window, for scaling the graph
+    double peakRate() const;
+
+    static std::string formatBytes(double bytes);
+
+private:
+    std::string iface;
+    int rxFd;
+    int txFd;
+
+    std::array<ThroughputSample, CAPACITY> ring;
+    size_t head;  // index of the oldest sample
+    size_t count;
+
+    bool primed;
+    uint64_t lastRx;
+    uint64_t lastTx;
+    double lastTime;
+    int intervalMs;
+
+    static bool readCounter(int fd, uint64_t& value);
+    void dropExpired(double now);
+};
+
+#endif // THROUGHPUTMONITOR_H
@@ -0,0 +1,263 @@
+#include "TreemapLayout.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+static uint64_t mix(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+static uint64_t rectHash(const TreemapLayout::Rect& rect) {
+    // Exact bits: an unchanged rectangle comes out of the same arithmetic
+    uint64_t hash = 0;
+    for (double value : {rect.x, rect.y, rect.w, rect.h}) {
+        uint64_t bits;
+        static_assert(sizeof(bits) == sizeof(value), "double is not 64 bits");
+        memcpy(&bits, &value, sizeof(bits));
+        hash = mix(hash, bits);
+    }
+    return hash;
+}
+
+TreemapLayout::TreemapLayout() : nextUnnamed(0) {
+}
+
+void TreemapLayout::setBounds(double width, double height) {
+    bounds = Rect{0.0, 0.0, width, height};
+    // Every rectangle changes; drop what could have been reused
+    for (Node& node : current) node.signature = 0;
+}
+
+void TreemapLayout::clear() {
+    current.clear();
+    previous.clear();
+    nextUnnamed = 0;
+}
+
+size_t TreemapLayout::update(const std::vector<TreemapSample>& samples) {
+    previous.swap(current);
+    current.clear();
+    if (samples.empty()) return 0;
+
+    for (const TreemapSample& sample : samples) {
+        nextUnnamed = std::max(nextUnnamed, sample.id + 1);
+    }
+
+    // Scanner ids keep growing as directories are found and folded away, so
+    // old nodes are looked up in a list as long as the old tree, not by id
+    previousIndex.clear();
+    previousIndex.reserve(previous.size());
+    for (size_t i = 0; i < previous.size(); ++i) {
+        previousIndex.emplace_back(previous[i].id, static_cast<int32_t>(i));
+    }
+    std::sort(previousIndex.begin(), previousIndex.end());
+
+    // Children of each sample are contiguous; find where each range starts
+    std::vector<int32_t> childStart(samples.size(), 0);
+    std::vector<int32_t> childCount(samples.size(), 0);
+    for (size_t i = 1; i < samples.size(); ++i) {
+        int32_t parent = samples[i].parent;
+        if (childCount[parent]++ == 0) childStart[parent] = static_cast<int32_t>(i);
+    }
+
+    // Rebuild breadth-first with the files of each directory as an extra
+    // child and every child range sorted largest first, as squarify wants
+    current.reserve(samples.size() + samples.size() / 2);
+    std::vector<int32_t> sampleOf;  // -1 for the files of the parent
+    sampleOf.reserve(current.capacity());
+
+    // The old tree is discarded after this, so its names can be taken
+    auto nameOf = [&](const TreemapSample& sample) -> std::string {
+        if (!sample.name.empty()) return sample.name;
+        int32_t old = findPrevious(sample.id);
+        return old >= 0 ? std::move(previous[old].name) : std::string();
+    };
+
+    Node root;
+    root.id = samples[0].id;
+    root.name = nameOf(samples[0]);
+    root.bytes = samples[0].bytes;
+    current.push_back(std::move(root));
+    sampleOf.push_back(0);
+
+    std::vector<int32_t> order;  // scratch, reused for every child range
+    for (size_t i = 0; i < current.size(); ++i) {
+        int32_t sample = sampleOf[i];
+        if (sample < 0 || childCount[sample] == 0) continue;
+
+        order.clear();
+        uint64_t childBytes = 0;
+        for (int32_t c = childStart[sample]; c < childStart[sample] + childCount[sample]; ++c) {
+            order.push_back(c);
+            childBytes += samples[c].bytes;
+        }
+        // Parent and child counters are bumped separately while scanning
+        uint64_t fileBytes = current[i].bytes > childBytes ? current[i].bytes - childBytes : 0;
+        if (fileBytes > 0) order.push_back(-1);
+
+        std::sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+            uint64_t aBytes = a < 0 ? fileBytes : samples[a].bytes;
+            uint64_t bBytes = b < 0 ? fileBytes : samples[b].bytes;
+            return aBytes > bBytes;
+        });
+
+        current[i].firstChild = static_cast<int32_t>(current.size());
+        current[i].childCount = static_cast<int32_t>(order.size());
+        uint64_t parentId = current[i].id;
+        uint16_t depth = current[i].depth + 1;
+        for (int32_t c : order) {
+            Node child;
+            if (c < 0) {
+                child.id = parentId | FILES_ID;
+                child.name = ".";
+                child.bytes = fileBytes;
+                child.files = true;
+            } else {
+                child.id = samples[c].id;
+                child.name = nameOf(samples[c]);
+                child.bytes = samples[c].bytes;
+            }
+            child.parent = static_cast<int32_t>(i);
+            child.depth = depth;
+            current.push_back(std::move(child));
+            sampleOf.push_back(c);
+        }
+    }
+
+    // Lay out top-down; a node's rectangle is final before its children's
+    current[0].rect = bounds;
+    size_t squarified = 0;
+    for (size_t i = 0; i < current.size(); ++i) {
+        Node& node = current[i];
+        if (node.childCount == 0) continue;
+
+        uint64_t signature = rectHash(node.rect);
+        for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+            signature = mix(mix(signature, current[c].id), current[c].bytes);
+        }
+        node.signature = signature;
+
+        int32_t before = findPrevious(node.id);
+        bool reuse = before >= 0 && previous[before].signature == signature;
+        if (reuse) {
+            for (int32_t c = node.firstChild; c < node.firstChild + node.childCount; ++c) {
+                int32_t old = findPrevious(current[c].id);
+                if (old < 0) {
+                    reuse = false;
+                    break;
+                }
+                current[c].rect = previous[old].rect;
+            }
+        }
+        if (!reuse) {
+            squarify(node.firstChild, node.childCount, node.rect, node.bytes);
+            squarified++;
+        }
+    }
+    return squarified;
+}
+
+int32_t TreemapLayout::findPrevious(uint64_t id) const {
+    auto it = std::lower_bound(previousIndex.begin(), previousIndex.end(), id,
+                               [](const std::pair<uint64_t, int32_t>& entry, uint64_t key) { return entry.first < key; });
+    return it != previousIndex.end() && it->first == id ? it->second : -1;
+}
+
+int TreemapLayout::findPath(const std::vector<std::string>& path) const {
+    if (current.empty()) return -1;
+
+    int node = 0;
+    for (const std::string& name : path) {
+        const Node& parent = current[node];
+        int found = -1;
+        for (int32_t c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+            if (!current[c].files && current[c].name == name) {
+                found = c;
+                break;
+            }
+        }
+        if (found < 0) return -1;
+        node = found;
+    }
+    return node;
+}
+
+int TreemapLayout::childAt(int node, double x, double y) const {
+    if (node < 0 || node >= static_cast<int>(current.size())) return -1;
+
+    const Node& parent = current[node];
+    for (int32_t c = parent.firstChild; c < parent.firstChild + parent.childCount; ++c) {
+        const Rect& r = current[c].rect;
+        if (x >= r.x && x < r.x + r.w && y >= r.y && y < r.y + r.h) return c;
+    }
+    return -1;
+}
+
+void TreemapLayout::squarify(int32_t first, int32_t count, Rect rect, uint64_t total) {
+    uint64_t remaining = 0;
+    for (int32_t c = first; c < first + count; ++c) remaining += current[c].bytes;
+    total = std::max(total, remaining);
+    if (total == 0 || rect.w <= 0.0 || rect.h <= 0.0) {
+        for (int32_t c = first; c < first + count; ++c) current[c].rect = Rect{rect.x, rect.y, 0.0, 0.0};
+        return;
+    }
+
+    // Areas in layout units; the children fill the part of the rectangle
+    // their bytes cover, which is all of it unless the counters lag
+    double scale = rect.w * rect.h / static_cast<double>(total);
+    Rect free = rect;
+    int32_t c = first;
+    int32_t end = first + count;
+
+    while (c < end) {
+        // Lay a row along the shorter side while that improves the worst aspect ratio
+        double side = std::min(free.w, free.h);
+        if (side <= 0.0) break;
+
+        double rowArea = 0.0;
+        double rowMin = std::numeric_limits<double>::max();
+        double rowMax = 0.0;
+        double worst = std::numeric_limits<double>::max();
+        int32_t rowEnd = c;
+        while (rowEnd < end) {
+            double area = current[rowEnd].bytes * scale;
+            double nextArea = rowArea + area;
+            double nextMin = std::min(rowMin, area);
+            double nextMax = std::max(rowMax, area);
+            double sideSquared = side * side;
+            double nextWorst = nextArea > 0.0 && nextMin > 0.0
+                ? std::max(sideSquared * nextMax / (nextArea * nextArea), (nextArea * nextArea) / (sideSquared * nextMin))
+                : std::numeric_limits<double>::max();
+            if (rowEnd > c && nextWorst > worst) break;
+            rowArea = nextArea;
+            rowMin = nextMin;
+            rowMax = nextMax;
+            worst = nextWorst;
+            rowEnd++;
+        }
+
+        // The row takes a strip of the free space as thick as its area needs
+        double thickness = rowArea / side;
+        double offset = 0.0;
+        bool horizontal = free.w >= free.h;  // the row runs down the left edge
+        for (int32_t k = c; k < rowEnd; ++k) {
+            double length = rowArea > 0.0 ? current[k].bytes * scale / thickness : 0.0;
+            if (horizontal) {
+                current[k].rect = Rect{free.x, free.y + offset, thickness, length};
+            } else {
+                current[k].rect = Rect{free.x + offset, free.y, length, thickness};
+            }
+            offset += length;
+        }
+        if (horizontal) {
+            free.x += thickness;
+            free.w = std::max(0.0, free.w - thickness);
+        } else {
+            free.y += thickness;
+            free.h = std::max(0.0, free.h - thickness);
+        }
+        c = rowEnd;
+    }
+    for (; c < end; ++c) current[c].rect = Rect{free.x, free.y, 0.0, 0.0};
+}
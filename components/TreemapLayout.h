@@ -0,0 +1,85 @@
+#ifndef TREEMAPLAYOUT_H
+#define TREEMAPLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// One directory of a breadth-first copy of the scanned tree; the children
+// of each node follow one another
+struct TreemapSample {
+    uint64_t id = 0;      // stable for the life of the directory
+    int32_t parent = -1;  // index in the copy, -1 for the root
+    uint64_t bytes = 0;
+    std::string name;     // left empty for ids the layout already knows
+};
+
+// Squarified treemap (Bruls, Huijsing, van Wijk) of the scanned tree, in a
+// fixed coordinate space set by setBounds(). The drawing side zooms by
+// mapping a view rectangle onto the widget, so zooming never lays out again.
+//
+// update() takes a fresh copy of the tree every time the scanner publishes.
+// A node whose rectangle and children (ids and sizes) are the same as last
+// time keeps its children's rectangles, so once the totals settle only the
+// parts of the tree still being scanned are squarified again. Files directly
+// inside a directory get a rectangle of their own, flagged files, so a
+// directory's children never claim its whole area.
+class TreemapLayout {
+public:
+    struct Rect {
+        double x = 0.0;
+        double y = 0.0;
+        double w = 0.0;
+        double h = 0.0;
+    };
+
+    struct Node {
+        uint64_t id = 0;
+        std::string name;
+        uint64_t bytes = 0;
+        int32_t parent = -1;
+        int32_t firstChild = 0;
+        int32_t childCount = 0;   // largest first
+        uint16_t depth = 0;
+        bool files = false;
+        Rect rect;
+        uint64_t signature = 0;   // children's ids and sizes, and the rectangle they split
+    };
+
+    static constexpr uint64_t FILES_ID = 1ull << 63;  // or'ed into the parent's id
+
+    TreemapLayout();
+
+    void setBounds(double width, double height);
+    void clear();
+
+    // Ids below this already have names; the scanner can skip copying them
+    uint64_t namedFrom() const { return nextUnnamed; }
+
+    // Replaces the tree; returns how many directories were squarified again
+    size_t update(const std::vector<TreemapSample>& samples);
+
+    const std::vector<Node>& nodes() const { return current; }
+    bool empty() const { return current.empty(); }
+
+    // Index of the node at path (names below the root), or -1
+    int findPath(const std::vector<std::string>& path) const;
+    // The child of node whose rectangle holds the point, or -1
+    int childAt(int node, double x, double y) const;
+
+private:
+    Rect bounds;
+    std::vector<Node> current;
+    std::vector<Node> previous;
+    // (id, index into previous) sorted by id; files nodes carry FILES_ID, so
+    // they never collide with their directory
+    std::vector<std::pair<uint64_t, int32_t>> previousIndex;
+    uint64_t nextUnnamed;
+
+    int32_t findPrevious(uint64_t id) const;
+    void squarify(int32_t first, int32_t count, Rect rect, uint64_t total);
+};
+
+#endif // TREEMAPLAYOUT_H
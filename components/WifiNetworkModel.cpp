@@ -0,0 +1,386 @@
+#include "WifiNetworkModel.h"
+#include <cstdlib>
+#include <new>
+
+struct _ElysiaWifiItem {
+    GObject parent_instance;
+    WifiNetwork network;
+    std::string key;
+    int sortStrength; // strength the row was last positioned by
+};
+
+G_DEFINE_FINAL_TYPE(ElysiaWifiItem, elysia_wifi_item, G_TYPE_OBJECT)
+
+static guint wifiItemChangedSignal = 0;
+
+static void elysia_wifi_item_finalize(GObject* object) {
+    ElysiaWifiItem* self = ELYSIA_WIFI_ITEM(object);
+    self->network.~WifiNetwork();
+    self->key.~basic_string();
+    G_OBJECT_CLASS(elysia_wifi_item_parent_class)->finalize(object);
+}
+
+static void elysia_wifi_item_class_init(ElysiaWifiItemClass* klass) {
+    G_OBJECT_CLASS(klass)->finalize = elysia_wifi_item_finalize;
+
+    wifiItemChangedSignal = g_signal_new("changed", G_TYPE_FROM_CLASS(klass), G_SIGNAL_RUN_LAST,
+                                         0, nullptr, nullptr, nullptr, G_TYPE_NONE, 0);
+}
+
+static void elysia_wifi_item_init(ElysiaWifiItem* self) {
+    new (&self->network) WifiNetwork();
+    new (&self->key) std::string();
+    self->sortStrength = 0;
+}
+
+const WifiNetwork* elysia_wifi_item_get_network(ElysiaWifiItem* item) {
+    return item ? &item->network : nullptr;
+}
+
+const std::string& elysia_wifi_item_get_key(ElysiaWifiItem* item) {
+    static const std::string empty;
+    return item ? item->key : empty;
+}
+
+WifiNetworkModel::WifiNetworkModel(SavedLookup isSaved)
+    : store(g_list_store_new(ELYSIA_TYPE_WIFI_ITEM)), device(nullptr), activeAp(nullptr),
+      isSaved(std::move(isSaved)) {
+}
+
+WifiNetworkModel::~WifiNetworkModel() {
+    detach();
+    g_object_unref(store);
+}
+
+guint WifiNetworkModel::size() const {
+    return g_list_model_get_n_items(G_LIST_MODEL(store));
+}
+
+void WifiNetworkModel::attach(NMDeviceWifi* wifi) {
+    detach();
+    if (!wifi) return;
+
+    device = NM_DEVICE_WIFI(g_object_ref(wifi));
+
+    NMAccessPoint* active = nm_device_wifi_get_active_access_point(device);
+    activeAp = active ? NM_ACCESS_POINT(g_object_ref(active)) : nullptr;
+    if (activeAp) {
+        const char* bssid = nm_access_point_get_bssid(activeAp);
+        history.recordActive(ssidFromBytes(nm_access_point_get_ssid(activeAp)), bssid ? bssid : "",
+                             nm_access_point_get_frequency(activeAp), currentTime());
+    }
+
+    const GPtrArray* aps = nm_device_wifi_get_access_points(device);
+    if (aps) {
+        for (guint i = 0; i < aps->len; ++i) {
+            addAccessPoint(static_cast<NMAccessPoint*>(g_ptr_array_index(aps, i)));
+        }
+    }
+
+    g_signal_connect(device, "access-point-added", G_CALLBACK(onAccessPointAdded), this);
+    g_signal_connect(device, "access-point-removed", G_CALLBACK(onAccessPointRemoved), this);
+    g_signal_connect(device, "notify::active-access-point", G_CALLBACK(onActiveAccessPointChanged), this);
+}
+
+void WifiNetworkModel::detach() {
+    if (device) {
+        g_signal_handlers_disconnect_by_data(device, this);
+    }
+
+    for (auto& entry : groups) {
+        for (NMAccessPoint* ap : entry.second.aps) {
+            g_signal_handlers_disconnect_by_data(ap, this);
+            g_object_unref(ap);
+        }
+        if (entry.second.item) g_object_unref(entry.second.item);
+    }
+    groups.clear();
+    apKeys.clear();
+    g_list_store_remove_all(store);
+
+    g_clear_object(&activeAp);
+    g_clear_object(&device);
+}
+
+void WifiNetworkModel::refreshSavedState() {
+    std::vector<std::string> keys;
+    keys.reserve(groups.size());
+    for (const auto& entry : groups) {
+        keys.push_back(entry.first);
+    }
+    for (const std::string& key : keys) {
+        updateGroup(key);
+    }
+}
+
+uint32_t WifiNetworkModel::currentTime() {
+    return static_cast<uint32_t>(g_get_monotonic_time() / G_USEC_PER_SEC);
+}
+
+std::string WifiNetworkModel::ssidFromBytes(GBytes* ssidBytes) {
+    if (!ssidBytes) return "";
+
+    gsize len = 0;
+    const guint8* data = static_cast<const guint8*>(g_bytes_get_data(ssidBytes, &len));
+    if (!data || len == 0) return "";
+
+    return std::string(reinterpret_cast<const char*>(data), len);
+}
+
+bool WifiNetworkModel::isAccessPointSecured(NMAccessPoint* ap) {
+    if (!ap) return false;
+
+    return (nm_access_point_get_flags(ap) != NM_802_11_AP_FLAGS_NONE) ||
+           (nm_access_point_get_wpa_flags(ap) != NM_802_11_AP_SEC_NONE) ||
+           (nm_access_point_get_rsn_flags(ap) != NM_802_11_AP_SEC_NONE);
+}
+
+std::string WifiNetworkModel::groupKey(NMAccessPoint* ap) const {
+    std::string ssid = ssidFromBytes(nm_access_point_get_ssid(ap));
+    if (!ssid.empty()) return ssid;
+
+    // Hidden networks can't be told apart by name, so they stay per-BSSID
+    const char* bssid = nm_access_point_get_bssid(ap);
+    return std::string("\n") + (bssid ? bssid : "");
+}
+
+void WifiNetworkModel::addAccessPoint(NMAccessPoint* ap) {
+    if (!ap || apKeys.count(ap)) return;
+
+    std::string key = groupKey(ap);
+    apKeys.emplace(ap, key);
+    groups[key].aps.push_back(NM_ACCESS_POINT(g_object_ref(ap)));
+
+    g_signal_connect(ap, "notify::strength", G_CALLBACK(onAccessPointStrength), this);
+
+    updateGroup(key);
+}
+
+void WifiNetworkModel::removeAccessPoint(NMAccessPoint* ap) {
+    auto found = apKeys.find(ap);
+    if (found == apKeys.end()) return;
+
+    std::string key = found->second;
+    apKeys.erase(found);
+
+    auto group = groups.find(key);
+    if (group != groups.end()) {
+        auto& aps = group->second.aps;
+        for (auto it = aps.begin(); it != aps.end(); ++it) {
+            if (*it == ap) {
+                aps.erase(it);
+                break;
+            }
+        }
+    }
+
+    g_signal_handlers_disconnect_by_data(ap, this);
+    g_object_unref(ap);
+
+    updateGroup(key);
+}
+
+void WifiNetworkModel::updateGroup(const std::string& key) {
+    auto it = groups.find(key);
+    if (it == groups.end()) return;
+
+    Group& group = it->second;
+
+    if (group.aps.empty()) {
+        if (group.item) {
+            guint position = 0;
+            if (g_list_store_find(store, group.item, &position)) {
+                g_list_store_remove(store, position);
+            }
+            g_object_unref(group.item);
+        }
+        groups.erase(it);
+        return;
+    }
+
+    // Fold every BSSID of this SSID into one row led by the strongest
+    NMAccessPoint* strongest = nullptr;
+    int strength = -1;
+    bool active = false;
+    for (NMAccessPoint* ap : group.aps) {
+        int apStrength = nm_access_point_get_strength(ap);
+        if (apStrength > strength) {
+            strength = apStrength;
+            strongest = ap;
+        }
+        active = active || (ap == activeAp);
+    }
+
+    // History follows the AP actually in use, otherwise the best candidate
+    NMAccessPoint* sampled = active ? activeAp : strongest;
+    const char* sampledBssid = nm_access_point_get_bssid(sampled);
+    bool recorded = history.record(key, currentTime(), nm_access_point_get_strength(sampled),
+                                   nm_access_point_get_frequency(sampled), sampledBssid ? sampledBssid : "");
+
+    WifiNetwork next;
+    next.ssid = ssidFromBytes(nm_access_point_get_ssid(strongest));
+    if (next.ssid.empty()) next.ssid = "<hidden>";
+    next.strength = strength;
+    next.isActive = active;
+    next.isSecured = isAccessPointSecured(strongest);
+    next.isSaved = isSaved && key[0] != '\n' && isSaved(next.ssid);
+    next.ap = nullptr; // Rows look the AP up again by SSID when used
+    const char* bssid = nm_access_point_get_bssid(strongest);
+    next.bssid = bssid ? bssid : "";
+    next.apCount = static_cast<int>(group.aps.size());
+
+    if (next.isActive) {
+        next.status = "Connected";
+    } else if (next.isSaved) {
+        next.status = "Saved";
+    } else if (next.isSecured) {
+        next.status = "Secured";
+    } else {
+        next.status = "Open";
+    }
+
+    if (!group.item) {
+        group.item = ELYSIA_WIFI_ITEM(g_object_new(ELYSIA_TYPE_WIFI_ITEM, nullptr));
+        group.item->network = next;
+        group.item->key = key;
+        group.item->sortStrength = next.strength;
+        g_list_store_insert_sorted(store, group.item, compareItems, nullptr);
+        return;
+    }
+
+    WifiNetwork& current = group.item->network;
+
+    // Besides a new history point, strength only matters once the signal icon changes
+    bool visible = current.isActive != next.isActive ||
+                   current.isSaved != next.isSaved ||
+                   current.isSecured != next.isSecured ||
+                   current.ssid != next.ssid ||
+                   current.bssid != next.bssid ||
+                   current.apCount != next.apCount ||
+                   signalBucket(current.strength) != signalBucket(next.strength);
+    bool resort = current.isActive != next.isActive ||
+                  std::abs(next.strength - group.item->sortStrength) >= HYSTERESIS;
+
+    current = next;
+
+    if (resort) {
+        group.item->sortStrength = next.strength;
+        moveIfOutOfOrder(group.item);
+    }
+    if (visible || recorded) {
+        g_signal_emit(group.item, wifiItemChangedSignal, 0);
+    }
+}
+
+void WifiNetworkModel::moveIfOutOfOrder(ElysiaWifiItem* item) {
+    guint position = 0;
+    if (!g_list_store_find(store, item, &position)) return;
+
+    guint count = g_list_model_get_n_items(G_LIST_MODEL(store));
+    bool inOrder = true;
+
+    if (position > 0) {
+        gpointer prev = g_list_model_get_item(G_LIST_MODEL(store), position - 1);
+        inOrder = compareItems(prev, item, nullptr) <= 0;
+        g_object_unref(prev);
+    }
+    if (inOrder && position + 1 < count) {
+        gpointer next = g_list_model_get_item(G_LIST_MODEL(store), position + 1);
+        inOrder = compareItems(item, next, nullptr) <= 0;
+        g_object_unref(next);
+    }
+
+    if (!inOrder) {
+        // The group still holds a reference, so the item survives the move
+        g_list_store_remove(store, position);
+        g_list_store_insert_sorted(store, item, compareItems, nullptr);
+    }
+}
+
+int WifiNetworkModel::signalBucket(int strength) {
+    if (strength > 75) return 3;
+    if (strength > 50) return 2;
+    if (strength > 25) return 1;
+    return 0;
+}
+
+gint WifiNetworkModel::compareItems(gconstpointer a, gconstpointer b, gpointer user_data) {
+    (void)user_data;
+
+    const ElysiaWifiItem* left = static_cast<const ElysiaWifiItem*>(a);
+    const ElysiaWifiItem* right = static_cast<const ElysiaWifiItem*>(b);
+
+    if (left->network.isActive != right->network.isActive) {
+        return left->network.isActive ? -1 : 1;
+    }
+    if (left->sortStrength != right->sortStrength) {
+        return right->sortStrength - left->sortStrength;
+    }
+    return left->network.ssid.compare(right->network.ssid);
+}
+
+void WifiNetworkModel::onAccessPointAdded(NMDeviceWifi* device, GObject* ap, gpointer user_data) {
+    (void)device;
+
+    WifiNetworkModel* model = static_cast<WifiNetworkModel*>(user_data);
+    if (model && NM_IS_ACCESS_POINT(ap)) {
+        model->addAccessPoint(NM_ACCESS_POINT(ap));
+    }
+}
+
+void WifiNetworkModel::onAccessPointRemoved(NMDeviceWifi* device, GObject* ap, gpointer user_data) {
+    (void)device;
+
+    WifiNetworkModel* model = static_cast<WifiNetworkModel*>(user_data);
+    if (model && NM_IS_ACCESS_POINT(ap)) {
+        model->removeAccessPoint(NM_ACCESS_POINT(ap));
+    }
+}
+
+void WifiNetworkModel::onAccessPointStrength(GObject* ap, GParamSpec* pspec, gpointer user_data) {
+    (void)pspec;
+
+    WifiNetworkModel* model = static_cast<WifiNetworkModel*>(user_data);
+    if (!model) return;
+
+    auto found = model->apKeys.find(NM_ACCESS_POINT(ap));
+    if (found != model->apKeys.end()) {
+        model->updateGroup(found->second);
+    }
+}
+
+void WifiNetworkModel::onActiveAccessPointChanged(GObject* device, GParamSpec* pspec, gpointer user_data) {
+    (void)pspec;
+
+    WifiNetworkModel* model = static_cast<WifiNetworkModel*>(user_data);
+    if (!model) return;
+
+    NMAccessPoint* previous = model->activeAp;
+    NMAccessPoint* current = nm_device_wifi_get_active_access_point(NM_DEVICE_WIFI(device));
+    model->activeAp = current ? NM_ACCESS_POINT(g_object_ref(current)) : nullptr;
+
+    if (current) {
+        const char* bssid = nm_access_point_get_bssid(current);
+        model->history.recordActive(ssidFromBytes(nm_access_point_get_ssid(current)), bssid ? bssid : "",
+                                    nm_access_point_get_frequency(current), currentTime());
+    } else {
+        model->history.recordActiveLost(currentTime());
+    }
+
+    // Only the rows losing and gaining the active flag need touching
+    if (previous) {
+        auto found = model->apKeys.find(previous);
+        if (found != model->apKeys.end()) {
+            std::string key = found->second;
+            model->updateGroup(key);
+        }
+        g_object_unref(previous);
+    }
+    if (current) {
+        auto found = model->apKeys.find(current);
+        if (found != model->apKeys.end()) {
+            std::string key = found->second;
+            model->updateGroup(key);
+        }
+    }
+}
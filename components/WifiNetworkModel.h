@@ -0,0 +1,100 @@
+#ifndef WIFINETWORKMODEL_H
+#define WIFINETWORKMODEL_H
+
+#include <gio/gio.h>
+#include <NetworkManager.h>
+#include "SignalHistory.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct WifiNetwork {
+    std::string ssid;
+    std::string security;
+    int strength;
+    bool isActive;
+    bool isSaved;
+    bool isSecured;
+    NMAccessPoint* ap;
+    std::string status;
+    std::string bssid;   // strongest BSSID advertising this SSID
+    int apCount;         // number of BSSIDs grouped under this SSID
+};
+
+// List item handed out by WifiNetworkModel, one per visible SSID. It emits
+// "changed" whenever the row showing it needs to be redrawn.
+G_BEGIN_DECLS
+#define ELYSIA_TYPE_WIFI_ITEM (elysia_wifi_item_get_type())
+G_DECLARE_FINAL_TYPE(ElysiaWifiItem, elysia_wifi_item, ELYSIA, WIFI_ITEM, GObject)
+G_END_DECLS
+
+const WifiNetwork* elysia_wifi_item_get_network(ElysiaWifiItem* item);
+// Key of the item's SignalHistory track
+const std::string& elysia_wifi_item_get_key(ElysiaWifiItem* item);
+
+// Keeps a GListModel of Wi-Fi networks in step with an NMDeviceWifi. Access
+// points are folded per SSID and every change touches only the affected row:
+// an AP appearing or vanishing inserts or removes one item, and a strength
+// change emits "changed" on that item alone. Rows are ordered active-first,
+// then by strength, but only move once their strength drifts HYSTERESIS
+// points from the value they were last sorted by, so fluctuating signals
+// don't reshuffle the list.
+class WifiNetworkModel {
+public:
+    static constexpr int HYSTERESIS = 10;
+
+    using SavedLookup = std::function<bool(const std::string& ssid)>;
+
+    explicit WifiNetworkModel(SavedLookup isSaved);
+    ~WifiNetworkModel();
+
+    GListModel* getModel() const { return G_LIST_MODEL(store); }
+    guint size() const;
+
+    // Loads the device's current access points and follows its signals
+    void attach(NMDeviceWifi* device);
+    void detach();
+
+    // Re-evaluates the saved flag of every row after profiles change
+    void refreshSavedState();
+
+    // Strength/frequency/BSSID per SSID and the roaming log, recorded from
+    // the same signals that drive the rows, so it costs nothing while idle
+    const SignalHistory& getHistory() const { return history; }
+    static uint32_t currentTime();
+
+    static std::string ssidFromBytes(GBytes* ssidBytes);
+    static bool isAccessPointSecured(NMAccessPoint* ap);
+
+private:
+    struct Group {
+        std::vector<NMAccessPoint*> aps;
+        ElysiaWifiItem* item;
+    };
+
+    GListStore* store;
+    NMDeviceWifi* device;
+    NMAccessPoint* activeAp;
+    SavedLookup isSaved;
+    SignalHistory history;
+
+    std::unordered_map<std::string, Group> groups;
+    std::unordered_map<NMAccessPoint*, std::string> apKeys;
+
+    void addAccessPoint(NMAccessPoint* ap);
+    void removeAccessPoint(NMAccessPoint* ap);
+    void updateGroup(const std::string& key);
+    void moveIfOutOfOrder(ElysiaWifiItem* item);
+    std::string groupKey(NMAccessPoint* ap) const;
+
+    static int signalBucket(int strength);
+    static gint compareItems(gconstpointer a, gconstpointer b, gpointer user_data);
+
+    static void onAccessPointAdded(NMDeviceWifi* device, GObject* ap, gpointer user_data);
+    static void onAccessPointRemoved(NMDeviceWifi* device, GObject* ap, gpointer user_data);
+    static void onAccessPointStrength(GObject* ap, GParamSpec* pspec, gpointer user_data);
+    static void onActiveAccessPointChanged(GObject* device, GParamSpec* pspec, gpointer user_data);
+};
+
+#endif // WIFINETWORKMODEL_H
@@ -0,0 +1,36 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cmath>
+#include <cstdio>
+
+// Just enough of a harness for the engine tests: a failed check prints
+// where and why, and main() returns the number of failures
+static int checkFailures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            checkFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+    do { \
+        double checkActual = (actual); \
+        double checkExpected = (expected); \
+        if (!(std::fabs(checkActual - checkExpected) <= (tolerance))) { \
+            std::fprintf(stderr, "%s:%d: %s is %g, expected %g within %g\n", __FILE__, __LINE__, \
+                         #actual, checkActual, checkExpected, static_cast<double>(tolerance)); \
+            checkFailures++; \
+        } \
+    } while (0)
+
+static int checkResult(const char* name) {
+    if (checkFailures == 0) std::printf("%s: all checks passed\n", name);
+    else std::printf("%s: %d checks failed\n", name, checkFailures);
+    return checkFailures == 0 ? 0 : 1;
+}
+
+#endif // TESTS_CHECK_H
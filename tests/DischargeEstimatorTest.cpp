@@ -0,0 +1,129 @@
+#include "Check.h"
+#include "../components/DischargeEstimator.h"
+#include <cstdint>
+
+// Deterministic noise in [-1, 1], so a failing trace fails the same way every run
+static double noise(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return static_cast<double>(state >> 8) / static_cast<double>(1u << 23) - 1.0;
+}
+
+// The mean rate the estimate was computed from, in W
+static double meanRate(const DischargeEstimator::Estimate& estimate, double energy) {
+    return estimate.valid() ? energy / estimate.seconds * 3600.0 : -1.0;
+}
+
+// power_now jumping ±40% around 10 W every 2 s for half an hour
+static void testNoisyTrace() {
+    DischargeEstimator estimator;
+    uint32_t seed = 1;
+    double energy = 50.0;
+    for (double time = 0.0; time <= 1800.0; time += 2.0) {
+        double rate = 10.0 + 4.0 * noise(seed);
+        estimator.addSample(time, BatteryState::Discharging, PowerProfile::Balanced, energy, rate);
+        energy -= rate * 2.0 / 3600.0;
+    }
+
+    DischargeEstimator::Estimate estimate =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Balanced, energy, 60.0);
+    CHECK(estimate.valid());
+    CHECK_NEAR(meanRate(estimate, energy), 10.0, 0.5);
+    // The spread of the noise shows up as a band around the estimate
+    CHECK(estimate.low > 0.0 && estimate.low < estimate.seconds);
+    CHECK(estimate.high > estimate.seconds);
+    CHECK(estimate.high / estimate.low < 2.0);
+}
+
+// No power_now at all: a 12 W drain seen only through an energy_now
+// counter that the firmware updates every 15 s
+static void testCounterOnlyTrace() {
+    DischargeEstimator estimator;
+    double energy = 45.0;
+    double counter = energy;
+    for (double time = 0.0; time <= 1800.0; time += 2.0) {
+        if (static_cast<int>(time) % 15 == 0) counter = energy;
+        estimator.addSample(time, BatteryState::Discharging, PowerProfile::Default, counter, -1.0);
+        energy -= 12.0 * 2.0 / 3600.0;
+    }
+
+    DischargeEstimator::Estimate estimate =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Default, counter, 60.0);
+    CHECK(estimate.valid());
+    CHECK_NEAR(meanRate(estimate, counter), 12.0, 1.0);
+
+    // Charging from the same counter is a separate model, still empty
+    CHECK(!estimator.estimate(BatteryState::Charging, PowerProfile::Default, counter, 60.0).valid());
+}
+
+// A profile with fewer than MIN_SAMPLES borrows the shared model of its state
+static void testProfileFallback() {
+    DischargeEstimator estimator;
+    double time = 0.0;
+    for (; time < 600.0; time += 2.0) {
+        estimator.addSample(time, BatteryState::Discharging, PowerProfile::Balanced, 40.0, 8.0);
+    }
+
+    // Performance has never been seen: it gets the shared 8 W, like Default
+    DischargeEstimator::Estimate shared =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Default, 40.0, 60.0);
+    CHECK_NEAR(meanRate(shared, 40.0), 8.0, 0.01);
+
+    for (int i = 0; i < DischargeEstimator::MIN_SAMPLES - 1; ++i, time += 2.0) {
+        estimator.addSample(time, BatteryState::Discharging, PowerProfile::Performance, 40.0, 20.0);
+    }
+    DischargeEstimator::Estimate borrowed =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Performance, 40.0, 60.0);
+    DischargeEstimator::Estimate fallback =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Default, 40.0, 60.0);
+    CHECK(borrowed.valid());
+    CHECK_NEAR(borrowed.seconds, fallback.seconds, 1e-9);
+    // The shared model has only been nudged by the few 20 W samples
+    CHECK(meanRate(borrowed, 40.0) < 9.0);
+
+    // The sample that reaches MIN_SAMPLES switches Performance to its own model
+    estimator.addSample(time, BatteryState::Discharging, PowerProfile::Performance, 40.0, 20.0);
+    DischargeEstimator::Estimate own =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Performance, 40.0, 60.0);
+    CHECK_NEAR(meanRate(own, 40.0), 20.0, 0.01);
+    CHECK(own.seconds < fallback.seconds);
+}
+
+// Eight hours of suspend count as MAX_STEP, not as eight hours of weight
+static void testSuspendGap() {
+    DischargeEstimator estimator;
+    double time = 0.0;
+    for (; time < 1200.0; time += 2.0) {
+        estimator.addSample(time, BatteryState::Discharging, PowerProfile::Default, 40.0, 10.0);
+    }
+    time += 8.0 * 3600.0;
+    estimator.addSample(time, BatteryState::Discharging, PowerProfile::Default, 40.0, 20.0);
+
+    double alpha = 1.0 - std::exp(-DischargeEstimator::MAX_STEP / DischargeEstimator::TIME_CONSTANT);
+    DischargeEstimator::Estimate estimate =
+        estimator.estimate(BatteryState::Discharging, PowerProfile::Default, 40.0, 60.0);
+    CHECK_NEAR(meanRate(estimate, 40.0), 10.0 + alpha * 10.0, 1e-6);
+
+    // A counter-only battery across the same gap re-anchors instead of
+    // reading the suspend as a near-zero rate
+    DischargeEstimator counterOnly;
+    double counter = 40.0;
+    for (time = 0.0; time <= 1200.0; time += 30.0) {
+        counterOnly.addSample(time, BatteryState::Discharging, PowerProfile::Default, counter, -1.0);
+        counter -= 10.0 * 30.0 / 3600.0;
+    }
+    double before = meanRate(counterOnly.estimate(BatteryState::Discharging, PowerProfile::Default, 30.0, 60.0), 30.0);
+    CHECK_NEAR(before, 10.0, 0.1);
+    time += 8.0 * 3600.0;
+    counter -= 0.5;
+    counterOnly.addSample(time, BatteryState::Discharging, PowerProfile::Default, counter, -1.0);
+    double after = meanRate(counterOnly.estimate(BatteryState::Discharging, PowerProfile::Default, 30.0, 60.0), 30.0);
+    CHECK_NEAR(after, before, 1e-9);
+}
+
+int main() {
+    testNoisyTrace();
+    testCounterOnlyTrace();
+    testProfileFallback();
+    testSuspendGap();
+    return checkResult("DischargeEstimatorTest");
+}
@@ -0,0 +1,202 @@
+#include "../components/DiskUsageScanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <ftw.h>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_set>
+#include <vector>
+
+// Generates a tree that exercises each of the scanner's limits and times a
+// scan of it:
+//   deep/   DEEP_LEVELS nested directories, one small file in each
+//   wide/   wide parents x WIDE_CHILDREN empty directories, more in all
+//           than MAX_NODES, though folding keeps far fewer held at once
+//   big/    directories over AGGREGATE_BYTES, which must stay nodes
+//   small/  directories under it, which must be folded
+//   links/  one file with LINKS hard links, which must be counted once
+//
+// Usage: DiskUsageScannerBench [parent directory] [wide parents]
+static constexpr int DEEP_LEVELS = 1500;
+static constexpr int WIDE_CHILDREN = 1000;
+static constexpr int BIG_DIRS = 4;
+static constexpr int SMALL_DIRS = 200;
+static constexpr int LINKS = 100;
+
+static bool makeFile(int dir, const char* name, off_t size) {
+    int fd = openat(dir, name, O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+    // Allocated blocks are what the scanner sums, and writing them is slow
+    bool ok = size == 0 || posix_fallocate(fd, 0, size) == 0;
+    close(fd);
+    return ok;
+}
+
+static int makeDirectory(int parent, const char* name) {
+    if (mkdirat(parent, name, 0755) != 0) return -1;
+    return openat(parent, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+}
+
+static bool generate(const std::string& root, int wideParents) {
+    int top = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (top < 0) return false;
+    bool ok = true;
+    char name[32];
+
+    int dir = makeDirectory(top, "deep");
+    for (int level = 0; ok && dir >= 0 && level < DEEP_LEVELS; ++level) {
+        ok = makeFile(dir, "file", 4096);
+        int next = makeDirectory(dir, "d");
+        close(dir);
+        dir = next;
+    }
+    ok = ok && dir >= 0;
+    if (dir >= 0) close(dir);
+
+    int wide = makeDirectory(top, "wide");
+    ok = ok && wide >= 0;
+    for (int i = 0; ok && i < wideParents; ++i) {
+        snprintf(name, sizeof(name), "w%04d", i);
+        int parent = makeDirectory(wide, name);
+        ok = parent >= 0;
+        for (int j = 0; ok && j < WIDE_CHILDREN; ++j) {
+            snprintf(name, sizeof(name), "s%04d", j);
+            ok = mkdirat(parent, name, 0755) == 0;
+        }
+        if (parent >= 0) close(parent);
+    }
+    if (wide >= 0) close(wide);
+
+    int big = makeDirectory(top, "big");
+    ok = ok && big >= 0;
+    for (int i = 0; ok && i < BIG_DIRS; ++i) {
+        snprintf(name, sizeof(name), "b%d", i);
+        int child = makeDirectory(big, name);
+        ok = child >= 0 && makeFile(child, "file", static_cast<off_t>(DiskUsageScanner::AGGREGATE_BYTES) * 2);
+        if (child >= 0) close(child);
+    }
+    if (big >= 0) close(big);
+
+    int small = makeDirectory(top, "small");
+    ok = ok && small >= 0;
+    for (int i = 0; ok && i < SMALL_DIRS; ++i) {
+        snprintf(name, sizeof(name), "s%03d", i);
+        int child = makeDirectory(small, name);
+        ok = child >= 0 && makeFile(child, "file", 64 * 1024);
+        if (child >= 0) close(child);
+    }
+    if (small >= 0) close(small);
+
+    int links = makeDirectory(top, "links");
+    ok = ok && links >= 0 && makeFile(links, "target", 64 << 20);
+    for (int i = 0; ok && i < LINKS; ++i) {
+        snprintf(name, sizeof(name), "l%03d", i);
+        int child = makeDirectory(links, name);
+        ok = child >= 0 && linkat(links, "target", child, "link", 0) == 0;
+        if (child >= 0) close(child);
+    }
+    if (links >= 0) close(links);
+
+    close(top);
+    return ok;
+}
+
+// What du -s would say, minus the root directory itself
+static uint64_t referenceBytes;
+static uint64_t referenceDirectories;
+static std::unordered_set<uint64_t> referenceInodes;
+
+static int countEntry(const char* path, const struct stat* status, int type, struct FTW* walk) {
+    (void)path; (void)type;
+    if (walk->level == 0) return 0;
+    if (S_ISDIR(status->st_mode)) referenceDirectories++;
+    else if (status->st_nlink > 1 && !referenceInodes.insert(status->st_ino).second) return 0;
+    referenceBytes += static_cast<uint64_t>(status->st_blocks) * 512;
+    return 0;
+}
+
+static int removeEntry(const char* path, const struct stat* status, int type, struct FTW* walk) {
+    (void)status; (void)walk;
+    return type == FTW_DP ? rmdir(path) : unlink(path);
+}
+
+static double mebibytes(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1 << 20);
+}
+
+static const UsageEntry* findChild(const std::vector<UsageEntry>& children, const char* name) {
+    for (const UsageEntry& child : children) {
+        if (child.name == name) return &child;
+    }
+    return nullptr;
+}
+
+// Children of a directory that are still nodes, rather than folded into it
+static size_t heldChildren(const DiskUsageScanner& scanner, const char* name) {
+    UsageEntry total;
+    std::vector<UsageEntry> children;
+    if (!scanner.list({name}, total, children)) return 0;
+    return findChild(children, ".") ? children.size() - 1 : children.size();
+}
+
+int main(int argc, char** argv) {
+    std::string parent = argc > 1 ? argv[1] : "/tmp";
+    int wideParents = argc > 2 ? std::atoi(argv[2]) : 250;
+
+    std::string root = parent + "/usage-bench-XXXXXX";
+    if (!mkdtemp(&root[0])) {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    auto clock = std::chrono::steady_clock::now;
+    auto started = clock();
+    bool generated = generate(root, wideParents);
+    double generateSeconds = std::chrono::duration<double>(clock() - started).count();
+    if (!generated) {
+        perror("generating the tree");
+        nftw(root.c_str(), removeEntry, 64, FTW_DEPTH | FTW_PHYS);
+        return 1;
+    }
+    nftw(root.c_str(), countEntry, 64, FTW_PHYS);
+    printf("tree: %llu directories, %.1f MiB, generated in %.2f s\n",
+           static_cast<unsigned long long>(referenceDirectories), mebibytes(referenceBytes), generateSeconds);
+
+    // Sample the node count about as often as the page would redraw
+    DiskUsageScanner scanner;
+    size_t peakNodes = 0;
+    started = clock();
+    scanner.start(root);
+    while (scanner.isRunning()) {
+        peakNodes = std::max(peakNodes, scanner.progress().nodes);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    double scanSeconds = std::chrono::duration<double>(clock() - started).count();
+    ScanProgress done = scanner.progress();
+    peakNodes = std::max(peakNodes, done.nodes);
+
+    printf("scan: %.3f s, %.0f directories/s, %s\n", scanSeconds, referenceDirectories / scanSeconds,
+           done.complete ? "complete" : "incomplete");
+    printf("bytes: %.1f MiB against %.1f MiB from the reference walk, %llu errors\n",
+           mebibytes(done.bytes), mebibytes(referenceBytes), static_cast<unsigned long long>(done.errors));
+    printf("nodes: peak %zu, %zu at the end, MAX_NODES %zu\n", peakNodes, done.nodes, DiskUsageScanner::MAX_NODES);
+    printf("folding at %.0f MiB: big/ keeps %zu of %d, small/ keeps %zu of %d, wide/ keeps %zu of %d\n",
+           mebibytes(DiskUsageScanner::AGGREGATE_BYTES), heldChildren(scanner, "big"), BIG_DIRS,
+           heldChildren(scanner, "small"), SMALL_DIRS, heldChildren(scanner, "wide"), wideParents);
+
+    UsageEntry total;
+    std::vector<UsageEntry> children;
+    scanner.list({}, total, children);
+    const UsageEntry* links = findChild(children, "links");
+    printf("hard links: links/ holds %.1f MiB for one 64 MiB file linked %d times\n",
+           links ? mebibytes(links->bytes) : 0.0, LINKS + 1);
+
+    nftw(root.c_str(), removeEntry, 64, FTW_DEPTH | FTW_PHYS);
+    return done.complete && done.bytes == referenceBytes ? 0 : 1;
+}
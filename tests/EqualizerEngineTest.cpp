@@ -0,0 +1,155 @@
+#include "Check.h"
+#include "../components/EqualizerEngine.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+static constexpr double SAMPLE_RATE = 48000.0;
+static constexpr size_t BLOCK_FRAMES = 256;  // what EqualizerSink hands over
+
+// Noise plus a few tones, the same on every run
+static std::vector<float> testSignal(int channels, size_t frames) {
+    std::vector<float> signal(frames * channels);
+    uint32_t state = 12345;
+    for (size_t n = 0; n < frames; ++n) {
+        for (int c = 0; c < channels; ++c) {
+            state = state * 1664525u + 1013904223u;
+            double noise = static_cast<double>(state >> 8) / static_cast<double>(1u << 24) - 0.5;
+            double tones = 0.3 * std::sin(n * 2.0 * M_PI * 60.0 / SAMPLE_RATE + c) +
+                           0.2 * std::sin(n * 2.0 * M_PI * 3000.0 / SAMPLE_RATE);
+            signal[n * channels + c] = static_cast<float>(0.3 * noise + tones);
+        }
+    }
+    return signal;
+}
+
+// process() must be processReference() delayed by latencyFrames(), sample
+// for sample up to float rounding, however the bands fill the SIMD lanes
+static void compareWithReference(EqualizerFilterType type, int bandCount, int channels) {
+    std::vector<EqualizerBand> bands;
+    for (int b = 0; b < bandCount; ++b) {
+        double frequency = 40.0 * std::pow(2.0, b * 9.0 / std::max(1, bandCount - 1));
+        double gain = (b % 2 == 0) ? 9.0 : -12.0;
+        bands.push_back(EqualizerBand{type, frequency, gain, 0.7 + 0.3 * b});
+    }
+
+    EqualizerEngine vectorised(channels, SAMPLE_RATE);
+    EqualizerEngine reference(channels, SAMPLE_RATE);
+    vectorised.setBands(bands);
+    reference.setBands(bands);
+    vectorised.setPreamp(-4.0);
+    reference.setPreamp(-4.0);
+
+    const size_t frames = 8192;
+    std::vector<float> input = testSignal(channels, frames);
+    std::vector<float> fast = input;
+    std::vector<float> slow = input;
+    // Uneven blocks, so state has to carry across calls
+    for (size_t done = 0, size = 1; done < frames; done += size, size = size * 3 % 1021 + 1) {
+        size = std::min(size, frames - done);
+        vectorised.process(fast.data() + done * channels, size);
+    }
+    reference.processReference(slow.data(), frames);
+
+    int latency = vectorised.latencyFrames();
+    double worst = 0.0;
+    double peak = 0.0;
+    double change = 0.0;
+    for (size_t n = latency; n < frames; ++n) {
+        for (int c = 0; c < channels; ++c) {
+            float expected = slow[(n - latency) * channels + c];
+            worst = std::max(worst, static_cast<double>(std::fabs(fast[n * channels + c] - expected)));
+            peak = std::max(peak, static_cast<double>(std::fabs(expected)));
+            change = std::max(change, static_cast<double>(std::fabs(expected - input[(n - latency) * channels + c])));
+        }
+    }
+    if (worst > 1e-5 * peak) {
+        std::fprintf(stderr, "type %d, %d bands, %d channels: differs by %g\n",
+                     static_cast<int>(type), bandCount, channels, worst);
+    }
+    CHECK(worst <= 1e-5 * peak);
+    // The filters really did something, so the match is not trivial
+    CHECK(change > 0.01);
+}
+
+// A tone at the centre of a +12 dB peaking band comes out four times louder
+static void testPeakingGain() {
+    EqualizerEngine engine(1, SAMPLE_RATE);
+    engine.setBands({EqualizerBand{EqualizerFilterType::Peaking, 1000.0, 12.0, 1.0}});
+
+    std::vector<float> tone(48000);
+    for (size_t n = 0; n < tone.size(); ++n) {
+        tone[n] = static_cast<float>(0.1 * std::sin(n * 2.0 * M_PI * 1000.0 / SAMPLE_RATE));
+    }
+    double inputPower = 0.0;
+    for (size_t n = tone.size() / 2; n < tone.size(); ++n) inputPower += tone[n] * tone[n];
+    engine.process(tone.data(), tone.size());
+    double outputPower = 0.0;
+    for (size_t n = tone.size() / 2; n < tone.size(); ++n) outputPower += tone[n] * tone[n];
+
+    CHECK_NEAR(10.0 * std::log10(outputPower / inputPower), 12.0, 0.1);
+    CHECK_NEAR(engine.magnitudeDb(1000.0), 12.0, 0.01);
+}
+
+// reset() forgets the filter state: the same input gives the same output
+static void testReset() {
+    EqualizerEngine engine(2, SAMPLE_RATE);
+    engine.setBands(EqualizerEngine::defaultBands());
+    std::vector<float> first = testSignal(2, 1024);
+    std::vector<float> second = first;
+    engine.process(first.data(), 1024);
+    engine.reset();
+    engine.process(second.data(), 1024);
+    CHECK(first == second);
+}
+
+// Time per BLOCK_FRAMES stereo block with all ten default bands, against the
+// time the block lasts
+static void timeBlocks() {
+    std::vector<EqualizerBand> bands = EqualizerEngine::defaultBands();
+    for (size_t b = 0; b < bands.size(); ++b) bands[b].gain = b % 2 ? 6.0 : -6.0;
+
+    const int blocks = 20000;
+    std::vector<float> signal = testSignal(2, BLOCK_FRAMES);
+    double budget = BLOCK_FRAMES / SAMPLE_RATE * 1e9;
+    auto clock = std::chrono::steady_clock::now;
+
+    EqualizerEngine engine(2, SAMPLE_RATE);
+    engine.setBands(bands);
+    std::vector<float> block = signal;
+    auto started = clock();
+    for (int i = 0; i < blocks; ++i) {
+        std::copy(signal.begin(), signal.end(), block.begin());
+        engine.process(block.data(), BLOCK_FRAMES);
+    }
+    double vectorised = std::chrono::duration<double, std::nano>(clock() - started).count() / blocks;
+
+    started = clock();
+    for (int i = 0; i < blocks; ++i) {
+        std::copy(signal.begin(), signal.end(), block.begin());
+        engine.processReference(block.data(), BLOCK_FRAMES);
+    }
+    double reference = std::chrono::duration<double, std::nano>(clock() - started).count() / blocks;
+
+    std::printf("%zu-frame stereo block, 10 bands: process %.0f ns, processReference %.0f ns (%.1fx), "
+                "%.3f%% of the %.0f us the block lasts\n",
+                BLOCK_FRAMES, vectorised, reference, reference / vectorised, vectorised / budget * 100.0,
+                budget / 1000.0);
+    CHECK(vectorised < budget);
+}
+
+int main() {
+    for (EqualizerFilterType type : {EqualizerFilterType::Peaking, EqualizerFilterType::LowShelf,
+                                     EqualizerFilterType::HighShelf}) {
+        for (int bandCount : {1, 3, 4, 5, 10, EqualizerEngine::MAX_BANDS}) {
+            for (int channels : {1, 2, 3, EqualizerEngine::MAX_CHANNELS}) {
+                compareWithReference(type, bandCount, channels);
+            }
+        }
+    }
+    testPeakingGain();
+    testReset();
+    timeBlocks();
+    return checkResult("EqualizerEngineTest");
+}
@@ -0,0 +1,155 @@
+#include "Check.h"
+#include "../components/NetworkProbe.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+// A socket of the given type bound to an ephemeral port on 127.0.0.1
+static int bindLoopback(int type, uint16_t& port) {
+    int fd = socket(AF_INET, type | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(addr);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length) < 0) {
+        close(fd);
+        return -1;
+    }
+    port = ntohs(addr.sin_port);
+    return fd;
+}
+
+// Runs one target to the end, the way the diagnostics panel would: waiting
+// on eventFd() and reading results() after each wake-up
+static ProbeResult runProbe(const ProbeTarget& target, int samples, int timeoutMs) {
+    NetworkProbe probe;
+    if (!probe.start({target}, samples, timeoutMs, 10)) return ProbeResult();
+
+    ProbeResult result;
+    while (!result.done) {
+        pollfd fd{probe.eventFd(), POLLIN, 0};
+        if (poll(&fd, 1, 5000) <= 0) break;
+        probe.acknowledge();
+        std::vector<ProbeResult> results = probe.results();
+        if (!results.empty()) result = results.front();
+    }
+    probe.stop();
+    return result;
+}
+
+static ProbeTarget dnsTarget(uint16_t port) {
+    return ProbeTarget{ProbeTarget::Kind::Dns, "stub resolver", "127.0.0.1", port, "example.test"};
+}
+
+static ProbeTarget tcpTarget(uint16_t port) {
+    return ProbeTarget{ProbeTarget::Kind::Tcp, "listener", "127.0.0.1", port, ""};
+}
+
+// A stub resolver that answers every A query with 192.0.2.1
+static void answerQueries(int fd, int count) {
+    for (int i = 0; i < count; ++i) {
+        uint8_t packet[512];
+        sockaddr_storage from{};
+        socklen_t fromLength = sizeof(from);
+        ssize_t n = recvfrom(fd, packet, sizeof(packet) - 16, 0, reinterpret_cast<sockaddr*>(&from), &fromLength);
+        if (n < 12) return;
+
+        packet[2] = 0x81;  // response, recursion desired
+        packet[3] = 0x80;  // recursion available, no error
+        packet[7] = 1;     // one answer
+        const uint8_t answer[16] = {
+            0xc0, 0x0c,             // the name in the question
+            0x00, 0x01, 0x00, 0x01, // A, IN
+            0x00, 0x00, 0x00, 0x3c, // TTL 60
+            0x00, 0x04, 192, 0, 2, 1
+        };
+        std::memcpy(packet + n, answer, sizeof(answer));
+        sendto(fd, packet, n + sizeof(answer), 0, reinterpret_cast<sockaddr*>(&from), fromLength);
+    }
+}
+
+static void testDnsAnswered() {
+    uint16_t port = 0;
+    int fd = bindLoopback(SOCK_DGRAM, port);
+    CHECK(fd >= 0);
+    if (fd < 0) return;
+
+    const int samples = 3;
+    std::thread stub(answerQueries, fd, samples);
+    ProbeResult result = runProbe(dnsTarget(port), samples, 1000);
+    stub.join();
+    close(fd);
+
+    CHECK(result.done);
+    CHECK(result.method == "UDP " + std::to_string(port));
+    CHECK(result.sent == samples);
+    CHECK(result.received == samples);
+    CHECK(result.error.empty());
+    CHECK(result.minMs > 0.0 && result.minMs <= result.p50Ms && result.p50Ms <= result.maxMs);
+    CHECK(result.maxMs < 1000.0);
+}
+
+// The stub reads nothing, so every sample has to run into the timeout
+static void testDnsTimeout() {
+    uint16_t port = 0;
+    int fd = bindLoopback(SOCK_DGRAM, port);
+    CHECK(fd >= 0);
+    if (fd < 0) return;
+
+    ProbeResult result = runProbe(dnsTarget(port), 2, 150);
+    close(fd);
+
+    CHECK(result.done);
+    CHECK(result.sent == 2);
+    CHECK(result.received == 0);
+    CHECK(result.error == "timed out");
+}
+
+static void testTcpConnects() {
+    uint16_t port = 0;
+    int fd = bindLoopback(SOCK_STREAM, port);
+    CHECK(fd >= 0 && listen(fd, 8) == 0);
+    if (fd < 0) return;
+
+    // The handshake completes in the kernel; nothing has to accept()
+    ProbeResult result = runProbe(tcpTarget(port), 3, 1000);
+    close(fd);
+
+    CHECK(result.done);
+    CHECK(result.method == "TCP " + std::to_string(port));
+    CHECK(result.sent == 3);
+    CHECK(result.received == 3);
+    CHECK(result.error.empty());
+}
+
+static void testTcpRefused() {
+    // Bound, never listening: the port is ours and nothing accepts on it
+    uint16_t port = 0;
+    int fd = bindLoopback(SOCK_STREAM, port);
+    CHECK(fd >= 0);
+    if (fd < 0) return;
+
+    ProbeResult result = runProbe(tcpTarget(port), 2, 1000);
+    close(fd);
+
+    CHECK(result.done);
+    CHECK(result.sent == 2);
+    CHECK(result.received == 0);
+    CHECK(result.error == std::strerror(ECONNREFUSED));
+}
+
+int main() {
+    testDnsAnswered();
+    testDnsTimeout();
+    testTcpConnects();
+    testTcpRefused();
+    return checkResult("NetworkProbeTest");
+}
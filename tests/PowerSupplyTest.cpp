@@ -0,0 +1,214 @@
+#include "Check.h"
+#include "../components/PowerSupply.h"
+#include "../components/PowerSupplyRegistry.h"
+#include <cstdlib>
+#include <fcntl.h>
+#include <ftw.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A fake /sys with a class/power_supply directory of plain files, which
+// PowerSupply reads instead of the kernel's through ELYSIA_SYSFS_ROOT
+static std::string classDirectory;
+
+// Rewrites the file in place, as the kernel would: an fd opened earlier
+// sees the new value
+static void writeAttribute(const std::string& supply, const char* name, const char* value) {
+    std::string path = classDirectory + "/" + supply + "/" + name;
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return;
+    std::string text = std::string(value) + "\n";
+    ssize_t written = write(fd, text.data(), text.size());
+    (void)written;
+    close(fd);
+}
+
+static void makeSupply(const std::string& supply, const char* type) {
+    mkdir((classDirectory + "/" + supply).c_str(), 0755);
+    writeAttribute(supply, "type", type);
+}
+
+// 40 of 50 Wh, draining at 10 W, reported in energy_* and power_now
+static void makeEnergyBattery(const std::string& supply) {
+    makeSupply(supply, "Battery");
+    writeAttribute(supply, "status", "Discharging");
+    writeAttribute(supply, "present", "1");
+    writeAttribute(supply, "energy_now", "40000000");
+    writeAttribute(supply, "energy_full", "50000000");
+    writeAttribute(supply, "power_now", "10000000");
+    writeAttribute(supply, "voltage_now", "12000000");
+}
+
+// The same battery as a driver reporting charge_* in µAh and current_now
+// at 10 V, with no voltage_min_design
+static void makeChargeBattery(const std::string& supply) {
+    makeSupply(supply, "Battery");
+    writeAttribute(supply, "status", "Discharging");
+    writeAttribute(supply, "present", "1");
+    writeAttribute(supply, "charge_now", "4000000");
+    writeAttribute(supply, "charge_full", "5000000");
+    writeAttribute(supply, "current_now", "1000000");
+    writeAttribute(supply, "voltage_now", "10000000");
+}
+
+static int removeEntry(const char* path, const struct stat* status, int type, struct FTW* walk) {
+    (void)status; (void)walk;
+    return type == FTW_DP ? rmdir(path) : unlink(path);
+}
+
+static void testEnergyAndChargeAgree() {
+    makeEnergyBattery("BAT0");
+    makeChargeBattery("BAT1");
+
+    PowerSupply energy;
+    PowerSupply charge;
+    BatteryInfo fromEnergy;
+    BatteryInfo fromCharge;
+    CHECK(energy.open("BAT0") && energy.read(fromEnergy));
+    CHECK(charge.open("BAT1") && charge.read(fromCharge));
+
+    CHECK_NEAR(fromEnergy.energyNow, 40.0, 1e-9);
+    CHECK_NEAR(fromEnergy.energyFull, 50.0, 1e-9);
+    CHECK_NEAR(fromEnergy.energyRate, 10.0, 1e-9);
+    CHECK_NEAR(fromCharge.energyNow, fromEnergy.energyNow, 1e-9);
+    CHECK_NEAR(fromCharge.energyFull, fromEnergy.energyFull, 1e-9);
+    CHECK_NEAR(fromCharge.energyRate, fromEnergy.energyRate, 1e-9);
+    CHECK_NEAR(fromCharge.percentage, 80.0, 1e-9);
+    CHECK_NEAR(fromCharge.timeToEmpty, 4.0 * 3600.0, 1e-6);
+    CHECK(fromCharge.state == BatteryState::Discharging);
+}
+
+// A driver with only status and capacity: everything else stays unknown
+static void testMissingAttributes() {
+    makeSupply("BAT2", "Battery");
+    writeAttribute("BAT2", "status", "Charging");
+    writeAttribute("BAT2", "capacity", "55");
+
+    PowerSupply supply;
+    BatteryInfo info;
+    CHECK(supply.open("BAT2") && supply.read(info));
+    CHECK(info.state == BatteryState::Charging);
+    CHECK(info.present);
+    CHECK_NEAR(info.percentage, 55.0, 1e-9);
+    CHECK(info.energyNow < 0.0);
+    CHECK(info.energyFull < 0.0);
+    CHECK(info.energyRate < 0.0);
+    CHECK(info.voltage < 0.0);
+    CHECK(info.capacity < 0.0);
+    CHECK(info.timeToFull < 0.0);
+    CHECK(info.chargeCycles < 0);
+    CHECK(info.level == BatteryLevel::Unknown);
+
+    // Without status or capacity it is not a battery that can be read at all
+    makeSupply("BAT3", "Battery");
+    PowerSupply empty;
+    CHECK(!empty.open("BAT3"));
+}
+
+// Two packs, one topping up the other: 10 W out, 6 W in
+static void testAggregate() {
+    makeEnergyBattery("BAT0");
+    makeChargeBattery("BAT1");
+    writeAttribute("BAT1", "status", "Charging");
+    writeAttribute("BAT1", "current_now", "600000");
+    makeSupply("AC", "Mains");
+    writeAttribute("AC", "online", "1");
+
+    PowerSupplyRegistry registry;
+    registry.start(0.0);
+    CHECK(registry.size() == 2);
+    CHECK(registry.systemCount() == 2);
+
+    BatteryInfo total = registry.aggregate();
+    CHECK_NEAR(total.energyNow, 80.0, 1e-9);
+    CHECK_NEAR(total.energyFull, 100.0, 1e-9);
+    CHECK_NEAR(total.percentage, 80.0, 1e-9);
+    CHECK(total.state == BatteryState::Discharging);
+    CHECK_NEAR(total.energyRate, 4.0, 1e-9);
+    CHECK_NEAR(total.timeToEmpty, 80.0 / 4.0 * 3600.0, 1e-6);
+
+    // The charger takes over: 6 W out, 10 W in
+    writeAttribute("BAT0", "power_now", "6000000");
+    writeAttribute("BAT1", "current_now", "1000000");
+    CHECK(registry.refresh(PowerSupplyRegistry::SYSTEM_INTERVAL));
+    total = registry.aggregate();
+    CHECK(total.state == BatteryState::Charging);
+    CHECK_NEAR(total.energyRate, 4.0, 1e-9);
+    CHECK_NEAR(total.timeToFull, 20.0 / 4.0 * 3600.0, 1e-6);
+    registry.stop();
+}
+
+// The attribute fds opened in open() are read again from offset 0, so a
+// value rewritten since, even a shorter one, is what the next read sees
+static void testRereadAfterRewrite() {
+    makeEnergyBattery("BAT0");
+
+    PowerSupply supply;
+    BatteryInfo info;
+    CHECK(supply.open("BAT0") && supply.read(info));
+    CHECK_NEAR(info.energyNow, 40.0, 1e-9);
+
+    writeAttribute("BAT0", "status", "Charging");
+    writeAttribute("BAT0", "energy_now", "9000000");
+    writeAttribute("BAT0", "power_now", "20000000");
+    CHECK(supply.read(info));
+    CHECK(info.state == BatteryState::Charging);
+    CHECK_NEAR(info.energyNow, 9.0, 1e-9);
+    CHECK_NEAR(info.energyRate, 20.0, 1e-9);
+    CHECK_NEAR(info.percentage, 18.0, 1e-9);
+    CHECK_NEAR(info.timeToFull, 41.0 / 20.0 * 3600.0, 1e-6);
+
+    // Files replaced rather than rewritten go unseen: the reader keeps
+    // reading the fds it opened instead of opening the paths again
+    std::string directory = classDirectory + "/BAT0";
+    nftw(directory.c_str(), removeEntry, 8, FTW_DEPTH | FTW_PHYS);
+    makeEnergyBattery("BAT0");
+    CHECK(supply.read(info));
+    CHECK_NEAR(info.energyNow, 9.0, 1e-9);
+}
+
+// A peripheral's battery never makes the machine run on battery, and any
+// online external supply means it does not
+static void testOnBatteryPower() {
+    makeSupply("hidpp_battery_0", "Battery");
+    writeAttribute("hidpp_battery_0", "scope", "Device");
+    writeAttribute("hidpp_battery_0", "status", "Discharging");
+    CHECK(!PowerSupply::onBatteryPower());
+
+    makeEnergyBattery("BAT0");
+    makeSupply("AC", "Mains");
+    writeAttribute("AC", "online", "1");
+    CHECK(!PowerSupply::onBatteryPower());
+    writeAttribute("AC", "online", "0");
+    CHECK(PowerSupply::onBatteryPower());
+    makeSupply("ucsi-source-psy-USBC000:001", "USB");
+    writeAttribute("ucsi-source-psy-USBC000:001", "online", "1");
+    CHECK(!PowerSupply::onBatteryPower());
+}
+
+int main() {
+    char root[] = "/tmp/power-supply-test-XXXXXX";
+    if (!mkdtemp(root)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    setenv("ELYSIA_SYSFS_ROOT", root, 1);
+    mkdir((std::string(root) + "/class").c_str(), 0755);
+    classDirectory = PowerSupply::classDirectory();
+    mkdir(classDirectory.c_str(), 0755);
+    CHECK(classDirectory == std::string(root) + "/class/power_supply");
+
+    testEnergyAndChargeAgree();
+    testMissingAttributes();
+    nftw(classDirectory.c_str(), removeEntry, 8, FTW_DEPTH | FTW_PHYS);
+    mkdir(classDirectory.c_str(), 0755);
+    testAggregate();
+    testRereadAfterRewrite();
+    nftw(classDirectory.c_str(), removeEntry, 8, FTW_DEPTH | FTW_PHYS);
+    mkdir(classDirectory.c_str(), 0755);
+    testOnBatteryPower();
+
+    nftw(root, removeEntry, 8, FTW_DEPTH | FTW_PHYS);
+    return checkResult("PowerSupplyTest");
+}
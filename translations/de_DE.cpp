@@ -206,6 +206,27 @@ void loadGermanTranslations(std::map<TranslationKeys, std::string>& translations
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Netzwerk deaktiviert";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi deaktiviert";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "Nicht verbunden";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(+{1} weitere Zugangspunkte)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Signal {1}-{2}%, erster Wert {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "Letzter Verbindungsaufbau dauerte {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Verbunden mit {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Gewechselt {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Verbindung zu {1} verloren";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "vor {1} s";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "vor {1} min";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "vor {1} h";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "vor {1} d";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "falsches Passwort oder fehlende Zugangsdaten";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "der Zugangspunkt hat die Verbindung abgelehnt";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "Zeitüberschreitung bei der Authentifizierung";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "Fehler im WLAN-Supplicant";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "Netzwerk nicht gefunden";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "keine IP-Adresse (DHCP fehlgeschlagen)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "IP-Lease abgelaufen";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "Verbindung verloren";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "vom Benutzer getrennt";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "durch eine andere Verbindung ersetzt";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "Grund {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
@@ -206,6 +206,103 @@ void loadEnglishTranslations(std::map<TranslationKeys, std::string>& translation
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Networking disabled";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi disabled";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "Not connected";
+    translations[TranslationKeys::THROUGHPUT_TOTAL] = "Total";
+    translations[TranslationKeys::ACTIVATION_REQUESTING] = "Requesting...";
+    translations[TranslationKeys::ACTIVATION_PREPARE] = "Preparing";
+    translations[TranslationKeys::ACTIVATION_CONFIG] = "Associating";
+    translations[TranslationKeys::ACTIVATION_NEED_AUTH] = "Authenticating";
+    translations[TranslationKeys::ACTIVATION_IP_CONFIG] = "Getting IP address";
+    translations[TranslationKeys::ACTIVATION_IP_CHECK] = "Checking connection";
+    translations[TranslationKeys::ACTIVATION_DONE] = "Connected in";
+    translations[TranslationKeys::ACTIVATION_FAILED] = "Failed:";
+    translations[TranslationKeys::ACTIVATION_CANCELLED] = "Cancelled";
+    translations[TranslationKeys::LAST_SCANNED] = "Last scanned";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(+{1} more access points)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Signal {1}-{2}% since {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "Last connect took {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Connected to {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Roamed {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Lost {1}";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1} s ago";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1} min ago";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1} h ago";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1} d ago";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "wrong password or missing secrets";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "the access point rejected the connection";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "authentication timed out";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "Wi-Fi supplicant error";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "network not found";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "no IP address (DHCP failed)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "IP lease expired";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "link lost";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "disconnected by user";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "replaced by another connection";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "reason {1}";
+    translations[TranslationKeys::DIAGNOSTICS_TITLE] = "Network Diagnostics";
+    translations[TranslationKeys::DIAGNOSTICS_HOST_PLACEHOLDER] = "Optional host for a TCP test, e.g. example.com:443";
+    translations[TranslationKeys::DIAGNOSTICS_SAMPLES] = "Samples";
+    translations[TranslationKeys::DIAGNOSTICS_RUN] = "Run";
+    translations[TranslationKeys::DIAGNOSTICS_STOP] = "Stop";
+    translations[TranslationKeys::DIAGNOSTICS_TARGET] = "Target";
+    translations[TranslationKeys::DIAGNOSTICS_METHOD] = "Method";
+    translations[TranslationKeys::DIAGNOSTICS_REPLIES] = "Replies";
+    translations[TranslationKeys::DIAGNOSTICS_MIN] = "Min";
+    translations[TranslationKeys::DIAGNOSTICS_P50] = "Median";
+    translations[TranslationKeys::DIAGNOSTICS_P90] = "p90";
+    translations[TranslationKeys::DIAGNOSTICS_P99] = "p99";
+    translations[TranslationKeys::DIAGNOSTICS_STATUS] = "Status";
+    translations[TranslationKeys::APP_USAGE_TITLE] = "Apps using the network";
+    translations[TranslationKeys::APP_USAGE_NONE] = "No active connections";
+    translations[TranslationKeys::APP_USAGE_OTHER] = "Other users' processes";
+    translations[TranslationKeys::SAVED_NETWORKS] = "Saved Networks";
+    translations[TranslationKeys::SAVED_SEARCH_PLACEHOLDER] = "Search saved networks";
+    translations[TranslationKeys::SAVED_AUTOCONNECT_ON] = "Auto-connect on";
+    translations[TranslationKeys::SAVED_AUTOCONNECT_OFF] = "Auto-connect off";
+    translations[TranslationKeys::SAVED_AUTOCONNECT] = "Auto";
+    translations[TranslationKeys::SAVED_MANUAL] = "Manual";
+    translations[TranslationKeys::SAVED_NEVER_USED] = "Never used";
+    translations[TranslationKeys::SAVED_LAST_USED] = "Last used";
+    translations[TranslationKeys::SAVED_COUNT] = "saved";
+    translations[TranslationKeys::SAVED_SELECTED] = "selected";
+    translations[TranslationKeys::SAVED_FAILED] = "failed";
+    translations[TranslationKeys::SAVED_FORGET_CONFIRM] = "Forget the selected networks? Their saved passwords will be removed.";
+    translations[TranslationKeys::BLUETOOTH_UNAVAILABLE] = "Bluetooth service is not running";
+    translations[TranslationKeys::STOP_SCAN] = "Stop Scan";
+    translations[TranslationKeys::SCAN_DURATION] = "Scan duration";
+    translations[TranslationKeys::PAIRING] = "Pairing...";
+    translations[TranslationKeys::DISCONNECTING] = "Disconnecting...";
+    translations[TranslationKeys::REMOVING] = "Removing...";
+    translations[TranslationKeys::QUEUED] = "Queued";
+    translations[TranslationKeys::BATTERY_BLU] = "Battery";
+    translations[TranslationKeys::STREAMING_BLU] = "streaming";
+    translations[TranslationKeys::BATTERY_STATE_UNKNOWN] = "Unknown";
+    translations[TranslationKeys::BATTERY_LEVEL_NORMAL] = "Normal";
+    translations[TranslationKeys::BATTERY_LEVEL_LOW] = "Low";
+    translations[TranslationKeys::BATTERY_LEVEL_CRITICAL] = "Critical";
+    translations[TranslationKeys::BATTERY_REMAINING] = "remaining";
+    translations[TranslationKeys::BATTERY_UNTIL_FULL] = "until full";
+    translations[TranslationKeys::BATTERY_HISTORY] = "History";
+    translations[TranslationKeys::HISTORY_DAY] = "24 h";
+    translations[TranslationKeys::HISTORY_WEEK] = "7 days";
+    translations[TranslationKeys::BATTERY_NO_HISTORY] = "No history recorded yet";
+    translations[TranslationKeys::PERIPHERAL_BATTERIES] = "DEVICE BATTERIES";
+    translations[TranslationKeys::DRIVE_NOT_RESPONDING] = "Not responding";
+    translations[TranslationKeys::USAGE_ANALYZE] = "What's using space";
+    translations[TranslationKeys::USAGE_DRIVES] = "Drives";
+    translations[TranslationKeys::USAGE_UP] = "Up";
+    translations[TranslationKeys::USAGE_STOP] = "Stop";
+    translations[TranslationKeys::USAGE_RESCAN] = "Rescan";
+    translations[TranslationKeys::USAGE_SCANNING] = "Scanning";
+    translations[TranslationKeys::USAGE_COMPLETE] = "Scan complete";
+    translations[TranslationKeys::USAGE_STOPPED] = "Scan stopped";
+    translations[TranslationKeys::USAGE_ITEMS] = "items";
+    translations[TranslationKeys::USAGE_UNREADABLE] = "unreadable folders";
+    translations[TranslationKeys::USAGE_FILES_HERE] = "Files in this folder";
+    translations[TranslationKeys::SORT_BY_SIZE] = "Size";
+    translations[TranslationKeys::SORT_BY_NAME] = "Name";
+    translations[TranslationKeys::SORT_BY_ITEMS] = "Items";
+    translations[TranslationKeys::USAGE_TREEMAP] = "Treemap";
+    translations[TranslationKeys::USAGE_LIST] = "List";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
@@ -223,6 +320,10 @@ void loadEnglishTranslations(std::map<TranslationKeys, std::string>& translation
     
     // Sound Manager
     translations[TranslationKeys::VOLUME_VALUE] = "0%";
+    translations[TranslationKeys::EQUALIZER] = "EQUALIZER";
+    translations[TranslationKeys::EQUALIZER_SAVE_PRESET] = "SAVE";
+    translations[TranslationKeys::EQUALIZER_SAVE_PRESET_AS] = "SAVE AS";
+    translations[TranslationKeys::EQUALIZER_PRESET_NAME] = "Preset name:";
     
     // Battery Manager Additional
     translations[TranslationKeys::POWER_DETAILS] = "POWER DETAILS";
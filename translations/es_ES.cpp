@@ -206,6 +206,27 @@ void loadSpanishTranslations(std::map<TranslationKeys, std::string>& translation
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Red deshabilitada";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi deshabilitado";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "No conectado";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(+{1} puntos de acceso más)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Señal {1}-{2}% desde {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "La última conexión tardó {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Conectado a {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Itinerancia {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Conexión perdida con {1}";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "hace {1} s";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "hace {1} min";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "hace {1} h";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "hace {1} d";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "contraseña incorrecta o faltan credenciales";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "el punto de acceso rechazó la conexión";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "se agotó el tiempo de autenticación";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "error del suplicante Wi-Fi";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "red no encontrada";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "sin dirección IP (falló DHCP)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "la concesión de IP caducó";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "enlace perdido";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "desconectado por el usuario";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "reemplazado por otra conexión";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "motivo {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
@@ -206,6 +206,27 @@ void loadFrenchTranslations(std::map<TranslationKeys, std::string>& translations
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Réseau désactivé";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi désactivé";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "Non connecté";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(+{1} autres points d'accès)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Signal {1}-{2}%, premier relevé {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "Dernière connexion établie en {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Connecté à {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Itinérance {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Connexion perdue avec {1}";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "il y a {1} s";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "il y a {1} min";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "il y a {1} h";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "il y a {1} j";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "mot de passe incorrect ou identifiants manquants";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "le point d'accès a refusé la connexion";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "délai d'authentification dépassé";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "erreur du supplicant Wi-Fi";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "réseau introuvable";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "aucune adresse IP (échec DHCP)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "bail IP expiré";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "liaison perdue";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "déconnecté par l'utilisateur";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "remplacé par une autre connexion";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "raison {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
@@ -206,6 +206,27 @@ void loadIndonesianTranslations(std::map<TranslationKeys, std::string>& translat
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Jaringan dinonaktifkan";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi dinonaktifkan";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "Tidak terhubung";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(+{1} titik akses lain)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Sinyal {1}-{2}% sejak {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "Koneksi terakhir memerlukan {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Terhubung ke {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Roaming {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Terputus dari {1}";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1} dtk lalu";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1} mnt lalu";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1} jam lalu";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1} hari lalu";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "kata sandi salah atau kredensial tidak ada";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "titik akses menolak koneksi";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "waktu autentikasi habis";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "kesalahan supplicant Wi-Fi";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "jaringan tidak ditemukan";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "tidak ada alamat IP (DHCP gagal)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "sewa IP kedaluwarsa";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "tautan terputus";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "diputus oleh pengguna";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "digantikan oleh koneksi lain";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "alasan {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
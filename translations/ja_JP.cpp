@@ -206,6 +206,27 @@ void loadJapaneseTranslations(std::map<TranslationKeys, std::string>& translatio
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "ネットワークが無効";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fiが無効";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "未接続";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "（他に {1} 個のアクセスポイント）";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "信号 {1}-{2}%（{3}から）";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "前回の接続時間 {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "{1} に接続（{2}）";
+    translations[TranslationKeys::ROAM_ROAMED] = "ローミング {1} → {2}（{3} → {4}）";
+    translations[TranslationKeys::ROAM_LOST] = "{1} との接続が切れました";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1} 秒前";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1} 分前";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1} 時間前";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1} 日前";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "パスワードが違うか認証情報がありません";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "アクセスポイントが接続を拒否しました";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "認証がタイムアウトしました";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "Wi-Fi サプリカントのエラー";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "ネットワークが見つかりません";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "IP アドレスがありません（DHCP 失敗）";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "IP リースの期限切れ";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "リンクが切断されました";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "ユーザーにより切断";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "別の接続に置き換えられました";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "理由 {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
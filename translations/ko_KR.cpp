@@ -206,6 +206,27 @@ void loadKoreanTranslations(std::map<TranslationKeys, std::string>& translations
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "네트워크 비활성화";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi 비활성화";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "연결되지 않음";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(액세스 포인트 {1}개 더)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "신호 {1}-{2}% ({3}부터)";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "마지막 연결 소요 시간 {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "{1}에 연결됨 ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "로밍 {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "{1} 연결 끊김";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1}초 전";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1}분 전";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1}시간 전";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1}일 전";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "잘못된 비밀번호 또는 인증 정보 없음";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "액세스 포인트가 연결을 거부함";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "인증 시간 초과";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "Wi-Fi 서플리컨트 오류";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "네트워크를 찾을 수 없음";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "IP 주소 없음 (DHCP 실패)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "IP 임대 만료";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "링크 끊김";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "사용자가 연결 해제함";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "다른 연결로 대체됨";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "사유 {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
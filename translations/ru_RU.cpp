@@ -206,6 +206,27 @@ void loadRussianTranslations(std::map<TranslationKeys, std::string>& translation
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Сеть отключена";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi отключен";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "Не подключено";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(ещё точек доступа: {1})";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Сигнал {1}-{2}%, начиная с {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "Последнее подключение заняло {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Подключено к {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Роуминг {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Потеряна связь с {1}";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1} с назад";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1} мин назад";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1} ч назад";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1} д назад";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "неверный пароль или нет учётных данных";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "точка доступа отклонила подключение";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "истекло время аутентификации";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "ошибка Wi-Fi supplicant";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "сеть не найдена";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "нет IP-адреса (сбой DHCP)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "истекла аренда IP";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "связь потеряна";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "отключено пользователем";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "заменено другим подключением";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "причина {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
@@ -79,6 +79,25 @@ const std::string& TranslationManager::translate(TranslationKeys key) const {
     return unknown;
 }
 
+std::string TranslationManager::format(TranslationKeys key, std::initializer_list<std::string> values) const {
+    const std::string& pattern = translate(key);
+    std::string result;
+    result.reserve(pattern.size());
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (pattern[i] == '{' && i + 2 < pattern.size() && pattern[i + 2] == '}' &&
+            pattern[i + 1] >= '1' && pattern[i + 1] <= '9') {
+            size_t index = static_cast<size_t>(pattern[i + 1] - '1');
+            if (index < values.size()) {
+                result += *(values.begin() + index);
+                i += 2;
+                continue;
+            }
+        }
+        result += pattern[i];
+    }
+    return result;
+}
+
 std::vector<std::string> TranslationManager::getAvailableLanguages() const {
     std::vector<std::string> languages;
     for (const auto& pair : translations) {
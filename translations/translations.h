@@ -2,6 +2,7 @@
 #define TRANSLATIONS_H
 
 #include <string>
+#include <initializer_list>
 #include <map>
 #include <memory>
 #include <vector>
@@ -211,6 +212,103 @@ enum class TranslationKeys {
     NETWORKING_DISABLED_STATUS,
     WIFI_DISABLED_STATUS,
     NOT_CONNECTED_STATUS,
+    THROUGHPUT_TOTAL,
+    ACTIVATION_REQUESTING,
+    ACTIVATION_PREPARE,
+    ACTIVATION_CONFIG,
+    ACTIVATION_NEED_AUTH,
+    ACTIVATION_IP_CONFIG,
+    ACTIVATION_IP_CHECK,
+    ACTIVATION_DONE,
+    ACTIVATION_FAILED,
+    ACTIVATION_CANCELLED,
+    LAST_SCANNED,
+    WIFI_MORE_ACCESS_POINTS,
+    WIFI_SIGNAL_RANGE,
+    WIFI_LAST_CONNECT,
+    ROAM_CONNECTED,
+    ROAM_ROAMED,
+    ROAM_LOST,
+    TIME_AGO_SECONDS,
+    TIME_AGO_MINUTES,
+    TIME_AGO_HOURS,
+    TIME_AGO_DAYS,
+    DEVICE_REASON_NO_SECRETS,
+    DEVICE_REASON_AP_REJECTED,
+    DEVICE_REASON_AUTH_TIMEOUT,
+    DEVICE_REASON_SUPPLICANT,
+    DEVICE_REASON_SSID_NOT_FOUND,
+    DEVICE_REASON_DHCP_FAILED,
+    DEVICE_REASON_LEASE_EXPIRED,
+    DEVICE_REASON_LINK_LOST,
+    DEVICE_REASON_USER,
+    DEVICE_REASON_REPLACED,
+    DEVICE_REASON_OTHER,
+    DIAGNOSTICS_TITLE,
+    DIAGNOSTICS_HOST_PLACEHOLDER,
+    DIAGNOSTICS_SAMPLES,
+    DIAGNOSTICS_RUN,
+    DIAGNOSTICS_STOP,
+    DIAGNOSTICS_TARGET,
+    DIAGNOSTICS_METHOD,
+    DIAGNOSTICS_REPLIES,
+    DIAGNOSTICS_MIN,
+    DIAGNOSTICS_P50,
+    DIAGNOSTICS_P90,
+    DIAGNOSTICS_P99,
+    DIAGNOSTICS_STATUS,
+    APP_USAGE_TITLE,
+    APP_USAGE_NONE,
+    APP_USAGE_OTHER,
+    SAVED_NETWORKS,
+    SAVED_SEARCH_PLACEHOLDER,
+    SAVED_AUTOCONNECT_ON,
+    SAVED_AUTOCONNECT_OFF,
+    SAVED_AUTOCONNECT,
+    SAVED_MANUAL,
+    SAVED_NEVER_USED,
+    SAVED_LAST_USED,
+    SAVED_COUNT,
+    SAVED_SELECTED,
+    SAVED_FAILED,
+    SAVED_FORGET_CONFIRM,
+    BLUETOOTH_UNAVAILABLE,
+    STOP_SCAN,
+    SCAN_DURATION,
+    PAIRING,
+    DISCONNECTING,
+    REMOVING,
+    QUEUED,
+    BATTERY_BLU,
+    STREAMING_BLU,
+    BATTERY_STATE_UNKNOWN,
+    BATTERY_LEVEL_NORMAL,
+    BATTERY_LEVEL_LOW,
+    BATTERY_LEVEL_CRITICAL,
+    BATTERY_REMAINING,
+    BATTERY_UNTIL_FULL,
+    BATTERY_HISTORY,
+    HISTORY_DAY,
+    HISTORY_WEEK,
+    BATTERY_NO_HISTORY,
+    PERIPHERAL_BATTERIES,
+    DRIVE_NOT_RESPONDING,
+    USAGE_ANALYZE,
+    USAGE_DRIVES,
+    USAGE_UP,
+    USAGE_STOP,
+    USAGE_RESCAN,
+    USAGE_SCANNING,
+    USAGE_COMPLETE,
+    USAGE_STOPPED,
+    USAGE_ITEMS,
+    USAGE_UNREADABLE,
+    USAGE_FILES_HERE,
+    SORT_BY_SIZE,
+    SORT_BY_NAME,
+    SORT_BY_ITEMS,
+    USAGE_TREEMAP,
+    USAGE_LIST,
     
     // Navigation Buttons
     PREVIOUS_ARROW,
@@ -228,6 +326,10 @@ enum class TranslationKeys {
     
     // Sound Manager
     VOLUME_VALUE,
+    EQUALIZER,
+    EQUALIZER_SAVE_PRESET,
+    EQUALIZER_SAVE_PRESET_AS,
+    EQUALIZER_PRESET_NAME,
     
     // Battery Manager Additional
     POWER_DETAILS,
@@ -260,6 +362,9 @@ public:
     void setLanguage(const std::string& languageCode);
     std::string getLanguage() const;
     const std::string& translate(TranslationKeys key) const;
+    // The translation with {1}, {2}, ... replaced by the given values, so
+    // each language can put them where its word order needs them
+    std::string format(TranslationKeys key, std::initializer_list<std::string> values) const;
     
     // Get list of available languages
     std::vector<std::string> getAvailableLanguages() const;
@@ -286,5 +391,6 @@ private:
 
 // Convenience macro for translation
 #define TR(key) TranslationManager::getInstance().translate(key).c_str()
+#define TRF(key, ...) TranslationManager::getInstance().format(key, {__VA_ARGS__})
 
 #endif // TRANSLATIONS_H
@@ -206,6 +206,27 @@ void loadVietnameseTranslations(std::map<TranslationKeys, std::string>& translat
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "Mạng bị vô hiệu hóa";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi bị vô hiệu hóa";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "Chưa kết nối";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "(+{1} điểm truy cập khác)";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "Tín hiệu {1}-{2}% từ {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "Lần kết nối gần nhất mất {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "Đã kết nối với {1} ({2})";
+    translations[TranslationKeys::ROAM_ROAMED] = "Chuyển vùng {1} → {2} ({3} → {4})";
+    translations[TranslationKeys::ROAM_LOST] = "Mất kết nối với {1}";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1} giây trước";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1} phút trước";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1} giờ trước";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1} ngày trước";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "sai mật khẩu hoặc thiếu thông tin xác thực";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "điểm truy cập đã từ chối kết nối";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "hết thời gian xác thực";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "lỗi Wi-Fi supplicant";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "không tìm thấy mạng";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "không có địa chỉ IP (DHCP thất bại)";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "thời hạn thuê IP đã hết";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "mất liên kết";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "người dùng đã ngắt kết nối";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "đã bị thay thế bởi kết nối khác";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "lý do {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";
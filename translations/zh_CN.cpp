@@ -205,6 +205,27 @@ void loadChineseTranslations(std::map<TranslationKeys, std::string>& translation
     translations[TranslationKeys::NETWORKING_DISABLED_STATUS] = "网络已禁用";
     translations[TranslationKeys::WIFI_DISABLED_STATUS] = "Wi-Fi已禁用";
     translations[TranslationKeys::NOT_CONNECTED_STATUS] = "未连接";
+    translations[TranslationKeys::WIFI_MORE_ACCESS_POINTS] = "（另有 {1} 个接入点）";
+    translations[TranslationKeys::WIFI_SIGNAL_RANGE] = "信号 {1}-{2}%，始于 {3}";
+    translations[TranslationKeys::WIFI_LAST_CONNECT] = "上次连接耗时 {1}";
+    translations[TranslationKeys::ROAM_CONNECTED] = "已连接到 {1}（{2}）";
+    translations[TranslationKeys::ROAM_ROAMED] = "已漫游 {1} → {2}（{3} → {4}）";
+    translations[TranslationKeys::ROAM_LOST] = "已与 {1} 断开";
+    translations[TranslationKeys::TIME_AGO_SECONDS] = "{1} 秒前";
+    translations[TranslationKeys::TIME_AGO_MINUTES] = "{1} 分钟前";
+    translations[TranslationKeys::TIME_AGO_HOURS] = "{1} 小时前";
+    translations[TranslationKeys::TIME_AGO_DAYS] = "{1} 天前";
+    translations[TranslationKeys::DEVICE_REASON_NO_SECRETS] = "密码错误或缺少凭据";
+    translations[TranslationKeys::DEVICE_REASON_AP_REJECTED] = "接入点拒绝了连接";
+    translations[TranslationKeys::DEVICE_REASON_AUTH_TIMEOUT] = "认证超时";
+    translations[TranslationKeys::DEVICE_REASON_SUPPLICANT] = "Wi-Fi 请求程序错误";
+    translations[TranslationKeys::DEVICE_REASON_SSID_NOT_FOUND] = "未找到网络";
+    translations[TranslationKeys::DEVICE_REASON_DHCP_FAILED] = "无 IP 地址（DHCP 失败）";
+    translations[TranslationKeys::DEVICE_REASON_LEASE_EXPIRED] = "IP 租约已过期";
+    translations[TranslationKeys::DEVICE_REASON_LINK_LOST] = "链路断开";
+    translations[TranslationKeys::DEVICE_REASON_USER] = "已由用户断开";
+    translations[TranslationKeys::DEVICE_REASON_REPLACED] = "已被其他连接取代";
+    translations[TranslationKeys::DEVICE_REASON_OTHER] = "原因 {1}";
     
     // Navigation Buttons
     translations[TranslationKeys::PREVIOUS_ARROW] = "‹";